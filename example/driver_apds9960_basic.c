@@ -48,7 +48,7 @@ static apds9960_handle_t gs_handle;        /**< apds9960 handle */
 uint8_t apds9960_basic_init(void)
 {
     uint8_t res;
-    uint8_t reg;
+    apds9960_config_t config;
     
     /* link interface function */
     DRIVER_APDS9960_LINK_INIT(&gs_handle, apds9960_handle_t);
@@ -56,7 +56,10 @@ uint8_t apds9960_basic_init(void)
     DRIVER_APDS9960_LINK_IIC_DEINIT(&gs_handle, apds9960_interface_iic_deinit);
     DRIVER_APDS9960_LINK_IIC_READ(&gs_handle, apds9960_interface_iic_read);
     DRIVER_APDS9960_LINK_IIC_WRITE(&gs_handle, apds9960_interface_iic_write);
+    DRIVER_APDS9960_LINK_IIC_TRANSFER(&gs_handle, apds9960_interface_iic_transfer);
     DRIVER_APDS9960_LINK_DELAY_MS(&gs_handle, apds9960_interface_delay_ms);
+    DRIVER_APDS9960_LINK_TIMESTAMP_NS(&gs_handle, apds9960_interface_timestamp_ns);
+    DRIVER_APDS9960_LINK_DELAY_UNTIL_NS(&gs_handle, apds9960_interface_delay_until_ns);
     DRIVER_APDS9960_LINK_DEBUG_PRINT(&gs_handle, apds9960_interface_debug_print);
     DRIVER_APDS9960_LINK_RECEIVE_CALLBACK(&gs_handle, apds9960_interface_receive_callback);
     
@@ -69,78 +72,38 @@ uint8_t apds9960_basic_init(void)
         return 1;
     }
     
-    /* power on */
-    res = apds9960_set_conf(&gs_handle, APDS9960_CONF_POWER_ON, APDS9960_BOOL_TRUE);
+    /* enable the register cache */
+    res = apds9960_set_cache(&gs_handle, APDS9960_BOOL_TRUE);
     if (res != 0)
     {
-        apds9960_interface_debug_print("apds9960: set conf failed.\n");
+        apds9960_interface_debug_print("apds9960: set cache failed.\n");
         (void)apds9960_deinit(&gs_handle);
         
         return 1;
     }
     
-    /* disable wait time */
-    res = apds9960_set_conf(&gs_handle, APDS9960_CONF_WAIT_ENABLE, APDS9960_BOOL_FALSE);
+    /* sync the register cache */
+    res = apds9960_cache_sync(&gs_handle);
     if (res != 0)
     {
-        apds9960_interface_debug_print("apds9960: set conf failed.\n");
+        apds9960_interface_debug_print("apds9960: cache sync failed.\n");
         (void)apds9960_deinit(&gs_handle);
         
         return 1;
     }
     
-    /* disable proximity detect */
-    res = apds9960_set_conf(&gs_handle, APDS9960_CONF_PROXIMITY_DETECT_ENABLE, APDS9960_BOOL_FALSE);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set conf failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* disable als */
-    res = apds9960_set_conf(&gs_handle, APDS9960_CONF_ALS_ENABLE, APDS9960_BOOL_FALSE);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set conf failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* disable als interrupt */
-    res = apds9960_set_conf(&gs_handle, APDS9960_CONF_ALS_INTERRUPT_ENABLE, APDS9960_BOOL_FALSE);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set conf failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* disable proximity interrupt */
-    res = apds9960_set_conf(&gs_handle, APDS9960_CONF_PROXIMITY_INTERRUPT_ENABLE, APDS9960_BOOL_FALSE);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set conf failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* disable gesture */
-    res = apds9960_set_conf(&gs_handle, APDS9960_CONF_GESTURE_ENABLE, APDS9960_BOOL_FALSE);
+    /* disable wait long */
+    res = apds9960_set_wait_long(&gs_handle, APDS9960_BOOL_FALSE);
     if (res != 0)
     {
-        apds9960_interface_debug_print("apds9960: set conf failed.\n");
+        apds9960_interface_debug_print("apds9960: set wait long failed.\n");
         (void)apds9960_deinit(&gs_handle);
         
         return 1;
     }
     
     /* convert adc integration time */
-    res = apds9960_adc_integration_time_convert_to_register(&gs_handle, APDS9960_BASIC_DEFAULT_ADC_INTEGRATION_TIME, (uint8_t *)&reg);
+    res = apds9960_adc_integration_time_convert_to_register(&gs_handle, APDS9960_BASIC_DEFAULT_ADC_INTEGRATION_TIME, (uint8_t *)&config.adc_integration_time);
     if (res != 0)
     {
         apds9960_interface_debug_print("apds9960: adc integration time convert to register failed.\n");
@@ -149,28 +112,8 @@ uint8_t apds9960_basic_init(void)
         return 1;
     }
     
-    /* set adc integration time */
-    res = apds9960_set_adc_integration_time(&gs_handle, reg);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set adc integration time failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* disable wait long */
-    res = apds9960_set_wait_long(&gs_handle, APDS9960_BOOL_FALSE);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set wait long failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
     /* wait time convert to register */
-    res = apds9960_wait_time_convert_to_register(&gs_handle, APDS9960_BASIC_DEFAULT_WAIT_TIME, (uint8_t *)&reg);
+    res = apds9960_wait_time_convert_to_register(&gs_handle, APDS9960_BASIC_DEFAULT_WAIT_TIME, (uint8_t *)&config.wait_time);
     if (res != 0)
     {
         apds9960_interface_debug_print("apds9960: wait time convert to register failed.\n");
@@ -179,381 +122,60 @@ uint8_t apds9960_basic_init(void)
         return 1;
     }
     
-    /* set wait time */
-    res = apds9960_set_wait_time(&gs_handle, reg);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set wait time failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set als interrupt low threshold */
-    res = apds9960_set_als_interrupt_low_threshold(&gs_handle, APDS9960_BASIC_DEFAULT_ALS_INTERRUPT_LOW_THRESHOLD);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set als interrupt low threshold failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set als interrupt high threshold */
-    res = apds9960_set_als_interrupt_high_threshold(&gs_handle, APDS9960_BASIC_DEFAULT_ALS_INTERRUPT_HIGH_THRESHOLD);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set als interrupt high threshold failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set proximity interrupt low threshold */
-    res = apds9960_set_proximity_interrupt_low_threshold(&gs_handle, APDS9960_BASIC_DEFAULT_PROXIMITY_INTERRUPT_LOW_THRESHOLD);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set proximity interrupt low threshold failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set proximity interrupt high threshold */
-    res = apds9960_set_proximity_interrupt_high_threshold(&gs_handle, APDS9960_BASIC_DEFAULT_PROXIMITY_INTERRUPT_HIGH_THRESHOLD);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set proximity interrupt high threshold failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* proximity interrupt cycle */
-    res = apds9960_set_proximity_interrupt_cycle(&gs_handle, APDS9960_BASIC_DEFAULT_PROXIMITY_INTERRUPT_CYCLE);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set proximity interrupt cycle failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* als interrupt cycle */
-    res = apds9960_set_als_interrupt_cycle(&gs_handle, APDS9960_BASIC_DEFAULT_ALS_INTERRUPT_CYCLE);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set als interrupt cycle failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set proximity pulse length */
-    res = apds9960_set_proximity_pulse_length(&gs_handle, APDS9960_BASIC_DEFAULT_PROXIMITY_PULSE_LENGTH);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set proximity pulse length failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set proximity pulse count */
-    res = apds9960_set_proximity_pulse_count(&gs_handle, APDS9960_BASIC_DEFAULT_PROXIMITY_PULSE_COUNT);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set proximity pulse count failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set led current */
-    res = apds9960_set_led_current(&gs_handle, APDS9960_BASIC_DEFAULT_LED_CURRENT);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set led current failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set proximity gain */
-    res = apds9960_set_proximity_gain(&gs_handle, APDS9960_BASIC_DEFAULT_PROXIMITY_GAIN);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set proximity gain failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set als color gain */
-    res = apds9960_set_als_color_gain(&gs_handle, APDS9960_BASIC_DEFAULT_ALS_COLOR_GAIN);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set als color gain failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set proximity saturation interrupt */
-    res = apds9960_set_saturation_interrupt(&gs_handle, APDS9960_SATURATION_INTERRUPT_PROXIMITY, APDS9960_BASIC_DEFAULT_SATURATION_INTERRUPT_PROXIMITY);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set saturation interrupt failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set clear photo diode saturation interrupt */
-    res = apds9960_set_saturation_interrupt(&gs_handle, APDS9960_SATURATION_INTERRUPT_CLEAR_PHOTODIODE, APDS9960_BASIC_DEFAULT_SATURATION_INTERRUPT_CLEAR_PHOTODIODE);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set saturation interrupt failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set led boost */
-    res = apds9960_set_led_boost(&gs_handle, APDS9960_BASIC_DEFAULT_LED_BOOST);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set led boost failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set proximity up right offset */
-    res = apds9960_set_proximity_up_right_offset(&gs_handle, APDS9960_BASIC_DEFAULT_PROXIMITY_UP_RIGHT_OFFSET);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set proximity up right offset failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set proximity down left offset */
-    res = apds9960_set_proximity_down_left_offset(&gs_handle, APDS9960_BASIC_DEFAULT_PROXIMITY_DOWN_LEFT_OFFSET);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set proximity down left offset failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set proximity gain compensation */
-    res = apds9960_set_proximity_gain_compensation(&gs_handle, APDS9960_BASIC_DEFAULT_PROXIMITY_GAIN_COMPENSATION);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set proximity gain compensation failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set sleep after interrupt */
-    res = apds9960_set_sleep_after_interrupt(&gs_handle, APDS9960_BASIC_DEFAULT_SLEEP_AFTER_INTERRUPT);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set sleep after interrupt failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set proximity mask up */
-    res = apds9960_set_proximity_mask(&gs_handle, APDS9960_PROXIMITY_MASK_UP, APDS9960_BASIC_DEFAULT_PROXIMITY_MASK_UP);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set proximity mask failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set proximity mask down */
-    res = apds9960_set_proximity_mask(&gs_handle, APDS9960_PROXIMITY_MASK_DOWN, APDS9960_BASIC_DEFAULT_PROXIMITY_MASK_DOWN);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set proximity mask failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set proximity mask left */
-    res = apds9960_set_proximity_mask(&gs_handle, APDS9960_PROXIMITY_MASK_LEFT, APDS9960_BASIC_DEFAULT_PROXIMITY_MASK_LEFT);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set proximity mask failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set proximity mask right */
-    res = apds9960_set_proximity_mask(&gs_handle, APDS9960_PROXIMITY_MASK_RIGHT, APDS9960_BASIC_DEFAULT_PROXIMITY_MASK_RIGHT);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set proximity mask failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture proximity enter threshold */
-    res = apds9960_set_gesture_proximity_enter_threshold(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_PROXIMITY_ENTER_THRESHOLD);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture proximity enter threshold failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture proximity exit threshold */
-    res = apds9960_set_gesture_proximity_exit_threshold(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_PROXIMITY_EXIT_THRESHOLD);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture proximity exit threshold failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture fifo threshold */
-    res = apds9960_set_gesture_fifo_threshold(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_FIFO_THRESHOLD);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture fifo threshold failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture exit persistence */
-    res = apds9960_set_gesture_exit_persistence(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_EXIT_PERSISTENCE);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture exit persistence failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture exit mask */
-    res = apds9960_set_gesture_exit_mask(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_EXIT_MASK);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture exit mask failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture gain */
-    res = apds9960_set_gesture_gain(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_GAIN);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture gain failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture led current */
-    res = apds9960_set_gesture_led_current(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_LED_CURRENT);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture led current failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture wait time */
-    res = apds9960_set_gesture_wait_time(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_WAIT_TIME);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture wait time failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture up offset */
-    res = apds9960_set_gesture_up_offset(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_UP_OFFSET);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture up offset failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture down offset */
-    res = apds9960_set_gesture_down_offset(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_DOWN_OFFSET);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture down offset failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture left offset */
-    res = apds9960_set_gesture_left_offset(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_LEFT_OFFSET);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture left offset failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture right offset */
-    res = apds9960_set_gesture_right_offset(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_RIGHT_OFFSET);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture right offset failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture pulse length */
-    res = apds9960_set_gesture_pulse_length(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_PULSE_LENGTH);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture pulse length failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture pulse count */
-    res = apds9960_set_gesture_pulse_count(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_PULSE_COUNT);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture pulse count failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture dimension */
-    res = apds9960_set_gesture_dimension(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_DIMENSION);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture dimension failed.\n");
+    /* set the config */
+    config.power_on = APDS9960_BOOL_TRUE;
+    config.als_enable = APDS9960_BOOL_TRUE;
+    config.proximity_detect_enable = APDS9960_BOOL_TRUE;
+    config.wait_enable = APDS9960_BOOL_TRUE;
+    config.als_interrupt_enable = APDS9960_BOOL_FALSE;
+    config.proximity_interrupt_enable = APDS9960_BOOL_FALSE;
+    config.gesture_enable = APDS9960_BOOL_FALSE;
+    config.wait_long = APDS9960_BOOL_FALSE;
+    config.als_interrupt_low_threshold = APDS9960_BASIC_DEFAULT_ALS_INTERRUPT_LOW_THRESHOLD;
+    config.als_interrupt_high_threshold = APDS9960_BASIC_DEFAULT_ALS_INTERRUPT_HIGH_THRESHOLD;
+    config.proximity_interrupt_low_threshold = APDS9960_BASIC_DEFAULT_PROXIMITY_INTERRUPT_LOW_THRESHOLD;
+    config.proximity_interrupt_high_threshold = APDS9960_BASIC_DEFAULT_PROXIMITY_INTERRUPT_HIGH_THRESHOLD;
+    config.proximity_interrupt_cycle = APDS9960_BASIC_DEFAULT_PROXIMITY_INTERRUPT_CYCLE;
+    config.als_interrupt_cycle = APDS9960_BASIC_DEFAULT_ALS_INTERRUPT_CYCLE;
+    config.proximity_pulse_length = APDS9960_BASIC_DEFAULT_PROXIMITY_PULSE_LENGTH;
+    config.proximity_pulse_count = APDS9960_BASIC_DEFAULT_PROXIMITY_PULSE_COUNT;
+    config.led_current = APDS9960_BASIC_DEFAULT_LED_CURRENT;
+    config.proximity_gain = APDS9960_BASIC_DEFAULT_PROXIMITY_GAIN;
+    config.als_color_gain = APDS9960_BASIC_DEFAULT_ALS_COLOR_GAIN;
+    config.saturation_interrupt_proximity = APDS9960_BASIC_DEFAULT_SATURATION_INTERRUPT_PROXIMITY;
+    config.saturation_interrupt_clear_photodiode = APDS9960_BASIC_DEFAULT_SATURATION_INTERRUPT_CLEAR_PHOTODIODE;
+    config.led_boost = APDS9960_BASIC_DEFAULT_LED_BOOST;
+    config.proximity_up_right_offset = APDS9960_BASIC_DEFAULT_PROXIMITY_UP_RIGHT_OFFSET;
+    config.proximity_down_left_offset = APDS9960_BASIC_DEFAULT_PROXIMITY_DOWN_LEFT_OFFSET;
+    config.proximity_gain_compensation = APDS9960_BASIC_DEFAULT_PROXIMITY_GAIN_COMPENSATION;
+    config.sleep_after_interrupt = APDS9960_BASIC_DEFAULT_SLEEP_AFTER_INTERRUPT;
+    config.proximity_mask_up = APDS9960_BASIC_DEFAULT_PROXIMITY_MASK_UP;
+    config.proximity_mask_down = APDS9960_BASIC_DEFAULT_PROXIMITY_MASK_DOWN;
+    config.proximity_mask_left = APDS9960_BASIC_DEFAULT_PROXIMITY_MASK_LEFT;
+    config.proximity_mask_right = APDS9960_BASIC_DEFAULT_PROXIMITY_MASK_RIGHT;
+    config.gesture_proximity_enter_threshold = APDS9960_BASIC_DEFAULT_GESTURE_PROXIMITY_ENTER_THRESHOLD;
+    config.gesture_proximity_exit_threshold = APDS9960_BASIC_DEFAULT_GESTURE_PROXIMITY_EXIT_THRESHOLD;
+    config.gesture_fifo_threshold = APDS9960_BASIC_DEFAULT_GESTURE_FIFO_THRESHOLD;
+    config.gesture_exit_persistence = APDS9960_BASIC_DEFAULT_GESTURE_EXIT_PERSISTENCE;
+    config.gesture_exit_mask = APDS9960_BASIC_DEFAULT_GESTURE_EXIT_MASK;
+    config.gesture_gain = APDS9960_BASIC_DEFAULT_GESTURE_GAIN;
+    config.gesture_led_current = APDS9960_BASIC_DEFAULT_GESTURE_LED_CURRENT;
+    config.gesture_wait_time = APDS9960_BASIC_DEFAULT_GESTURE_WAIT_TIME;
+    config.gesture_up_offset = APDS9960_BASIC_DEFAULT_GESTURE_UP_OFFSET;
+    config.gesture_down_offset = APDS9960_BASIC_DEFAULT_GESTURE_DOWN_OFFSET;
+    config.gesture_left_offset = APDS9960_BASIC_DEFAULT_GESTURE_LEFT_OFFSET;
+    config.gesture_right_offset = APDS9960_BASIC_DEFAULT_GESTURE_RIGHT_OFFSET;
+    config.gesture_pulse_length = APDS9960_BASIC_DEFAULT_GESTURE_PULSE_LENGTH;
+    config.gesture_pulse_count = APDS9960_BASIC_DEFAULT_GESTURE_PULSE_COUNT;
+    config.gesture_dimension = APDS9960_BASIC_DEFAULT_GESTURE_DIMENSION;
+    config.gesture_interrupt = APDS9960_BASIC_DEFAULT_GESTURE_INTERRUPT;
+    config.gesture_mode = APDS9960_BOOL_FALSE;
+    
+    /* apply the config */
+    res = apds9960_apply_config(&gs_handle, &config);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: apply config failed.\n");
         (void)apds9960_deinit(&gs_handle);
         
         return 1;
@@ -569,26 +191,6 @@ uint8_t apds9960_basic_init(void)
         return 1;
     }
     
-    /* set gesture interrupt */
-    res = apds9960_set_gesture_interrupt(&gs_handle, APDS9960_BASIC_DEFAULT_GESTURE_INTERRUPT);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture interrupt failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set gesture mode */
-    res = apds9960_set_gesture_mode(&gs_handle, APDS9960_BOOL_FALSE);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set gesture mode failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
     /* all non gesture interrupt clear */
     res = apds9960_all_non_gesture_interrupt_clear(&gs_handle);
     if (res != 0)
@@ -599,36 +201,6 @@ uint8_t apds9960_basic_init(void)
         return 1;
     }
     
-    /* enable wait time */
-    res = apds9960_set_conf(&gs_handle, APDS9960_CONF_WAIT_ENABLE, APDS9960_BOOL_TRUE);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set conf failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* enable proximity detect */
-    res = apds9960_set_conf(&gs_handle, APDS9960_CONF_PROXIMITY_DETECT_ENABLE, APDS9960_BOOL_TRUE);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set conf failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* enable als */
-    res = apds9960_set_conf(&gs_handle, APDS9960_CONF_ALS_ENABLE, APDS9960_BOOL_TRUE);
-    if (res != 0)
-    {
-        apds9960_interface_debug_print("apds9960: set conf failed.\n");
-        (void)apds9960_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
     return 0;
 }
 
@@ -693,3 +265,68 @@ uint8_t apds9960_basic_read_proximity(uint8_t *proximity)
         return 0;
     }
 }
+
+/**
+ * @brief      basic example read rgbc and proximity
+ * @param[out] *red pointer to a red buffer
+ * @param[out] *green pointer to a green buffer
+ * @param[out] *blue pointer to a blue buffer
+ * @param[out] *clear pointer to a clear buffer
+ * @param[out] *proximity pointer to a proximity buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read all failed
+ * @note       none
+ */
+uint8_t apds9960_basic_read_all(uint16_t *red, uint16_t *green, uint16_t *blue, uint16_t *clear, uint8_t *proximity)
+{
+    if (apds9960_read_all(&gs_handle, NULL, red, green, blue, clear, proximity) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief     basic example start periodic sampling
+ * @param[in] *periodic pointer to a periodic sampling structure
+ * @param[in] hz sampling rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 periodic init failed
+ * @note      1 <= hz <= 1000000 / cycle time
+ */
+uint8_t apds9960_basic_periodic_init(apds9960_periodic_t *periodic, uint16_t hz)
+{
+    if (apds9960_periodic_init(&gs_handle, periodic, hz) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief     basic example wait for the next sampling deadline
+ * @param[in] *periodic pointer to a periodic sampling structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 periodic wait failed
+ * @note      none
+ */
+uint8_t apds9960_basic_periodic_wait(apds9960_periodic_t *periodic)
+{
+    if (apds9960_periodic_wait(&gs_handle, periodic) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
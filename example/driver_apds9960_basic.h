@@ -135,6 +135,41 @@ uint8_t apds9960_basic_read_rgbc(uint16_t *red, uint16_t *green, uint16_t *blue,
  */
 uint8_t apds9960_basic_read_proximity(uint8_t *proximity);
 
+/**
+ * @brief      basic example read rgbc and proximity
+ * @param[out] *red pointer to a red buffer
+ * @param[out] *green pointer to a green buffer
+ * @param[out] *blue pointer to a blue buffer
+ * @param[out] *clear pointer to a clear buffer
+ * @param[out] *proximity pointer to a proximity buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read all failed
+ * @note       none
+ */
+uint8_t apds9960_basic_read_all(uint16_t *red, uint16_t *green, uint16_t *blue, uint16_t *clear, uint8_t *proximity);
+
+/**
+ * @brief     basic example start periodic sampling
+ * @param[in] *periodic pointer to a periodic sampling structure
+ * @param[in] hz sampling rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 periodic init failed
+ * @note      1 <= hz <= 1000000 / cycle time
+ */
+uint8_t apds9960_basic_periodic_init(apds9960_periodic_t *periodic, uint16_t hz);
+
+/**
+ * @brief     basic example wait for the next sampling deadline
+ * @param[in] *periodic pointer to a periodic sampling structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 periodic wait failed
+ * @note      none
+ */
+uint8_t apds9960_basic_periodic_wait(apds9960_periodic_t *periodic);
+
 /**
  * @}
  */
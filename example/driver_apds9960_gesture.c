@@ -36,9 +36,9 @@
 
 #include "driver_apds9960_gesture.h"
 
-static apds9960_handle_t gs_handle;                      /**< apds9960 handle */
-static uint8_t gs_data[32][4];                           /**< inner data */
-static void (*a_callback)(uint8_t type) = NULL;         /**< inner callback */
+static apds9960_handle_t gs_handle;                                  /**< apds9960 handle */
+static uint8_t gs_data[64][4];                                       /**< inner data */
+static void (*a_callback)(void *user, uint8_t type) = NULL;         /**< inner callback */
 
 /**
  * @brief  gesture irq
@@ -59,12 +59,36 @@ uint8_t apds9960_gesture_irq_handler(void)
     }
 }
 
+/**
+ * @brief     gesture irq with the interrupt timestamp
+ * @param[in] *user pointer to a user context
+ * @param[in] timestamp interrupt timestamp in ns
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      it has the type of the timestamped gpio handler, user is not used
+ */
+uint8_t apds9960_gesture_irq_handler_timestamp(void *user, uint64_t timestamp)
+{
+    (void)user;
+    
+    if (apds9960_irq_handler_timestamp(&gs_handle, timestamp) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
 /**
  * @brief     gesture callback
+ * @param[in] *user pointer to a user context
  * @param[in] type interrupt type
  * @note      none
  */
-static void a_gesture_callback(uint8_t type)
+static void a_gesture_callback(void *user, uint8_t type)
 {
     switch (type)
     {
@@ -72,27 +96,29 @@ static void a_gesture_callback(uint8_t type)
         {
             uint8_t res;
             uint8_t len;
+            apds9960_bool_t overflow;
             
-            /* read gesture fifo */
-            len = 32;
-            res = apds9960_read_gesture_fifo(&gs_handle, gs_data, (uint8_t *)&len);
+            /* drain gesture fifo */
+            len = 64;
+            res = apds9960_drain_gesture_fifo(&gs_handle, gs_data, (uint8_t *)&len, &overflow);
             if (res != 0)
             {
-                apds9960_interface_debug_print("apds9960: read gesture fifo failed.\n");
+                apds9960_interface_debug_print("apds9960: drain gesture fifo failed.\n");
                 
                 return;
             }
+            if (overflow == APDS9960_BOOL_TRUE)
+            {
+                apds9960_interface_debug_print("apds9960: gesture fifo overflow.\n");
+            }
             
             /* gesture decode */
-            if (len >= 4)
+            res = apds9960_gesture_decode(&gs_handle, gs_data, len);
+            if (res != 0)
             {
-                res = apds9960_gesture_decode(&gs_handle, gs_data, len);
-                if (res != 0)
-                {
-                    apds9960_interface_debug_print("apds9960: gesture decode failed.\n");
-                    
-                    return;
-                }
+                apds9960_interface_debug_print("apds9960: gesture decode failed.\n");
+                
+                return;
             }
             
             break;
@@ -101,7 +127,7 @@ static void a_gesture_callback(uint8_t type)
         {
             if (a_callback != NULL)
             {
-                a_callback(type);
+                a_callback(user, type);
             }
             
             break;
@@ -117,7 +143,7 @@ static void a_gesture_callback(uint8_t type)
  *            - 1 init failed
  * @note      none
  */
-uint8_t apds9960_gesture_init(void (*callback)(uint8_t type))
+uint8_t apds9960_gesture_init(void (*callback)(void *user, uint8_t type))
 {
     uint8_t res;
     uint8_t reg;
@@ -128,7 +154,10 @@ uint8_t apds9960_gesture_init(void (*callback)(uint8_t type))
     DRIVER_APDS9960_LINK_IIC_DEINIT(&gs_handle, apds9960_interface_iic_deinit);
     DRIVER_APDS9960_LINK_IIC_READ(&gs_handle, apds9960_interface_iic_read);
     DRIVER_APDS9960_LINK_IIC_WRITE(&gs_handle, apds9960_interface_iic_write);
+    DRIVER_APDS9960_LINK_IIC_TRANSFER(&gs_handle, apds9960_interface_iic_transfer);
     DRIVER_APDS9960_LINK_DELAY_MS(&gs_handle, apds9960_interface_delay_ms);
+    DRIVER_APDS9960_LINK_TIMESTAMP_NS(&gs_handle, apds9960_interface_timestamp_ns);
+    DRIVER_APDS9960_LINK_DELAY_UNTIL_NS(&gs_handle, apds9960_interface_delay_until_ns);
     DRIVER_APDS9960_LINK_DEBUG_PRINT(&gs_handle, apds9960_interface_debug_print);
     DRIVER_APDS9960_LINK_RECEIVE_CALLBACK(&gs_handle, a_gesture_callback);
     a_callback = callback;
@@ -142,6 +171,26 @@ uint8_t apds9960_gesture_init(void (*callback)(uint8_t type))
         return 1;
     }
     
+    /* enable the register cache */
+    res = apds9960_set_cache(&gs_handle, APDS9960_BOOL_TRUE);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: set cache failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* sync the register cache */
+    res = apds9960_cache_sync(&gs_handle);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: cache sync failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
     /* power on */
     res = apds9960_set_conf(&gs_handle, APDS9960_CONF_POWER_ON, APDS9960_BOOL_TRUE);
     if (res != 0)
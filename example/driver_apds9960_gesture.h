@@ -100,6 +100,17 @@ extern "C"{
  */
 uint8_t apds9960_gesture_irq_handler(void);
 
+/**
+ * @brief     gesture irq with the interrupt timestamp
+ * @param[in] *user pointer to a user context
+ * @param[in] timestamp interrupt timestamp in ns
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      it has the type of the timestamped gpio handler, user is not used
+ */
+uint8_t apds9960_gesture_irq_handler_timestamp(void *user, uint64_t timestamp);
+
 /**
  * @brief     gesture example init
  * @param[in] *callback pointer to a callback function
@@ -108,7 +119,7 @@ uint8_t apds9960_gesture_irq_handler(void);
  *            - 1 init failed
  * @note      none
  */
-uint8_t apds9960_gesture_init(void (*callback)(uint8_t type));
+uint8_t apds9960_gesture_init(void (*callback)(void *user, uint8_t type));
 
 /**
  * @brief  gesture example deinit
@@ -57,6 +57,29 @@ uint8_t apds9960_interrupt_irq_handler(void)
     }
 }
 
+/**
+ * @brief     interrupt irq with the interrupt timestamp
+ * @param[in] *user pointer to a user context
+ * @param[in] timestamp interrupt timestamp in ns
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      it has the type of the timestamped gpio handler, user is not used
+ */
+uint8_t apds9960_interrupt_irq_handler_timestamp(void *user, uint64_t timestamp)
+{
+    (void)user;
+    
+    if (apds9960_irq_handler_timestamp(&gs_handle, timestamp) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
 /**
  * @brief     interrupt example init
  * @param[in] *callback pointer to a callback function
@@ -69,7 +92,7 @@ uint8_t apds9960_interrupt_irq_handler(void)
  *            - 1 init failed
  * @note      none
  */
-uint8_t apds9960_interrupt_init(void (*callback)(uint8_t type), uint16_t als_low_threshold, uint16_t als_high_threshold,
+uint8_t apds9960_interrupt_init(void (*callback)(void *user, uint8_t type), uint16_t als_low_threshold, uint16_t als_high_threshold,
                                 uint8_t proximity_low_threshold, uint8_t proximity_high_threshold)
 {
     uint8_t res;
@@ -81,7 +104,10 @@ uint8_t apds9960_interrupt_init(void (*callback)(uint8_t type), uint16_t als_low
     DRIVER_APDS9960_LINK_IIC_DEINIT(&gs_handle, apds9960_interface_iic_deinit);
     DRIVER_APDS9960_LINK_IIC_READ(&gs_handle, apds9960_interface_iic_read);
     DRIVER_APDS9960_LINK_IIC_WRITE(&gs_handle, apds9960_interface_iic_write);
+    DRIVER_APDS9960_LINK_IIC_TRANSFER(&gs_handle, apds9960_interface_iic_transfer);
     DRIVER_APDS9960_LINK_DELAY_MS(&gs_handle, apds9960_interface_delay_ms);
+    DRIVER_APDS9960_LINK_TIMESTAMP_NS(&gs_handle, apds9960_interface_timestamp_ns);
+    DRIVER_APDS9960_LINK_DELAY_UNTIL_NS(&gs_handle, apds9960_interface_delay_until_ns);
     DRIVER_APDS9960_LINK_DEBUG_PRINT(&gs_handle, apds9960_interface_debug_print);
     DRIVER_APDS9960_LINK_RECEIVE_CALLBACK(&gs_handle, callback);
     
@@ -94,6 +120,26 @@ uint8_t apds9960_interrupt_init(void (*callback)(uint8_t type), uint16_t als_low
         return 1;
     }
     
+    /* enable the register cache */
+    res = apds9960_set_cache(&gs_handle, APDS9960_BOOL_TRUE);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: set cache failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* sync the register cache */
+    res = apds9960_cache_sync(&gs_handle);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: cache sync failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
     /* power on */
     res = apds9960_set_conf(&gs_handle, APDS9960_CONF_POWER_ON, APDS9960_BOOL_TRUE);
     if (res != 0)
@@ -97,6 +97,17 @@ extern "C"{
  */
 uint8_t apds9960_interrupt_irq_handler(void);
 
+/**
+ * @brief     interrupt irq with the interrupt timestamp
+ * @param[in] *user pointer to a user context
+ * @param[in] timestamp interrupt timestamp in ns
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      it has the type of the timestamped gpio handler, user is not used
+ */
+uint8_t apds9960_interrupt_irq_handler_timestamp(void *user, uint64_t timestamp);
+
 /**
  * @brief     interrupt example init
  * @param[in] *callback pointer to a callback function
@@ -109,7 +120,7 @@ uint8_t apds9960_interrupt_irq_handler(void);
  *            - 1 init failed
  * @note      none
  */
-uint8_t apds9960_interrupt_init(void (*callback)(uint8_t type), uint16_t als_low_threshold, uint16_t als_high_threshold,
+uint8_t apds9960_interrupt_init(void (*callback)(void *user, uint8_t type), uint16_t als_low_threshold, uint16_t als_high_threshold,
                                 uint8_t proximity_low_threshold, uint8_t proximity_high_threshold);
 
 /**
@@ -51,25 +51,28 @@ extern "C"{
  */
 
 /**
- * @brief  interface iic bus init
- * @return status code
- *         - 0 success
- *         - 1 iic init failed
- * @note   none
+ * @brief     interface iic bus init
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
  */
-uint8_t apds9960_interface_iic_init(void);
+uint8_t apds9960_interface_iic_init(void *user);
 
 /**
- * @brief  interface iic bus deinit
- * @return status code
- *         - 0 success
- *         - 1 iic deinit failed
- * @note   none
+ * @brief     interface iic bus deinit
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
  */
-uint8_t apds9960_interface_iic_deinit(void);
+uint8_t apds9960_interface_iic_deinit(void *user);
 
 /**
  * @brief      interface iic bus read
+ * @param[in]  *user pointer to a user context
  * @param[in]  addr iic device write address
  * @param[in]  reg iic register address
  * @param[out] *buf pointer to a data buffer
@@ -79,10 +82,11 @@ uint8_t apds9960_interface_iic_deinit(void);
  *             - 1 read failed
  * @note       none
  */
-uint8_t apds9960_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+uint8_t apds9960_interface_iic_read(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
 
 /**
  * @brief     interface iic bus write
+ * @param[in] *user pointer to a user context
  * @param[in] addr iic device write address
  * @param[in] reg iic register address
  * @param[in] *buf pointer to a data buffer
@@ -92,7 +96,59 @@ uint8_t apds9960_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uin
  *            - 1 write failed
  * @note      none
  */
-uint8_t apds9960_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+uint8_t apds9960_interface_iic_write(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     interface iic bus async read submit
+ * @param[in] *user pointer to a user context
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      the buffer is filled when apds9960_interface_iic_poll is not busy
+ */
+uint8_t apds9960_interface_iic_read_submit(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     interface iic bus async write submit
+ * @param[in] *user pointer to a user context
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      the buffer must be kept until apds9960_interface_iic_poll is not busy
+ */
+uint8_t apds9960_interface_iic_write_submit(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     interface iic bus async poll
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ *            - 2 busy
+ * @note      none
+ */
+uint8_t apds9960_interface_iic_poll(void *user);
+
+/**
+ * @brief     interface iic bus batch transfer
+ * @param[in] *user pointer to a user context
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message buffer
+ * @param[in] num number of the messages
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the messages are run in order with one repeated start between them
+ */
+uint8_t apds9960_interface_iic_transfer(void *user, uint8_t addr, apds9960_iic_msg_t *msg, uint8_t num);
 
 /**
  * @brief     interface delay ms
@@ -101,6 +157,27 @@ uint8_t apds9960_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, ui
  */
 void apds9960_interface_delay_ms(uint32_t ms);
 
+/**
+ * @brief  interface timestamp ns
+ * @return monotonic timestamp in ns
+ * @note   none
+ */
+uint64_t apds9960_interface_timestamp_ns(void);
+
+/**
+ * @brief  interface cycle count
+ * @return free running cpu cycle counter
+ * @note   it wraps at 32 bits, return 0 when the board has no cycle counter
+ */
+uint32_t apds9960_interface_cycle_count(void);
+
+/**
+ * @brief     interface delay until an absolute time
+ * @param[in] ns absolute timestamp_ns time
+ * @note      none
+ */
+void apds9960_interface_delay_until_ns(uint64_t ns);
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -110,10 +187,11 @@ void apds9960_interface_debug_print(const char *const fmt, ...);
 
 /**
  * @brief     interface receive callback
+ * @param[in] *user pointer to a user context
  * @param[in] type interrupt type
  * @note      none
  */
-void apds9960_interface_receive_callback(uint8_t type);
+void apds9960_interface_receive_callback(void *user, uint8_t type);
 
 /**
  * @}
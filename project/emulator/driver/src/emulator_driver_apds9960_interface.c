@@ -0,0 +1,474 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      emulator_driver_apds9960_interface.c
+ * @brief     emulator_driver apds9960 interface source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-01-23
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/01/23  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_apds9960_interface.h"
+#include "emulator.h"
+#include "gpio.h"
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief global var definition
+ */
+static uint8_t gs_inited;               /**< emulator is powered */
+static uint64_t gs_skip_ns;             /**< emulated time skipped by the delays and the bus */
+static uint64_t gs_last_ns;             /**< last returned time */
+static uint8_t gs_async_res = 0;        /**< result of the last async transfer */
+
+/**
+ * @brief  get the emulated time
+ * @return time in ns
+ * @note   the cpu time is real and the delays and the bus transfers are skipped,
+ *         so the cpu bound tests keep their real cost and the delays cost nothing
+ */
+static uint64_t a_apds9960_interface_now(void)
+{
+    struct timespec ts;
+    uint64_t ns;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    ns = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec + gs_skip_ns;
+    if (ns < gs_last_ns)
+    {
+        ns = gs_last_ns;
+    }
+    gs_last_ns = ns;
+    
+    return ns;
+}
+
+/**
+ * @brief     skip the emulated time
+ * @param[in] ns time to skip in ns
+ * @note      none
+ */
+static void a_apds9960_interface_skip(uint64_t ns)
+{
+    gs_skip_ns += ns;
+}
+
+/**
+ * @brief  run the emulator up to now
+ * @note   the edges on the way are latched and dispatched by the next delay
+ */
+static void a_apds9960_interface_sync(void)
+{
+    uint64_t now = a_apds9960_interface_now();
+    
+    while (emulator_run(now) != 0)
+    {
+        continue;
+    }
+}
+
+/**
+ * @brief     interface iic bus init
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      the chip is powered once and keeps its registers like the real one
+ */
+uint8_t apds9960_interface_iic_init(void *user)
+{
+    (void)user;
+    
+    if (gs_inited == 0)
+    {
+        if (emulator_init(NULL, a_apds9960_interface_now()) != 0)
+        {
+            return 1;
+        }
+        gs_inited = 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus deinit
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+uint8_t apds9960_interface_iic_deinit(void *user)
+{
+    (void)user;
+    
+    return 0;
+}
+
+/**
+ * @brief      interface iic bus read
+ * @param[in]  *user pointer to a user context
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t apds9960_interface_iic_read(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    (void)user;
+    
+    a_apds9960_interface_sync();
+    res = emulator_read(addr, reg, buf, len);
+    a_apds9960_interface_skip((uint64_t)(len + 3) * EMULATOR_IIC_BYTE_NS);
+    
+    return res;
+}
+
+/**
+ * @brief     interface iic bus write
+ * @param[in] *user pointer to a user context
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t apds9960_interface_iic_write(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    (void)user;
+    
+    a_apds9960_interface_sync();
+    res = emulator_write(addr, reg, buf, len);
+    a_apds9960_interface_skip((uint64_t)(len + 2) * EMULATOR_IIC_BYTE_NS);
+    
+    return res;
+}
+
+/**
+ * @brief     interface iic bus async read submit
+ * @param[in] *user pointer to a user context
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ * @note      the transfer is done at once and its result is returned by apds9960_interface_iic_poll
+ */
+uint8_t apds9960_interface_iic_read_submit(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_async_res = apds9960_interface_iic_read(user, addr, reg, buf, len);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus async write submit
+ * @param[in] *user pointer to a user context
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ * @note      the transfer is done at once and its result is returned by apds9960_interface_iic_poll
+ */
+uint8_t apds9960_interface_iic_write_submit(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_async_res = apds9960_interface_iic_write(user, addr, reg, buf, len);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus async poll
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ *            - 2 busy
+ * @note      it is never busy
+ */
+uint8_t apds9960_interface_iic_poll(void *user)
+{
+    (void)user;
+    
+    return gs_async_res;
+}
+
+/**
+ * @brief     interface iic bus batch transfer
+ * @param[in] *user pointer to a user context
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message buffer
+ * @param[in] num number of the messages
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the messages are joined by repeated starts, so the emulator is not run between them
+ */
+uint8_t apds9960_interface_iic_transfer(void *user, uint8_t addr, apds9960_iic_msg_t *msg, uint8_t num)
+{
+    uint8_t i;
+    uint8_t res;
+    uint64_t bytes;
+    
+    (void)user;
+    
+    a_apds9960_interface_sync();
+    res = 0;
+    bytes = 1;
+    for (i = 0; i < num; i++)
+    {
+        if (msg[i].write != 0)
+        {
+            res |= emulator_write(addr, msg[i].reg, msg[i].buf, msg[i].len);
+        }
+        else
+        {
+            res |= emulator_read(addr, msg[i].reg, msg[i].buf, msg[i].len);
+        }
+        bytes += (uint64_t)msg[i].len + ((msg[i].write != 0) ? 2 : 3);
+    }
+    a_apds9960_interface_skip(bytes * EMULATOR_IIC_BYTE_NS);
+    
+    return (res != 0) ? 1 : 0;
+}
+
+/**
+ * @brief  interface timestamp ns
+ * @return emulated timestamp in ns
+ * @note   none
+ */
+uint64_t apds9960_interface_timestamp_ns(void)
+{
+    return a_apds9960_interface_now();
+}
+
+/**
+ * @brief  interface cycle count
+ * @return free running cpu cycle counter
+ * @note   the host has no portable cycle counter, so it returns 0
+ */
+uint32_t apds9960_interface_cycle_count(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface delay until an absolute time
+ * @param[in] ns absolute timestamp_ns time
+ * @note      the emulator runs to ns and the INT falling edges on the way run the gpio irq handler
+ *            at their own time
+ */
+void apds9960_interface_delay_until_ns(uint64_t ns)
+{
+    uint64_t now;
+    uint64_t edge;
+    
+    /* the edges latched by the bus transfers */
+    (void)gpio_interrupt_poll(a_apds9960_interface_now);
+    while (1)
+    {
+        now = a_apds9960_interface_now();
+        if (now >= ns)
+        {
+            return;
+        }
+        if (emulator_run(ns) == 0)
+        {
+            a_apds9960_interface_skip(ns - now);
+            
+            return;
+        }
+        
+        /* move to the edge and run the irq handler */
+        edge = emulator_get_time();
+        if (edge > now)
+        {
+            a_apds9960_interface_skip(edge - now);
+        }
+        (void)gpio_interrupt_poll(a_apds9960_interface_now);
+    }
+}
+
+/**
+ * @brief     interface delay ms
+ * @param[in] ms time
+ * @note      none
+ */
+void apds9960_interface_delay_ms(uint32_t ms)
+{
+    apds9960_interface_delay_until_ns(a_apds9960_interface_now() + (uint64_t)ms * 1000000ULL);
+}
+
+/**
+ * @brief     interface print format data
+ * @param[in] fmt format data
+ * @note      none
+ */
+void apds9960_interface_debug_print(const char *const fmt, ...)
+{
+    char str[256];
+    uint16_t len;
+    va_list args;
+    
+    memset((char *)str, 0, sizeof(char) * 256); 
+    va_start(args, fmt);
+    vsnprintf((char *)str, 255, (char const *)fmt, args);
+    va_end(args);
+    
+    len = strlen((char *)str);
+    (void)fwrite(str, 1, len, stdout);
+}
+
+/**
+ * @brief     interface receive callback
+ * @param[in] *user pointer to a user context
+ * @param[in] type interrupt type
+ * @note      none
+ */
+void apds9960_interface_receive_callback(void *user, uint8_t type)
+{
+    (void)user;
+    
+    switch (type)
+    {
+        case APDS9960_INTERRUPT_STATUS_GESTURE_LEFT :
+        {
+            apds9960_interface_debug_print("apds9960: irq gesture left.\n");
+            
+            break;
+        }
+        case APDS9960_INTERRUPT_STATUS_GESTURE_RIGHT :
+        {
+            apds9960_interface_debug_print("apds9960: irq gesture right.\n");
+            
+            break;
+        }
+        case APDS9960_INTERRUPT_STATUS_GESTURE_UP :
+        {
+            apds9960_interface_debug_print("apds9960: irq gesture up.\n");
+            
+            break;
+        }
+        case APDS9960_INTERRUPT_STATUS_GESTURE_DOWN :
+        {
+            apds9960_interface_debug_print("apds9960: irq gesture down.\n");
+            
+            break;
+        }
+        case APDS9960_INTERRUPT_STATUS_GESTURE_NEAR :
+        {
+            apds9960_interface_debug_print("apds9960: irq gesture near.\n");
+            
+            break;
+        }
+        case APDS9960_INTERRUPT_STATUS_GESTURE_FAR :
+        {
+            apds9960_interface_debug_print("apds9960: irq gesture far.\n");
+            
+            break;
+        }
+        case APDS9960_INTERRUPT_STATUS_GFOV :
+        {
+            apds9960_interface_debug_print("apds9960: irq gesture fifo overflow.\n");
+            
+            break;
+        }
+        case APDS9960_INTERRUPT_STATUS_GVALID :
+        {
+            apds9960_interface_debug_print("apds9960: irq gesture fifo data.\n");
+            
+            break;
+        }
+        case APDS9960_INTERRUPT_STATUS_CPSAT :
+        {
+            apds9960_interface_debug_print("apds9960: irq clear photo diode saturation.\n");
+            
+            break;
+        }
+        case APDS9960_INTERRUPT_STATUS_PGSAT :
+        {
+            apds9960_interface_debug_print("apds9960: irq analog saturation.\n");
+            
+            break;
+        }
+        case APDS9960_INTERRUPT_STATUS_PINT :
+        {
+            apds9960_interface_debug_print("apds9960: irq proximity interrupt.\n");
+            
+            break;
+        }
+        case APDS9960_INTERRUPT_STATUS_AINT :
+        {
+            apds9960_interface_debug_print("apds9960: irq als interrupt.\n");
+            
+            break;
+        }
+        case APDS9960_INTERRUPT_STATUS_GINT :
+        {
+            apds9960_interface_debug_print("apds9960: irq gesture interrupt.\n");
+            
+            break;
+        }
+        case APDS9960_INTERRUPT_STATUS_PVALID :
+        {
+            apds9960_interface_debug_print("apds9960: irq proximity valid.\n");
+            
+            break;
+        }
+        case APDS9960_INTERRUPT_STATUS_AVALID :
+        {
+            apds9960_interface_debug_print("apds9960: irq als valid.\n");
+            
+            break;
+        }
+        default :
+        {
+            apds9960_interface_debug_print("apds9960: irq unknown.\n");
+            
+            break;
+        }
+    }
+}
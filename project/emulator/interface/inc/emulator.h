@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      emulator.h
+ * @brief     emulator header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-11-11
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef EMULATOR_H
+#define EMULATOR_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup emulator emulator function
+ * @brief    emulator function modules
+ * @{
+ */
+
+/**
+ * @brief emulator iic definition
+ */
+#define EMULATOR_IIC_ADDRESS    0x72         /**< 8-bit iic address of the chip */
+#define EMULATOR_IIC_BYTE_NS    22500        /**< one byte and its ack at 400 kHz */
+
+/**
+ * @brief emulator scene structure definition
+ */
+typedef struct emulator_scene_s
+{
+    uint16_t clear;                 /**< clear counts per 2.78 ms integration step at 1x gain */
+    uint16_t red;                   /**< red counts per 2.78 ms integration step at 1x gain */
+    uint16_t green;                 /**< green counts per 2.78 ms integration step at 1x gain */
+    uint16_t blue;                  /**< blue counts per 2.78 ms integration step at 1x gain */
+    uint8_t background;             /**< proximity and photodiode counts without a hand at 1x gain */
+    uint8_t hand;                   /**< photodiode counts of a hand right above the diode at 1x gain */
+    uint32_t swipe_period_ms;       /**< time from one swipe to the next, 0 for no hand */
+    uint32_t swipe_ms;              /**< time the hand needs to cross the sensor */
+} emulator_scene_t;
+
+/**
+ * @brief     emulator init
+ * @param[in] *scene pointer to a scene structure, NULL for the default scene
+ * @param[in] now_ns time of the power on in ns
+ * @return    status code
+ *            - 0 success
+ * @note      all registers get their power on values, the chip sleeps until PON is set,
+ *            the default scene is an office light and a hand swiping right, left, down and up
+ *            once per second
+ */
+uint8_t emulator_init(const emulator_scene_t *scene, uint64_t now_ns);
+
+/**
+ * @brief     emulator set the scene
+ * @param[in] *scene pointer to a scene structure
+ * @return    status code
+ *            - 0 success
+ * @note      a swipe starts at every multiple of swipe_period_ms and cycles through
+ *            right, left, down and up
+ */
+uint8_t emulator_set_scene(const emulator_scene_t *scene);
+
+/**
+ * @brief     emulator run the state machine
+ * @param[in] until_ns absolute time in ns
+ * @return    status code
+ *            - 0 until_ns is reached
+ *            - 1 the INT pin falls before until_ns, the emulator stops at the edge
+ * @note      nothing is done when until_ns is in the past
+ */
+uint8_t emulator_run(uint64_t until_ns);
+
+/**
+ * @brief  emulator get the time
+ * @return time of the state machine in ns
+ * @note   none
+ */
+uint64_t emulator_get_time(void);
+
+/**
+ * @brief      emulator read the registers
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the register address increments after each byte, the gesture fifo registers
+ *             wrap from 0xFF to 0xFC and one dataset is popped each time 0xFF is read
+ */
+uint8_t emulator_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     emulator write the registers
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the register address increments after each byte, read only registers ignore the data,
+ *            an access to 0xE4 - 0xE7 forces or clears the interrupts
+ */
+uint8_t emulator_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief  emulator get the INT pin level
+ * @return pin level
+ *         - 0 interrupt is asserted
+ *         - 1 interrupt is not asserted
+ * @note   none
+ */
+uint8_t emulator_get_int(void);
+
+/**
+ * @brief      emulator take the latched INT falling edge
+ * @param[out] *timestamp pointer to an edge time buffer
+ * @return     status code
+ *             - 0 no edge
+ *             - 1 an edge is taken
+ * @note       only the first edge is kept until it is taken, like an edge triggered gpio
+ */
+uint8_t emulator_take_edge(uint64_t *timestamp);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,287 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      gpio.h
+ * @brief     gpio header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-11-11
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef GPIO_H
+#define GPIO_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup gpio gpio function
+ * @brief    gpio function modules
+ * @{
+ */
+
+/**
+ * @brief gpio latency definition
+ */
+#define GPIO_LATENCY_BUCKET 20        /**< log2 buckets from 1us to 2^18us */
+
+/**
+ * @brief gpio realtime structure definition
+ */
+typedef struct gpio_realtime_s
+{
+    int priority;        /**< SCHED_FIFO priority from 1 to 99, 0 keeps the default scheduler */
+    int cpu;             /**< cpu the pthread runs on, -1 for any cpu */
+    uint8_t lock;        /**< 1 locks the current and future memory pages */
+} gpio_realtime_t;
+
+/**
+ * @brief gpio latency structure definition
+ */
+typedef struct gpio_latency_s
+{
+    uint32_t count;                             /**< number of the serviced edges */
+    uint64_t sum_ns;                            /**< latency sum in ns */
+    uint64_t max_ns;                            /**< max latency in ns */
+    uint32_t bucket[GPIO_LATENCY_BUCKET];       /**< bucket i counts latencies below 2^i us, the last one counts the rest */
+} gpio_latency_t;
+
+/**
+ * @brief gpio reactor definition
+ */
+#define GPIO_REACTOR_MAX_SOURCE 32        /**< max lines and timers of one reactor */
+
+/**
+ * @brief gpio reactor source type enumeration definition
+ */
+typedef enum
+{
+    GPIO_SOURCE_LINE  = 0x00,        /**< gpio line falling edge */
+    GPIO_SOURCE_TIMER = 0x01,        /**< periodic timer */
+} gpio_source_type_t;
+
+/**
+ * @brief gpio reactor source structure definition
+ */
+typedef struct gpio_source_s
+{
+    uint8_t type;                                      /**< source type */
+    uint32_t line;                                     /**< gpio line offset */
+    uint64_t period_ns;                                /**< timer period in ns */
+    uint64_t next_ns;                                  /**< next timer expiration in ns, 0 before the first poll */
+    uint8_t (*irq)(void *user, uint64_t timestamp);    /**< irq handler of the source */
+    void *user;                                        /**< user context passed to the irq handler */
+} gpio_source_t;
+
+/**
+ * @brief gpio reactor structure definition
+ */
+typedef struct gpio_reactor_s
+{
+    uint8_t running;                                  /**< reactor is started */
+    uint8_t num;                                      /**< number of the sources */
+    gpio_source_t source[GPIO_REACTOR_MAX_SOURCE];    /**< source buffer */
+    gpio_realtime_t realtime;                         /**< realtime options of the reactor */
+    gpio_latency_t latency;                           /**< latency histogram of all line sources */
+} gpio_reactor_t;
+
+/**
+ * @brief  gpio interrupt init
+ * @return status code
+ *         - 0 success
+ * @note   the emulated INT pin has no pthread, its edges are dispatched by gpio_interrupt_poll
+ */
+uint8_t gpio_interrupt_init(void);
+
+/**
+ * @brief  gpio interrupt deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t gpio_interrupt_deinit(void);
+
+/**
+ * @brief     gpio interrupt set the timestamped handler
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ * @note      when it is set it is run instead of g_gpio_irq with the emulated time of the edge in ns,
+ *            set it to NULL to restore g_gpio_irq
+ */
+uint8_t gpio_interrupt_set_handler(uint8_t (*irq)(void *user, uint64_t timestamp), void *user);
+
+/**
+ * @brief     gpio interrupt set the realtime options
+ * @param[in] *rt pointer to a gpio realtime structure
+ * @return    status code
+ *            - 0 success
+ * @note      the options are kept for the command line but have no effect on the emulator
+ */
+uint8_t gpio_interrupt_set_realtime(const gpio_realtime_t *rt);
+
+/**
+ * @brief      gpio interrupt get the latency histogram
+ * @param[out] *latency pointer to a gpio latency structure
+ * @return     status code
+ *             - 0 success
+ * @note       latency is measured from the emulated edge to the return of the irq handler
+ */
+uint8_t gpio_interrupt_get_latency(gpio_latency_t *latency);
+
+/**
+ * @brief  gpio interrupt clear the latency histogram
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t gpio_interrupt_clear_latency(void);
+
+/**
+ * @brief     gpio interrupt dispatch the latched edge
+ * @param[in] *get_time pointer to a function returning the current time in ns
+ * @return    status code
+ *            - 0 no edge
+ *            - 1 an edge is dispatched
+ * @note      it is run by the delay functions of the driver interface, the irq handler runs on the
+ *            caller thread like an interrupt between two instructions, nested calls do nothing,
+ *            when a reactor is started its sources are run instead of the irq handler
+ */
+uint8_t gpio_interrupt_poll(uint64_t (*get_time)(void));
+
+/**
+ * @brief      gpio reactor init
+ * @param[out] *reactor pointer to a gpio reactor structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t gpio_reactor_init(gpio_reactor_t *reactor);
+
+/**
+ * @brief     gpio reactor add a line
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] line gpio line offset
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      every line is wired to the emulated INT pin, irq is run for every falling edge
+ *            with the emulated time of the edge in ns
+ */
+uint8_t gpio_reactor_add_line(gpio_reactor_t *reactor, uint32_t line, uint8_t (*irq)(void *user, uint64_t timestamp), void *user);
+
+/**
+ * @brief     gpio reactor add a periodic timer
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] period_ms timer period in ms
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      the emulator has no timer, an expired timer is run by the next gpio_interrupt_poll
+ */
+uint8_t gpio_reactor_add_timer(gpio_reactor_t *reactor, uint32_t period_ms, uint8_t (*irq)(void *user, uint64_t timestamp), void *user);
+
+/**
+ * @brief     gpio reactor wait and dispatch once
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] timeout_ms wait timeout in ms, -1 waits forever
+ * @return    status code
+ *            - 0 success
+ * @note      the emulated time only moves in the delay functions of the driver interface, which
+ *            dispatch the sources of the started reactor, so there is nothing to wait for
+ */
+uint8_t gpio_reactor_poll(gpio_reactor_t *reactor, int timeout_ms);
+
+/**
+ * @brief     gpio reactor start the dispatch
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the emulator has one INT pin, so only one reactor can be started at a time and it
+ *            takes the edges from gpio_interrupt_init
+ */
+uint8_t gpio_reactor_start(gpio_reactor_t *reactor);
+
+/**
+ * @brief     gpio reactor set the realtime options
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] *rt pointer to a gpio realtime structure
+ * @return    status code
+ *            - 0 success
+ * @note      the options are kept for the command line but have no effect on the emulator
+ */
+uint8_t gpio_reactor_set_realtime(gpio_reactor_t *reactor, const gpio_realtime_t *rt);
+
+/**
+ * @brief      gpio reactor get the latency histogram
+ * @param[in]  *reactor pointer to a gpio reactor structure
+ * @param[out] *latency pointer to a gpio latency structure
+ * @return     status code
+ *             - 0 success
+ * @note       latency is measured from the emulated edge to the return of the irq handler
+ */
+uint8_t gpio_reactor_get_latency(gpio_reactor_t *reactor, gpio_latency_t *latency);
+
+/**
+ * @brief     gpio reactor clear the latency histogram
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t gpio_reactor_clear_latency(gpio_reactor_t *reactor);
+
+/**
+ * @brief     gpio reactor deinit
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @return    status code
+ *            - 0 success
+ * @note      the dispatch is stopped and all the lines and timers are removed
+ */
+uint8_t gpio_reactor_deinit(gpio_reactor_t *reactor);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,999 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      emulator.c
+ * @brief     emulator source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-11-11
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "emulator.h"
+#include <string.h>
+
+/**
+ * @brief chip register definition
+ */
+#define EMULATOR_REG_ENABLE         0x80        /**< enable states and interrupts register */
+#define EMULATOR_REG_ATIME          0x81        /**< adc integration time register */
+#define EMULATOR_REG_WTIME          0x83        /**< wait time register */
+#define EMULATOR_REG_AILTL          0x84        /**< als interrupt low threshold low byte register */
+#define EMULATOR_REG_AIHTL          0x86        /**< als interrupt high threshold low byte register */
+#define EMULATOR_REG_PILT           0x89        /**< proximity interrupt low threshold register */
+#define EMULATOR_REG_PIHT           0x8B        /**< proximity interrupt high threshold register */
+#define EMULATOR_REG_PERS           0x8C        /**< interrupt persistence filters register */
+#define EMULATOR_REG_CONFIG1        0x8D        /**< configuration register one register */
+#define EMULATOR_REG_PPULSE         0x8E        /**< proximity pulse count and length register */
+#define EMULATOR_REG_CONTROL        0x8F        /**< gain control register */
+#define EMULATOR_REG_CONFIG2        0x90        /**< configuration register two register */
+#define EMULATOR_REG_ID             0x92        /**< device id register */
+#define EMULATOR_REG_STATUS         0x93        /**< device status register */
+#define EMULATOR_REG_CDATAL         0x94        /**< low byte of clear channel data register */
+#define EMULATOR_REG_BDATAH         0x9B        /**< high byte of blue channel data register */
+#define EMULATOR_REG_PDATA          0x9C        /**< proximity data register */
+#define EMULATOR_REG_GPENTH         0xA0        /**< gesture proximity enter threshold register */
+#define EMULATOR_REG_GEXTH          0xA1        /**< gesture exit threshold register */
+#define EMULATOR_REG_GCONF1         0xA2        /**< gesture configuration one register */
+#define EMULATOR_REG_GCONF2         0xA3        /**< gesture configuration two register */
+#define EMULATOR_REG_GPULSE         0xA6        /**< gesture pulse count and length register */
+#define EMULATOR_REG_GCONF4         0xAB        /**< gesture configuration four register */
+#define EMULATOR_REG_GFLVL          0xAE        /**< gesture fifo level register */
+#define EMULATOR_REG_GSTATUS        0xAF        /**< gesture status register */
+#define EMULATOR_REG_IFORCE         0xE4        /**< force interrupt register */
+#define EMULATOR_REG_PICLEAR        0xE5        /**< proximity interrupt clear register */
+#define EMULATOR_REG_CICLEAR        0xE6        /**< als clear channel interrupt clear register */
+#define EMULATOR_REG_AICLEAR        0xE7        /**< all non-gesture interrupts clear register */
+#define EMULATOR_REG_GFIFO_U        0xFC        /**< gesture fifo UP value register */
+#define EMULATOR_REG_GFIFO_R        0xFF        /**< gesture fifo RIGHT value register */
+
+/**
+ * @brief chip register bit definition
+ */
+#define EMULATOR_ENABLE_PON         (1 << 0)        /**< power on */
+#define EMULATOR_ENABLE_AEN         (1 << 1)        /**< als enable */
+#define EMULATOR_ENABLE_PEN         (1 << 2)        /**< proximity enable */
+#define EMULATOR_ENABLE_WEN         (1 << 3)        /**< wait enable */
+#define EMULATOR_ENABLE_AIEN        (1 << 4)        /**< als interrupt enable */
+#define EMULATOR_ENABLE_PIEN        (1 << 5)        /**< proximity interrupt enable */
+#define EMULATOR_ENABLE_GEN         (1 << 6)        /**< gesture enable */
+#define EMULATOR_STATUS_AVALID      (1 << 0)        /**< als valid */
+#define EMULATOR_STATUS_PVALID      (1 << 1)        /**< proximity valid */
+#define EMULATOR_STATUS_GINT        (1 << 2)        /**< gesture interrupt */
+#define EMULATOR_STATUS_AINT        (1 << 4)        /**< als interrupt */
+#define EMULATOR_STATUS_PINT        (1 << 5)        /**< proximity interrupt */
+#define EMULATOR_STATUS_PGSAT       (1 << 6)        /**< proximity analog saturation */
+#define EMULATOR_STATUS_CPSAT       (1 << 7)        /**< clear photodiode saturation */
+#define EMULATOR_GSTATUS_GVALID     (1 << 0)        /**< gesture fifo data is valid */
+#define EMULATOR_GSTATUS_GFOV       (1 << 1)        /**< gesture fifo overflow */
+#define EMULATOR_GCONF4_GMODE       (1 << 0)        /**< gesture mode */
+#define EMULATOR_GCONF4_GIEN        (1 << 1)        /**< gesture interrupt enable */
+#define EMULATOR_GCONF4_GFIFO_CLR   (1 << 2)        /**< gesture fifo clear */
+
+/**
+ * @brief state machine timing definition
+ */
+#define EMULATOR_STEP_NS            2780000ULL      /**< als integration and wait step */
+#define EMULATOR_PULSE_SETUP_NS     700000ULL       /**< proximity or gesture state overhead */
+#define EMULATOR_NEVER              UINT64_MAX      /**< no deadline */
+
+/**
+ * @brief emulator fifo definition
+ */
+#define EMULATOR_FIFO_DEPTH         32              /**< 32 datasets of the gesture fifo */
+
+/**
+ * @brief emulator state enumeration definition
+ */
+typedef enum
+{
+    EMULATOR_STATE_SLEEP     = 0x00,        /**< PON is 0 */
+    EMULATOR_STATE_IDLE      = 0x01,        /**< no engine is enabled */
+    EMULATOR_STATE_PROXIMITY = 0x02,        /**< proximity pulses */
+    EMULATOR_STATE_GESTURE   = 0x03,        /**< one gesture pass */
+    EMULATOR_STATE_WAIT      = 0x04,        /**< wait time */
+    EMULATOR_STATE_ALS       = 0x05,        /**< als integration */
+} emulator_state_t;
+
+/**
+ * @brief emulator structure definition
+ */
+typedef struct emulator_s
+{
+    uint8_t reg[256];                                   /**< register file */
+    uint8_t fifo[EMULATOR_FIFO_DEPTH][4];               /**< gesture fifo */
+    uint8_t fifo_head;                                  /**< index of the oldest dataset */
+    uint8_t fifo_level;                                 /**< datasets in the fifo */
+    uint8_t state;                                      /**< state machine state */
+    uint64_t now;                                       /**< state machine time in ns */
+    uint64_t deadline;                                  /**< end of the current state in ns */
+    uint8_t als_count;                                  /**< als cycles out of the thresholds */
+    uint8_t proximity_count;                            /**< proximity cycles out of the thresholds */
+    uint8_t exit_count;                                 /**< gesture passes below the exit threshold */
+    uint8_t pin;                                        /**< INT pin level */
+    uint8_t edge;                                       /**< a falling edge is latched */
+    uint64_t edge_ns;                                   /**< time of the latched edge */
+    uint64_t origin_ns;                                 /**< time of the power on */
+    emulator_scene_t scene;                             /**< scene in front of the sensor */
+} emulator_t;
+
+/**
+ * @brief emulator var definition
+ */
+static emulator_t gs_emulator;                          /**< emulated chip */
+
+/**
+ * @brief default scene definition
+ */
+static const emulator_scene_t gs_scene_default =
+{
+    40, 14, 16, 10,        /* office light */
+    2, 60,                 /* background and hand */
+    1000, 300,             /* one 300 ms swipe per second */
+};
+
+/**
+ * @brief     get the photodiode counts of the scene
+ * @param[in] t time in ns
+ * @param[out] *channel pointer to an up, down, left and right count buffer
+ * @return    proximity count
+ * @note      the photodiodes sit at up (0, 1), down (0, -1), left (-1, 0) and right (1, 0),
+ *            the hand crosses from (0, 2.5) to (0, -2.5) for a right swipe
+ */
+static float a_emulator_scene(uint64_t t, float *channel)
+{
+    const float x[4] = {0.0f, 0.0f, -1.0f, 1.0f};
+    const float y[4] = {1.0f, -1.0f, 0.0f, 0.0f};
+    const float path[4][4] =
+    {
+        { 0.0f,  2.5f,  0.0f, -2.5f},        /* right */
+        { 0.0f, -2.5f,  0.0f,  2.5f},        /* left */
+        { 2.5f,  0.0f, -2.5f,  0.0f},        /* down */
+        {-2.5f,  0.0f,  2.5f,  0.0f},        /* up */
+    };
+    const emulator_scene_t *scene = &gs_emulator.scene;
+    uint64_t ms;
+    uint64_t index;
+    float p, px, py, dx, dy;
+    uint8_t k;
+    
+    for (k = 0; k < 4; k++)
+    {
+        channel[k] = (float)scene->background;
+    }
+    if ((scene->swipe_period_ms == 0) || (scene->swipe_ms == 0) || (t < gs_emulator.origin_ns))
+    {
+        return (float)scene->background;
+    }
+    ms = (t - gs_emulator.origin_ns) / 1000000ULL;
+    index = ms / scene->swipe_period_ms;
+    ms = ms % scene->swipe_period_ms;
+    if (ms >= scene->swipe_ms)
+    {
+        return (float)scene->background;
+    }
+    
+    /* hand position */
+    p = (float)ms / (float)scene->swipe_ms;
+    px = path[index % 4][0] + (path[index % 4][2] - path[index % 4][0]) * p;
+    py = path[index % 4][1] + (path[index % 4][3] - path[index % 4][1]) * p;
+    for (k = 0; k < 4; k++)
+    {
+        dx = px - x[k];
+        dy = py - y[k];
+        channel[k] += (float)scene->hand / (1.0f + (dx * dx + dy * dy) * 1.5f);
+    }
+    
+    return (float)scene->background + (float)scene->hand / (1.0f + (px * px + py * py) * 1.5f);
+}
+
+/**
+ * @brief     check whether a register can be written
+ * @param[in] reg register address
+ * @return    status code
+ *            - 0 read only or reserved
+ *            - 1 writable
+ * @note      none
+ */
+static uint8_t a_emulator_writable(uint8_t reg)
+{
+    switch (reg)
+    {
+        case 0x80 : case 0x81 : case 0x83 : case 0x84 : case 0x85 : case 0x86 : case 0x87 :
+        case 0x89 : case 0x8B : case 0x8C : case 0x8D : case 0x8E : case 0x8F : case 0x90 :
+        case 0x9D : case 0x9E : case 0x9F : case 0xA0 : case 0xA1 : case 0xA2 : case 0xA3 :
+        case 0xA4 : case 0xA5 : case 0xA6 : case 0xA7 : case 0xA9 : case 0xAA : case 0xAB :
+        {
+            return 1;
+        }
+        default :
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief  update the INT pin
+ * @return status code
+ *         - 0 no falling edge
+ *         - 1 the pin falls
+ * @note   the INT pin is open drain and active low
+ */
+static uint8_t a_emulator_pin_update(void)
+{
+    uint8_t *reg = gs_emulator.reg;
+    uint8_t status = reg[EMULATOR_REG_STATUS];
+    uint8_t active;
+    uint8_t prev;
+    
+    active = 0;
+    if ((reg[EMULATOR_REG_ENABLE] & EMULATOR_ENABLE_PON) != 0)
+    {
+        active = (uint8_t)((((status & EMULATOR_STATUS_AINT) != 0) && ((reg[EMULATOR_REG_ENABLE] & EMULATOR_ENABLE_AIEN) != 0)) ||
+                           (((status & EMULATOR_STATUS_PINT) != 0) && ((reg[EMULATOR_REG_ENABLE] & EMULATOR_ENABLE_PIEN) != 0)) ||
+                           (((status & EMULATOR_STATUS_GINT) != 0) && ((reg[EMULATOR_REG_GCONF4] & EMULATOR_GCONF4_GIEN) != 0)) ||
+                           (((status & EMULATOR_STATUS_CPSAT) != 0) && ((reg[EMULATOR_REG_CONFIG2] & (1 << 6)) != 0)) ||
+                           (((status & EMULATOR_STATUS_PGSAT) != 0) && ((reg[EMULATOR_REG_CONFIG2] & (1 << 7)) != 0)));
+    }
+    prev = gs_emulator.pin;
+    gs_emulator.pin = (active != 0) ? 0 : 1;
+    if ((prev == 1) && (gs_emulator.pin == 0))
+    {
+        if (gs_emulator.edge == 0)
+        {
+            gs_emulator.edge = 1;
+            gs_emulator.edge_ns = gs_emulator.now;
+        }
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     enter a state
+ * @param[in] state next state
+ * @note      none
+ */
+static void a_emulator_enter(uint8_t state)
+{
+    uint8_t *reg = gs_emulator.reg;
+    const uint16_t gwtime[8] = {0, 2800, 5600, 8400, 14000, 22400, 30800, 39200};
+    uint64_t ns;
+    
+    switch (state)
+    {
+        case EMULATOR_STATE_PROXIMITY :
+        {
+            ns = EMULATOR_PULSE_SETUP_NS +
+                 (uint64_t)((reg[EMULATOR_REG_PPULSE] & 0x3F) + 1) * (8U << ((reg[EMULATOR_REG_PPULSE] >> 6) & 0x3)) * 1000ULL;
+            
+            break;
+        }
+        case EMULATOR_STATE_GESTURE :
+        {
+            ns = EMULATOR_PULSE_SETUP_NS +
+                 (uint64_t)((reg[EMULATOR_REG_GPULSE] & 0x3F) + 1) * (8U << ((reg[EMULATOR_REG_GPULSE] >> 6) & 0x3)) * 1000ULL +
+                 (uint64_t)gwtime[reg[EMULATOR_REG_GCONF2] & 0x07] * 1000ULL;
+            
+            break;
+        }
+        case EMULATOR_STATE_WAIT :
+        {
+            ns = (uint64_t)(256 - reg[EMULATOR_REG_WTIME]) * EMULATOR_STEP_NS;
+            if ((reg[EMULATOR_REG_CONFIG1] & (1 << 1)) != 0)
+            {
+                ns *= 12;
+            }
+            
+            break;
+        }
+        case EMULATOR_STATE_ALS :
+        {
+            ns = (uint64_t)(256 - reg[EMULATOR_REG_ATIME]) * EMULATOR_STEP_NS;
+            
+            break;
+        }
+        default :
+        {
+            gs_emulator.state = state;
+            gs_emulator.deadline = EMULATOR_NEVER;
+            
+            return;
+        }
+    }
+    gs_emulator.state = state;
+    gs_emulator.deadline = gs_emulator.now + ns;
+}
+
+/**
+ * @brief start a new cycle of the state machine
+ * @note  proximity, gesture, wait and als run in this order
+ */
+static void a_emulator_start(void)
+{
+    uint8_t enable = gs_emulator.reg[EMULATOR_REG_ENABLE];
+    
+    if ((enable & EMULATOR_ENABLE_PON) == 0)
+    {
+        a_emulator_enter(EMULATOR_STATE_SLEEP);
+    }
+    else if ((enable & (EMULATOR_ENABLE_PEN | EMULATOR_ENABLE_GEN)) != 0)
+    {
+        a_emulator_enter(EMULATOR_STATE_PROXIMITY);
+    }
+    else if ((enable & EMULATOR_ENABLE_WEN) != 0)
+    {
+        a_emulator_enter(EMULATOR_STATE_WAIT);
+    }
+    else if ((enable & EMULATOR_ENABLE_AEN) != 0)
+    {
+        a_emulator_enter(EMULATOR_STATE_ALS);
+    }
+    else
+    {
+        a_emulator_enter(EMULATOR_STATE_IDLE);
+    }
+}
+
+/**
+ * @brief go to the wait or als state after the proximity and gesture states
+ * @note  none
+ */
+static void a_emulator_after_gesture(void)
+{
+    uint8_t enable = gs_emulator.reg[EMULATOR_REG_ENABLE];
+    
+    if ((enable & EMULATOR_ENABLE_WEN) != 0)
+    {
+        a_emulator_enter(EMULATOR_STATE_WAIT);
+    }
+    else if ((enable & EMULATOR_ENABLE_AEN) != 0)
+    {
+        a_emulator_enter(EMULATOR_STATE_ALS);
+    }
+    else
+    {
+        a_emulator_start();
+    }
+}
+
+/**
+ * @brief     check a value against the thresholds with persistence
+ * @param[in] out value is out of the thresholds
+ * @param[in] *count pointer to a persistence counter
+ * @param[in] persistence cycles needed, 0 for every cycle
+ * @return    status code
+ *            - 0 no interrupt
+ *            - 1 interrupt
+ * @note      none
+ */
+static uint8_t a_emulator_persistence(uint8_t out, uint8_t *count, uint8_t persistence)
+{
+    if (persistence == 0)
+    {
+        return 1;
+    }
+    if (out == 0)
+    {
+        *count = 0;
+        
+        return 0;
+    }
+    if (*count < 0xFF)
+    {
+        (*count)++;
+    }
+    
+    return (*count >= persistence) ? 1 : 0;
+}
+
+/**
+ * @brief end the proximity state
+ * @note  none
+ */
+static void a_emulator_proximity_end(void)
+{
+    uint8_t *reg = gs_emulator.reg;
+    float channel[4];
+    float p;
+    uint8_t pdata;
+    
+    p = a_emulator_scene(gs_emulator.now, channel) * (float)(1 << ((reg[EMULATOR_REG_CONTROL] >> 2) & 0x3));
+    pdata = (p >= 255.0f) ? 255 : (uint8_t)p;
+    if ((reg[EMULATOR_REG_ENABLE] & EMULATOR_ENABLE_PEN) != 0)
+    {
+        reg[EMULATOR_REG_PDATA] = pdata;
+        reg[EMULATOR_REG_STATUS] |= EMULATOR_STATUS_PVALID;
+        if (p > 255.0f)
+        {
+            reg[EMULATOR_REG_STATUS] |= EMULATOR_STATUS_PGSAT;
+        }
+        if (a_emulator_persistence((uint8_t)((pdata < reg[EMULATOR_REG_PILT]) || (pdata > reg[EMULATOR_REG_PIHT])),
+                                   &gs_emulator.proximity_count, (reg[EMULATOR_REG_PERS] >> 4) & 0xF) != 0)
+        {
+            reg[EMULATOR_REG_STATUS] |= EMULATOR_STATUS_PINT;
+        }
+    }
+    if (((reg[EMULATOR_REG_ENABLE] & EMULATOR_ENABLE_GEN) != 0) &&
+        ((pdata >= reg[EMULATOR_REG_GPENTH]) || ((reg[EMULATOR_REG_GCONF4] & EMULATOR_GCONF4_GMODE) != 0)))
+    {
+        reg[EMULATOR_REG_GCONF4] |= EMULATOR_GCONF4_GMODE;
+        gs_emulator.exit_count = 0;
+        a_emulator_enter(EMULATOR_STATE_GESTURE);
+        
+        return;
+    }
+    a_emulator_after_gesture();
+}
+
+/**
+ * @brief end one gesture pass
+ * @note  none
+ */
+static void a_emulator_gesture_end(void)
+{
+    uint8_t *reg = gs_emulator.reg;
+    const uint8_t gfifoth[4] = {1, 4, 8, 16};
+    const uint8_t gexpers[4] = {1, 2, 4, 7};
+    float channel[4];
+    float gain;
+    uint8_t data[4];
+    uint8_t below;
+    uint8_t k;
+    
+    if (((reg[EMULATOR_REG_ENABLE] & EMULATOR_ENABLE_GEN) == 0) ||
+        ((reg[EMULATOR_REG_GCONF4] & EMULATOR_GCONF4_GMODE) == 0))
+    {
+        reg[EMULATOR_REG_GCONF4] &= ~EMULATOR_GCONF4_GMODE;
+        a_emulator_after_gesture();
+        
+        return;
+    }
+    
+    /* one dataset */
+    (void)a_emulator_scene(gs_emulator.now, channel);
+    gain = (float)(1 << ((reg[EMULATOR_REG_GCONF2] >> 5) & 0x3));
+    below = 1;
+    for (k = 0; k < 4; k++)
+    {
+        channel[k] *= gain;
+        data[k] = (channel[k] >= 255.0f) ? 255 : (uint8_t)channel[k];
+        if (((reg[EMULATOR_REG_GCONF1] >> (5 - k)) & 0x01) == 0)
+        {
+            if (data[k] >= reg[EMULATOR_REG_GEXTH])
+            {
+                below = 0;
+            }
+        }
+    }
+    if (gs_emulator.fifo_level >= EMULATOR_FIFO_DEPTH)
+    {
+        reg[EMULATOR_REG_GSTATUS] |= EMULATOR_GSTATUS_GFOV;
+    }
+    else
+    {
+        memcpy(gs_emulator.fifo[(gs_emulator.fifo_head + gs_emulator.fifo_level) % EMULATOR_FIFO_DEPTH], data, 4);
+        gs_emulator.fifo_level++;
+    }
+    if (gs_emulator.fifo_level >= gfifoth[(reg[EMULATOR_REG_GCONF1] >> 6) & 0x3])
+    {
+        reg[EMULATOR_REG_GSTATUS] |= EMULATOR_GSTATUS_GVALID;
+        reg[EMULATOR_REG_STATUS] |= EMULATOR_STATUS_GINT;
+    }
+    
+    /* exit */
+    gs_emulator.exit_count = (below != 0) ? (uint8_t)(gs_emulator.exit_count + 1) : 0;
+    if (gs_emulator.exit_count >= gexpers[reg[EMULATOR_REG_GCONF1] & 0x3])
+    {
+        reg[EMULATOR_REG_GCONF4] &= ~EMULATOR_GCONF4_GMODE;
+        if (gs_emulator.fifo_level != 0)
+        {
+            reg[EMULATOR_REG_GSTATUS] |= EMULATOR_GSTATUS_GVALID;
+            reg[EMULATOR_REG_STATUS] |= EMULATOR_STATUS_GINT;
+        }
+        a_emulator_after_gesture();
+        
+        return;
+    }
+    a_emulator_enter(EMULATOR_STATE_GESTURE);
+}
+
+/**
+ * @brief end the als state
+ * @note  none
+ */
+static void a_emulator_als_end(void)
+{
+    uint8_t *reg = gs_emulator.reg;
+    const uint8_t gain[4] = {1, 4, 16, 64};
+    const uint16_t *level[4];
+    uint32_t steps;
+    uint32_t max;
+    uint32_t count;
+    uint16_t threshold_low;
+    uint16_t threshold_high;
+    uint8_t persistence;
+    uint8_t k;
+    
+    if ((reg[EMULATOR_REG_ENABLE] & EMULATOR_ENABLE_AEN) == 0)
+    {
+        a_emulator_start();
+        
+        return;
+    }
+    level[0] = &gs_emulator.scene.clear;
+    level[1] = &gs_emulator.scene.red;
+    level[2] = &gs_emulator.scene.green;
+    level[3] = &gs_emulator.scene.blue;
+    steps = 256 - (uint32_t)reg[EMULATOR_REG_ATIME];
+    max = (1025 * steps > 65535) ? 65535 : 1025 * steps;
+    for (k = 0; k < 4; k++)
+    {
+        count = (uint32_t)(*level[k]) * steps * gain[reg[EMULATOR_REG_CONTROL] & 0x3];
+        count = (count > max) ? max : count;
+        reg[EMULATOR_REG_CDATAL + k * 2] = (uint8_t)(count & 0xFF);
+        reg[EMULATOR_REG_CDATAL + k * 2 + 1] = (uint8_t)((count >> 8) & 0xFF);
+        if ((k == 0) && (count >= max))
+        {
+            reg[EMULATOR_REG_STATUS] |= EMULATOR_STATUS_CPSAT;
+        }
+    }
+    reg[EMULATOR_REG_STATUS] |= EMULATOR_STATUS_AVALID;
+    count = (uint32_t)reg[EMULATOR_REG_CDATAL] | ((uint32_t)reg[EMULATOR_REG_CDATAL + 1] << 8);
+    threshold_low = (uint16_t)(reg[EMULATOR_REG_AILTL] | (reg[EMULATOR_REG_AILTL + 1] << 8));
+    threshold_high = (uint16_t)(reg[EMULATOR_REG_AIHTL] | (reg[EMULATOR_REG_AIHTL + 1] << 8));
+    persistence = reg[EMULATOR_REG_PERS] & 0xF;
+    persistence = (persistence <= 3) ? persistence : (uint8_t)((persistence - 3) * 5);
+    if (a_emulator_persistence((uint8_t)((count < threshold_low) || (count > threshold_high)),
+                               &gs_emulator.als_count, persistence) != 0)
+    {
+        reg[EMULATOR_REG_STATUS] |= EMULATOR_STATUS_AINT;
+    }
+    a_emulator_start();
+}
+
+/**
+ * @brief end the current state
+ * @note  none
+ */
+static void a_emulator_state_end(void)
+{
+    switch (gs_emulator.state)
+    {
+        case EMULATOR_STATE_PROXIMITY :
+        {
+            a_emulator_proximity_end();
+            
+            break;
+        }
+        case EMULATOR_STATE_GESTURE :
+        {
+            a_emulator_gesture_end();
+            
+            break;
+        }
+        case EMULATOR_STATE_WAIT :
+        {
+            if ((gs_emulator.reg[EMULATOR_REG_ENABLE] & EMULATOR_ENABLE_AEN) != 0)
+            {
+                a_emulator_enter(EMULATOR_STATE_ALS);
+            }
+            else
+            {
+                a_emulator_start();
+            }
+            
+            break;
+        }
+        case EMULATOR_STATE_ALS :
+        {
+            a_emulator_als_end();
+            
+            break;
+        }
+        default :
+        {
+            gs_emulator.deadline = EMULATOR_NEVER;
+            
+            break;
+        }
+    }
+}
+
+/**
+ * @brief     run the side effect of accessing a special function register
+ * @param[in] reg register address
+ * @note      none
+ */
+static void a_emulator_special(uint8_t reg)
+{
+    uint8_t *status = &gs_emulator.reg[EMULATOR_REG_STATUS];
+    
+    switch (reg)
+    {
+        case EMULATOR_REG_IFORCE :
+        {
+            *status |= EMULATOR_STATUS_AINT | EMULATOR_STATUS_PINT;
+            
+            break;
+        }
+        case EMULATOR_REG_PICLEAR :
+        {
+            *status &= ~(EMULATOR_STATUS_PINT | EMULATOR_STATUS_PGSAT);
+            gs_emulator.proximity_count = 0;
+            
+            break;
+        }
+        case EMULATOR_REG_CICLEAR :
+        {
+            *status &= ~(EMULATOR_STATUS_AINT | EMULATOR_STATUS_CPSAT);
+            gs_emulator.als_count = 0;
+            
+            break;
+        }
+        case EMULATOR_REG_AICLEAR :
+        {
+            *status &= ~(EMULATOR_STATUS_AINT | EMULATOR_STATUS_PINT | EMULATOR_STATUS_PGSAT | EMULATOR_STATUS_CPSAT);
+            gs_emulator.als_count = 0;
+            gs_emulator.proximity_count = 0;
+            
+            break;
+        }
+        default :
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief     read one register
+ * @param[in] reg register address
+ * @return    register value
+ * @note      none
+ */
+static uint8_t a_emulator_read_byte(uint8_t reg)
+{
+    uint8_t value;
+    
+    if ((reg >= EMULATOR_REG_IFORCE) && (reg <= EMULATOR_REG_AICLEAR))
+    {
+        a_emulator_special(reg);
+        
+        return 0;
+    }
+    if (reg == EMULATOR_REG_GFLVL)
+    {
+        return gs_emulator.fifo_level;
+    }
+    if (reg < EMULATOR_REG_GFIFO_U)
+    {
+        return gs_emulator.reg[reg];
+    }
+    if (gs_emulator.fifo_level == 0)
+    {
+        return 0;
+    }
+    value = gs_emulator.fifo[gs_emulator.fifo_head][reg - EMULATOR_REG_GFIFO_U];
+    if (reg == EMULATOR_REG_GFIFO_R)
+    {
+        gs_emulator.fifo_head = (uint8_t)((gs_emulator.fifo_head + 1) % EMULATOR_FIFO_DEPTH);
+        gs_emulator.fifo_level--;
+        if (gs_emulator.fifo_level == 0)
+        {
+            gs_emulator.reg[EMULATOR_REG_GSTATUS] &= ~EMULATOR_GSTATUS_GVALID;
+            gs_emulator.reg[EMULATOR_REG_STATUS] &= ~EMULATOR_STATUS_GINT;
+        }
+    }
+    
+    return value;
+}
+
+/**
+ * @brief     write one register
+ * @param[in] reg register address
+ * @param[in] value register value
+ * @note      none
+ */
+static void a_emulator_write_byte(uint8_t reg, uint8_t value)
+{
+    uint8_t *r = gs_emulator.reg;
+    uint8_t prev;
+    
+    if ((reg >= EMULATOR_REG_IFORCE) && (reg <= EMULATOR_REG_AICLEAR))
+    {
+        a_emulator_special(reg);
+        
+        return;
+    }
+    if (a_emulator_writable(reg) == 0)
+    {
+        return;
+    }
+    prev = r[reg];
+    if (reg == EMULATOR_REG_GCONF4)
+    {
+        if ((value & EMULATOR_GCONF4_GFIFO_CLR) != 0)
+        {
+            gs_emulator.fifo_head = 0;
+            gs_emulator.fifo_level = 0;
+            r[EMULATOR_REG_GSTATUS] = 0;
+            r[EMULATOR_REG_STATUS] &= ~EMULATOR_STATUS_GINT;
+        }
+        r[reg] = value & (EMULATOR_GCONF4_GMODE | EMULATOR_GCONF4_GIEN);
+        
+        return;
+    }
+    if (reg != EMULATOR_REG_ENABLE)
+    {
+        r[reg] = value;
+        
+        return;
+    }
+    
+    r[reg] = value & 0x7F;
+    if ((value & EMULATOR_ENABLE_AEN) == 0)
+    {
+        r[EMULATOR_REG_STATUS] &= ~EMULATOR_STATUS_AVALID;
+        gs_emulator.als_count = 0;
+    }
+    if ((value & EMULATOR_ENABLE_PEN) == 0)
+    {
+        r[EMULATOR_REG_STATUS] &= ~EMULATOR_STATUS_PVALID;
+        gs_emulator.proximity_count = 0;
+    }
+    if ((value & EMULATOR_ENABLE_GEN) == 0)
+    {
+        r[EMULATOR_REG_GCONF4] &= ~EMULATOR_GCONF4_GMODE;
+    }
+    if ((value & EMULATOR_ENABLE_PON) == 0)
+    {
+        a_emulator_enter(EMULATOR_STATE_SLEEP);
+    }
+    else if (((prev & EMULATOR_ENABLE_PON) == 0) || (gs_emulator.state == EMULATOR_STATE_IDLE))
+    {
+        a_emulator_start();
+    }
+    else
+    {
+        /* do nothing */
+    }
+}
+
+/**
+ * @brief     get the next register address of a burst
+ * @param[in] reg register address
+ * @return    next register address
+ * @note      the gesture fifo registers wrap from 0xFF to 0xFC
+ */
+static uint8_t a_emulator_next_reg(uint8_t reg)
+{
+    if (reg == EMULATOR_REG_GFIFO_R)
+    {
+        return EMULATOR_REG_GFIFO_U;
+    }
+    
+    return (uint8_t)(reg + 1);
+}
+
+/**
+ * @brief     emulator init
+ * @param[in] *scene pointer to a scene structure, NULL for the default scene
+ * @param[in] now_ns time of the power on in ns
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t emulator_init(const emulator_scene_t *scene, uint64_t now_ns)
+{
+    memset(&gs_emulator, 0, sizeof(emulator_t));
+    gs_emulator.reg[EMULATOR_REG_ATIME] = 0xFF;
+    gs_emulator.reg[EMULATOR_REG_WTIME] = 0xFF;
+    gs_emulator.reg[EMULATOR_REG_CONFIG1] = 0x40;
+    gs_emulator.reg[EMULATOR_REG_PPULSE] = 0x40;
+    gs_emulator.reg[EMULATOR_REG_CONFIG2] = 0x01;
+    gs_emulator.reg[EMULATOR_REG_ID] = 0xAB;
+    gs_emulator.reg[EMULATOR_REG_GPULSE] = 0x40;
+    gs_emulator.scene = (scene != NULL) ? *scene : gs_scene_default;
+    gs_emulator.now = now_ns;
+    gs_emulator.origin_ns = now_ns;
+    gs_emulator.pin = 1;
+    a_emulator_enter(EMULATOR_STATE_SLEEP);
+    
+    return 0;
+}
+
+/**
+ * @brief     emulator set the scene
+ * @param[in] *scene pointer to a scene structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t emulator_set_scene(const emulator_scene_t *scene)
+{
+    gs_emulator.scene = *scene;
+    
+    return 0;
+}
+
+/**
+ * @brief     emulator run the state machine
+ * @param[in] until_ns absolute time in ns
+ * @return    status code
+ *            - 0 until_ns is reached
+ *            - 1 the INT pin falls before until_ns
+ * @note      none
+ */
+uint8_t emulator_run(uint64_t until_ns)
+{
+    while (gs_emulator.deadline <= until_ns)
+    {
+        gs_emulator.now = gs_emulator.deadline;
+        a_emulator_state_end();
+        if (a_emulator_pin_update() != 0)
+        {
+            return 1;
+        }
+    }
+    if (until_ns > gs_emulator.now)
+    {
+        gs_emulator.now = until_ns;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  emulator get the time
+ * @return time of the state machine in ns
+ * @note   none
+ */
+uint64_t emulator_get_time(void)
+{
+    return gs_emulator.now;
+}
+
+/**
+ * @brief      emulator read the registers
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t emulator_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    uint8_t als;
+    uint8_t proximity;
+    
+    if (addr != EMULATOR_IIC_ADDRESS)
+    {
+        return 1;
+    }
+    
+    als = 0;
+    proximity = 0;
+    for (i = 0; i < len; i++)
+    {
+        if ((reg >= EMULATOR_REG_CDATAL) && (reg <= EMULATOR_REG_BDATAH))
+        {
+            als = 1;
+        }
+        if (reg == EMULATOR_REG_PDATA)
+        {
+            proximity = 1;
+        }
+        buf[i] = a_emulator_read_byte(reg);
+        reg = a_emulator_next_reg(reg);
+    }
+    if (als != 0)
+    {
+        gs_emulator.reg[EMULATOR_REG_STATUS] &= ~EMULATOR_STATUS_AVALID;
+    }
+    if (proximity != 0)
+    {
+        gs_emulator.reg[EMULATOR_REG_STATUS] &= ~EMULATOR_STATUS_PVALID;
+    }
+    (void)a_emulator_pin_update();
+    
+    return 0;
+}
+
+/**
+ * @brief     emulator write the registers
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t emulator_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    
+    if (addr != EMULATOR_IIC_ADDRESS)
+    {
+        return 1;
+    }
+    
+    if (len == 0)
+    {
+        a_emulator_special(reg);
+    }
+    for (i = 0; i < len; i++)
+    {
+        a_emulator_write_byte(reg, buf[i]);
+        reg = a_emulator_next_reg(reg);
+    }
+    (void)a_emulator_pin_update();
+    
+    return 0;
+}
+
+/**
+ * @brief  emulator get the INT pin level
+ * @return pin level
+ *         - 0 interrupt is asserted
+ *         - 1 interrupt is not asserted
+ * @note   none
+ */
+uint8_t emulator_get_int(void)
+{
+    return gs_emulator.pin;
+}
+
+/**
+ * @brief      emulator take the latched INT falling edge
+ * @param[out] *timestamp pointer to an edge time buffer
+ * @return     status code
+ *             - 0 no edge
+ *             - 1 an edge is taken
+ * @note       none
+ */
+uint8_t emulator_take_edge(uint64_t *timestamp)
+{
+    if (gs_emulator.edge == 0)
+    {
+        return 0;
+    }
+    gs_emulator.edge = 0;
+    *timestamp = gs_emulator.edge_ns;
+    
+    return 1;
+}
@@ -0,0 +1,491 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      gpio.c
+ * @brief     gpio source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-11-11
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "gpio.h"
+#include "emulator.h"
+#include <string.h>
+
+/**
+ * @brief global var definition
+ */
+extern uint8_t (*g_gpio_irq)(void);                              /**< gpio irq */
+static uint8_t (*gs_irq)(void *user, uint64_t timestamp);        /**< gpio timestamped irq */
+static void *gs_user;                                            /**< gpio timestamped irq user context */
+static uint8_t gs_running;                                       /**< gpio interrupt is inited */
+static uint8_t gs_busy;                                          /**< gpio irq handler is running */
+static gpio_realtime_t gs_realtime = {0, -1, 0};                 /**< gpio realtime options */
+static gpio_latency_t gs_latency;                                /**< gpio latency histogram */
+static gpio_reactor_t *gs_reactor;                               /**< started gpio reactor */
+
+/**
+ * @brief     add one sample to the latency histogram
+ * @param[in] *latency pointer to a gpio latency structure
+ * @param[in] ns latency in ns
+ * @note      none
+ */
+static void a_gpio_latency_add(gpio_latency_t *latency, uint64_t ns)
+{
+    uint8_t i;
+    uint64_t us;
+    
+    /* find the bucket */
+    us = ns / 1000;
+    i = 0;
+    while ((i < GPIO_LATENCY_BUCKET - 1) && (us >= (1ULL << i)))
+    {
+        i++;
+    }
+    
+    /* update the histogram */
+    latency->bucket[i]++;
+    latency->count++;
+    latency->sum_ns += ns;
+    if (ns > latency->max_ns)
+    {
+        latency->max_ns = ns;
+    }
+}
+
+/**
+ * @brief     run the sources of a started reactor
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] *get_time pointer to a function returning the current time in ns
+ * @return    status code
+ *            - 0 no source is run
+ *            - 1 a source is run
+ * @note      none
+ */
+static uint8_t a_gpio_reactor_dispatch(gpio_reactor_t *reactor, uint64_t (*get_time)(void))
+{
+    uint8_t i;
+    uint8_t res;
+    uint64_t timestamp;
+    uint64_t now;
+    
+    /* run the line sources on the latched edge */
+    res = 0;
+    if (emulator_take_edge(&timestamp) != 0)
+    {
+        for (i = 0; i < reactor->num; i++)
+        {
+            if ((reactor->source[i].type != GPIO_SOURCE_LINE) || (reactor->source[i].irq == NULL))
+            {
+                continue;
+            }
+            (void)reactor->source[i].irq(reactor->source[i].user, timestamp);
+            now = get_time();
+            a_gpio_latency_add(&reactor->latency, (now > timestamp) ? (now - timestamp) : 0);
+        }
+        res = 1;
+    }
+    
+    /* run the expired timers */
+    now = get_time();
+    for (i = 0; i < reactor->num; i++)
+    {
+        gpio_source_t *source = &reactor->source[i];
+        
+        if ((source->type != GPIO_SOURCE_TIMER) || (source->irq == NULL))
+        {
+            continue;
+        }
+        if (source->next_ns == 0)
+        {
+            source->next_ns = now + source->period_ns;
+            
+            continue;
+        }
+        if (now < source->next_ns)
+        {
+            continue;
+        }
+        
+        /* the missed expirations are merged like a timerfd read */
+        while (source->next_ns <= now)
+        {
+            source->next_ns += source->period_ns;
+        }
+        (void)source->irq(source->user, now);
+        res = 1;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief  gpio interrupt init
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t gpio_interrupt_init(void)
+{
+    uint64_t timestamp;
+    
+    /* drop the edges before the init */
+    (void)emulator_take_edge(&timestamp);
+    gs_running = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  gpio interrupt deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t gpio_interrupt_deinit(void)
+{
+    gs_running = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio interrupt set the timestamped handler
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ * @note      when it is set it is run instead of g_gpio_irq with the emulated time of the edge in ns,
+ *            set it to NULL to restore g_gpio_irq
+ */
+uint8_t gpio_interrupt_set_handler(uint8_t (*irq)(void *user, uint64_t timestamp), void *user)
+{
+    gs_user = user;
+    gs_irq = irq;
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio interrupt set the realtime options
+ * @param[in] *rt pointer to a gpio realtime structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t gpio_interrupt_set_realtime(const gpio_realtime_t *rt)
+{
+    gs_realtime = *rt;
+    
+    return 0;
+}
+
+/**
+ * @brief      gpio interrupt get the latency histogram
+ * @param[out] *latency pointer to a gpio latency structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t gpio_interrupt_get_latency(gpio_latency_t *latency)
+{
+    *latency = gs_latency;
+    
+    return 0;
+}
+
+/**
+ * @brief  gpio interrupt clear the latency histogram
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t gpio_interrupt_clear_latency(void)
+{
+    memset(&gs_latency, 0, sizeof(gpio_latency_t));
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio interrupt dispatch the latched edge
+ * @param[in] *get_time pointer to a function returning the current time in ns
+ * @return    status code
+ *            - 0 no edge
+ *            - 1 an edge is dispatched
+ * @note      none
+ */
+uint8_t gpio_interrupt_poll(uint64_t (*get_time)(void))
+{
+    uint64_t timestamp;
+    uint64_t now;
+    uint8_t res;
+    
+    /* the irq handler reads the chip and delays */
+    if (gs_busy != 0)
+    {
+        return 0;
+    }
+    
+    /* a started reactor takes the edges */
+    if (gs_reactor != NULL)
+    {
+        gs_busy = 1;
+        res = a_gpio_reactor_dispatch(gs_reactor, get_time);
+        gs_busy = 0;
+        
+        return res;
+    }
+    if (gs_running == 0)
+    {
+        return 0;
+    }
+    if (emulator_take_edge(&timestamp) == 0)
+    {
+        return 0;
+    }
+    
+    /* run the irq handler */
+    gs_busy = 1;
+    if (gs_irq != NULL)
+    {
+        (void)gs_irq(gs_user, timestamp);
+    }
+    else if (g_gpio_irq != NULL)
+    {
+        (void)g_gpio_irq();
+    }
+    else
+    {
+        /* no handler */
+    }
+    gs_busy = 0;
+    
+    /* update the histogram */
+    now = get_time();
+    a_gpio_latency_add(&gs_latency, (now > timestamp) ? (now - timestamp) : 0);
+    
+    return 1;
+}
+
+/**
+ * @brief      gpio reactor init
+ * @param[out] *reactor pointer to a gpio reactor structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t gpio_reactor_init(gpio_reactor_t *reactor)
+{
+    /* clear the reactor */
+    memset(reactor, 0, sizeof(gpio_reactor_t));
+    reactor->realtime.cpu = -1;
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio reactor add a source
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] type source type
+ * @param[in] line gpio line offset
+ * @param[in] period_ns timer period in ns
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      none
+ */
+static uint8_t a_gpio_reactor_add(gpio_reactor_t *reactor, uint8_t type, uint32_t line, uint64_t period_ns,
+                                  uint8_t (*irq)(void *user, uint64_t timestamp), void *user)
+{
+    gpio_source_t *source;
+    
+    /* check the sources */
+    if (reactor->num >= GPIO_REACTOR_MAX_SOURCE)
+    {
+        return 1;
+    }
+    
+    /* add the source */
+    source = &reactor->source[reactor->num];
+    source->type = type;
+    source->line = line;
+    source->period_ns = period_ns;
+    source->next_ns = 0;
+    source->irq = irq;
+    source->user = user;
+    reactor->num++;
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio reactor add a line
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] line gpio line offset
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      every line is wired to the emulated INT pin
+ */
+uint8_t gpio_reactor_add_line(gpio_reactor_t *reactor, uint32_t line, uint8_t (*irq)(void *user, uint64_t timestamp), void *user)
+{
+    return a_gpio_reactor_add(reactor, GPIO_SOURCE_LINE, line, 0, irq, user);
+}
+
+/**
+ * @brief     gpio reactor add a periodic timer
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] period_ms timer period in ms
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      none
+ */
+uint8_t gpio_reactor_add_timer(gpio_reactor_t *reactor, uint32_t period_ms, uint8_t (*irq)(void *user, uint64_t timestamp), void *user)
+{
+    if (period_ms == 0)
+    {
+        return 1;
+    }
+    
+    return a_gpio_reactor_add(reactor, GPIO_SOURCE_TIMER, 0, (uint64_t)period_ms * 1000000ULL, irq, user);
+}
+
+/**
+ * @brief     gpio reactor wait and dispatch once
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] timeout_ms wait timeout in ms, -1 waits forever
+ * @return    status code
+ *            - 0 success
+ * @note      the sources are dispatched by the delay functions of the driver interface
+ */
+uint8_t gpio_reactor_poll(gpio_reactor_t *reactor, int timeout_ms)
+{
+    (void)reactor;
+    (void)timeout_ms;
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio reactor start the dispatch
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      none
+ */
+uint8_t gpio_reactor_start(gpio_reactor_t *reactor)
+{
+    uint64_t timestamp;
+    
+    /* one INT pin serves one reactor */
+    if (gs_reactor != NULL)
+    {
+        return 1;
+    }
+    
+    /* drop the edges before the start */
+    (void)emulator_take_edge(&timestamp);
+    gs_reactor = reactor;
+    reactor->running = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio reactor set the realtime options
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] *rt pointer to a gpio realtime structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t gpio_reactor_set_realtime(gpio_reactor_t *reactor, const gpio_realtime_t *rt)
+{
+    reactor->realtime = *rt;
+    
+    return 0;
+}
+
+/**
+ * @brief      gpio reactor get the latency histogram
+ * @param[in]  *reactor pointer to a gpio reactor structure
+ * @param[out] *latency pointer to a gpio latency structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t gpio_reactor_get_latency(gpio_reactor_t *reactor, gpio_latency_t *latency)
+{
+    *latency = reactor->latency;
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio reactor clear the latency histogram
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t gpio_reactor_clear_latency(gpio_reactor_t *reactor)
+{
+    memset(&reactor->latency, 0, sizeof(gpio_latency_t));
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio reactor deinit
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t gpio_reactor_deinit(gpio_reactor_t *reactor)
+{
+    /* stop the dispatch */
+    if (gs_reactor == reactor)
+    {
+        gs_reactor = NULL;
+    }
+    reactor->running = 0;
+    reactor->num = 0;
+    
+    return 0;
+}
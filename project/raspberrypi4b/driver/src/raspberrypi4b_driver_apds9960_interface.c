@@ -37,6 +37,8 @@
 #include "driver_apds9960_interface.h"
 #include "iic.h"
 #include <stdarg.h>
+#include <errno.h>
+#include <time.h>
 
 /**
  * @brief iic device name definition
@@ -44,36 +46,61 @@
 #define IIC_DEVICE_NAME "/dev/i2c-1"        /**< iic device name */
 
 /**
- * @brief iic device handle definition
+ * @brief default iic bus definition
  */
-static int gs_fd;                           /**< iic handle */
+static iic_bus_t gs_bus = {.name = IIC_DEVICE_NAME, .fd = -1};        /**< iic bus used when the user context is NULL */
 
 /**
- * @brief  interface iic bus init
- * @return status code
- *         - 0 success
- *         - 1 iic init failed
- * @note   none
+ * @brief     get the iic bus of a user context
+ * @param[in] *user pointer to a user context
+ * @return    pointer to an iic bus
+ * @note      the user context points to an iic_bus_t, which may be the first member of a larger context
  */
-uint8_t apds9960_interface_iic_init(void)
+static iic_bus_t *a_apds9960_interface_bus(void *user)
 {
-    return iic_init(IIC_DEVICE_NAME, &gs_fd);
+    if (user == NULL)
+    {
+        return &gs_bus;
+    }
+    
+    return (iic_bus_t *)user;
 }
 
 /**
- * @brief  interface iic bus deinit
- * @return status code
- *         - 0 success
- *         - 1 iic deinit failed
- * @note   none
+ * @brief     interface iic bus init
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+uint8_t apds9960_interface_iic_init(void *user)
+{
+    iic_bus_t *bus = a_apds9960_interface_bus(user);
+    
+    return iic_init(bus->name, &bus->fd);
+}
+
+/**
+ * @brief     interface iic bus deinit
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
  */
-uint8_t apds9960_interface_iic_deinit(void)
+uint8_t apds9960_interface_iic_deinit(void *user)
 {
-    return iic_deinit(gs_fd);
+    iic_bus_t *bus = a_apds9960_interface_bus(user);
+    
+    (void)iic_async_deinit(&bus->async);
+    
+    return iic_deinit(bus->fd);
 }
 
 /**
  * @brief      interface iic bus read
+ * @param[in]  *user pointer to a user context
  * @param[in]  addr iic device write address
  * @param[in]  reg iic register address
  * @param[out] *buf pointer to a data buffer
@@ -83,13 +110,14 @@ uint8_t apds9960_interface_iic_deinit(void)
  *             - 1 read failed
  * @note       none
  */
-uint8_t apds9960_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+uint8_t apds9960_interface_iic_read(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    return iic_read(gs_fd, addr, reg, buf, len);
+    return iic_read(a_apds9960_interface_bus(user)->fd, addr, reg, buf, len);
 }
 
 /**
  * @brief     interface iic bus write
+ * @param[in] *user pointer to a user context
  * @param[in] addr iic device write address
  * @param[in] reg iic register address
  * @param[in] *buf pointer to a data buffer
@@ -99,9 +127,88 @@ uint8_t apds9960_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uin
  *            - 1 write failed
  * @note      none
  */
-uint8_t apds9960_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+uint8_t apds9960_interface_iic_write(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return iic_write(a_apds9960_interface_bus(user)->fd, addr, reg, buf, len);
+}
+
+/**
+ * @brief     interface iic bus async read submit
+ * @param[in] *user pointer to a user context
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      the buffer is filled when apds9960_interface_iic_poll is not busy
+ */
+uint8_t apds9960_interface_iic_read_submit(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    iic_bus_t *bus = a_apds9960_interface_bus(user);
+    
+    return iic_async_read(&bus->async, bus->fd, addr, reg, buf, len);
+}
+
+/**
+ * @brief     interface iic bus async write submit
+ * @param[in] *user pointer to a user context
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      the buffer must be kept until apds9960_interface_iic_poll is not busy
+ */
+uint8_t apds9960_interface_iic_write_submit(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    iic_bus_t *bus = a_apds9960_interface_bus(user);
+    
+    return iic_async_write(&bus->async, bus->fd, addr, reg, buf, len);
+}
+
+/**
+ * @brief     interface iic bus async poll
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ *            - 2 busy
+ * @note      none
+ */
+uint8_t apds9960_interface_iic_poll(void *user)
+{
+    return iic_async_poll(&a_apds9960_interface_bus(user)->async);
+}
+
+/**
+ * @brief     interface iic bus batch transfer
+ * @param[in] *user pointer to a user context
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message buffer
+ * @param[in] num number of the messages
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the messages are sent with as few I2C_RDWR ioctls as IIC_RDWR_MAX_MSGS allows
+ */
+uint8_t apds9960_interface_iic_transfer(void *user, uint8_t addr, apds9960_iic_msg_t *msg, uint8_t num)
 {
-    return iic_write(gs_fd, addr, reg, buf, len);
+    uint8_t i;
+    iic_msg_t msgs[num];
+    
+    for (i = 0; i < num; i++)
+    {
+        msgs[i].write = msg[i].write;
+        msgs[i].reg = msg[i].reg;
+        msgs[i].buf = msg[i].buf;
+        msgs[i].len = msg[i].len;
+    }
+    
+    return iic_transfer(a_apds9960_interface_bus(user)->fd, addr, msgs, num);
 }
 
 /**
@@ -114,6 +221,47 @@ void apds9960_interface_delay_ms(uint32_t ms)
     usleep(1000 * ms);
 }
 
+/**
+ * @brief  interface timestamp ns
+ * @return monotonic timestamp in ns
+ * @note   none
+ */
+uint64_t apds9960_interface_timestamp_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief  interface cycle count
+ * @return free running cpu cycle counter
+ * @note   the cycle counter of the cortex-a72 is not readable from user space by default, so it returns 0
+ */
+uint32_t apds9960_interface_cycle_count(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface delay until an absolute time
+ * @param[in] ns absolute timestamp_ns time
+ * @note      none
+ */
+void apds9960_interface_delay_until_ns(uint64_t ns)
+{
+    struct timespec ts;
+    
+    ts.tv_sec = (time_t)(ns / 1000000000ULL);
+    ts.tv_nsec = (long)(ns % 1000000000ULL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+    {
+        continue;
+    }
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -136,11 +284,14 @@ void apds9960_interface_debug_print(const char *const fmt, ...)
 
 /**
  * @brief     interface receive callback
+ * @param[in] *user pointer to a user context
  * @param[in] type interrupt type
  * @note      none
  */
-void apds9960_interface_receive_callback(uint8_t type)
+void apds9960_interface_receive_callback(void *user, uint8_t type)
 {
+    (void)user;
+    
     switch (type)
     {
         case APDS9960_INTERRUPT_STATUS_GESTURE_LEFT :
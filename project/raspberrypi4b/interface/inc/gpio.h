@@ -40,6 +40,10 @@
 #include <unistd.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <pthread.h>
+
+struct gpiod_chip;
+struct gpiod_line;
 
 #ifdef __cplusplus
  extern "C" {
@@ -51,6 +55,32 @@
  * @{
  */
 
+/**
+ * @brief gpio latency definition
+ */
+#define GPIO_LATENCY_BUCKET 20        /**< log2 buckets from 1us to 2^18us */
+
+/**
+ * @brief gpio realtime structure definition
+ */
+typedef struct gpio_realtime_s
+{
+    int priority;        /**< SCHED_FIFO priority from 1 to 99, 0 keeps the default scheduler */
+    int cpu;             /**< cpu the pthread runs on, -1 for any cpu */
+    uint8_t lock;        /**< 1 locks the current and future memory pages */
+} gpio_realtime_t;
+
+/**
+ * @brief gpio latency structure definition
+ */
+typedef struct gpio_latency_s
+{
+    uint32_t count;                             /**< number of the serviced edges */
+    uint64_t sum_ns;                            /**< latency sum in ns */
+    uint64_t max_ns;                            /**< max latency in ns */
+    uint32_t bucket[GPIO_LATENCY_BUCKET];       /**< bucket i counts latencies below 2^i us, the last one counts the rest */
+} gpio_latency_t;
+
 /**
  * @brief  gpio interrupt init
  * @return status code
@@ -69,6 +99,192 @@ uint8_t gpio_interrupt_init(void);
  */
 uint8_t gpio_interrupt_deinit(void);
 
+/**
+ * @brief     gpio interrupt set the timestamped handler
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ * @note      when it is set it is run instead of g_gpio_irq with the kernel timestamp of the edge in ns,
+ *            set it to NULL to restore g_gpio_irq
+ */
+uint8_t gpio_interrupt_set_handler(uint8_t (*irq)(void *user, uint64_t timestamp), void *user);
+
+/**
+ * @brief     gpio interrupt set the realtime options
+ * @param[in] *rt pointer to a gpio realtime structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the options are applied by gpio_interrupt_init or at once when the pthread is running,
+ *            SCHED_FIFO and mlock need root or CAP_SYS_NICE and CAP_IPC_LOCK
+ */
+uint8_t gpio_interrupt_set_realtime(const gpio_realtime_t *rt);
+
+/**
+ * @brief      gpio interrupt get the latency histogram
+ * @param[out] *latency pointer to a gpio latency structure
+ * @return     status code
+ *             - 0 success
+ * @note       latency is measured from the kernel timestamp of the edge to the return of the irq handler,
+ *             the histogram is copied under its mutex while the gpio pthread runs
+ */
+uint8_t gpio_interrupt_get_latency(gpio_latency_t *latency);
+
+/**
+ * @brief  gpio interrupt clear the latency histogram
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t gpio_interrupt_clear_latency(void);
+
+/**
+ * @brief gpio event batch definition
+ */
+#define GPIO_EVENT_BATCH 16               /**< max edge events read by one syscall */
+
+/**
+ * @brief gpio reactor definition
+ */
+#define GPIO_REACTOR_MAX_SOURCE 32        /**< max lines and timers of one reactor */
+
+/**
+ * @brief gpio reactor source type enumeration definition
+ */
+typedef enum
+{
+    GPIO_SOURCE_LINE  = 0x00,        /**< gpio line falling edge */
+    GPIO_SOURCE_TIMER = 0x01,        /**< periodic timer */
+} gpio_source_type_t;
+
+/**
+ * @brief gpio reactor source structure definition
+ */
+typedef struct gpio_source_s
+{
+    int fd;                                            /**< line event or timer fd */
+    uint8_t type;                                      /**< source type */
+    struct gpiod_line *line;                           /**< gpio line handle */
+    uint8_t (*irq)(void *user, uint64_t timestamp);    /**< irq handler of the source */
+    void *user;                                        /**< user context passed to the irq handler */
+} gpio_source_t;
+
+/**
+ * @brief gpio reactor structure definition
+ */
+typedef struct gpio_reactor_s
+{
+    struct gpiod_chip *chip;                          /**< gpio chip handle */
+    int epfd;                                         /**< epoll fd */
+    pthread_t pid;                                    /**< reactor pthread pid */
+    uint8_t running;                                  /**< reactor pthread is running */
+    uint8_t num;                                      /**< number of the sources */
+    gpio_source_t source[GPIO_REACTOR_MAX_SOURCE];    /**< source buffer */
+    gpio_realtime_t realtime;                         /**< realtime options of the reactor pthread */
+    gpio_latency_t latency;                           /**< latency histogram of all line sources */
+    pthread_mutex_t mutex;                            /**< latency histogram mutex */
+} gpio_reactor_t;
+
+/**
+ * @brief      gpio reactor init
+ * @param[out] *reactor pointer to a gpio reactor structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       none
+ */
+uint8_t gpio_reactor_init(gpio_reactor_t *reactor);
+
+/**
+ * @brief     gpio reactor add a line
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] line gpio line offset
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      irq is run on the reactor pthread for every falling edge of the line with the kernel
+ *            timestamp of the edge in ns, user is usually the driver handle served by the line
+ */
+uint8_t gpio_reactor_add_line(gpio_reactor_t *reactor, uint32_t line, uint8_t (*irq)(void *user, uint64_t timestamp), void *user);
+
+/**
+ * @brief     gpio reactor add a periodic timer
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] period_ms timer period in ms
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      it is used for the polled sensors without an interrupt line,
+ *            irq gets the CLOCK_MONOTONIC time the expiration is read in ns
+ */
+uint8_t gpio_reactor_add_timer(gpio_reactor_t *reactor, uint32_t period_ms, uint8_t (*irq)(void *user, uint64_t timestamp), void *user);
+
+/**
+ * @brief     gpio reactor wait and dispatch once
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] timeout_ms wait timeout in ms, -1 waits forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ * @note      it can be run in the caller loop instead of gpio_reactor_start
+ */
+uint8_t gpio_reactor_poll(gpio_reactor_t *reactor, int timeout_ms);
+
+/**
+ * @brief     gpio reactor start the dispatch pthread
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      one pthread serves all the sources
+ */
+uint8_t gpio_reactor_start(gpio_reactor_t *reactor);
+
+/**
+ * @brief     gpio reactor set the realtime options
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] *rt pointer to a gpio realtime structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the options are applied by gpio_reactor_start or at once when the pthread is running
+ */
+uint8_t gpio_reactor_set_realtime(gpio_reactor_t *reactor, const gpio_realtime_t *rt);
+
+/**
+ * @brief      gpio reactor get the latency histogram
+ * @param[in]  *reactor pointer to a gpio reactor structure
+ * @param[out] *latency pointer to a gpio latency structure
+ * @return     status code
+ *             - 0 success
+ * @note       the histogram is copied under its mutex while the dispatch pthread runs
+ */
+uint8_t gpio_reactor_get_latency(gpio_reactor_t *reactor, gpio_latency_t *latency);
+
+/**
+ * @brief     gpio reactor clear the latency histogram
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t gpio_reactor_clear_latency(gpio_reactor_t *reactor);
+
+/**
+ * @brief     gpio reactor deinit
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      the dispatch pthread is stopped and all the lines and timers are closed
+ */
+uint8_t gpio_reactor_deinit(gpio_reactor_t *reactor);
+
 /**
  * @}
  */
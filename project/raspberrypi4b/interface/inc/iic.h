@@ -42,6 +42,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -53,6 +54,54 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief iic batch definition
+ */
+#define IIC_RDWR_MAX_MSGS 42        /**< max messages in one I2C_RDWR ioctl */
+
+/**
+ * @brief iic message structure definition
+ */
+typedef struct iic_msg_s
+{
+    uint8_t write;             /**< 1 for write and 0 for read */
+    uint8_t reg;               /**< iic register address */
+    uint8_t *buf;              /**< data buffer */
+    uint16_t len;              /**< data length */
+} iic_msg_t;
+
+/**
+ * @brief iic async transfer structure definition
+ */
+typedef struct iic_async_s
+{
+    pthread_t pid;             /**< worker pthread pid */
+    pthread_mutex_t mutex;     /**< submit mutex */
+    pthread_cond_t cond;       /**< submit condition */
+    int fd;                    /**< iic device handle */
+    uint8_t write;             /**< 1 for write and 0 for read */
+    uint8_t addr;              /**< iic device write address */
+    uint8_t reg;               /**< iic register address */
+    uint8_t *buf;              /**< data buffer */
+    uint16_t len;              /**< data length */
+    uint8_t res;               /**< transfer result */
+    uint8_t started;           /**< worker pthread is running */
+    uint8_t stop;              /**< worker pthread is asked to exit */
+    uint8_t pending;           /**< a transfer is handed to the worker */
+    uint8_t busy;              /**< a transfer is not polled yet */
+    int done;                  /**< transfer is finished */
+} iic_async_t;
+
+/**
+ * @brief iic bus structure definition
+ */
+typedef struct iic_bus_s
+{
+    char *name;                /**< iic device name */
+    int fd;                    /**< iic device handle */
+    iic_async_t async;         /**< iic async transfer */
+} iic_bus_t;
+
 /**
  * @brief      iic bus init
  * @param[in]  *name pointer to an iic device name buffer
@@ -156,6 +205,73 @@ uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     iic bus batch transfer
+ * @param[in] fd iic handle
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message buffer
+ * @param[in] num number of the messages
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      addr = device_address_7bits << 1,
+ *            a read uses two iic messages and a write uses one, the messages are sent
+ *            with as few I2C_RDWR ioctls as IIC_RDWR_MAX_MSGS allows
+ */
+uint8_t iic_transfer(int fd, uint8_t addr, iic_msg_t *msg, uint8_t num);
+
+/**
+ * @brief     iic bus async read
+ * @param[in] *async pointer to an iic async transfer structure
+ * @param[in] fd iic handle
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      addr = device_address_7bits << 1,
+ *            the transfer runs on the worker pthread of async and the buffer must be kept until iic_async_poll is not busy
+ */
+uint8_t iic_async_read(iic_async_t *async, int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     iic bus async write
+ * @param[in] *async pointer to an iic async transfer structure
+ * @param[in] fd iic handle
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      addr = device_address_7bits << 1,
+ *            the transfer runs on the worker pthread of async and the buffer must be kept until iic_async_poll is not busy
+ */
+uint8_t iic_async_write(iic_async_t *async, int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     iic bus async poll
+ * @param[in] *async pointer to an iic async transfer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ *            - 2 busy
+ * @note      none
+ */
+uint8_t iic_async_poll(iic_async_t *async);
+
+/**
+ * @brief     iic bus async deinit
+ * @param[in] *async pointer to an iic async transfer structure
+ * @return    status code
+ *            - 0 success
+ * @note      the worker pthread finishes the submitted transfer and exits
+ */
+uint8_t iic_async_deinit(iic_async_t *async);
+
 /**
  * @}
  */
@@ -34,9 +34,19 @@
  * </table>
  */
 
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
 #include "gpio.h"
 #include <gpiod.h>
 #include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/mman.h>
 
 /**
  * @brief gpio device name definition
@@ -51,10 +61,124 @@
 /**
  * @brief global var definition
  */
-static struct gpiod_chip *gs_chip;        /**< gpio chip handle */
-static struct gpiod_line *gs_line;        /**< gpio line handle */
-static pthread_t gs_pid;                  /**< gpio pthread pid */
-extern uint8_t (*g_gpio_irq)(void);       /**< gpio irq */
+static struct gpiod_chip *gs_chip;                               /**< gpio chip handle */
+static struct gpiod_line *gs_line;                               /**< gpio line handle */
+static pthread_t gs_pid;                                         /**< gpio pthread pid */
+extern uint8_t (*g_gpio_irq)(void);                              /**< gpio irq */
+static uint8_t (*gs_irq)(void *user, uint64_t timestamp);        /**< gpio timestamped irq */
+static void *gs_user;                                            /**< gpio timestamped irq user context */
+static uint8_t gs_running;                                       /**< gpio pthread is running */
+static gpio_realtime_t gs_realtime = {0, -1, 0};                 /**< gpio pthread realtime options */
+static gpio_latency_t gs_latency;                                /**< gpio latency histogram */
+static pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;     /**< gpio latency histogram mutex */
+
+/**
+ * @brief     convert a timespec to ns
+ * @param[in] *ts pointer to a timespec structure
+ * @return    time in ns
+ * @note      none
+ */
+static uint64_t a_gpio_timestamp(const struct timespec *ts)
+{
+    return (uint64_t)ts->tv_sec * 1000000000ULL + (uint64_t)ts->tv_nsec;
+}
+
+/**
+ * @brief     add one sample to the latency histogram
+ * @param[in] *latency pointer to a gpio latency structure
+ * @param[in] *mutex pointer to the mutex of the histogram
+ * @param[in] timestamp edge timestamp in ns
+ * @note      the gpio pthread is cancelled asynchronously, so it can't be cancelled with the mutex held
+ */
+static void a_gpio_latency_add(gpio_latency_t *latency, pthread_mutex_t *mutex, uint64_t timestamp)
+{
+    uint8_t i;
+    int state;
+    uint64_t ns;
+    uint64_t us;
+    struct timespec ts;
+    
+    /* get the latency */
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ns = a_gpio_timestamp(&ts);
+    ns = (ns > timestamp) ? (ns - timestamp) : 0;
+    
+    /* find the bucket */
+    us = ns / 1000;
+    i = 0;
+    while ((i < GPIO_LATENCY_BUCKET - 1) && (us >= (1ULL << i)))
+    {
+        i++;
+    }
+    
+    /* update the histogram */
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+    pthread_mutex_lock(mutex);
+    latency->bucket[i]++;
+    latency->count++;
+    latency->sum_ns += ns;
+    if (ns > latency->max_ns)
+    {
+        latency->max_ns = ns;
+    }
+    pthread_mutex_unlock(mutex);
+    pthread_setcancelstate(state, NULL);
+}
+
+/**
+ * @brief     apply the realtime options to a pthread
+ * @param[in] pid pthread pid
+ * @param[in] *rt pointer to a gpio realtime structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 apply failed
+ * @note      none
+ */
+static uint8_t a_gpio_realtime(pthread_t pid, const gpio_realtime_t *rt)
+{
+    /* lock the memory */
+    if (rt->lock != 0)
+    {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            perror("gpio: mlock failed.\n");
+            
+            return 1;
+        }
+    }
+    
+    /* set the scheduler */
+    if (rt->priority > 0)
+    {
+        struct sched_param param;
+        
+        memset(&param, 0, sizeof(struct sched_param));
+        param.sched_priority = rt->priority;
+        if (pthread_setschedparam(pid, SCHED_FIFO, &param) != 0)
+        {
+            perror("gpio: set sched fifo failed.\n");
+            
+            return 1;
+        }
+    }
+    
+    /* set the cpu affinity */
+    if (rt->cpu >= 0)
+    {
+        cpu_set_t set;
+        
+        CPU_ZERO(&set);
+        CPU_SET(rt->cpu, &set);
+        if (pthread_setaffinity_np(pid, sizeof(cpu_set_t), &set) != 0)
+        {
+            perror("gpio: set cpu affinity failed.\n");
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
 
 /**
  * @brief  gpio interrupt pthread
@@ -65,7 +189,9 @@ extern uint8_t (*g_gpio_irq)(void);       /**< gpio irq */
 static void *a_gpio_interrupt_pthread(void *p)
 {
     int res;
-    struct gpiod_line_event event;
+    int i;
+    int n;
+    struct gpiod_line_event event[GPIO_EVENT_BATCH];
     
     /* enable catching cancel signal */
     pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
@@ -80,21 +206,36 @@ static void *a_gpio_interrupt_pthread(void *p)
         res = gpiod_line_event_wait(gs_line, NULL);
         if (res == 1)
         {
-            /* read the event */
-            if (gpiod_line_event_read(gs_line, &event) != 0)
+            /* read all pending events */
+            n = gpiod_line_event_read_multiple(gs_line, event, GPIO_EVENT_BATCH);
+            if (n <= 0)
             {
                 continue;
             }
-
-            /* if the falling edge */
-            if (event.event_type == GPIOD_LINE_EVENT_FALLING_EDGE)
+            
+            for (i = 0; i < n; i++)
             {
+                /* if not the falling edge */
+                if (event[i].event_type != GPIOD_LINE_EVENT_FALLING_EDGE)
+                {
+                    continue;
+                }
+                
+                /* run the timestamped callback */
+                if (gs_irq != NULL)
+                {
+                    gs_irq(gs_user, a_gpio_timestamp(&event[i].ts));
+                }
+                
                 /* check the g_gpio_irq */
-                if (g_gpio_irq != NULL)
+                else if (g_gpio_irq != NULL)
                 {
                     /* run the callback */
                     g_gpio_irq();
                 }
+                
+                /* record the latency */
+                a_gpio_latency_add(&gs_latency, &gs_mutex, a_gpio_timestamp(&event[i].ts));
             }
         }
     }
@@ -148,6 +289,17 @@ uint8_t gpio_interrupt_init(void)
 
         return 1;
     }
+    
+    /* apply the realtime options */
+    if (a_gpio_realtime(gs_pid, &gs_realtime) != 0)
+    {
+        (void)pthread_cancel(gs_pid);
+        (void)pthread_join(gs_pid, NULL);
+        gpiod_chip_close(gs_chip);
+        
+        return 1;
+    }
+    gs_running = 1;
 
     return 0;
 }
@@ -171,9 +323,518 @@ uint8_t gpio_interrupt_deinit(void)
 
         return 1;
     }
+    gs_running = 0;
 
     /* close the gpio */
     gpiod_chip_close(gs_chip);
     
     return 0;
 }
+
+/**
+ * @brief     gpio interrupt set the timestamped handler
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ * @note      when it is set it is run instead of g_gpio_irq with the kernel timestamp of the edge in ns,
+ *            set it to NULL to restore g_gpio_irq
+ */
+uint8_t gpio_interrupt_set_handler(uint8_t (*irq)(void *user, uint64_t timestamp), void *user)
+{
+    gs_user = user;
+    gs_irq = irq;
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio interrupt set the realtime options
+ * @param[in] *rt pointer to a gpio realtime structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the options are applied by gpio_interrupt_init or at once when the pthread is running,
+ *            SCHED_FIFO and mlock need root or CAP_SYS_NICE and CAP_IPC_LOCK
+ */
+uint8_t gpio_interrupt_set_realtime(const gpio_realtime_t *rt)
+{
+    gs_realtime = *rt;
+    if (gs_running != 0)
+    {
+        return a_gpio_realtime(gs_pid, &gs_realtime);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      gpio interrupt get the latency histogram
+ * @param[out] *latency pointer to a gpio latency structure
+ * @return     status code
+ *             - 0 success
+ * @note       latency is measured from the kernel timestamp of the edge to the return of the irq handler
+ */
+uint8_t gpio_interrupt_get_latency(gpio_latency_t *latency)
+{
+    pthread_mutex_lock(&gs_mutex);
+    *latency = gs_latency;
+    pthread_mutex_unlock(&gs_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief  gpio interrupt clear the latency histogram
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t gpio_interrupt_clear_latency(void)
+{
+    pthread_mutex_lock(&gs_mutex);
+    memset(&gs_latency, 0, sizeof(gpio_latency_t));
+    pthread_mutex_unlock(&gs_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief      gpio reactor init
+ * @param[out] *reactor pointer to a gpio reactor structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       none
+ */
+uint8_t gpio_reactor_init(gpio_reactor_t *reactor)
+{
+    /* clear the reactor */
+    memset(reactor, 0, sizeof(gpio_reactor_t));
+    reactor->realtime.cpu = -1;
+    
+    /* open the gpio group */
+    reactor->chip = gpiod_chip_open(GPIO_DEVICE_NAME);
+    if (reactor->chip == NULL)
+    {
+        perror("gpio: open failed.\n");
+        
+        return 1;
+    }
+    
+    /* create the epoll fd */
+    reactor->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (reactor->epfd < 0)
+    {
+        perror("gpio: epoll create failed.\n");
+        gpiod_chip_close(reactor->chip);
+        
+        return 1;
+    }
+    
+    /* init the latency mutex */
+    if (pthread_mutex_init(&reactor->mutex, NULL) != 0)
+    {
+        perror("gpio: mutex init failed.\n");
+        close(reactor->epfd);
+        gpiod_chip_close(reactor->chip);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio reactor add a source
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] fd source fd
+ * @param[in] type source type
+ * @param[in] *line pointer to a gpio line handle
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      none
+ */
+static uint8_t a_gpio_reactor_add(gpio_reactor_t *reactor, int fd, uint8_t type, struct gpiod_line *line, uint8_t (*irq)(void *user, uint64_t timestamp), void *user)
+{
+    struct epoll_event ev;
+    gpio_source_t *source;
+    
+    /* set the source */
+    source = &reactor->source[reactor->num];
+    source->fd = fd;
+    source->type = type;
+    source->line = line;
+    source->irq = irq;
+    source->user = user;
+    
+    /* add to the epoll */
+    memset(&ev, 0, sizeof(struct epoll_event));
+    ev.events = EPOLLIN;
+    ev.data.ptr = source;
+    if (epoll_ctl(reactor->epfd, EPOLL_CTL_ADD, fd, &ev) < 0)
+    {
+        perror("gpio: epoll add failed.\n");
+        
+        return 1;
+    }
+    reactor->num++;
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio reactor add a line
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] line gpio line offset
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      irq is run on the reactor pthread for every falling edge of the line with the kernel
+ *            timestamp of the edge in ns, user is usually the driver handle served by the line
+ */
+uint8_t gpio_reactor_add_line(gpio_reactor_t *reactor, uint32_t line, uint8_t (*irq)(void *user, uint64_t timestamp), void *user)
+{
+    int fd;
+    struct gpiod_line *l;
+    
+    /* check the number */
+    if (reactor->num >= GPIO_REACTOR_MAX_SOURCE)
+    {
+        perror("gpio: too many sources.\n");
+        
+        return 1;
+    }
+    
+    /* get the gpio line */
+    l = gpiod_chip_get_line(reactor->chip, line);
+    if (l == NULL)
+    {
+        perror("gpio: get line failed.\n");
+        
+        return 1;
+    }
+    
+    /* catch the falling edge */
+    if (gpiod_line_request_falling_edge_events(l, "gpiointerrupt") < 0)
+    {
+        perror("gpio: set edge events failed.\n");
+        
+        return 1;
+    }
+    
+    /* get the event fd */
+    fd = gpiod_line_event_get_fd(l);
+    if (fd < 0)
+    {
+        perror("gpio: get event fd failed.\n");
+        gpiod_line_release(l);
+        
+        return 1;
+    }
+    
+    /* add the line */
+    if (a_gpio_reactor_add(reactor, fd, GPIO_SOURCE_LINE, l, irq, user) != 0)
+    {
+        gpiod_line_release(l);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio reactor add a periodic timer
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] period_ms timer period in ms
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      it is used for the polled sensors without an interrupt line,
+ *            irq gets the CLOCK_MONOTONIC time the expiration is read in ns
+ */
+uint8_t gpio_reactor_add_timer(gpio_reactor_t *reactor, uint32_t period_ms, uint8_t (*irq)(void *user, uint64_t timestamp), void *user)
+{
+    int fd;
+    struct itimerspec spec;
+    
+    /* check the number */
+    if ((reactor->num >= GPIO_REACTOR_MAX_SOURCE) || (period_ms == 0))
+    {
+        perror("gpio: invalid timer.\n");
+        
+        return 1;
+    }
+    
+    /* create the timer fd */
+    fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0)
+    {
+        perror("gpio: timer create failed.\n");
+        
+        return 1;
+    }
+    
+    /* set the period */
+    spec.it_interval.tv_sec = period_ms / 1000;
+    spec.it_interval.tv_nsec = (long)(period_ms % 1000) * 1000000L;
+    spec.it_value = spec.it_interval;
+    if (timerfd_settime(fd, 0, &spec, NULL) < 0)
+    {
+        perror("gpio: timer set failed.\n");
+        close(fd);
+        
+        return 1;
+    }
+    
+    /* add the timer */
+    if (a_gpio_reactor_add(reactor, fd, GPIO_SOURCE_TIMER, NULL, irq, user) != 0)
+    {
+        close(fd);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio reactor wait and dispatch once
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] timeout_ms wait timeout in ms, -1 waits forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ * @note      it can be run in the caller loop instead of gpio_reactor_start
+ */
+uint8_t gpio_reactor_poll(gpio_reactor_t *reactor, int timeout_ms)
+{
+    int i;
+    int j;
+    int n;
+    int m;
+    int state;
+    uint64_t expire;
+    struct timespec ts;
+    struct gpiod_line_event event[GPIO_EVENT_BATCH];
+    struct epoll_event ev[GPIO_REACTOR_MAX_SOURCE];
+    
+    /* wait for the sources, the wait is the only cancel point */
+    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &state);
+    n = epoll_wait(reactor->epfd, ev, GPIO_REACTOR_MAX_SOURCE, timeout_ms);
+    pthread_setcancelstate(state, NULL);
+    if (n < 0)
+    {
+        if (errno == EINTR)
+        {
+            return 0;
+        }
+        perror("gpio: epoll wait failed.\n");
+        
+        return 1;
+    }
+    
+    /* dispatch all ready sources */
+    for (i = 0; i < n; i++)
+    {
+        gpio_source_t *source = (gpio_source_t *)ev[i].data.ptr;
+        
+        if (source->irq == NULL)
+        {
+            continue;
+        }
+        if (source->type == GPIO_SOURCE_LINE)
+        {
+            /* read all pending events */
+            m = gpiod_line_event_read_fd_multiple(source->fd, event, GPIO_EVENT_BATCH);
+            for (j = 0; j < m; j++)
+            {
+                /* run the irq handler on the falling edge */
+                if (event[j].event_type == GPIOD_LINE_EVENT_FALLING_EDGE)
+                {
+                    (void)source->irq(source->user, a_gpio_timestamp(&event[j].ts));
+                    a_gpio_latency_add(&reactor->latency, &reactor->mutex, a_gpio_timestamp(&event[j].ts));
+                }
+            }
+        }
+        else
+        {
+            /* read the expirations */
+            if (read(source->fd, &expire, sizeof(uint64_t)) != sizeof(uint64_t))
+            {
+                continue;
+            }
+            
+            /* run the irq handler */
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            (void)source->irq(source->user, a_gpio_timestamp(&ts));
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  gpio reactor pthread
+ * @param  *p pointer to a gpio reactor structure
+ * @return NULL
+ * @note   the pthread is only cancelled while it waits, so an irq handler is never cut in half
+ */
+static void *a_gpio_reactor_pthread(void *p)
+{
+    gpio_reactor_t *reactor = (gpio_reactor_t *)p;
+    
+    /* cancel only in the wait */
+    pthread_setcanceltype(PTHREAD_CANCEL_DEFERRED, NULL);
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+    
+    /* loop */
+    while (1)
+    {
+        if (gpio_reactor_poll(reactor, -1) != 0)
+        {
+            break;
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     gpio reactor start the dispatch pthread
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      one pthread serves all the sources
+ */
+uint8_t gpio_reactor_start(gpio_reactor_t *reactor)
+{
+    /* creat the reactor pthread */
+    if (pthread_create(&reactor->pid, NULL, a_gpio_reactor_pthread, reactor) != 0)
+    {
+        perror("gpio: creat pthread failed.\n");
+        
+        return 1;
+    }
+    
+    /* apply the realtime options */
+    if (a_gpio_realtime(reactor->pid, &reactor->realtime) != 0)
+    {
+        (void)pthread_cancel(reactor->pid);
+        (void)pthread_join(reactor->pid, NULL);
+        
+        return 1;
+    }
+    reactor->running = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio reactor set the realtime options
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @param[in] *rt pointer to a gpio realtime structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the options are applied by gpio_reactor_start or at once when the pthread is running
+ */
+uint8_t gpio_reactor_set_realtime(gpio_reactor_t *reactor, const gpio_realtime_t *rt)
+{
+    reactor->realtime = *rt;
+    if (reactor->running != 0)
+    {
+        return a_gpio_realtime(reactor->pid, &reactor->realtime);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      gpio reactor get the latency histogram
+ * @param[in]  *reactor pointer to a gpio reactor structure
+ * @param[out] *latency pointer to a gpio latency structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t gpio_reactor_get_latency(gpio_reactor_t *reactor, gpio_latency_t *latency)
+{
+    pthread_mutex_lock(&reactor->mutex);
+    *latency = reactor->latency;
+    pthread_mutex_unlock(&reactor->mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio reactor clear the latency histogram
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t gpio_reactor_clear_latency(gpio_reactor_t *reactor)
+{
+    pthread_mutex_lock(&reactor->mutex);
+    memset(&reactor->latency, 0, sizeof(gpio_latency_t));
+    pthread_mutex_unlock(&reactor->mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief     gpio reactor deinit
+ * @param[in] *reactor pointer to a gpio reactor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      the dispatch pthread is stopped and all the lines and timers are closed
+ */
+uint8_t gpio_reactor_deinit(gpio_reactor_t *reactor)
+{
+    uint8_t i;
+    
+    /* stop the reactor pthread */
+    if (reactor->running != 0)
+    {
+        if (pthread_cancel(reactor->pid) != 0)
+        {
+            perror("gpio: delete pthread failed.\n");
+            
+            return 1;
+        }
+        (void)pthread_join(reactor->pid, NULL);
+        reactor->running = 0;
+    }
+    
+    /* close all sources */
+    for (i = 0; i < reactor->num; i++)
+    {
+        if (reactor->source[i].type == GPIO_SOURCE_LINE)
+        {
+            gpiod_line_release(reactor->source[i].line);
+        }
+        else
+        {
+            close(reactor->source[i].fd);
+        }
+    }
+    reactor->num = 0;
+    
+    /* close the epoll and the gpio */
+    close(reactor->epfd);
+    gpiod_chip_close(reactor->chip);
+    (void)pthread_mutex_destroy(&reactor->mutex);
+    
+    return 0;
+}
@@ -363,3 +363,300 @@ uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, ui
      
     return 0;
 }
+
+/**
+ * @brief     iic bus batch transfer
+ * @param[in] fd iic handle
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message buffer
+ * @param[in] num number of the messages
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      addr = device_address_7bits << 1,
+ *            a read uses two iic messages and a write uses one, the messages are sent
+ *            with as few I2C_RDWR ioctls as IIC_RDWR_MAX_MSGS allows
+ */
+uint8_t iic_transfer(int fd, uint8_t addr, iic_msg_t *msg, uint8_t num)
+{
+    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
+    struct i2c_msg msgs[IIC_RDWR_MAX_MSGS];
+    uint8_t reg[IIC_RDWR_MAX_MSGS];
+    uint32_t size;
+    uint32_t offset;
+    uint8_t i;
+    uint8_t n;
+    
+    /* get the write buffer size */
+    size = 0;
+    for (i = 0; i < num; i++)
+    {
+        if (msg[i].write != 0)
+        {
+            size += msg[i].len + 1;
+        }
+    }
+    
+    {
+        uint8_t buf_send[size + 1];
+        
+        i = 0;
+        while (i < num)
+        {
+            /* clear ioctl data */
+            memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));
+            
+            /* clear msgs data */
+            memset(msgs, 0, sizeof(struct i2c_msg) * IIC_RDWR_MAX_MSGS);
+            
+            /* fill as many messages as one ioctl holds */
+            n = 0;
+            offset = 0;
+            while ((i < num) && (n + (msg[i].write != 0 ? 1 : 2) <= IIC_RDWR_MAX_MSGS))
+            {
+                if (msg[i].write != 0)
+                {
+                    msgs[n].addr = addr >> 1;
+                    msgs[n].flags = 0;
+                    buf_send[offset] = msg[i].reg;
+                    memcpy(&buf_send[offset + 1], msg[i].buf, msg[i].len);
+                    msgs[n].buf = &buf_send[offset];
+                    msgs[n].len = msg[i].len + 1;
+                    offset += msg[i].len + 1;
+                    n++;
+                }
+                else
+                {
+                    reg[n] = msg[i].reg;
+                    msgs[n].addr = addr >> 1;
+                    msgs[n].flags = 0;
+                    msgs[n].buf = &reg[n];
+                    msgs[n].len = 1;
+                    msgs[n + 1].addr = addr >> 1;
+                    msgs[n + 1].flags = I2C_M_RD;
+                    msgs[n + 1].buf = msg[i].buf;
+                    msgs[n + 1].len = msg[i].len;
+                    n += 2;
+                }
+                i++;
+            }
+            i2c_rdwr_data.msgs = msgs;
+            i2c_rdwr_data.nmsgs = n;
+            
+            /* transmit */
+            if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+            {
+                perror("iic: transfer failed.\n");
+                
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  iic async worker pthread
+ * @param  *p pointer to an iic async transfer structure
+ * @return NULL
+ * @note   one worker serves all the transfers of async
+ */
+static void *a_iic_async_pthread(void *p)
+{
+    iic_async_t *async = (iic_async_t *)p;
+    
+    while (1)
+    {
+        /* wait for a transfer */
+        pthread_mutex_lock(&async->mutex);
+        while ((async->pending == 0) && (async->stop == 0))
+        {
+            pthread_cond_wait(&async->cond, &async->mutex);
+        }
+        if (async->pending == 0)
+        {
+            pthread_mutex_unlock(&async->mutex);
+            
+            break;
+        }
+        async->pending = 0;
+        pthread_mutex_unlock(&async->mutex);
+        
+        /* run the transfer */
+        if (async->write != 0)
+        {
+            async->res = iic_write(async->fd, async->addr, async->reg, async->buf, async->len);
+        }
+        else
+        {
+            async->res = iic_read(async->fd, async->addr, async->reg, async->buf, async->len);
+        }
+        
+        /* publish the result */
+        __atomic_store_n(&async->done, 1, __ATOMIC_RELEASE);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     iic async submit
+ * @param[in] *async pointer to an iic async transfer structure
+ * @param[in] fd iic handle
+ * @param[in] write 1 for write and 0 for read
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      the worker pthread is created by the first submit
+ */
+static uint8_t a_iic_async_submit(iic_async_t *async, int fd, uint8_t write, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    /* check the last transfer */
+    if (iic_async_poll(async) == 2)
+    {
+        return 1;
+    }
+    
+    /* start the worker */
+    if (async->started == 0)
+    {
+        if (pthread_mutex_init(&async->mutex, NULL) != 0)
+        {
+            perror("iic: init mutex failed.\n");
+            
+            return 1;
+        }
+        if (pthread_cond_init(&async->cond, NULL) != 0)
+        {
+            perror("iic: init cond failed.\n");
+            (void)pthread_mutex_destroy(&async->mutex);
+            
+            return 1;
+        }
+        async->stop = 0;
+        async->pending = 0;
+        if (pthread_create(&async->pid, NULL, a_iic_async_pthread, async) != 0)
+        {
+            perror("iic: creat pthread failed.\n");
+            (void)pthread_cond_destroy(&async->cond);
+            (void)pthread_mutex_destroy(&async->mutex);
+            
+            return 1;
+        }
+        async->started = 1;
+    }
+    
+    /* hand the transfer to the worker */
+    pthread_mutex_lock(&async->mutex);
+    async->fd = fd;
+    async->write = write;
+    async->addr = addr;
+    async->reg = reg;
+    async->buf = buf;
+    async->len = len;
+    async->res = 1;
+    __atomic_store_n(&async->done, 0, __ATOMIC_RELAXED);
+    async->pending = 1;
+    async->busy = 1;
+    pthread_cond_signal(&async->cond);
+    pthread_mutex_unlock(&async->mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief     iic bus async read
+ * @param[in] *async pointer to an iic async transfer structure
+ * @param[in] fd iic handle
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      addr = device_address_7bits << 1,
+ *            the transfer runs on its own pthread and the buffer must be kept until iic_async_poll is not busy
+ */
+uint8_t iic_async_read(iic_async_t *async, int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return a_iic_async_submit(async, fd, 0, addr, reg, buf, len);
+}
+
+/**
+ * @brief     iic bus async write
+ * @param[in] *async pointer to an iic async transfer structure
+ * @param[in] fd iic handle
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      addr = device_address_7bits << 1,
+ *            the transfer runs on its own pthread and the buffer must be kept until iic_async_poll is not busy
+ */
+uint8_t iic_async_write(iic_async_t *async, int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return a_iic_async_submit(async, fd, 1, addr, reg, buf, len);
+}
+
+/**
+ * @brief     iic bus async poll
+ * @param[in] *async pointer to an iic async transfer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ *            - 2 busy
+ * @note      none
+ */
+uint8_t iic_async_poll(iic_async_t *async)
+{
+    /* check the transfer */
+    if (async->busy == 0)
+    {
+        return async->res != 0 ? 1 : 0;
+    }
+    if (__atomic_load_n(&async->done, __ATOMIC_ACQUIRE) == 0)
+    {
+        return 2;
+    }
+    async->busy = 0;
+    
+    return async->res != 0 ? 1 : 0;
+}
+
+/**
+ * @brief     iic bus async deinit
+ * @param[in] *async pointer to an iic async transfer structure
+ * @return    status code
+ *            - 0 success
+ * @note      the worker pthread finishes the submitted transfer and exits
+ */
+uint8_t iic_async_deinit(iic_async_t *async)
+{
+    /* check the worker */
+    if (async->started == 0)
+    {
+        return 0;
+    }
+    
+    /* stop the worker */
+    pthread_mutex_lock(&async->mutex);
+    async->stop = 1;
+    pthread_cond_signal(&async->cond);
+    pthread_mutex_unlock(&async->mutex);
+    (void)pthread_join(async->pid, NULL);
+    (void)pthread_cond_destroy(&async->cond);
+    (void)pthread_mutex_destroy(&async->mutex);
+    async->started = 0;
+    async->busy = 0;
+    
+    return 0;
+}
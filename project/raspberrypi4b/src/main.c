@@ -38,6 +38,7 @@
 #include "driver_apds9960_interrupt.h"
 #include "driver_apds9960_basic.h"
 #include "driver_apds9960_gesture_test.h"
+#include "driver_apds9960_decode_test.h"
 #include "driver_apds9960_interrupt_test.h"
 #include "driver_apds9960_read_test.h"
 #include "driver_apds9960_register_test.h"
@@ -45,16 +46,27 @@
 #include <getopt.h>
 #include <stdlib.h>
 
+/**
+ * @brief gpio interrupt line definition
+ */
+#define GPIO_INTERRUPT_LINE 17        /**< INT is connected to GPIO17(BCM) */
+
 uint8_t (*g_gpio_irq)(void) = NULL;        /**< gpio irq */
 static volatile uint8_t gs_flag;           /**< flag */
+static uint8_t gs_latency;                 /**< print the latency histogram */
+static uint8_t gs_reactor_enable;          /**< serve the INT line by a gpio reactor */
+static gpio_reactor_t gs_reactor;          /**< gpio reactor */
 
 /**
  * @brief     gesture callback
+ * @param[in] *user pointer to a user context
  * @param[in] type interrupt type
  * @note      none
  */
-static void a_gesture_callback(uint8_t type)
+static void a_gesture_callback(void *user, uint8_t type)
 {
+    (void)user;
+    
     switch (type)
     {
         case APDS9960_INTERRUPT_STATUS_GESTURE_LEFT :
@@ -158,11 +170,14 @@ static void a_gesture_callback(uint8_t type)
 
 /**
  * @brief     interrupt receive callback
+ * @param[in] *user pointer to a user context
  * @param[in] type interrupt type
  * @note      none
  */
-static void a_interrupt_callback(uint8_t type)
+static void a_interrupt_callback(void *user, uint8_t type)
 {
+    (void)user;
+    
     switch (type)
     {
         case APDS9960_INTERRUPT_STATUS_GESTURE_LEFT :
@@ -282,6 +297,121 @@ static void a_interrupt_callback(uint8_t type)
     }
 }
 
+/**
+ * @brief print the gpio interrupt latency histogram
+ * @note  none
+ */
+static void a_latency_print(void)
+{
+    uint8_t i;
+    gpio_latency_t latency;
+    
+    /* check the flag */
+    if (gs_latency == 0)
+    {
+        return;
+    }
+    
+    /* get the latency */
+    if (gs_reactor_enable != 0)
+    {
+        /* the reactor failed to start */
+        if (gs_reactor.running == 0)
+        {
+            return;
+        }
+        (void)gpio_reactor_get_latency(&gs_reactor, &latency);
+    }
+    else
+    {
+        (void)gpio_interrupt_get_latency(&latency);
+    }
+    apds9960_interface_debug_print("apds9960: irq latency count is %d.\n", latency.count);
+    if (latency.count == 0)
+    {
+        return;
+    }
+    apds9960_interface_debug_print("apds9960: irq latency mean is %dus.\n", (uint32_t)(latency.sum_ns / latency.count / 1000));
+    apds9960_interface_debug_print("apds9960: irq latency max is %dus.\n", (uint32_t)(latency.max_ns / 1000));
+    for (i = 0; i < GPIO_LATENCY_BUCKET; i++)
+    {
+        if (latency.bucket[i] == 0)
+        {
+            continue;
+        }
+        if (i == GPIO_LATENCY_BUCKET - 1)
+        {
+            apds9960_interface_debug_print("apds9960: irq latency >= %dus is %d.\n", 1U << (i - 1), latency.bucket[i]);
+        }
+        else
+        {
+            apds9960_interface_debug_print("apds9960: irq latency < %dus is %d.\n", 1U << i, latency.bucket[i]);
+        }
+    }
+}
+
+/**
+ * @brief     start serving the INT line
+ * @param[in] *irq pointer to an irq handler
+ * @param[in] *irq_timestamp pointer to a timestamped irq handler
+ * @param[in] *rt pointer to a gpio realtime structure
+ * @note      the reactor passes user to irq_timestamp, the examples and the tests keep their own
+ *            handle and iic bus so user is NULL, a failed start leaves the line unserved
+ */
+static void a_gpio_init(uint8_t (*irq)(void), uint8_t (*irq_timestamp)(void *user, uint64_t timestamp), const gpio_realtime_t *rt)
+{
+    /* serve the line by a reactor */
+    if (gs_reactor_enable != 0)
+    {
+        if (gpio_reactor_init(&gs_reactor) != 0)
+        {
+            return;
+        }
+        (void)gpio_reactor_set_realtime(&gs_reactor, rt);
+        if ((gpio_reactor_add_line(&gs_reactor, GPIO_INTERRUPT_LINE, irq_timestamp, NULL) != 0) ||
+            (gpio_reactor_start(&gs_reactor) != 0))
+        {
+            (void)gpio_reactor_deinit(&gs_reactor);
+        }
+        
+        return;
+    }
+    
+    /* set gpio irq */
+    g_gpio_irq = irq;
+    (void)gpio_interrupt_set_handler(irq_timestamp, NULL);
+    
+    /* gpio init */
+    if (gpio_interrupt_init() != 0)
+    {
+        g_gpio_irq = NULL;
+        (void)gpio_interrupt_set_handler(NULL, NULL);
+    }
+}
+
+/**
+ * @brief stop serving the INT line
+ * @note  none
+ */
+static void a_gpio_deinit(void)
+{
+    /* stop the reactor */
+    if (gs_reactor_enable != 0)
+    {
+        if (gs_reactor.running != 0)
+        {
+            (void)gpio_reactor_deinit(&gs_reactor);
+        }
+        
+        return;
+    }
+    
+    /* gpio deinit */
+    (void)gpio_interrupt_deinit();
+    g_gpio_irq = NULL;
+    (void)gpio_interrupt_set_handler(NULL, NULL);
+}
+
 /**
  * @brief     apds9960 full function
  * @param[in] argc arg numbers
@@ -309,14 +439,22 @@ uint8_t apds9960(uint8_t argc, char **argv)
         {"proximity-high-threshold", required_argument, NULL, 3},
         {"proximity-low-threshold", required_argument, NULL, 4},
         {"times", required_argument, NULL, 5},
+        {"rt-priority", required_argument, NULL, 6},
+        {"cpu", required_argument, NULL, 7},
+        {"mlock", no_argument, NULL, 8},
+        {"latency", no_argument, NULL, 9},
+        {"rate", required_argument, NULL, 10},
+        {"reactor", no_argument, NULL, 11},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
     uint32_t times = 3;
+    uint16_t rate = 1;
     uint16_t alow = 1;
     uint16_t ahigh = 1000;
     uint8_t plow = 1;
     uint8_t phigh = 128;
+    gpio_realtime_t rt = {0, -1, 0};
 
     /* if no params */
     if (argc == 1)
@@ -432,6 +570,60 @@ uint8_t apds9960(uint8_t argc, char **argv)
                 break;
             } 
             
+            /* realtime priority */
+            case 6 :
+            {
+                /* set the priority */
+                rt.priority = atoi(optarg);
+                
+                break;
+            }
+            
+            /* cpu affinity */
+            case 7 :
+            {
+                /* set the cpu */
+                rt.cpu = atoi(optarg);
+                
+                break;
+            }
+            
+            /* lock the memory */
+            case 8 :
+            {
+                /* set the lock */
+                rt.lock = 1;
+                
+                break;
+            }
+            
+            /* print the latency */
+            case 9 :
+            {
+                /* set the latency */
+                gs_latency = 1;
+                
+                break;
+            }
+            
+            /* sampling rate */
+            case 10 :
+            {
+                /* set the rate */
+                rate = atol(optarg);
+                
+                break;
+            }
+            
+            /* serve the INT line by a gpio reactor */
+            case 11 :
+            {
+                /* set the reactor */
+                gs_reactor_enable = 1;
+                
+                break;
+            }
+            
             /* the end */
             case -1 :
             {
@@ -445,6 +637,10 @@ uint8_t apds9960(uint8_t argc, char **argv)
             }
         }
     } while (c != -1);
+    
+    /* set the gpio realtime options */
+    (void)gpio_interrupt_set_realtime(&rt);
+    (void)gpio_interrupt_clear_latency();
 
     /* run the function */
     if (strcmp("t_reg", type) == 0)
@@ -471,55 +667,57 @@ uint8_t apds9960(uint8_t argc, char **argv)
             return 0;
         }
     }
-    else if (strcmp("t_int", type) == 0)
+    else if (strcmp("t_decode", type) == 0)
     {
-        /* set gpio irq */
-        g_gpio_irq = apds9960_interrupt_test_irq_handler;
-        
-        /* gpio init */
-        if (gpio_interrupt_init() != 0)
+        /* run decode test */
+        if (apds9960_decode_test(times) != 0)
         {
-            g_gpio_irq = NULL;
+            return 1;
+        }
+        else
+        {
+            return 0;
         }
+    }
+    else if (strcmp("t_int", type) == 0)
+    {
+        /* gpio init */
+        a_gpio_init(apds9960_interrupt_test_irq_handler, apds9960_interrupt_test_irq_handler_timestamp, &rt);
         
         /* run interrupt test */
         if (apds9960_interrupt_test(times, alow, ahigh, plow, phigh) != 0)
         {
-            (void)gpio_interrupt_deinit();
-            g_gpio_irq = NULL;
+            a_gpio_deinit();
             
             return 1;
         }
         
+        /* print the latency */
+        a_latency_print();
+        
         /* gpio deinit */
-        (void)gpio_interrupt_deinit();
-        g_gpio_irq = NULL;
+        a_gpio_deinit();
         
         return 0;
     }
     else if (strcmp("t_gesture", type) == 0)
     {
-        /* set gpio irq */
-        g_gpio_irq = apds9960_gesture_test_irq_handler;
-        
         /* gpio init */
-        if (gpio_interrupt_init() != 0)
-        {
-            g_gpio_irq = NULL;
-        }
+        a_gpio_init(apds9960_gesture_test_irq_handler, apds9960_gesture_test_irq_handler_timestamp, &rt);
         
         /* run gesture test */
         if (apds9960_gesture_test(times) != 0)
         {
-            (void)gpio_interrupt_deinit();
-            g_gpio_irq = NULL;
+            a_gpio_deinit();
             
             return 1;
         }
         
+        /* print the latency */
+        a_latency_print();
+        
         /* gpio deinit */
-        (void)gpio_interrupt_deinit();
-        g_gpio_irq = NULL;
+        a_gpio_deinit();
         
         return 0;
     }
@@ -527,6 +725,7 @@ uint8_t apds9960(uint8_t argc, char **argv)
     {
         uint8_t res;
         uint32_t i;
+        apds9960_periodic_t periodic;
         
         /* basic init */
         res = apds9960_basic_init();
@@ -535,8 +734,14 @@ uint8_t apds9960(uint8_t argc, char **argv)
             return 1;
         }
         
-        /* 1000 ms */
-        apds9960_interface_delay_ms(1000);
+        /* periodic init */
+        res = apds9960_basic_periodic_init(&periodic, rate);
+        if (res != 0)
+        {
+            (void)apds9960_basic_deinit();
+            
+            return 1;
+        }
         
         /* loop */
         for (i = 0; i < times; i++)
@@ -544,21 +749,14 @@ uint8_t apds9960(uint8_t argc, char **argv)
             uint8_t proximity;
             uint16_t red, green, blue, clear;
             
-            /* read rgbc */
-            res = apds9960_basic_read_rgbc((uint16_t *)&red, (uint16_t *)&green, (uint16_t *)&blue, (uint16_t *)&clear);
-            if (res != 0)
-            {
-                apds9960_interface_debug_print("apds9960: read rgbc failed.\n");
-                (void)apds9960_basic_deinit();
-                
-                return 1;
-            }
+            /* wait the deadline */
+            (void)apds9960_basic_periodic_wait(&periodic);
             
-            /* read proximity */
-            res = apds9960_basic_read_proximity((uint8_t *)&proximity);
+            /* read all */
+            res = apds9960_basic_read_all((uint16_t *)&red, (uint16_t *)&green, (uint16_t *)&blue, (uint16_t *)&clear, (uint8_t *)&proximity);
             if (res != 0)
             {
-                apds9960_interface_debug_print("apds9960: read proximity failed.\n");
+                apds9960_interface_debug_print("apds9960: read all failed.\n");
                 (void)apds9960_basic_deinit();
                 
                 return 1;
@@ -571,10 +769,8 @@ uint8_t apds9960(uint8_t argc, char **argv)
             apds9960_interface_debug_print("apds9960: blue is 0x%04X.\n", blue);
             apds9960_interface_debug_print("apds9960: clear is 0x%04X.\n", clear);
             apds9960_interface_debug_print("apds9960: proximity is 0x%02X.\n", proximity);
-            
-            /* 1000 ms */
-            apds9960_interface_delay_ms(1000);
         }
+        apds9960_interface_debug_print("apds9960: missed %d deadlines.\n", periodic.missed);
         
         /* deinit */
         (void)apds9960_basic_deinit();
@@ -586,21 +782,14 @@ uint8_t apds9960(uint8_t argc, char **argv)
         uint8_t res;
         uint32_t i;
         
-        /* set gpio irq */
-        g_gpio_irq = apds9960_gesture_irq_handler;
-        
         /* gpio init */
-        if (gpio_interrupt_init() != 0)
-        {
-            g_gpio_irq = NULL;
-        }
+        a_gpio_init(apds9960_gesture_irq_handler, apds9960_gesture_irq_handler_timestamp, &rt);
         
         /* gesture init */
         res = apds9960_gesture_init(a_gesture_callback);
         if (res != 0)
         {
-            (void)gpio_interrupt_deinit();
-            g_gpio_irq = NULL;
+            a_gpio_deinit();
             
             return 1;
         }
@@ -630,10 +819,12 @@ uint8_t apds9960(uint8_t argc, char **argv)
             }
         }
         
+        /* print the latency */
+        a_latency_print();
+        
         /* deinit */
         (void)apds9960_gesture_deinit();
-        (void)gpio_interrupt_deinit();
-        g_gpio_irq = NULL;
+        a_gpio_deinit();
         
         return 0;
     }
@@ -641,20 +832,13 @@ uint8_t apds9960(uint8_t argc, char **argv)
     {
         uint32_t i;
         
-        /* set gpio irq */
-        g_gpio_irq = apds9960_interrupt_irq_handler;
-        
         /* gpio init */
-        if (gpio_interrupt_init() != 0)
-        {
-            g_gpio_irq = NULL;
-        }
+        a_gpio_init(apds9960_interrupt_irq_handler, apds9960_interrupt_irq_handler_timestamp, &rt);
         
         /* run interrupt function */
         if (apds9960_interrupt_init(a_interrupt_callback, alow, ahigh, plow, phigh) != 0)
         {
-            (void)gpio_interrupt_deinit();
-            g_gpio_irq = NULL;
+            a_gpio_deinit();
             
             return 1;
         }
@@ -684,10 +868,12 @@ uint8_t apds9960(uint8_t argc, char **argv)
             }
         }
         
+        /* print the latency */
+        a_latency_print();
+        
         /* deinit */
         (void)apds9960_interrupt_deinit();
-        (void)gpio_interrupt_deinit();
-        g_gpio_irq = NULL;
+        a_gpio_deinit();
         
         return 0;
     }
@@ -702,23 +888,34 @@ uint8_t apds9960(uint8_t argc, char **argv)
         apds9960_interface_debug_print("  apds9960 (-t read | --test=read) [--times=<num>]\n");
         apds9960_interface_debug_print("  apds9960 (-t int | --test=int) [--times=<num>] [--als-high-threshold=<ahigh>] [--als-low-threshold=<alow>]\n");
         apds9960_interface_debug_print("           [--proximity-high-threshold=<phigh>] [--proximity-low-threshold=<plow>]\n");
+        apds9960_interface_debug_print("           [--rt-priority=<prio>] [--cpu=<cpu>] [--mlock] [--latency] [--reactor]\n");
         apds9960_interface_debug_print("  apds9960 (-t gesture | --test=gesture) [--times=<num>]\n");
-        apds9960_interface_debug_print("  apds9960 (-e read | --example=read) [--times=<num>]\n");
+        apds9960_interface_debug_print("           [--rt-priority=<prio>] [--cpu=<cpu>] [--mlock] [--latency] [--reactor]\n");
+        apds9960_interface_debug_print("  apds9960 (-t decode | --test=decode) [--times=<num>]\n");
+        apds9960_interface_debug_print("  apds9960 (-e read | --example=read) [--times=<num>] [--rate=<hz>]\n");
         apds9960_interface_debug_print("  apds9960 (-e int | --example=int) [--times=<num>] [--als-high-threshold=<ahigh>] [--als-low-threshold=<alow>]\n");
         apds9960_interface_debug_print("           [--proximity-high-threshold=<phigh>] [--proximity-low-threshold=<plow>]\n");
+        apds9960_interface_debug_print("           [--rt-priority=<prio>] [--cpu=<cpu>] [--mlock] [--latency] [--reactor]\n");
         apds9960_interface_debug_print("  apds9960 (-e gesture | --example=gesture)  [--times=<num>]\n");
+        apds9960_interface_debug_print("           [--rt-priority=<prio>] [--cpu=<cpu>] [--mlock] [--latency] [--reactor]\n");
         apds9960_interface_debug_print("\n");
         apds9960_interface_debug_print("Options:\n");
         apds9960_interface_debug_print("      --als-high-threshold=<ahigh>          Set the als interrupt high threshold.([default: 1000])\n");
         apds9960_interface_debug_print("      --als-low-threshold=<alow>            Set the als interrupt low threshold.([default: 1])\n");
+        apds9960_interface_debug_print("      --cpu=<cpu>                           Pin the interrupt thread to the cpu.([default: none])\n");
         apds9960_interface_debug_print("  -e <read | int | gesture>, --example=<read | int | gesture>\n");
         apds9960_interface_debug_print("                                            Run the driver example.\n");
         apds9960_interface_debug_print("  -h, --help                                Show the help.\n");
         apds9960_interface_debug_print("  -i, --information                         Show the chip information.\n");
+        apds9960_interface_debug_print("      --latency                             Print the interrupt latency histogram.\n");
+        apds9960_interface_debug_print("      --mlock                               Lock the process memory.\n");
         apds9960_interface_debug_print("  -p, --port                                Display the pin connections of the current board.\n");
         apds9960_interface_debug_print("      --proximity-high-threshold=<phigh>    Set the proximity high threshold.([default: 128])\n");
         apds9960_interface_debug_print("      --proximity-low-threshold=<plow>      Set the proximity low threshold.([default: 1])\n");
-        apds9960_interface_debug_print("  -t <reg | read | int | gesture>, --test=<reg | read | int | gesture>\n");
+        apds9960_interface_debug_print("      --rate=<hz>                           Set the sampling rate of the read example.([default: 1])\n");
+        apds9960_interface_debug_print("      --reactor                             Serve the interrupt line by a gpio reactor.\n");
+        apds9960_interface_debug_print("      --rt-priority=<prio>                  Run the interrupt thread with SCHED_FIFO priority.([default: 0])\n");
+        apds9960_interface_debug_print("  -t <reg | read | int | gesture | decode>, --test=<reg | read | int | gesture | decode>\n");
         apds9960_interface_debug_print("                                            Run the driver test.\n");
         apds9960_interface_debug_print("      --times=<num>                         Set the running times.([default: 3])\n");
         
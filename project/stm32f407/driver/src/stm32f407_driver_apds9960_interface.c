@@ -41,31 +41,39 @@
 #include <stdarg.h>
 
 /**
- * @brief  interface iic bus init
- * @return status code
- *         - 0 success
- *         - 1 iic init failed
- * @note   none
+ * @brief async transfer result definition
  */
-uint8_t apds9960_interface_iic_init(void)
+static uint8_t gs_res;        /**< result of the last submitted transfer */
+
+/**
+ * @brief     interface iic bus init
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+uint8_t apds9960_interface_iic_init(void *user)
 {
     return iic_init();
 }
 
 /**
- * @brief  interface iic bus deinit
- * @return status code
- *         - 0 success
- *         - 1 iic deinit failed
- * @note   none
+ * @brief     interface iic bus deinit
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
  */
-uint8_t apds9960_interface_iic_deinit(void)
+uint8_t apds9960_interface_iic_deinit(void *user)
 {
     return iic_deinit();
 }
 
 /**
  * @brief      interface iic bus read
+ * @param[in]  *user pointer to a user context
  * @param[in]  addr iic device write address
  * @param[in]  reg iic register address
  * @param[out] *buf pointer to a data buffer
@@ -75,13 +83,14 @@ uint8_t apds9960_interface_iic_deinit(void)
  *             - 1 read failed
  * @note       none
  */
-uint8_t apds9960_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+uint8_t apds9960_interface_iic_read(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
 {
     return iic_read(addr, reg, buf, len);
 }
 
 /**
  * @brief     interface iic bus write
+ * @param[in] *user pointer to a user context
  * @param[in] addr iic device write address
  * @param[in] reg iic register address
  * @param[in] *buf pointer to a data buffer
@@ -91,11 +100,98 @@ uint8_t apds9960_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uin
  *            - 1 write failed
  * @note      none
  */
-uint8_t apds9960_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+uint8_t apds9960_interface_iic_write(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
 {
     return iic_write(addr, reg, buf, len);
 }
 
+/**
+ * @brief     interface iic bus async read submit
+ * @param[in] *user pointer to a user context
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      the blocking transfer is run in the submit and its result is reported by the poll
+ */
+uint8_t apds9960_interface_iic_read_submit(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_res = iic_read(addr, reg, buf, len);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus async write submit
+ * @param[in] *user pointer to a user context
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      the blocking transfer is run in the submit and its result is reported by the poll
+ */
+uint8_t apds9960_interface_iic_write_submit(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_res = iic_write(addr, reg, buf, len);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus async poll
+ * @param[in] *user pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ *            - 2 busy
+ * @note      none
+ */
+uint8_t apds9960_interface_iic_poll(void *user)
+{
+    return gs_res;
+}
+
+/**
+ * @brief     interface iic bus batch transfer
+ * @param[in] *user pointer to a user context
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message buffer
+ * @param[in] num number of the messages
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the hal has no multi-message transfer, so the messages are run one by one
+ */
+uint8_t apds9960_interface_iic_transfer(void *user, uint8_t addr, apds9960_iic_msg_t *msg, uint8_t num)
+{
+    uint8_t i;
+    uint8_t res;
+    
+    for (i = 0; i < num; i++)
+    {
+        if (msg[i].write != 0)
+        {
+            res = iic_write(addr, msg[i].reg, msg[i].buf, msg[i].len);
+        }
+        else
+        {
+            res = iic_read(addr, msg[i].reg, msg[i].buf, msg[i].len);
+        }
+        if (res != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -106,6 +202,50 @@ void apds9960_interface_delay_ms(uint32_t ms)
     delay_ms(ms);
 }
 
+/**
+ * @brief  interface timestamp ns
+ * @return monotonic timestamp in ns
+ * @note   none
+ */
+uint64_t apds9960_interface_timestamp_ns(void)
+{
+    return (uint64_t)HAL_GetTick() * 1000000ULL;
+}
+
+/**
+ * @brief  interface cycle count
+ * @return free running cpu cycle counter
+ * @note   the dwt cycle counter is started by the first call
+ */
+uint32_t apds9960_interface_cycle_count(void)
+{
+    /* start the dwt cycle counter */
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0)
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief     interface delay until an absolute time
+ * @param[in] ns absolute timestamp_ns time
+ * @note      none
+ */
+void apds9960_interface_delay_until_ns(uint64_t ns)
+{
+    uint64_t now;
+    
+    now = apds9960_interface_timestamp_ns();
+    if (ns > now)
+    {
+        delay_ms((uint32_t)((ns - now + 999999ULL) / 1000000ULL));
+    }
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -128,11 +268,14 @@ void apds9960_interface_debug_print(const char *const fmt, ...)
 
 /**
  * @brief     interface receive callback
+ * @param[in] *user pointer to a user context
  * @param[in] type interrupt type
  * @note      none
  */
-void apds9960_interface_receive_callback(uint8_t type)
+void apds9960_interface_receive_callback(void *user, uint8_t type)
 {
+    (void)user;
+    
     switch (type)
     {
         case APDS9960_INTERRUPT_STATUS_GESTURE_LEFT :
@@ -38,6 +38,7 @@
 #include "driver_apds9960_interrupt.h"
 #include "driver_apds9960_basic.h"
 #include "driver_apds9960_gesture_test.h"
+#include "driver_apds9960_decode_test.h"
 #include "driver_apds9960_interrupt_test.h"
 #include "driver_apds9960_read_test.h"
 #include "driver_apds9960_register_test.h"
@@ -84,11 +85,14 @@ void HAL_GPIO_EXTI_Callback(uint16_t pin)
 
 /**
  * @brief     gesture callback
+ * @param[in] *user pointer to a user context
  * @param[in] type interrupt type
  * @note      none
  */
-static void a_gesture_callback(uint8_t type)
+static void a_gesture_callback(void *user, uint8_t type)
 {
+    (void)user;
+    
     switch (type)
     {
         case APDS9960_INTERRUPT_STATUS_GESTURE_LEFT :
@@ -194,11 +198,14 @@ static void a_gesture_callback(uint8_t type)
 
 /**
  * @brief     interrupt receive callback
+ * @param[in] *user pointer to a user context
  * @param[in] type interrupt type
  * @note      none
  */
-static void a_interrupt_callback(uint8_t type)
+static void a_interrupt_callback(void *user, uint8_t type)
 {
+    (void)user;
+    
     switch (type)
     {
         case APDS9960_INTERRUPT_STATUS_GESTURE_LEFT :
@@ -509,6 +516,18 @@ uint8_t apds9960(uint8_t argc, char **argv)
             return 0;
         }
     }
+    else if (strcmp("t_decode", type) == 0)
+    {
+        /* run decode test */
+        if (apds9960_decode_test(times) != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
     else if (strcmp("t_int", type) == 0)
     {
         /* set gpio irq */
@@ -582,21 +601,11 @@ uint8_t apds9960(uint8_t argc, char **argv)
             uint8_t proximity;
             uint16_t red, green, blue, clear;
             
-            /* read rgbc */
-            res = apds9960_basic_read_rgbc((uint16_t *)&red, (uint16_t *)&green, (uint16_t *)&blue, (uint16_t *)&clear);
+            /* read all */
+            res = apds9960_basic_read_all((uint16_t *)&red, (uint16_t *)&green, (uint16_t *)&blue, (uint16_t *)&clear, (uint8_t *)&proximity);
             if (res != 0)
             {
-                apds9960_interface_debug_print("apds9960: read rgbc failed.\n");
-                (void)apds9960_basic_deinit();
-                
-                return 1;
-            }
-            
-            /* read proximity */
-            res = apds9960_basic_read_proximity((uint8_t *)&proximity);
-            if (res != 0)
-            {
-                apds9960_interface_debug_print("apds9960: read proximity failed.\n");
+                apds9960_interface_debug_print("apds9960: read all failed.\n");
                 (void)apds9960_basic_deinit();
                 
                 return 1;
@@ -741,6 +750,7 @@ uint8_t apds9960(uint8_t argc, char **argv)
         apds9960_interface_debug_print("  apds9960 (-t int | --test=int) [--times=<num>] [--als-high-threshold=<ahigh>] [--als-low-threshold=<alow>]\n");
         apds9960_interface_debug_print("           [--proximity-high-threshold=<phigh>] [--proximity-low-threshold=<plow>]\n");
         apds9960_interface_debug_print("  apds9960 (-t gesture | --test=gesture) [--times=<num>]\n");
+        apds9960_interface_debug_print("  apds9960 (-t decode | --test=decode) [--times=<num>]\n");
         apds9960_interface_debug_print("  apds9960 (-e read | --example=read) [--times=<num>]\n");
         apds9960_interface_debug_print("  apds9960 (-e int | --example=int) [--times=<num>] [--als-high-threshold=<ahigh>] [--als-low-threshold=<alow>]\n");
         apds9960_interface_debug_print("           [--proximity-high-threshold=<phigh>] [--proximity-low-threshold=<plow>]\n");
@@ -756,7 +766,7 @@ uint8_t apds9960(uint8_t argc, char **argv)
         apds9960_interface_debug_print("  -p, --port                                Display the pin connections of the current board.\n");
         apds9960_interface_debug_print("      --proximity-high-threshold=<phigh>    Set the proximity high threshold.([default: 128])\n");
         apds9960_interface_debug_print("      --proximity-low-threshold=<plow>      Set the proximity low threshold.([default: 1])\n");
-        apds9960_interface_debug_print("  -t <reg | read | int | gesture>, --test=<reg | read | int | gesture>\n");
+        apds9960_interface_debug_print("  -t <reg | read | int | gesture | decode>, --test=<reg | read | int | gesture | decode>\n");
         apds9960_interface_debug_print("                                            Run the driver test.\n");
         apds9960_interface_debug_print("      --times=<num>                         Set the running times.([default: 3])\n");
         
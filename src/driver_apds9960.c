@@ -37,6 +37,14 @@
 #include "driver_apds9960.h"
 #include <stdlib.h>
 
+#if (APDS9960_GESTURE_SIMD != 0) && (defined(__SSE2__) || defined(_M_X64))
+    #include <emmintrin.h>
+    #define APDS9960_GESTURE_SCAN_SSE2        /**< sse2 threshold scan */
+#elif (APDS9960_GESTURE_SIMD != 0) && defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define APDS9960_GESTURE_SCAN_NEON        /**< neon threshold scan */
+#endif
+
 /**
  * @brief chip information definition
  */
@@ -107,6 +115,209 @@
 #define APDS9960_REG_GFIFO_L        0xFE        /**< gesture fifo LEFT value register */
 #define APDS9960_REG_GFIFO_R        0xFF        /**< gesture fifo RIGHT value register */
 
+/**
+ * @brief register cache range definition
+ */
+#define APDS9960_CACHE_BASE         0x80        /**< first register of the cache */
+
+/**
+ * @brief state machine timing definition
+ */
+#define APDS9960_STEP_US            2780        /**< als integration and wait step */
+#define APDS9960_PULSE_SETUP_US     700         /**< estimated proximity or gesture state overhead */
+#define APDS9960_SAMPLE_POLL_US     250         /**< min delay between two status reads of an early prediction */
+#define APDS9960_SAMPLE_PROBE       32          /**< samples between two phase measurements */
+#define APDS9960_WAIT_SPIN_US       1000        /**< status is polled without sleep this close to the expected data */
+
+/**
+ * @brief gesture stream state definition
+ */
+#define APDS9960_GESTURE_STREAM_IDLE       0        /**< no dataset above the threshold */
+#define APDS9960_GESTURE_STREAM_TRACK      1        /**< gesture is tracked */
+#define APDS9960_GESTURE_STREAM_EMITTED    2        /**< early direction is reported, wait for the exit */
+
+/**
+ * @brief gesture ratio kernel definition
+ */
+#define APDS9960_GESTURE_RATIO_SHIFT       25       /**< 100 * 2^25 fits in 32 bits and 100 * 510 * 510 < 2^25 keeps the quotient exact */
+
+/**
+ * @brief register image burst definition
+ */
+#define APDS9960_IMAGE_BURST_GAP    2           /**< max unchanged registers merged into one burst */
+
+/**
+ * @brief event ring index access definition
+ */
+#if defined(__GNUC__)
+    #define APDS9960_RING_LOAD_ACQUIRE(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)            /**< load with acquire order */
+    #define APDS9960_RING_STORE_RELEASE(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)      /**< store with release order */
+#else
+    #define APDS9960_RING_LOAD_ACQUIRE(p)        (*(p))                                            /**< single core volatile load */
+    #define APDS9960_RING_STORE_RELEASE(p, v)    (*(p) = (v))                                      /**< single core volatile store */
+#endif
+#if (APDS9960_EVENT_RING_SIZE & (APDS9960_EVENT_RING_SIZE - 1)) != 0
+    #error "APDS9960_EVENT_RING_SIZE must be a power of 2"
+#endif
+
+/**
+ * @brief async operation step definition
+ */
+#define APDS9960_ASYNC_STEP_START             0         /**< submit the first transfer */
+#define APDS9960_ASYNC_STEP_DATA              1         /**< status and data are read */
+#define APDS9960_ASYNC_STEP_FIFO_LEVEL        2         /**< read the gesture fifo level */
+#define APDS9960_ASYNC_STEP_FIFO_READ         3         /**< gesture fifo level is read */
+#define APDS9960_ASYNC_STEP_FIFO_DATA         4         /**< gesture fifo data is read */
+#define APDS9960_ASYNC_STEP_CLEAR             5         /**< clear the non-gesture interrupts */
+#define APDS9960_ASYNC_STEP_FIFO_CLEAR        6         /**< clear the gesture fifo */
+#define APDS9960_ASYNC_STEP_GCONF4_READ       7         /**< gesture conf 4 is read */
+#define APDS9960_ASYNC_STEP_GCONF4_WRITE      8         /**< gesture conf 4 is written */
+#define APDS9960_ASYNC_STEP_GESTURE           9         /**< report the decoded gesture */
+#define APDS9960_ASYNC_STEP_CONFIG_READ       10        /**< read the poffset_ur - gconf4 registers */
+#define APDS9960_ASYNC_STEP_CONFIG_WRITE      11        /**< write the packed atime - config2 registers */
+#define APDS9960_ASYNC_STEP_CONFIG_GESTURE    12        /**< write the packed poffset_ur - gconf4 registers */
+#define APDS9960_ASYNC_STEP_CONFIG_ENABLE     13        /**< write the enable register */
+#define APDS9960_ASYNC_STEP_FINISH            14        /**< operation is done */
+
+/**
+ * @brief     check whether a register is held in the cache
+ * @param[in] reg iic register address
+ * @return    status code
+ *            - 0 not cached
+ *            - 1 cached
+ * @note      status, data, id and gesture configuration four registers are changed by the chip itself,
+ *            so they are never cached
+ */
+static uint8_t a_apds9960_cache_able(uint16_t reg)
+{
+    if ((reg >= APDS9960_REG_ENABLE) && (reg <= APDS9960_REG_CONFIG2))         /* enable - config2 */
+    {
+        return 1;                                                              /* cached */
+    }
+    else if ((reg >= APDS9960_REG_POFFSET_UR) && (reg <= APDS9960_REG_GCONF3)) /* poffset_ur - gconf3 */
+    {
+        return 1;                                                              /* cached */
+    }
+    else
+    {
+        return 0;                                                              /* not cached */
+    }
+}
+
+/**
+ * @brief     check whether a register of the image can be written
+ * @param[in] reg iic register address
+ * @return    status code
+ *            - 0 reserved
+ *            - 1 writable
+ * @note      the reserved registers inside atime - config2 and poffset_ur - gconf4 are never written
+ */
+static uint8_t a_apds9960_image_writable(uint16_t reg)
+{
+    if ((reg == 0x82) || (reg == 0x88) || (reg == 0x8A) || (reg == 0xA8))     /* reserved */
+    {
+        return 0;                                                              /* reserved */
+    }
+    else
+    {
+        return 1;                                                              /* writable */
+    }
+}
+
+/**
+ * @brief     update the cache after a transfer
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] reg iic register address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @param[in] valid 1 if the transfer succeeded, 0 if the registers are unknown
+ * @note      none
+ */
+static void a_apds9960_cache_update(apds9960_handle_t *handle, uint8_t reg, uint8_t *data, uint16_t len, uint8_t valid)
+{
+    uint16_t i;
+    uint16_t addr;
+    
+    if (handle->cache_enable == 0)                                                      /* check the cache */
+    {
+        return;                                                                         /* no cache */
+    }
+    for (i = 0; i < len; i++)                                                           /* update all registers */
+    {
+        addr = (uint16_t)(reg + i);                                                     /* get the address */
+        if (a_apds9960_cache_able(addr) != 0)                                           /* check the address */
+        {
+            if (valid != 0)                                                             /* check the result */
+            {
+                handle->cache[addr - APDS9960_CACHE_BASE] = data[i];                    /* save to the cache */
+                handle->cache_valid |= (uint64_t)1 << (addr - APDS9960_CACHE_BASE);     /* set valid */
+            }
+            else
+            {
+                handle->cache_valid &= ~((uint64_t)1 << (addr - APDS9960_CACHE_BASE));  /* register is unknown */
+            }
+        }
+    }
+}
+
+/**
+ * @brief     drop the timing derived from written registers
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] reg iic register address
+ * @param[in] len data length
+ * @note      a write of enable - config2 changes the cycle, so the sample and wait phases are measured again
+ */
+static void a_apds9960_timing_update(apds9960_handle_t *handle, uint8_t reg, uint16_t len)
+{
+    if ((reg <= APDS9960_REG_GPULSE) && ((uint16_t)reg + len > APDS9960_REG_GCONF1))      /* check the gesture timing registers */
+    {
+        handle->gesture_period_ns = 0;                                                  /* read the gesture period again */
+    }
+    if ((reg <= APDS9960_REG_CONFIG2) && ((uint16_t)reg + len > APDS9960_REG_ENABLE))     /* check the cycle registers */
+    {
+        handle->sample_ns = 0;                                                          /* synchronize the samples again */
+        handle->wait_als_ns = 0;                                                        /* als phase is unknown */
+        handle->wait_proximity_ns = 0;                                                  /* proximity phase is unknown */
+    }
+}
+
+/**
+ * @brief      read bytes from the cache
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  reg iic register address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 not cached
+ *             - 1 read from the cache
+ * @note       none
+ */
+static uint8_t a_apds9960_cache_read(apds9960_handle_t *handle, uint8_t reg, uint8_t *data, uint16_t len)
+{
+    uint16_t i;
+    uint16_t addr;
+    
+    if (handle->cache_enable == 0)                                                      /* check the cache */
+    {
+        return 0;                                                                       /* no cache */
+    }
+    for (i = 0; i < len; i++)                                                           /* check all registers */
+    {
+        addr = (uint16_t)(reg + i);                                                     /* get the address */
+        if ((a_apds9960_cache_able(addr) == 0) ||
+            (((handle->cache_valid >> (addr - APDS9960_CACHE_BASE)) & 0x01) == 0))      /* check the cache valid */
+        {
+            return 0;                                                                   /* not cached */
+        }
+    }
+    for (i = 0; i < len; i++)                                                           /* copy all registers */
+    {
+        data[i] = handle->cache[reg + i - APDS9960_CACHE_BASE];                         /* copy from the cache */
+    }
+    
+    return 1;                                                                           /* read from the cache */
+}
+
 /**
  * @brief      read bytes
  * @param[in]  *handle pointer to an apds9960 handle structure
@@ -120,14 +331,17 @@
  */
 static uint8_t a_apds9960_iic_read(apds9960_handle_t *handle, uint8_t reg, uint8_t *data, uint16_t len)
 {
-    if (handle->iic_read(APDS9960_ADDRESS, reg, data, len) != 0)        /* read the register */
+    if (a_apds9960_cache_read(handle, reg, data, len) != 0)                             /* check the cache */
     {
-        return 1;                                                       /* return error */
+        return 0;                                                                       /* success return 0 */
     }
-    else
+    if (handle->iic_read(handle->user, APDS9960_ADDRESS, reg, data, len) != 0)          /* read the register */
     {
-        return 0;                                                       /* success return 0 */
+        return 1;                                                                       /* return error */
     }
+    a_apds9960_cache_update(handle, reg, data, len, 1);                                 /* update the cache */
+    
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
@@ -143,14 +357,338 @@ static uint8_t a_apds9960_iic_read(apds9960_handle_t *handle, uint8_t reg, uint8
  */
 static uint8_t a_apds9960_iic_write(apds9960_handle_t *handle, uint8_t reg, uint8_t *data, uint16_t len)
 {
-    if (handle->iic_write(APDS9960_ADDRESS, reg, data, len) != 0)        /* write the register */
+    uint8_t res;
+    
+    res = handle->iic_write(handle->user, APDS9960_ADDRESS, reg, data, len);            /* write the register */
+    a_apds9960_cache_update(handle, reg, data, len, (uint8_t)(res == 0));               /* update the cache */
+    a_apds9960_timing_update(handle, reg, len);                                         /* update the timing */
+    if (res != 0)                                                                       /* check the result */
+    {
+        return 1;                                                                       /* return error */
+    }
+    else
+    {
+        return 0;                                                                       /* success return 0 */
+    }
+}
+
+/**
+ * @brief     run a batch of transfers
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *msg pointer to a message buffer
+ * @param[in] num number of the messages
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed or too many messages
+ * @note      cached reads are served locally and the rest is sent in one iic_transfer call,
+ *            without iic_transfer the messages are run one by one in order
+ */
+static uint8_t a_apds9960_iic_transfer(apds9960_handle_t *handle, apds9960_iic_msg_t *msg, uint8_t num)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t n;
+    apds9960_iic_msg_t bus[APDS9960_IIC_BATCH_MAX];
+    
+    if (num > APDS9960_IIC_BATCH_MAX)                                                   /* check the number */
+    {
+        return 1;                                                                       /* return error */
+    }
+    if (handle->iic_transfer == NULL)                                                   /* check the iic_transfer */
+    {
+        for (i = 0; i < num; i++)                                                       /* run all messages */
+        {
+            if (msg[i].write != 0)                                                      /* write */
+            {
+                res = a_apds9960_iic_write(handle, msg[i].reg, msg[i].buf, msg[i].len); /* write the register */
+            }
+            else                                                                        /* read */
+            {
+                res = a_apds9960_iic_read(handle, msg[i].reg, msg[i].buf, msg[i].len);  /* read the register */
+            }
+            if (res != 0)                                                               /* check the result */
+            {
+                return 1;                                                               /* return error */
+            }
+        }
+        
+        return 0;                                                                       /* success return 0 */
+    }
+    
+    n = 0;                                                                              /* init 0 */
+    for (i = 0; i < num; i++)                                                           /* find all bus messages */
+    {
+        if ((msg[i].write == 0) && 
+            (a_apds9960_cache_read(handle, msg[i].reg, msg[i].buf, msg[i].len) != 0))   /* read from the cache */
+        {
+            continue;                                                                   /* next */
+        }
+        bus[n] = msg[i];                                                                /* add to the batch */
+        n++;                                                                            /* n++ */
+    }
+    if (n == 0)                                                                         /* all from the cache */
+    {
+        return 0;                                                                       /* success return 0 */
+    }
+    res = handle->iic_transfer(handle->user, APDS9960_ADDRESS, bus, n);                 /* run the batch */
+    for (i = 0; i < n; i++)                                                             /* update the cache */
+    {
+        if ((bus[i].write != 0) || (res == 0))                                          /* failed reads keep the cache */
+        {
+            a_apds9960_cache_update(handle, bus[i].reg, bus[i].buf, bus[i].len, (uint8_t)(res == 0));    /* update the cache */
+        }
+        if (bus[i].write != 0)                                                          /* check the write */
+        {
+            a_apds9960_timing_update(handle, bus[i].reg, bus[i].len);                   /* update the timing */
+        }
+    }
+    if (res != 0)                                                                       /* check the result */
+    {
+        return 1;                                                                       /* return error */
+    }
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     read the gesture dataset period
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      one dataset is one gesture pass of the pulses and the gesture wait time
+ */
+static uint8_t a_apds9960_gesture_period(apds9960_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t buf[5];
+    const uint16_t gwtime[8] = {0, 2800, 5600, 8400, 14000, 22400, 30800, 39200};
+    const uint8_t gfifoth[4] = {1, 4, 8, 16};
+    
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF1, (uint8_t *)buf, 5);          /* read gconf1 - gpulse register */
+    if (res != 0)                                                                       /* check result */
+    {
+        handle->debug_print("apds9960: read gesture config failed.\n");                /* read gesture config failed */
+        
+        return 1;                                                                       /* return error */
+    }
+    handle->gesture_fifo_threshold = gfifoth[(buf[0] >> 6) & 0x3];                      /* set the fifo threshold */
+    handle->gesture_period_ns = (APDS9960_PULSE_SETUP_US + 
+                                 (uint32_t)((buf[4] & 0x3F) + 1) * (8U << ((buf[4] >> 6) & 0x3)) + 
+                                 gwtime[buf[1] & 0x07]) * 1000;                         /* pulse period is twice the pulse length */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     estimate the capture time of the first dataset in the gesture fifo
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] level gesture fifo level
+ * @param[in] now time the level was read in ns, 0 when unknown
+ * @note      after an interrupt edge the fifo held gesture_fifo_threshold datasets with the
+ *            newest one captured at the edge, otherwise the newest one is half a period
+ *            older than the level read, the result is never later than now, the edge is used once
+ */
+static void a_apds9960_gesture_fifo_time(apds9960_handle_t *handle, uint8_t level, uint64_t now)
+{
+    uint64_t back;
+    uint64_t first;
+    uint64_t period;
+    
+    handle->gesture_fifo_ns = 0;                                                        /* unknown */
+    period = handle->gesture_period_ns;                                                 /* get the period */
+    if ((level == 0) || (period == 0))                                                  /* check the level and period */
+    {
+        return;                                                                         /* return */
+    }
+    if ((handle->gesture_edge_ns != 0) && (level >= handle->gesture_fifo_threshold))    /* check the edge */
+    {
+        back = (uint64_t)(handle->gesture_fifo_threshold - 1) * period;                 /* datasets before the edge */
+        first = handle->gesture_edge_ns;                                                /* newest at the edge */
+        handle->gesture_edge_ns = 0;                                                    /* only the first read follows the edge */
+    }
+    else if (now != 0)                                                                  /* check the time */
+    {
+        back = (uint64_t)(level - 1) * period + period / 2;                             /* datasets before the level read */
+        first = now;                                                                    /* newest half a period ago */
+    }
+    else
+    {
+        return;                                                                         /* return */
+    }
+    if (first <= back)                                                                  /* check the range */
+    {
+        return;                                                                         /* return */
+    }
+    first -= back;                                                                      /* capture time of the first dataset */
+    back = (uint64_t)(level - 1) * period;                                              /* first to newest */
+    if ((now != 0) && (first + back > now))                                             /* never in the future */
+    {
+        if (now <= back)                                                                /* check the range */
+        {
+            return;                                                                     /* return */
+        }
+        first = now - back;                                                             /* newest at now */
+    }
+    handle->gesture_fifo_ns = first;                                                    /* save the time */
+}
+
+/**
+ * @brief     estimate the capture time of the gesture fifo data with a blocking read of the period
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] level gesture fifo level
+ * @note      the period is only read after a gesture timing register was written
+ */
+static void a_apds9960_gesture_fifo_stamp(apds9960_handle_t *handle, uint8_t level)
+{
+    uint64_t now;
+    
+    now = (handle->timestamp_ns != NULL) ? handle->timestamp_ns() : 0;                 /* time of the level read */
+    if (handle->gesture_period_ns == 0)                                                 /* check the period */
+    {
+        if (a_apds9960_gesture_period(handle) != 0)                                     /* read the period */
+        {
+            handle->gesture_fifo_ns = 0;                                                /* unknown */
+            
+            return;                                                                     /* return */
+        }
+    }
+    a_apds9960_gesture_fifo_time(handle, level, now);                                   /* estimate the time */
+}
+
+/**
+ * @brief     encode the offset to the register raw data
+ * @param[in] offset signed offset
+ * @return    register raw data
+ * @note      none
+ */
+static uint8_t a_apds9960_offset_encode(int8_t offset)
+{
+    uint8_t prev;
+    
+    if (offset >= 0)                  /* if >= 0 */
     {
-        return 1;                                                        /* return error */
+        prev = offset;                /* set the positive */
     }
     else
     {
-        return 0;                                                        /* success return 0 */
+        prev = 0x80;                  /* set the 0x80 */
+        prev |= (-offset);            /* set the negative */
+    }
+    
+    return prev;                      /* return the raw data */
+}
+
+/**
+ * @brief     check the configuration
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *config pointer to a configuration structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 config is invalid
+ * @note      none
+ */
+static uint8_t a_apds9960_config_check(apds9960_handle_t *handle, const apds9960_config_t *config)
+{
+    if (config->proximity_pulse_count > 0x3F)                                         /* check proximity pulse count */
+    {
+        handle->debug_print("apds9960: proximity pulse count is over 63.\n");         /* proximity pulse count is over 63 */
+        
+        return 1;                                                                     /* return error */
+    }
+    if (config->gesture_pulse_count > 0x3F)                                           /* check gesture pulse count */
+    {
+        handle->debug_print("apds9960: gesture pulse count is over 63.\n");           /* gesture pulse count is over 63 */
+        
+        return 1;                                                                     /* return error */
+    }
+    if (config->gesture_exit_mask > 0xF)                                              /* check gesture exit mask */
+    {
+        handle->debug_print("apds9960: gesture exit mask is over 0xF.\n");            /* gesture exit mask is over 0xF */
+        
+        return 1;                                                                     /* return error */
     }
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief         pack the configuration into the register image
+ * @param[in]     *config pointer to a configuration structure
+ * @param[in,out] *image pointer to a register image buffer
+ * @note          image holds the register map from 0x80 to 0xAB, reserved bits are kept
+ */
+static void a_apds9960_config_pack(const apds9960_config_t *config, uint8_t *image)
+{
+    uint8_t *reg;
+    
+    reg = &image[APDS9960_REG_ENABLE - APDS9960_CACHE_BASE];                                   /* enable */
+    *reg &= ~0x7F;                                                                             /* clear config */
+    *reg |= config->power_on << APDS9960_CONF_POWER_ON;                                        /* set power on */
+    *reg |= config->als_enable << APDS9960_CONF_ALS_ENABLE;                                    /* set als enable */
+    *reg |= config->proximity_detect_enable << APDS9960_CONF_PROXIMITY_DETECT_ENABLE;          /* set proximity detect enable */
+    *reg |= config->wait_enable << APDS9960_CONF_WAIT_ENABLE;                                  /* set wait enable */
+    *reg |= config->als_interrupt_enable << APDS9960_CONF_ALS_INTERRUPT_ENABLE;                /* set als interrupt enable */
+    *reg |= config->proximity_interrupt_enable << APDS9960_CONF_PROXIMITY_INTERRUPT_ENABLE;    /* set proximity interrupt enable */
+    *reg |= config->gesture_enable << APDS9960_CONF_GESTURE_ENABLE;                            /* set gesture enable */
+    image[APDS9960_REG_ATIME - APDS9960_CACHE_BASE] = config->adc_integration_time;            /* set adc integration time */
+    image[APDS9960_REG_WTIME - APDS9960_CACHE_BASE] = config->wait_time;                       /* set wait time */
+    image[APDS9960_REG_AILTL - APDS9960_CACHE_BASE] = (config->als_interrupt_low_threshold >> 0) & 0xFF;    /* set als low threshold lsb */
+    image[APDS9960_REG_AILTH - APDS9960_CACHE_BASE] = (config->als_interrupt_low_threshold >> 8) & 0xFF;    /* set als low threshold msb */
+    image[APDS9960_REG_AIHTL - APDS9960_CACHE_BASE] = (config->als_interrupt_high_threshold >> 0) & 0xFF;    /* set als high threshold lsb */
+    image[APDS9960_REG_AIHTH - APDS9960_CACHE_BASE] = (config->als_interrupt_high_threshold >> 8) & 0xFF;    /* set als high threshold msb */
+    image[APDS9960_REG_PILT - APDS9960_CACHE_BASE] = config->proximity_interrupt_low_threshold;     /* set proximity low threshold */
+    image[APDS9960_REG_PIHT - APDS9960_CACHE_BASE] = config->proximity_interrupt_high_threshold;    /* set proximity high threshold */
+    image[APDS9960_REG_PERS - APDS9960_CACHE_BASE] = (uint8_t)((config->proximity_interrupt_cycle << 4) | 
+                                                               (config->als_interrupt_cycle << 0));  /* set persistence */
+    reg = &image[APDS9960_REG_CONFIG1 - APDS9960_CACHE_BASE];                                  /* config1 */
+    *reg &= ~(1 << 1);                                                                         /* clear config */
+    *reg |= config->wait_long << 1;                                                            /* set wait long */
+    image[APDS9960_REG_PPULSE - APDS9960_CACHE_BASE] = (uint8_t)((config->proximity_pulse_length << 6) | 
+                                                                 (config->proximity_pulse_count & 0x3F));    /* set proximity pulse */
+    reg = &image[APDS9960_REG_CONTROL - APDS9960_CACHE_BASE];                                  /* control */
+    *reg &= ~((0x3 << 6) | (0x3 << 2) | (0x3 << 0));                                           /* clear config */
+    *reg |= config->led_current << 6;                                                          /* set led current */
+    *reg |= config->proximity_gain << 2;                                                       /* set proximity gain */
+    *reg |= config->als_color_gain << 0;                                                       /* set als color gain */
+    reg = &image[APDS9960_REG_CONFIG2 - APDS9960_CACHE_BASE];                                  /* config2 */
+    *reg &= ~((1 << 7) | (1 << 6) | (0x3 << 4));                                               /* clear config */
+    *reg |= config->saturation_interrupt_proximity << APDS9960_SATURATION_INTERRUPT_PROXIMITY; /* set proximity saturation interrupt */
+    *reg |= config->saturation_interrupt_clear_photodiode << APDS9960_SATURATION_INTERRUPT_CLEAR_PHOTODIODE;    /* set clear photo diode saturation interrupt */
+    *reg |= config->led_boost << 4;                                                            /* set led boost */
+    image[APDS9960_REG_POFFSET_UR - APDS9960_CACHE_BASE] = a_apds9960_offset_encode(config->proximity_up_right_offset);    /* set proximity up right offset */
+    image[APDS9960_REG_POFFSET_DL - APDS9960_CACHE_BASE] = a_apds9960_offset_encode(config->proximity_down_left_offset);    /* set proximity down left offset */
+    reg = &image[APDS9960_REG_CONFIG3 - APDS9960_CACHE_BASE];                                  /* config3 */
+    *reg &= ~((1 << 5) | (1 << 4) | (0xF << 0));                                               /* clear config */
+    *reg |= config->proximity_gain_compensation << 5;                                          /* set proximity gain compensation */
+    *reg |= config->sleep_after_interrupt << 4;                                                /* set sleep after interrupt */
+    *reg |= config->proximity_mask_up << APDS9960_PROXIMITY_MASK_UP;                           /* set proximity mask up */
+    *reg |= config->proximity_mask_down << APDS9960_PROXIMITY_MASK_DOWN;                       /* set proximity mask down */
+    *reg |= config->proximity_mask_left << APDS9960_PROXIMITY_MASK_LEFT;                       /* set proximity mask left */
+    *reg |= config->proximity_mask_right << APDS9960_PROXIMITY_MASK_RIGHT;                     /* set proximity mask right */
+    image[APDS9960_REG_GPENTH - APDS9960_CACHE_BASE] = config->gesture_proximity_enter_threshold;    /* set gesture enter threshold */
+    image[APDS9960_REG_GEXTH - APDS9960_CACHE_BASE] = config->gesture_proximity_exit_threshold;      /* set gesture exit threshold */
+    image[APDS9960_REG_GCONF1 - APDS9960_CACHE_BASE] = (uint8_t)((config->gesture_fifo_threshold << 6) | 
+                                                                 ((config->gesture_exit_mask & 0xF) << 2) |
+                                                                 (config->gesture_exit_persistence << 0));    /* set gesture config 1 */
+    reg = &image[APDS9960_REG_GCONF2 - APDS9960_CACHE_BASE];                                   /* gconf2 */
+    *reg &= ~((0x3 << 5) | (0x3 << 3) | (0x7 << 0));                                           /* clear config */
+    *reg |= config->gesture_gain << 5;                                                         /* set gesture gain */
+    *reg |= config->gesture_led_current << 3;                                                  /* set gesture led current */
+    *reg |= config->gesture_wait_time << 0;                                                    /* set gesture wait time */
+    image[APDS9960_REG_GOFFSET_U - APDS9960_CACHE_BASE] = a_apds9960_offset_encode(config->gesture_up_offset);       /* set gesture up offset */
+    image[APDS9960_REG_GOFFSET_D - APDS9960_CACHE_BASE] = a_apds9960_offset_encode(config->gesture_down_offset);     /* set gesture down offset */
+    image[APDS9960_REG_GOFFSET_L - APDS9960_CACHE_BASE] = a_apds9960_offset_encode(config->gesture_left_offset);     /* set gesture left offset */
+    image[APDS9960_REG_GOFFSET_R - APDS9960_CACHE_BASE] = a_apds9960_offset_encode(config->gesture_right_offset);    /* set gesture right offset */
+    image[APDS9960_REG_GPULSE - APDS9960_CACHE_BASE] = (uint8_t)((config->gesture_pulse_length << 6) | 
+                                                                 (config->gesture_pulse_count & 0x3F));      /* set gesture pulse */
+    reg = &image[APDS9960_REG_GCONF3 - APDS9960_CACHE_BASE];                                   /* gconf3 */
+    *reg &= ~(0x3 << 0);                                                                       /* clear config */
+    *reg |= config->gesture_dimension << 0;                                                    /* set gesture dimension */
+    reg = &image[APDS9960_REG_GCONF4 - APDS9960_CACHE_BASE];                                   /* gconf4 */
+    *reg &= ~((1 << 2) | (1 << 1) | (1 << 0));                                                 /* clear config */
+    *reg |= config->gesture_interrupt << 1;                                                    /* set gesture interrupt */
+    *reg |= config->gesture_mode << 0;                                                         /* set gesture mode */
 }
 
 /**
@@ -207,43 +745,62 @@ uint8_t apds9960_init(apds9960_handle_t *handle)
         
         return 3;                                                            /* return error */
     }
-    if (handle->receive_callback == NULL)                                    /* check receive_callback */
+    if ((handle->receive_callback == NULL) &&                                /* check receive_callback */
+        (handle->event_callback == NULL) &&                                  /* check event_callback */
+        (handle->event_ring == NULL))                                        /* check event_ring */
     {
         handle->debug_print("apds9960: receive_callback is null.\n");        /* receive_callback is null */
         
         return 3;                                                            /* return error */
     }
     
-    if (handle->iic_init() != 0)                                             /* iic init */
+    if (handle->iic_init(handle->user) != 0)                                 /* iic init */
     {
         handle->debug_print("apds9960: iic init failed.\n");                 /* iic init failed */
         
         return 1;                                                            /* return error */
     }
+    handle->cache_enable = 0;                                                /* disable the cache */
+    handle->cache_valid = 0;                                                 /* clear the cache */
     if (a_apds9960_iic_read(handle, APDS9960_REG_ID, (uint8_t *)&id, 1) != 0)/* read id */
     {
         handle->debug_print("apds9960: read id failed.\n");                  /* read id failed */
-        (void)handle->iic_deinit();                                          /* iic deinit */
+        (void)handle->iic_deinit(handle->user);                              /* iic deinit */
         
         return 4;                                                            /* return error */
     }
     if (id != 0xAB)                                                          /* check id */
     {
         handle->debug_print("apds9960: id is invalid.\n");                   /* id is invalid */
-        (void)handle->iic_deinit();                                          /* iic deinit */
+        (void)handle->iic_deinit(handle->user);                              /* iic deinit */
         
         return 5;                                                            /* return error */
     }
     handle->gesture_status = 0;                                              /* clear the gesture status */
+    handle->gesture_second = 0;                                              /* clear the second stroke */
     handle->gesture_threshold = APDS9960_GESTURE_THRESHOLD;                  /* set the default gesture threshold */
     handle->gesture_sensitivity_1 = APDS9960_GESTURE_SENSITIVITY_1;          /* set the default gesture sensitivity 1 */
     handle->gesture_sensitivity_2 = APDS9960_GESTURE_SENSITIVITY_2;          /* set the default gesture sensitivity 2 */
-    handle->gesture_ud_delta = 0;                                            /* set gesture_ud_delta 0 */
-    handle->gesture_lr_delta = 0;                                            /* set gesture_lr_delta 0 */
-    handle->gesture_ud_count = 0;                                            /* set gesture_ud_count 0 */
-    handle->gesture_lr_count = 0;                                            /* set gesture_lr_count 0 */
-    handle->gesture_near_count = 0;                                          /* set gesture_near_count 0 */
-    handle->gesture_far_count = 0;                                           /* set gesture_far_count 0 */
+    handle->gesture_confidence = APDS9960_GESTURE_CONFIDENCE;                /* set the default gesture confidence */
+    memset(&handle->gesture_ratio, 0, sizeof(apds9960_gesture_ratio_t));    /* no gesture */
+    handle->gesture_decoder = &g_apds9960_gesture_decoder_ratio;             /* set the default decoder */
+    handle->gesture_decoder_state = NULL;                                    /* no decoder state */
+    handle->gesture_fifo_level = 0;                                          /* set gesture_fifo_level 0 */
+    handle->async_state = APDS9960_ASYNC_STATE_IDLE;                         /* set async idle */
+    handle->async_pending = 0;                                               /* no async transfer */
+    handle->sample_ns = 0;                                                   /* not synchronized */
+    handle->sample_polls = 0;                                                /* no polls */
+    handle->wait_als_ns = 0;                                                 /* als phase is unknown */
+    handle->gesture_period_ns = 0;                                           /* gesture period is unknown */
+    handle->gesture_edge_ns = 0;                                             /* no edge */
+    handle->gesture_fifo_ns = 0;                                             /* no fifo time */
+    handle->wait_proximity_ns = 0;                                           /* proximity phase is unknown */
+    if (handle->event_ring != NULL)                                          /* check the event ring */
+    {
+        handle->event_ring->head = 0;                                        /* reset head */
+        handle->event_ring->tail = 0;                                        /* reset tail */
+        handle->event_ring->dropped = 0;                                     /* reset dropped */
+    }
     handle->inited = 1;                                                      /* flag inited */
     
     return 0;                                                                /* success return 0 */
@@ -288,7 +845,7 @@ uint8_t apds9960_deinit(apds9960_handle_t *handle)
         
         return 4;                                                                       /* return error */
     }
-    res = handle->iic_deinit();                                                         /* iic deinit */
+    res = handle->iic_deinit(handle->user);                                             /* iic deinit */
     if (res != 0)                                                                       /* check the result */
     {
         handle->debug_print("apds9960: iic deinit failed.\n");                          /* iic deinit failed */
@@ -304,1162 +861,1542 @@ uint8_t apds9960_deinit(apds9960_handle_t *handle)
 }
 
 /**
- * @brief     irq handler
+ * @brief     clear the interrupts after an irq
  * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] status status register
+ * @param[in] gesture_status gesture status register
  * @return    status code
  *            - 0 success
- *            - 1 run failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ *            - 1 clear failed
  * @note      none
  */
-uint8_t apds9960_irq_handler(apds9960_handle_t *handle)
+static uint8_t a_apds9960_irq_clear(apds9960_handle_t *handle, uint8_t status, uint8_t gesture_status)
 {
-    uint8_t res, prev, prev1;
+    uint8_t res;
     uint8_t times;
+    uint8_t num;
+    uint8_t reg;
+    uint8_t clear;
+    uint8_t conf;
+    uint8_t fifo;
+    apds9960_iic_msg_t msg[2];
     
-    if (handle == NULL)                                                                      /* check handle */
+    fifo = (uint8_t)(((status & (1 << APDS9960_STATUS_GINT)) != 0) && 
+                     ((handle->gesture_fifo_level != 0) || 
+                      ((gesture_status & (1 << APDS9960_GESTURE_STATUS_FIFO_OVERFLOW)) != 0)));  /* the fifo is not drained or overflowed */
+    num = 0;                                                                                 /* init 0 */
+    if (((status & ((1 << APDS9960_STATUS_CPSAT) | (1 << APDS9960_STATUS_PGSAT) | 
+         (1 << APDS9960_STATUS_PINT) | (1 << APDS9960_STATUS_AINT))) != 0) ||
+        ((status & (1 << APDS9960_STATUS_GINT)) == 0))                                       /* not only the gesture interrupt */
     {
-        return 2;                                                                            /* return error */
+        clear = 0xFF;                                                                        /* set 0xFF */
+        msg[num].write = 1;                                                                  /* write */
+        msg[num].reg = APDS9960_REG_AICLEAR;                                                 /* clear all non-gesture interrupts */
+        msg[num].buf = (uint8_t *)&clear;                                                    /* set the buffer */
+        msg[num].len = 1;                                                                    /* set the length */
+        num++;                                                                               /* num++ */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (fifo != 0)                                                                           /* fifo needs to be cleared */
     {
-        return 3;                                                                            /* return error */
+        msg[num].write = 0;                                                                  /* read */
+        msg[num].reg = APDS9960_REG_GCONF4;                                                  /* get gesture conf 4 register */
+        msg[num].buf = (uint8_t *)&conf;                                                     /* set the buffer */
+        msg[num].len = 1;                                                                    /* set the length */
+        num++;                                                                               /* num++ */
     }
-    
-    res = a_apds9960_iic_read(handle, APDS9960_REG_STATUS, (uint8_t *)&prev, 1);             /* read status */
-    if (res != 0)                                                                            /* check the result */
+    if (num == 0)                                                                            /* nothing to clear */
     {
-        handle->debug_print("apds9960: read status failed.\n");                              /* read status failed */
-        
-        return 1;                                                                            /* return error */
+        return 0;                                                                            /* success return 0 */
     }
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GSTATUS, (uint8_t *)&prev1, 1);           /* read gesture status */
-    if (res != 0)                                                                            /* check the result */
+    
+    times = 3;                                                                               /* set retry times */
+    while (1)                                                                                /* retry label */
     {
-        handle->debug_print("apds9960: read gesture status failed.\n");                      /* read gesture status failed */
+        res = a_apds9960_iic_transfer(handle, msg, num);                                     /* clear and read gesture conf 4 in one batch */
+        if (res != 0)                                                                        /* check result */
+        {
+            if (times != 0)                                                                  /* check retry times */
+            {
+                times--;                                                                     /* times-- */
+                
+                continue;                                                                    /* continue */
+            }
+            
+            handle->debug_print("apds9960: clear interrupts failed.\n");                     /* clear interrupts failed */
+           
+            return 1;                                                                        /* return error */
+        }
         
-        return 1;                                                                            /* return error */
+        if (fifo != 0)                                                                       /* fifo needs to be cleared */
+        {
+            reg = conf;                                                                      /* get gesture conf 4 */
+            reg &= ~(1 << 2);                                                                /* clear config */
+            reg |= 1 << 2;                                                                   /* set config */
+            res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF4, (uint8_t *)&reg, 1);     /* set gesture conf 4 register */
+            if (res != 0)                                                                    /* check result */
+            {
+                if (times != 0)                                                              /* check retry times */
+                {
+                    times--;                                                                 /* times-- */
+                    
+                    continue;                                                                /* continue */
+                }
+                
+                handle->debug_print("apds9960: set gesture conf 4 register failed.\n");      /* set gesture conf 4 register failed */
+               
+                return 1;                                                                    /* return error */
+            }
+            handle->gesture_fifo_level = 0;                                                  /* fifo is cleared */
+        }
+        
+        break;                                                                               /* break */
     }
     
-    if ((prev & (1 << APDS9960_STATUS_CPSAT)) != 0)                                          /* check clear photo diode saturation */
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     reset the reported gesture
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @note      the gesture stream is kept, so the rest of a reported gesture is not decoded again
+ */
+static void a_apds9960_gesture_reset(apds9960_handle_t *handle)
+{
+    handle->gesture_status = 0;                                                              /* clear the gesture status */
+    handle->gesture_second = 0;                                                              /* clear the second stroke */
+}
+
+/**
+ * @brief     run the receive_callback for every gesture bit
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] gesture gesture bits
+ * @note      none
+ */
+static void a_apds9960_gesture_receive(apds9960_handle_t *handle, uint8_t gesture)
+{
+    if ((gesture & (1 << 0)) != 0)                                                           /* check far */
     {
         if (handle->receive_callback != NULL)                                                /* if valid */
         {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_CPSAT);                       /* run the callback */
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_GESTURE_FAR);   /* run the callback */
         }
     }
-    if ((prev & (1 << APDS9960_STATUS_PGSAT)) != 0)                                          /* check analog saturation */
+    if ((gesture & (1 << 1)) != 0)                                                           /* check near */
     {
         if (handle->receive_callback != NULL)                                                /* if valid */
         {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_PGSAT);                       /* run the callback */
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_GESTURE_NEAR);  /* run the callback */
         }
     }
-    if ((prev & (1 << APDS9960_STATUS_PINT)) != 0)                                           /* check proximity interrupt */
+    if ((gesture & (1 << 2)) != 0)                                                           /* check down */
     {
         if (handle->receive_callback != NULL)                                                /* if valid */
         {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_PINT);                        /* run the callback */
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_GESTURE_DOWN);  /* run the callback */
         }
     }
-    if ((prev & (1 << APDS9960_STATUS_AINT)) != 0)                                           /* check als interrupt */
+    if ((gesture & (1 << 3)) != 0)                                                           /* check up */
     {
         if (handle->receive_callback != NULL)                                                /* if valid */
         {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_AINT);                        /* run the callback */
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_GESTURE_UP);    /* run the callback */
         }
     }
-    if ((prev & (1 << APDS9960_STATUS_GINT)) != 0)                                           /* gesture interrupt */
+    if ((gesture & (1 << 4)) != 0)                                                           /* check right */
     {
         if (handle->receive_callback != NULL)                                                /* if valid */
         {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_GINT);                        /* run the callback */
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_GESTURE_RIGHT); /* run the callback */
         }
     }
-    if ((prev & (1 << APDS9960_STATUS_PVALID)) != 0)                                         /* check proximity valid */
+    if ((gesture & (1 << 5)) != 0)                                                           /* check left */
     {
         if (handle->receive_callback != NULL)                                                /* if valid */
         {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_PVALID);                      /* run the callback */
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_GESTURE_LEFT);  /* run the callback */
         }
     }
-    if ((prev & (1 << APDS9960_STATUS_AVALID)) != 0)                                         /* check als valid */
+}
+
+/**
+ * @brief      parse the status and data registers into an event
+ * @param[out] *event pointer to an event structure
+ * @param[in]  *buf pointer to the 10 bytes read from the status register
+ * @note       none
+ */
+static void a_apds9960_event_parse(apds9960_event_t *event, uint8_t *buf)
+{
+    event->status = buf[0];                                                                  /* set the status */
+    event->clear = (uint16_t)(((uint16_t)buf[2] << 8) | buf[1]);                             /* set the clear */
+    event->red = (uint16_t)(((uint16_t)buf[4] << 8) | buf[3]);                               /* set the red */
+    event->green = (uint16_t)(((uint16_t)buf[6] << 8) | buf[5]);                             /* set the green */
+    event->blue = (uint16_t)(((uint16_t)buf[8] << 8) | buf[7]);                              /* set the blue */
+    event->proximity = buf[9];                                                               /* set the proximity */
+}
+
+/**
+ * @brief     push an event into the event ring
+ * @param[in] *ring pointer to an event ring structure
+ * @param[in] *event pointer to an event structure
+ * @note      only the irq handler pushes, the event is dropped when the ring is full
+ */
+static void a_apds9960_event_push(apds9960_event_ring_t *ring, const apds9960_event_t *event)
+{
+    uint32_t head;
+    uint32_t index;
+    
+    head = ring->head;                                                                       /* only the producer changes head */
+    if ((uint32_t)(head - APDS9960_RING_LOAD_ACQUIRE(&ring->tail)) >= APDS9960_EVENT_RING_SIZE)  /* check the free space */
     {
-        if (handle->receive_callback != NULL)                                                /* if valid */
-        {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_AVALID);                      /* run the callback */
-        }
+        ring->dropped = ring->dropped + 1;                                                   /* drop the event */
+        
+        return;                                                                              /* return */
     }
-    if ((prev1 & (1 << APDS9960_GESTURE_STATUS_FIFO_OVERFLOW)) != 0)                         /* check gesture fifo overflow */
+    index = head & (APDS9960_EVENT_RING_SIZE - 1);                                           /* get the slot */
+    ring->event[index] = *event;                                                             /* copy the event */
+    ring->event[index].fifo = NULL;                                                          /* fifo is copied below */
+    if (event->fifo_len != 0)                                                                /* check the fifo */
     {
-        if (handle->receive_callback != NULL)                                                /* if valid */
-        {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_GFOV);                        /* run the callback */
-        }
+        memcpy(ring->fifo[index], event->fifo, (size_t)event->fifo_len * 4);                 /* copy the fifo */
     }
-    if ((prev1 & (1 << APDS9960_GESTURE_STATUS_FIFO_VALID)) != 0)                            /* check gesture fifo data */
+    APDS9960_RING_STORE_RELEASE(&ring->head, head + 1);                                      /* publish the slot */
+}
+
+/**
+ * @brief     irq handler with one event per interrupt
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] timestamp interrupt timestamp in ns
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      status and data are read in one burst and the gesture fifo is drained
+ *            and decoded before the event is pushed into the ring and passed to the callback
+ */
+static uint8_t a_apds9960_irq_event(apds9960_handle_t *handle, uint64_t timestamp)
+{
+    uint8_t res;
+    uint8_t len;
+    uint8_t buf[10];
+    apds9960_bool_t overflow;
+    apds9960_event_t event;
+    
+    memset(&event, 0, sizeof(apds9960_event_t));                                             /* clear the event */
+    event.timestamp = timestamp;                                                             /* set the timestamp */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_STATUS, (uint8_t *)buf, 10);              /* read status and data */
+    if (res != 0)                                                                            /* check the result */
     {
-        if (handle->receive_callback != NULL)                                                /* if valid */
-        {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_GVALID);                      /* run the callback */
-        }
+        handle->debug_print("apds9960: read status failed.\n");                              /* read status failed */
+        
+        return 1;                                                                            /* return error */
     }
-    
-    times = 3;                                                                               /* set retry times */
-    while (1)                                                                                /* retry label */
+    a_apds9960_event_parse(&event, buf);                                                     /* parse the status and data */
+    if ((event.status & (1 << APDS9960_STATUS_GINT)) != 0)                                   /* only gesture interrupt needs the gesture fifo */
     {
-        prev = 0xFF;                                                                         /* set 0xFF */
-        res = a_apds9960_iic_write(handle, APDS9960_REG_AICLEAR, (uint8_t *)&prev, 1);       /* clear all non-gesture interrupts */
-        if (res != 0)                                                                        /* check result */
+        len = APDS9960_GESTURE_FIFO_DEPTH;                                                   /* set the buffer length */
+        handle->gesture_edge_ns = timestamp;                                                 /* the fifo is anchored to the edge */
+        res = apds9960_drain_gesture_fifo(handle, handle->event_fifo, &len, &overflow);      /* drain the gesture fifo */
+        handle->gesture_edge_ns = 0;                                                         /* edge is used */
+        if (res != 0)                                                                        /* check the result */
         {
-            if (times != 0)                                                                  /* check retry times */
-            {
-                times--;                                                                     /* times-- */
-                
-                continue;                                                                    /* continue */
-            }
+            handle->debug_print("apds9960: drain gesture fifo failed.\n");                   /* drain gesture fifo failed */
             
-            handle->debug_print("apds9960: clear all non-gesture interrupts failed.\n");     /* clear all non-gesture interrupts failed */
-           
             return 1;                                                                        /* return error */
         }
-        
-        res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);         /* get gesture conf 4 register */
-        if (res != 0)                                                                        /* check result */
+        event.fifo_timestamp = handle->gesture_fifo_ns;                                      /* set the fifo timestamp */
+        event.fifo_period = handle->gesture_period_ns;                                       /* set the fifo period */
+        if (len != 0)                                                                        /* check the length */
         {
-            if (times != 0)                                                                  /* check retry times */
-            {
-                times--;                                                                     /* times-- */
-                
-                continue;                                                                    /* continue */
-            }
-            
-            handle->debug_print("apds9960: get gesture conf 4 register failed.\n");          /* get gesture conf 4 register failed */
-           
-            return 1;                                                                        /* return error */
+            event.gesture_status |= 1 << APDS9960_GESTURE_STATUS_FIFO_VALID;                 /* set fifo valid */
         }
-        prev &= ~(1 << 2);                                                                   /* clear config */
-        prev |= 1 << 2;                                                                      /* set config */
-        res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);        /* set gesture conf 4 register */
-        if (res != 0)                                                                        /* check result */
+        if (overflow == APDS9960_BOOL_TRUE)                                                  /* check the overflow */
         {
-            if (times != 0)                                                                  /* check retry times */
-            {
-                times--;                                                                     /* times-- */
-                
-                continue;                                                                    /* continue */
-            }
+            event.gesture_status |= 1 << APDS9960_GESTURE_STATUS_FIFO_OVERFLOW;              /* set fifo overflow */
+        }
+        event.fifo = handle->event_fifo;                                                     /* set the fifo */
+        event.fifo_len = len;                                                                /* set the fifo length */
+        (void)apds9960_gesture_decode(handle, handle->event_fifo, len);                      /* decode the gesture */
+    }
+    res = a_apds9960_irq_clear(handle, event.status, event.gesture_status);                  /* clear the interrupts */
+    if (res != 0)                                                                            /* check the result */
+    {
+        return 1;                                                                            /* return error */
+    }
+    event.gesture = handle->gesture_status;                                                  /* set the decoded gesture */
+    event.gesture_second = handle->gesture_second;                                           /* set the second stroke */
+    if ((event.gesture | event.gesture_second) != 0)                                         /* if we find gesture */
+    {
+        a_apds9960_gesture_reset(handle);                                                    /* reset the gesture state */
+    }
+    if (handle->event_ring != NULL)                                                          /* check the event ring */
+    {
+        a_apds9960_event_push(handle->event_ring, &event);                                   /* push the event */
+    }
+    if (handle->event_callback != NULL)                                                      /* check the event callback */
+    {
+        handle->event_callback(handle->user, &event);                                        /* run the event callback */
+    }
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     irq handler
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      gesture registers are only accessed when the gesture interrupt is asserted and
+ *            the gesture fifo is only cleared when the callback has not drained it
+ */
+uint8_t apds9960_irq_handler(apds9960_handle_t *handle)
+{
+    uint8_t res, prev, prev1;
+    uint8_t buf[2];
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    
+    if ((handle->event_callback != NULL) || (handle->event_ring != NULL))                    /* check the event callback and ring */
+    {
+        return a_apds9960_irq_event(handle, (handle->timestamp_ns != NULL) ? handle->timestamp_ns() : 0);    /* run the event handler */
+    }
+    
+    res = a_apds9960_iic_read(handle, APDS9960_REG_STATUS, (uint8_t *)&prev, 1);             /* read status */
+    if (res != 0)                                                                            /* check the result */
+    {
+        handle->debug_print("apds9960: read status failed.\n");                              /* read status failed */
+        
+        return 1;                                                                            /* return error */
+    }
+    prev1 = 0;                                                                               /* no gesture status */
+    if ((prev & (1 << APDS9960_STATUS_GINT)) != 0)                                           /* only gesture interrupt needs the gesture status */
+    {
+        res = a_apds9960_iic_read(handle, APDS9960_REG_GFLVL, (uint8_t *)buf, 2);            /* read gesture fifo level and status */
+        if (res != 0)                                                                        /* check the result */
+        {
+            handle->debug_print("apds9960: read gesture status failed.\n");                  /* read gesture status failed */
             
-            handle->debug_print("apds9960: set gesture conf 4 register failed.\n");          /* set gesture conf 4 register failed */
-           
             return 1;                                                                        /* return error */
         }
-        
-        break;                                                                               /* break */
+        handle->gesture_fifo_level = buf[0];                                                 /* save the fifo level */
+        prev1 = buf[1];                                                                      /* set the gesture status */
     }
     
-    prev = handle->gesture_status;                                                           /* get the gesture status */
-    if ((prev & (1 << 0)) != 0)                                                              /* check far */
+    if ((prev & (1 << APDS9960_STATUS_CPSAT)) != 0)                                          /* check clear photo diode saturation */
+    {
+        if (handle->receive_callback != NULL)                                                /* if valid */
+        {
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_CPSAT);         /* run the callback */
+        }
+    }
+    if ((prev & (1 << APDS9960_STATUS_PGSAT)) != 0)                                          /* check analog saturation */
+    {
+        if (handle->receive_callback != NULL)                                                /* if valid */
+        {
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_PGSAT);         /* run the callback */
+        }
+    }
+    if ((prev & (1 << APDS9960_STATUS_PINT)) != 0)                                           /* check proximity interrupt */
+    {
+        if (handle->receive_callback != NULL)                                                /* if valid */
+        {
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_PINT);          /* run the callback */
+        }
+    }
+    if ((prev & (1 << APDS9960_STATUS_AINT)) != 0)                                           /* check als interrupt */
     {
         if (handle->receive_callback != NULL)                                                /* if valid */
         {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_GESTURE_FAR);                 /* run the callback */
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_AINT);          /* run the callback */
         }
     }
-    if ((prev & (1 << 1)) != 0)                                                              /* check near */
+    if ((prev & (1 << APDS9960_STATUS_GINT)) != 0)                                           /* gesture interrupt */
     {
         if (handle->receive_callback != NULL)                                                /* if valid */
         {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_GESTURE_NEAR);                /* run the callback */
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_GINT);          /* run the callback */
         }
     }
-    if ((prev & (1 << 2)) != 0)                                                              /* check down */
+    if ((prev & (1 << APDS9960_STATUS_PVALID)) != 0)                                         /* check proximity valid */
     {
         if (handle->receive_callback != NULL)                                                /* if valid */
         {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_GESTURE_DOWN);                /* run the callback */
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_PVALID);        /* run the callback */
         }
     }
-    if ((prev & (1 << 3)) != 0)                                                              /* check up */
+    if ((prev & (1 << APDS9960_STATUS_AVALID)) != 0)                                         /* check als valid */
     {
         if (handle->receive_callback != NULL)                                                /* if valid */
         {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_GESTURE_UP);                  /* run the callback */
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_AVALID);        /* run the callback */
         }
     }
-    if ((prev & (1 << 4)) != 0)                                                              /* check right */
+    if ((prev1 & (1 << APDS9960_GESTURE_STATUS_FIFO_OVERFLOW)) != 0)                         /* check gesture fifo overflow */
     {
         if (handle->receive_callback != NULL)                                                /* if valid */
         {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_GESTURE_RIGHT);               /* run the callback */
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_GFOV);          /* run the callback */
         }
     }
-    if ((prev & (1 << 5)) != 0)                                                              /* check left */
+    if ((prev1 & (1 << APDS9960_GESTURE_STATUS_FIFO_VALID)) != 0)                            /* check gesture fifo data */
     {
         if (handle->receive_callback != NULL)                                                /* if valid */
         {
-            handle->receive_callback(APDS9960_INTERRUPT_STATUS_GESTURE_LEFT);                /* run the callback */
+            handle->receive_callback(handle->user, APDS9960_INTERRUPT_STATUS_GVALID);        /* run the callback */
         }
     }
+    
+    res = a_apds9960_irq_clear(handle, prev, prev1);                                         /* clear the interrupts */
+    if (res != 0)                                                                            /* check the result */
+    {
+        return 1;                                                                            /* return error */
+    }
+    
+    a_apds9960_gesture_receive(handle, handle->gesture_status);                              /* run the first stroke callbacks */
+    a_apds9960_gesture_receive(handle, handle->gesture_second);                              /* run the second stroke callbacks */
+    prev = handle->gesture_status | handle->gesture_second;                                  /* get the gesture status */
     handle->gesture_status = 0;                                                              /* clear the gesture status */
     if (prev != 0)                                                                           /* if we find gesture */
     {
-        handle->gesture_ud_delta = 0;                                                        /* set gesture_ud_delta 0 */
-        handle->gesture_lr_delta = 0;                                                        /* set gesture_lr_delta 0 */
-        handle->gesture_ud_count = 0;                                                        /* set gesture_ud_count 0 */
-        handle->gesture_lr_count = 0;                                                        /* set gesture_lr_count 0 */
-        handle->gesture_near_count = 0;                                                      /* set gesture_near_count 0 */
-        handle->gesture_far_count = 0;                                                       /* set gesture_far_count 0 */
+        a_apds9960_gesture_reset(handle);                                                    /* reset the gesture state */
     }
 
     return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief     decode gestures from the fifo data
+ * @brief     irq handler with the interrupt timestamp
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] **data pointer to data buffer
- * @param[in] len length of the data buffer
+ * @param[in] timestamp interrupt timestamp in ns
  * @return    status code
  *            - 0 success
- *            - 1 decode gesture from fifo failed
+ *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 decode failed
- * @note      none
+ * @note      timestamp is the edge time taken by the interrupt source, e.g. the kernel gpio event time,
+ *            it is used as the event timestamp instead of timestamp_ns, without the event callback and
+ *            ring it anchors the gesture fifo drained by the receive_callback
  */
-uint8_t apds9960_gesture_decode(apds9960_handle_t *handle, uint8_t (*data)[4], uint8_t len)
+uint8_t apds9960_irq_handler_timestamp(apds9960_handle_t *handle, uint64_t timestamp)
 {
-    int8_t i;
-    uint8_t u_first, d_first, l_first, r_first;
-    uint8_t u_last, d_last, l_last, r_last;
-    int32_t ud_ratio_first, lr_ratio_first, ud_ratio_last, lr_ratio_last;
-    int32_t ud_delta, lr_delta;
+    uint8_t res;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                                      /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                                 /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                            /* return error */
     }
-    if (len < 4)                                                                         /* check len */
+    
+    if ((handle->event_callback != NULL) || (handle->event_ring != NULL))                    /* check the event callback and ring */
     {
-        handle->debug_print("apds9960: fifo level must be over 4.\n");                   /* fifo level must be over 4 */
-       
-        return 4;                                                                        /* return error */
+        return a_apds9960_irq_event(handle, timestamp);                                      /* run the event handler */
     }
     
-    u_first = 0;                                                                         /* clear up first */
-    d_first = 0;                                                                         /* clear down first */
-    l_first = 0;                                                                         /* clear left first */
-    r_first = 0;                                                                         /* clear right first */
-    u_last = 0;                                                                          /* clear up last */
-    d_last = 0;                                                                          /* clear down last */
-    l_last = 0;                                                                          /* clear left last */
-    r_last = 0;                                                                          /* clear right last */
-    for (i = 0; i < len; i++)                                                            /* run len times */
+    handle->gesture_edge_ns = timestamp;                                                     /* the fifo is anchored to the edge */
+    res = apds9960_irq_handler(handle);                                                      /* run the irq handler */
+    handle->gesture_edge_ns = 0;                                                             /* edge is used */
+    
+    return res;                                                                              /* return the result */
+}
+
+/**
+ * @brief ceil(2^APDS9960_GESTURE_RATIO_SHIFT / sum) of every channel sum from 0 to 510
+ */
+static const uint32_t gs_ratio_reciprocal[511] =
+{
+    0x00000000U, 0x02000000U, 0x01000000U, 0x00AAAAABU, 0x00800000U, 0x00666667U, 0x00555556U, 0x00492493U,
+    0x00400000U, 0x0038E38FU, 0x00333334U, 0x002E8BA3U, 0x002AAAABU, 0x00276277U, 0x0024924AU, 0x00222223U,
+    0x00200000U, 0x001E1E1FU, 0x001C71C8U, 0x001AF287U, 0x0019999AU, 0x00186187U, 0x001745D2U, 0x001642C9U,
+    0x00155556U, 0x00147AE2U, 0x0013B13CU, 0x0012F685U, 0x00124925U, 0x0011A7BAU, 0x00111112U, 0x00108422U,
+    0x00100000U, 0x000F83E1U, 0x000F0F10U, 0x000EA0EBU, 0x000E38E4U, 0x000DD67DU, 0x000D7944U, 0x000D20D3U,
+    0x000CCCCDU, 0x000C7CE1U, 0x000C30C4U, 0x000BE830U, 0x000BA2E9U, 0x000B60B7U, 0x000B2165U, 0x000AE4C5U,
+    0x000AAAABU, 0x000A72F1U, 0x000A3D71U, 0x000A0A0BU, 0x0009D89EU, 0x0009A90FU, 0x00097B43U, 0x00094F21U,
+    0x00092493U, 0x0008FB83U, 0x0008D3DDU, 0x0008AD90U, 0x00088889U, 0x000864B9U, 0x00084211U, 0x00082083U,
+    0x00080000U, 0x0007E07FU, 0x0007C1F1U, 0x0007A44DU, 0x00078788U, 0x00076B99U, 0x00075076U, 0x00073616U,
+    0x00071C72U, 0x00070382U, 0x0006EB3FU, 0x0006D3A1U, 0x0006BCA2U, 0x0006A63CU, 0x0006906AU, 0x00067B24U,
+    0x00066667U, 0x0006522DU, 0x00063E71U, 0x00062B2FU, 0x00061862U, 0x00060607U, 0x0005F418U, 0x0005E294U,
+    0x0005D175U, 0x0005C0B9U, 0x0005B05CU, 0x0005A05BU, 0x000590B3U, 0x00058161U, 0x00057263U, 0x000563B5U,
+    0x00055556U, 0x00054742U, 0x00053979U, 0x00052BF6U, 0x00051EB9U, 0x000511BFU, 0x00050506U, 0x0004F88CU,
+    0x0004EC4FU, 0x0004E04FU, 0x0004D488U, 0x0004C8F9U, 0x0004BDA2U, 0x0004B27FU, 0x0004A791U, 0x00049CD5U,
+    0x0004924AU, 0x000487EEU, 0x00047DC2U, 0x000473C2U, 0x000469EFU, 0x00046047U, 0x000456C8U, 0x00044D73U,
+    0x00044445U, 0x00043B3EU, 0x0004325DU, 0x000429A1U, 0x00042109U, 0x00041894U, 0x00041042U, 0x00040811U,
+    0x00040000U, 0x0003F810U, 0x0003F040U, 0x0003E88DU, 0x0003E0F9U, 0x0003D981U, 0x0003D227U, 0x0003CAE8U,
+    0x0003C3C4U, 0x0003BCBBU, 0x0003B5CDU, 0x0003AEF7U, 0x0003A83BU, 0x0003A197U, 0x00039B0BU, 0x00039497U,
+    0x00038E39U, 0x000387F2U, 0x000381C1U, 0x00037BA6U, 0x000375A0U, 0x00036FAEU, 0x000369D1U, 0x00036407U,
+    0x00035E51U, 0x000358AFU, 0x0003531EU, 0x00034DA1U, 0x00034835U, 0x000342DBU, 0x00033D92U, 0x0003385BU,
+    0x00033334U, 0x00032E1DU, 0x00032917U, 0x00032420U, 0x00031F39U, 0x00031A61U, 0x00031598U, 0x000310DDU,
+    0x00030C31U, 0x00030793U, 0x00030304U, 0x0002FE81U, 0x0002FA0CU, 0x0002F5A5U, 0x0002F14AU, 0x0002ECFCU,
+    0x0002E8BBU, 0x0002E486U, 0x0002E05DU, 0x0002DC3FU, 0x0002D82EU, 0x0002D428U, 0x0002D02EU, 0x0002CC3EU,
+    0x0002C85AU, 0x0002C480U, 0x0002C0B1U, 0x0002BCECU, 0x0002B932U, 0x0002B581U, 0x0002B1DBU, 0x0002AE3EU,
+    0x0002AAABU, 0x0002A722U, 0x0002A3A1U, 0x0002A02BU, 0x00029CBDU, 0x00029958U, 0x000295FBU, 0x000292A8U,
+    0x00028F5DU, 0x00028C1AU, 0x000288E0U, 0x000285ADU, 0x00028283U, 0x00027F61U, 0x00027C46U, 0x00027933U,
+    0x00027628U, 0x00027324U, 0x00027028U, 0x00026D32U, 0x00026A44U, 0x0002675DU, 0x0002647DU, 0x000261A4U,
+    0x00025ED1U, 0x00025C05U, 0x00025940U, 0x00025681U, 0x000253C9U, 0x00025117U, 0x00024E6BU, 0x00024BC5U,
+    0x00024925U, 0x0002468BU, 0x000243F7U, 0x00024169U, 0x00023EE1U, 0x00023C5EU, 0x000239E1U, 0x0002376AU,
+    0x000234F8U, 0x0002328BU, 0x00023024U, 0x00022DC1U, 0x00022B64U, 0x0002290CU, 0x000226BAU, 0x0002246CU,
+    0x00022223U, 0x00021FDFU, 0x00021D9FU, 0x00021B65U, 0x0002192FU, 0x000216FDU, 0x000214D1U, 0x000212A8U,
+    0x00021085U, 0x00020E65U, 0x00020C4AU, 0x00020A33U, 0x00020821U, 0x00020613U, 0x00020409U, 0x00020203U,
+    0x00020000U, 0x0001FE02U, 0x0001FC08U, 0x0001FA12U, 0x0001F820U, 0x0001F632U, 0x0001F447U, 0x0001F260U,
+    0x0001F07DU, 0x0001EE9DU, 0x0001ECC1U, 0x0001EAE9U, 0x0001E914U, 0x0001E742U, 0x0001E574U, 0x0001E3AAU,
+    0x0001E1E2U, 0x0001E01FU, 0x0001DE5EU, 0x0001DCA1U, 0x0001DAE7U, 0x0001D930U, 0x0001D77CU, 0x0001D5CBU,
+    0x0001D41EU, 0x0001D273U, 0x0001D0CCU, 0x0001CF27U, 0x0001CD86U, 0x0001CBE7U, 0x0001CA4CU, 0x0001C8B3U,
+    0x0001C71DU, 0x0001C58AU, 0x0001C3F9U, 0x0001C26CU, 0x0001C0E1U, 0x0001BF59U, 0x0001BDD3U, 0x0001BC50U,
+    0x0001BAD0U, 0x0001B952U, 0x0001B7D7U, 0x0001B65FU, 0x0001B4E9U, 0x0001B375U, 0x0001B204U, 0x0001B095U,
+    0x0001AF29U, 0x0001ADBFU, 0x0001AC58U, 0x0001AAF2U, 0x0001A98FU, 0x0001A82FU, 0x0001A6D1U, 0x0001A575U,
+    0x0001A41BU, 0x0001A2C3U, 0x0001A16EU, 0x0001A01BU, 0x00019EC9U, 0x00019D7AU, 0x00019C2EU, 0x00019AE3U,
+    0x0001999AU, 0x00019853U, 0x0001970FU, 0x000195CCU, 0x0001948CU, 0x0001934DU, 0x00019210U, 0x000190D5U,
+    0x00018F9DU, 0x00018E66U, 0x00018D31U, 0x00018BFDU, 0x00018ACCU, 0x0001899DU, 0x0001886FU, 0x00018743U,
+    0x00018619U, 0x000184F1U, 0x000183CAU, 0x000182A5U, 0x00018182U, 0x00018061U, 0x00017F41U, 0x00017E23U,
+    0x00017D06U, 0x00017BECU, 0x00017AD3U, 0x000179BBU, 0x000178A5U, 0x00017791U, 0x0001767EU, 0x0001756DU,
+    0x0001745EU, 0x00017350U, 0x00017243U, 0x00017138U, 0x0001702FU, 0x00016F27U, 0x00016E20U, 0x00016D1BU,
+    0x00016C17U, 0x00016B15U, 0x00016A14U, 0x00016915U, 0x00016817U, 0x0001671AU, 0x0001661FU, 0x00016525U,
+    0x0001642DU, 0x00016336U, 0x00016240U, 0x0001614CU, 0x00016059U, 0x00015F67U, 0x00015E76U, 0x00015D87U,
+    0x00015C99U, 0x00015BACU, 0x00015AC1U, 0x000159D7U, 0x000158EEU, 0x00015806U, 0x0001571FU, 0x0001563AU,
+    0x00015556U, 0x00015473U, 0x00015391U, 0x000152B0U, 0x000151D1U, 0x000150F3U, 0x00015016U, 0x00014F39U,
+    0x00014E5FU, 0x00014D85U, 0x00014CACU, 0x00014BD4U, 0x00014AFEU, 0x00014A28U, 0x00014954U, 0x00014881U,
+    0x000147AFU, 0x000146DDU, 0x0001460DU, 0x0001453EU, 0x00014470U, 0x000143A3U, 0x000142D7U, 0x0001420CU,
+    0x00014142U, 0x00014079U, 0x00013FB1U, 0x00013EE9U, 0x00013E23U, 0x00013D5EU, 0x00013C9AU, 0x00013BD7U,
+    0x00013B14U, 0x00013A53U, 0x00013992U, 0x000138D3U, 0x00013814U, 0x00013756U, 0x00013699U, 0x000135DDU,
+    0x00013522U, 0x00013468U, 0x000133AFU, 0x000132F6U, 0x0001323FU, 0x00013188U, 0x000130D2U, 0x0001301DU,
+    0x00012F69U, 0x00012EB5U, 0x00012E03U, 0x00012D51U, 0x00012CA0U, 0x00012BF0U, 0x00012B41U, 0x00012A92U,
+    0x000129E5U, 0x00012938U, 0x0001288CU, 0x000127E0U, 0x00012736U, 0x0001268CU, 0x000125E3U, 0x0001253AU,
+    0x00012493U, 0x000123ECU, 0x00012346U, 0x000122A1U, 0x000121FCU, 0x00012158U, 0x000120B5U, 0x00012013U,
+    0x00011F71U, 0x00011ED0U, 0x00011E2FU, 0x00011D90U, 0x00011CF1U, 0x00011C53U, 0x00011BB5U, 0x00011B18U,
+    0x00011A7CU, 0x000119E1U, 0x00011946U, 0x000118ACU, 0x00011812U, 0x00011779U, 0x000116E1U, 0x00011649U,
+    0x000115B2U, 0x0001151CU, 0x00011486U, 0x000113F1U, 0x0001135DU, 0x000112C9U, 0x00011236U, 0x000111A4U,
+    0x00011112U, 0x00011080U, 0x00010FF0U, 0x00010F5FU, 0x00010ED0U, 0x00010E41U, 0x00010DB3U, 0x00010D25U,
+    0x00010C98U, 0x00010C0BU, 0x00010B7FU, 0x00010AF3U, 0x00010A69U, 0x000109DEU, 0x00010954U, 0x000108CBU,
+    0x00010843U, 0x000107BAU, 0x00010733U, 0x000106ACU, 0x00010625U, 0x0001059FU, 0x0001051AU, 0x00010495U,
+    0x00010411U, 0x0001038DU, 0x0001030AU, 0x00010287U, 0x00010205U, 0x00010183U, 0x00010102U
+};
+
+/**
+ * @brief     get the ratio of two gesture channels without a division
+ * @param[in] a first channel
+ * @param[in] b second channel
+ * @return    ratio
+ * @note      bit-identical to ((a - b) * 100) / (a + b) when a + b > 0, 0 when a + b is 0
+ */
+static int32_t a_apds9960_gesture_ratio(uint8_t a, uint8_t b)
+{
+    uint32_t reciprocal;
+    
+    reciprocal = gs_ratio_reciprocal[a + b];                                                 /* get the reciprocal of the sum */
+    if (a >= b)                                                                              /* not negative */
     {
-        if ((data[i][0] > handle->gesture_threshold) &&                                  /* check gesture threshold */
-            (data[i][1] > handle->gesture_threshold) &&                                  /* check gesture threshold */
-            (data[i][2] > handle->gesture_threshold) &&                                  /* check gesture threshold */
-            (data[i][3] > handle->gesture_threshold)                                     /* check gesture threshold */
-           )
-        {
-            u_first = data[i][0];                                                        /* set up first */
-            d_first = data[i][1];                                                        /* set down first */
-            l_first = data[i][2];                                                        /* set left first */
-            r_first = data[i][3];                                                        /* set right first */
-            
-            break;                                                                       /* break */
-        }
+        return (int32_t)(((uint32_t)(a - b) * 100U * reciprocal) >> APDS9960_GESTURE_RATIO_SHIFT);        /* a > b */
     }
-    if ((u_first == 0) ||                                                                /* check up first */
-        (d_first == 0) ||                                                                /* check down first */
-        (l_first == 0) ||                                                                /* check left first */
-        (r_first == 0)                                                                   /* check right first */
-       )
+    else
     {
-        goto decode;                                                                     /* go to decode */
+        return -(int32_t)(((uint32_t)(b - a) * 100U * reciprocal) >> APDS9960_GESTURE_RATIO_SHIFT);       /* a < b */
     }
-    for (i = len - 1; i >= 0; i--)                                                       /* run len times */
-    {
-        if ((data[i][0] > handle->gesture_threshold) &&                                  /* check gesture threshold */
-            (data[i][1] > handle->gesture_threshold) &&                                  /* check gesture threshold */
-            (data[i][2] > handle->gesture_threshold) &&                                  /* check gesture threshold */
-            (data[i][3] > handle->gesture_threshold)                                     /* check gesture threshold */
-           )
+}
+
+/**
+ * @brief     get the mask of the datasets above the threshold
+ * @param[in] *data pointer to len datasets of up, down, left and right
+ * @param[in] len length of the data buffer
+ * @param[in] threshold gesture threshold
+ * @return    dataset mask
+ * @note      len <= 32
+ */
+static uint32_t a_apds9960_gesture_scan(const uint8_t *data, uint8_t len, uint8_t threshold)
+{
+    uint32_t mask;
+    uint8_t i;
+#if defined(APDS9960_GESTURE_SCAN_SSE2)
+    __m128i t;
+    __m128i zero;
+    __m128i below;
+#elif defined(APDS9960_GESTURE_SCAN_NEON)
+    static const uint32_t bit[4] = {1, 2, 4, 8};
+    uint8x16_t t;
+    uint32x4_t in;
+#endif
+    
+    mask = 0;                                                                                /* no dataset */
+    i = 0;                                                                                   /* from the first dataset */
+#if defined(APDS9960_GESTURE_SCAN_SSE2)
+    t = _mm_set1_epi8((char)threshold);                                                      /* threshold in every byte */
+    zero = _mm_setzero_si128();                                                              /* zero */
+    for (; (i + 4) <= len; i += 4)                                                           /* four datasets per step */
+    {
+        below = _mm_cmpeq_epi8(_mm_subs_epu8(_mm_loadu_si128((const __m128i *)(data + i * 4)), t), zero);        /* channel <= threshold */
+        mask |= (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(below, zero))) << i;                 /* no channel is below */
+    }
+#elif defined(APDS9960_GESTURE_SCAN_NEON)
+    t = vdupq_n_u8(threshold);                                                               /* threshold in every byte */
+    for (; (i + 4) <= len; i += 4)                                                           /* four datasets per step */
+    {
+        in = vceqq_u32(vreinterpretq_u32_u8(vcgtq_u8(vld1q_u8(data + i * 4), t)),
+                       vdupq_n_u32(0xFFFFFFFFU));                                            /* every channel is above */
+        mask |= vaddvq_u32(vandq_u32(in, vld1q_u32(bit))) << i;                              /* dataset bits */
+    }
+#endif
+    for (; i < len; i++)                                                                     /* scalar tail */
+    {
+        if ((data[i * 4 + 0] > threshold) &&                                                 /* check up */
+            (data[i * 4 + 1] > threshold) &&                                                 /* check down */
+            (data[i * 4 + 2] > threshold) &&                                                 /* check left */
+            (data[i * 4 + 3] > threshold))                                                   /* check right */
         {
-            u_last = data[i][0];                                                         /* set up last */
-            d_last = data[i][1];                                                         /* set down last */
-            l_last = data[i][2];                                                         /* set left last */
-            r_last = data[i][3];                                                         /* set right last */
-            
-            break;                                                                       /* break */
+            mask |= 1UL << i;                                                                /* set the dataset bit */
         }
     }
-    ud_ratio_first = ((u_first - d_first) * 100) / (u_first + d_first);                  /* get ud ratio first */
-    lr_ratio_first = ((l_first - r_first) * 100) / (l_first + r_first);                  /* get lr ratio first */
-    ud_ratio_last = ((u_last - d_last) * 100) / (u_last + d_last);                       /* get ud ratio last */
-    lr_ratio_last = ((l_last - r_last) * 100) / (l_last + r_last);                       /* get lr ratio last */
-    ud_delta = ud_ratio_last - ud_ratio_first;                                           /* get ud delta */
-    lr_delta = lr_ratio_last - lr_ratio_first;                                           /* get lr delta */
-    handle->gesture_ud_delta += ud_delta;                                                /* gesture_ud_delta++ */
-    handle->gesture_lr_delta += lr_delta;                                                /* gesture_lr_delta++ */
     
-    if (handle->gesture_ud_delta >= handle->gesture_sensitivity_1)                       /* check gesture_ud_delta */
-    {
-        handle->gesture_ud_count = 1;                                                    /* set gesture_ud_count 1 */
-    } 
-    else if (handle->gesture_ud_delta  <= -handle->gesture_sensitivity_1)                /* check gesture_ud_delta */
-    {
-        handle->gesture_ud_count = -1;                                                   /* set gesture_ud_count -1 */
-    } 
-    else 
+    return mask;                                                                             /* return the mask */
+}
+
+/**
+ * @brief     get the gesture bit of the ratio deltas
+ * @param[in] ud_delta ud ratio delta
+ * @param[in] lr_delta lr ratio delta
+ * @return    gesture bit
+ * @note      the larger delta gives the axis
+ */
+static uint8_t a_apds9960_gesture_direction(int32_t ud_delta, int32_t lr_delta)
+{
+    if (abs(ud_delta) > abs(lr_delta))                                                   /* ud axis */
     {
-        handle->gesture_ud_count = 0;                                                    /* set gesture_ud_count 0 */
+        return (ud_delta < 0) ? (1 << 4) : (1 << 5);                                     /* right or left */
     }
-    if (handle->gesture_lr_delta >= handle->gesture_sensitivity_1)                       /* check gesture_lr_delta */
-    {
-        handle->gesture_lr_count = 1;                                                    /* set gesture_lr_count 1 */
-    } 
-    else if (handle->gesture_lr_delta <= -handle->gesture_sensitivity_1)                 /* check gesture_lr_delta */
+    else                                                                                 /* lr axis */
     {
-        handle->gesture_lr_count = -1;                                                   /* set gesture_lr_count -1 */
-    } 
-    else 
-    {
-        handle->gesture_lr_count = 0;                                                    /* set gesture_lr_count 0 */
+        return (lr_delta > 0) ? (1 << 2) : (1 << 3);                                     /* down or up */
     }
+}
+
+/**
+ * @brief     get the lead of the dominant ratio delta
+ * @param[in] ud_delta ud ratio delta
+ * @param[in] lr_delta lr ratio delta
+ * @return    confidence
+ * @note      none
+ */
+static int32_t a_apds9960_gesture_margin(int32_t ud_delta, int32_t lr_delta)
+{
+    return abs(abs(ud_delta) - abs(lr_delta));                                           /* return the margin */
+}
+
+/**
+ * @brief     run the gesture callback
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] gesture gesture mask
+ * @param[in] state report state
+ * @param[in] confidence gesture confidence
+ * @note      none
+ */
+static void a_apds9960_gesture_report(apds9960_handle_t *handle, uint8_t gesture, uint8_t state, int32_t confidence)
+{
+    apds9960_gesture_report_t report;
+    
+    report.timestamp = (handle->timestamp_ns != NULL) ? handle->timestamp_ns() : 0;     /* set the timestamp */
+    report.gesture = gesture;                                                            /* set the gesture */
+    report.state = state;                                                                /* set the state */
+    report.confidence = confidence;                                                      /* set the confidence */
+    handle->gesture_callback(handle->user, &report);                                     /* run the gesture callback */
+}
+
+/**
+ * @brief     resolve a gesture at its exit
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *ratio pointer to a ratio decoder structure
+ * @return    gesture bits
+ * @note      none
+ */
+static uint8_t a_apds9960_gesture_end(apds9960_handle_t *handle, apds9960_gesture_ratio_t *ratio)
+{
+    int32_t ud_delta;
+    int32_t lr_delta;
     
-    if ((handle->gesture_ud_count == 0) && (handle->gesture_lr_count == 0))              /* check gesture_ud_count && gesture_lr_count */
+    ud_delta = ratio->ud_delta;                                                          /* get ud delta */
+    lr_delta = ratio->lr_delta;                                                          /* get lr delta */
+    if ((abs(ud_delta) >= handle->gesture_sensitivity_1) ||                              /* check ud delta */
+        (abs(lr_delta) >= handle->gesture_sensitivity_1))                                /* check lr delta */
+    {
+        return a_apds9960_gesture_direction(ud_delta, lr_delta);                         /* the larger delta wins */
+    }
+    if ((ratio->near_count >= 10) &&                                                     /* check near_count */
+        (ratio->far_count >= 2))                                                         /* check far_count */
     {
-        if ((abs(ud_delta) < handle->gesture_sensitivity_2) &&                           /* check ud_delta */
-            (abs(lr_delta) < handle->gesture_sensitivity_2))                             /* check lr_delta */
+        if ((ud_delta == 0) && (lr_delta == 0))                                          /* if ud_delta == 0 && lr_delta == 0 */
+        {
+            return 1 << 1;                                                               /* near */
+        }
+        else if ((ud_delta != 0) && (lr_delta != 0))                                     /* if ud_delta != 0 && lr_delta != 0 */
+        {
+            return 1 << 0;                                                               /* far */
+        }
+        else
         {
-            if ((ud_delta == 0) && (lr_delta == 0))                                      /* if ud_delta == 0 && lr_delta == 0 */
-            {
-                handle->gesture_near_count++;                                            /* gesture_near_count++ */
-            } 
-            else if ((ud_delta != 0) || (lr_delta != 0))                                 /* if ud_delta != 0 && lr_delta != 0 */
-            {
-                handle->gesture_far_count++;                                             /* gesture_far_count++ */
-            }
-            else
-            {
-                
-            }
-            if ((handle->gesture_near_count >= 10) &&                                    /* check gesture_near_count */
-                (handle->gesture_far_count >= 2))                                        /* check gesture_far_count */
-            {
-                if ((ud_delta == 0) && (lr_delta == 0))                                  /* if ud_delta == 0 && lr_delta == 0 */
-                {
-                    handle->gesture_status |= 1 << 1;                                    /* near */
-                } 
-                else if ((ud_delta != 0) && (lr_delta != 0))                             /* if ud_delta != 0 && lr_delta != 0 */
-                {
-                    handle->gesture_status |= 1 << 0;                                    /* far */
-                }
-                else
-                {
                                                                                          /* do nothing */
-                }
-            }
         }
-    } 
-    else 
+    }
+    
+    return 0;                                                                            /* no gesture */
+}
+
+/**
+ * @brief      end the gesture of the ratio decoder
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  *ratio pointer to a ratio decoder structure
+ * @param[out] *gesture pointer to a gesture bits buffer
+ * @note       the gesture is only output here, an early direction reported to the gesture callback
+ *             is confirmed or retracted
+ */
+static void a_apds9960_ratio_exit(apds9960_handle_t *handle, apds9960_gesture_ratio_t *ratio, uint8_t *gesture)
+{
+    int32_t margin;
+    
+    *gesture = a_apds9960_gesture_end(handle, ratio);                                    /* resolve at the exit */
+    if ((ratio->stream == APDS9960_GESTURE_STREAM_EMITTED) &&                            /* an early direction is reported */
+        (handle->gesture_callback != NULL))                                              /* check the callback */
     {
-        if ((abs(ud_delta) < handle->gesture_sensitivity_2) &&                           /* check ud_delta */
-            (abs(lr_delta) < handle->gesture_sensitivity_2))                             /* check lr_delta */
+        margin = a_apds9960_gesture_margin(ratio->ud_delta, ratio->lr_delta);            /* get the final margin */
+        if (*gesture == ratio->early)                                                    /* same direction */
         {
-            if ((ud_delta == 0) && (lr_delta == 0))                                      /* if ud_delta == 0 && lr_delta == 0 */
-            {
-                handle->gesture_near_count++;                                            /* gesture_near_count++ */
-            }
-            if (handle->gesture_near_count >= 10)                                        /* if gesture_near_count >= 10 */
+            a_apds9960_gesture_report(handle, *gesture, APDS9960_GESTURE_REPORT_CONFIRM, margin);             /* confirm */
+        }
+        else
+        {
+            a_apds9960_gesture_report(handle, ratio->early,
+                                      APDS9960_GESTURE_REPORT_RETRACT, margin);          /* retract */
+            if (*gesture != 0)                                                           /* another gesture */
             {
-                handle->gesture_ud_count = 0;                                            /* set gesture_ud_count 0 */
-                handle->gesture_lr_count = 0;                                            /* set gesture_lr_count 0 */
-                handle->gesture_ud_delta = 0;                                            /* set gesture_ud_delta 0 */
-                handle->gesture_lr_delta = 0;                                            /* set gesture_lr_delta 0 */
+                a_apds9960_gesture_report(handle, *gesture, APDS9960_GESTURE_REPORT_CONFIRM, margin);         /* confirm */
             }
         }
     }
+    ratio->early = 0;                                                                    /* set early 0 */
+    ratio->stream = APDS9960_GESTURE_STREAM_IDLE;                                        /* gesture ends */
+    ratio->exit = 0;                                                                     /* set exit 0 */
+}
+
+/**
+ * @brief     init the ratio decoder
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *state ignored, the ratio decoder uses the handle's own state
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_apds9960_ratio_init(apds9960_handle_t *handle, void *state)
+{
+    (void)state;
     
-    decode:
+    memset(&handle->gesture_ratio, 0, sizeof(apds9960_gesture_ratio_t));                /* clear the ratio decoder */
     
-    if ((handle->gesture_ud_count == -1) && (handle->gesture_lr_count == 0))             /* if gesture_ud_count == -1 && gesture_lr_count == 0 */
-    {
-        handle->gesture_status |= 1 << 4;                                                /* right */
-    } 
-    else if ((handle->gesture_ud_count == 1) && (handle->gesture_lr_count == 0))         /* if gesture_ud_count == 1 && gesture_lr_count == 0 */
-    {
-        handle->gesture_status |= 1 << 5;                                                /* left */
-    } 
-    else if ((handle->gesture_ud_count == 0) && (handle->gesture_lr_count == 1))         /* if gesture_ud_count == 0 && gesture_lr_count == 1 */
-    {
-        handle->gesture_status |= 1 << 2;                                                /* down */
-    } 
-    else if ((handle->gesture_ud_count == 0) && (handle->gesture_lr_count == -1))        /* if gesture_ud_count == 0 && gesture_lr_count == -1 */
-    {
-        handle->gesture_status |= 1 << 3;                                                /* up */
-    } 
-    else if ((handle->gesture_ud_count == -1) && (handle->gesture_lr_count == 1))        /* if gesture_ud_count == -1 && gesture_lr_count == 1 */
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     reset the ratio decoder
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *state ignored, the ratio decoder uses the handle's own state
+ * @note      none
+ */
+static void a_apds9960_ratio_reset(apds9960_handle_t *handle, void *state)
+{
+    (void)state;
+    
+    memset(&handle->gesture_ratio, 0, sizeof(apds9960_gesture_ratio_t));                /* clear the ratio decoder */
+}
+
+/**
+ * @brief      feed one dataset to the ratio decoder
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  *state ignored, the ratio decoder uses the handle's own state
+ * @param[in]  *data pointer to one dataset of up, down, left and right
+ * @param[out] *gesture pointer to a gesture bits buffer
+ * @param[out] *second pointer to a second stroke gesture bits buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the ratio decoder has no compound gesture, second is always 0
+ */
+static uint8_t a_apds9960_ratio_feed(apds9960_handle_t *handle, void *state, uint8_t *data, uint8_t *gesture, uint8_t *second)
+{
+    apds9960_gesture_ratio_t *ratio = &handle->gesture_ratio;
+    int32_t ud_ratio, lr_ratio;
+    int32_t ud_step, lr_step;
+    int32_t major, minor;
+    
+    (void)state;
+    
+    *gesture = 0;                                                                        /* no gesture */
+    *second = 0;                                                                         /* no second stroke */
+    if ((data[0] > handle->gesture_threshold) &&                                         /* check gesture threshold */
+        (data[1] > handle->gesture_threshold) &&                                         /* check gesture threshold */
+        (data[2] > handle->gesture_threshold) &&                                         /* check gesture threshold */
+        (data[3] > handle->gesture_threshold)                                            /* check gesture threshold */
+       )
     {
-        if (abs(handle->gesture_ud_delta) > abs(handle->gesture_lr_delta))               /* check gesture_ud_delta && gesture_lr_delta */
-        {
-            handle->gesture_status |= 1 << 4;                                            /* right */
-        } 
-        else 
+        ud_ratio = a_apds9960_gesture_ratio(data[0], data[1]);                           /* get ud ratio */
+        lr_ratio = a_apds9960_gesture_ratio(data[2], data[3]);                           /* get lr ratio */
+        ratio->exit = 0;                                                                 /* the hand is in */
+        if (ratio->stream == APDS9960_GESTURE_STREAM_IDLE)                               /* a new gesture */
         {
-            handle->gesture_status |= 1 << 2;                                            /* down */
+            ratio->ud_first = ud_ratio;                                                  /* set ud first */
+            ratio->lr_first = lr_ratio;                                                  /* set lr first */
+            ratio->ud_last = ud_ratio;                                                   /* set ud last */
+            ratio->lr_last = lr_ratio;                                                   /* set lr last */
+            ratio->ud_delta = 0;                                                         /* set ud_delta 0 */
+            ratio->lr_delta = 0;                                                         /* set lr_delta 0 */
+            ratio->near_count = 0;                                                       /* set near_count 0 */
+            ratio->far_count = 0;                                                        /* set far_count 0 */
+            ratio->stream = APDS9960_GESTURE_STREAM_TRACK;                               /* track the gesture */
+            
+            return 0;                                                                    /* success return 0 */
         }
-    } 
-    else if ((handle->gesture_ud_count == 1) && (handle->gesture_lr_count == -1))        /* if gesture_ud_count == 1 && gesture_lr_count == -1 */
-    {
-        if (abs(handle->gesture_ud_delta) > abs(handle->gesture_lr_delta))               /* check gesture_ud_delta && gesture_lr_delta */
+        
+        ud_step = ud_ratio - ratio->ud_last;                                             /* get ud step */
+        lr_step = lr_ratio - ratio->lr_last;                                             /* get lr step */
+        ratio->ud_last = ud_ratio;                                                       /* set ud last */
+        ratio->lr_last = lr_ratio;                                                       /* set lr last */
+        if ((abs(ud_step) < handle->gesture_sensitivity_2) &&                            /* check ud step */
+            (abs(lr_step) < handle->gesture_sensitivity_2))                              /* check lr step */
         {
-            handle->gesture_status |= 1 << 5;                                            /* left */
-        } 
-        else 
+            if ((ud_step == 0) && (lr_step == 0))                                        /* the hand holds */
+            {
+                ratio->near_count++;                                                     /* near_count++ */
+            }
+            else
+            {
+                ratio->far_count++;                                                      /* far_count++ */
+            }
+        }
+        ratio->ud_delta = ud_ratio - ratio->ud_first;                                    /* get ud delta */
+        ratio->lr_delta = lr_ratio - ratio->lr_first;                                    /* get lr delta */
+        if (ratio->stream != APDS9960_GESTURE_STREAM_TRACK)                              /* already emitted */
         {
-            handle->gesture_status |= 1 << 3;                                            /* up */
+            return 0;                                                                    /* success return 0 */
         }
-    } 
-    else if ((handle->gesture_ud_count == -1) && (handle->gesture_lr_count == -1))       /* if gesture_ud_count == -1 && gesture_lr_count == -1 */
-    {
-        if (abs(handle->gesture_ud_delta) > abs(handle->gesture_lr_delta))               /* check gesture_ud_delta && gesture_lr_delta */
+        
+        major = abs(ratio->ud_delta);                                                    /* get ud delta */
+        minor = abs(ratio->lr_delta);                                                    /* get lr delta */
+        if (minor > major)                                                               /* sort the axes */
         {
-            handle->gesture_status |= 1 << 4;                                            /* right */
-        } 
-        else 
+            major = abs(ratio->lr_delta);                                                /* lr is the major axis */
+            minor = abs(ratio->ud_delta);                                                /* ud is the minor axis */
+        }
+        if ((handle->gesture_callback != NULL) &&                                        /* early commit is opt-in */
+            (major >= handle->gesture_sensitivity_1) &&                                  /* check sensitivity 1 */
+            ((major - minor) >= handle->gesture_confidence))                             /* check confidence */
         {
-            handle->gesture_status |= 1 << 3;                                            /* up */
+            ratio->early = a_apds9960_gesture_direction(ratio->ud_delta, ratio->lr_delta);    /* save the early direction */
+            ratio->stream = APDS9960_GESTURE_STREAM_EMITTED;                             /* wait for the exit */
+            a_apds9960_gesture_report(handle, ratio->early, APDS9960_GESTURE_REPORT_EARLY,
+                                      major - minor);                                    /* report it now */
         }
-    } 
-    else if ((handle->gesture_ud_count == 1) && (handle->gesture_lr_count == 1))         /* if gesture_ud_count == 1 && gesture_lr_count == 1 */
+    }
+    else
     {
-        if (abs(handle->gesture_ud_delta) > abs(handle->gesture_lr_delta))               /* check gesture_ud_delta && gesture_lr_delta */
+        if (ratio->stream == APDS9960_GESTURE_STREAM_IDLE)                               /* no gesture */
         {
-            handle->gesture_status |= 1 << 5;                                            /* left */
-        } 
-        else 
+            return 0;                                                                    /* success return 0 */
+        }
+        ratio->exit++;                                                                   /* exit++ */
+        if (ratio->exit < APDS9960_GESTURE_EXIT_FRAMES)                                  /* the hand may be back */
         {
-            handle->gesture_status |= 1 << 2;                                            /* down */
+            return 0;                                                                    /* success return 0 */
         }
+        a_apds9960_ratio_exit(handle, ratio, gesture);                                   /* end the gesture */
     }
-    else
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      end the gesture of the ratio decoder now
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  *state ignored, the ratio decoder uses the handle's own state
+ * @param[out] *gesture pointer to a gesture bits buffer
+ * @param[out] *second pointer to a second stroke gesture bits buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the ratio decoder has no compound gesture, second is always 0
+ */
+static uint8_t a_apds9960_ratio_flush(apds9960_handle_t *handle, void *state, uint8_t *gesture, uint8_t *second)
+{
+    (void)state;
+    
+    *gesture = 0;                                                                        /* no gesture */
+    *second = 0;                                                                         /* no second stroke */
+    if (handle->gesture_ratio.stream != APDS9960_GESTURE_STREAM_IDLE)                    /* a gesture is tracked */
     {
-        
+        a_apds9960_ratio_exit(handle, &handle->gesture_ratio, gesture);                  /* end the gesture */
     }
     
     return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the gesture decode threshold
+ * @brief built-in streaming ratio decoder
+ */
+const apds9960_gesture_decoder_t g_apds9960_gesture_decoder_ratio =
+{
+    "ratio",                          /* name */
+    a_apds9960_ratio_init,            /* init */
+    a_apds9960_ratio_feed,            /* feed */
+    a_apds9960_ratio_flush,           /* flush */
+    a_apds9960_ratio_reset,           /* reset */
+};
+
+/**
+ * @brief     decode gestures from the fifo data
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] threshold gesture decode threshold
+ * @param[in] **data pointer to data buffer
+ * @param[in] len length of the data buffer
  * @return    status code
  *            - 0 success
- *            - 1 set gesture decode threshold failed
+ *            - 1 decode gesture from fifo failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_gesture_decode_threshold(apds9960_handle_t *handle, uint8_t threshold)
+uint8_t apds9960_gesture_decode(apds9960_handle_t *handle, uint8_t (*data)[4], uint8_t len)
 {
-    if (handle == NULL)                           /* check handle */
+    uint8_t i;
+    uint8_t gesture;
+    uint8_t second;
+    
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                 /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                      /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                 /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    handle->gesture_threshold = threshold;        /* set threshold */
+    for (i = 0; i < len; i++)                                                            /* run len times */
+    {
+        if (handle->gesture_decoder->feed(handle, handle->gesture_decoder_state,
+                                          data[i], &gesture, &second) != 0)              /* decode one dataset */
+        {
+            handle->debug_print("apds9960: decode gesture from fifo failed.\n");         /* decode gesture from fifo failed */
+            
+            return 1;                                                                    /* return error */
+        }
+        handle->gesture_status |= gesture;                                               /* save the gesture */
+        handle->gesture_second |= second;                                                /* save the second stroke */
+    }
     
-    return 0;                                     /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      get the gesture decode threshold
+ * @brief      decode gestures from one fifo dataset
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *threshold pointer to a gesture decode threshold buffer
+ * @param[in]  *data pointer to one dataset of up, down, left and right
+ * @param[out] *gesture pointer to a gesture bits buffer
+ * @param[out] *second pointer to a second stroke gesture bits buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture decode threshold failed
+ *             - 1 decode gesture from dataset failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_decode_threshold(apds9960_handle_t *handle, uint8_t *threshold)
+uint8_t apds9960_gesture_decode_dataset(apds9960_handle_t *handle, uint8_t *data, uint8_t *gesture, uint8_t *second)
 {
-    if (handle == NULL)                           /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                 /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                      /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                 /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    *threshold = handle->gesture_threshold;       /* get threshold */
-    
-    return 0;                                     /* success return 0 */
-}
-
-/**
- * @brief     set the gesture decode sensitivity 1
- * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] sensitivity gesture decode sensitivity
- * @return    status code
- *            - 0 success
- *            - 1 set gesture decode sensitivity 1 failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t apds9960_set_gesture_decode_sensitivity_1(apds9960_handle_t *handle, int32_t sensitivity)
-{
-    if (handle == NULL)                                 /* check handle */
-    {
-        return 2;                                       /* return error */
-    }
-    if (handle->inited != 1)                            /* check handle initialization */
+    if (handle->gesture_decoder->feed(handle, handle->gesture_decoder_state,
+                                      data, gesture, second) != 0)                       /* decode one dataset */
     {
-        return 3;                                       /* return error */
+        handle->debug_print("apds9960: decode gesture from dataset failed.\n");          /* decode gesture from dataset failed */
+        
+        return 1;                                                                        /* return error */
     }
+    handle->gesture_status |= *gesture;                                                  /* save the gesture */
+    handle->gesture_second |= *second;                                                   /* save the second stroke */
     
-    handle->gesture_sensitivity_1 = sensitivity;        /* set sensitivity */
-    
-    return 0;                                           /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      get the gesture decode sensitivity 1
+ * @brief      end the gesture being decoded
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *sensitivity pointer to a gesture decode sensitivity buffer
+ * @param[out] *gesture pointer to a gesture bits buffer
+ * @param[out] *second pointer to a second stroke gesture bits buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture decode sensitivity 1 failed
+ *             - 1 flush gesture decoder failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_decode_sensitivity_1(apds9960_handle_t *handle, int32_t *sensitivity)
+uint8_t apds9960_gesture_decode_flush(apds9960_handle_t *handle, uint8_t *gesture, uint8_t *second)
 {
-    if (handle == NULL)                                 /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                       /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                            /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                       /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    *sensitivity = handle->gesture_sensitivity_1;       /* get sensitivity */
-    
-    return 0;                                           /* success return 0 */
-}
-
-/**
- * @brief     set the gesture decode sensitivity 2
- * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] sensitivity gesture decode sensitivity
- * @return    status code
- *            - 0 success
- *            - 1 set gesture decode sensitivity 2 failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t apds9960_set_gesture_decode_sensitivity_2(apds9960_handle_t *handle, int32_t sensitivity)
-{
-    if (handle == NULL)                                 /* check handle */
+    *gesture = 0;                                                                        /* no gesture */
+    *second = 0;                                                                         /* no second stroke */
+    if (handle->gesture_decoder->flush == NULL)                                          /* no flush */
     {
-        return 2;                                       /* return error */
+        return 0;                                                                        /* success return 0 */
     }
-    if (handle->inited != 1)                            /* check handle initialization */
+    if (handle->gesture_decoder->flush(handle, handle->gesture_decoder_state,
+                                       gesture, second) != 0)                            /* flush the decoder */
     {
-        return 3;                                       /* return error */
+        handle->debug_print("apds9960: flush gesture decoder failed.\n");                /* flush gesture decoder failed */
+        
+        return 1;                                                                        /* return error */
     }
+    handle->gesture_status |= *gesture;                                                  /* save the gesture */
+    handle->gesture_second |= *second;                                                   /* save the second stroke */
     
-    handle->gesture_sensitivity_2 = sensitivity;        /* set sensitivity */
-    
-    return 0;                                           /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      get the gesture decode sensitivity 2
+ * @brief      get the ud and lr ratios of fifo datasets
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *sensitivity pointer to a gesture decode sensitivity buffer
+ * @param[in]  **data pointer to data buffer
+ * @param[in]  len length of the data buffer
+ * @param[out] **ratio pointer to a ud and lr ratio buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture decode sensitivity 2 failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_decode_sensitivity_2(apds9960_handle_t *handle, int32_t *sensitivity)
+uint8_t apds9960_gesture_ratio(apds9960_handle_t *handle, uint8_t (*data)[4], uint8_t len, int32_t (*ratio)[2])
 {
-    if (handle == NULL)                                 /* check handle */
+    uint8_t i;
+    
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                       /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                            /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                       /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    *sensitivity = handle->gesture_sensitivity_2;       /* get sensitivity */
+    for (i = 0; i < len; i++)                                                            /* run len times */
+    {
+        ratio[i][0] = a_apds9960_gesture_ratio(data[i][0], data[i][1]);                  /* get ud ratio */
+        ratio[i][1] = a_apds9960_gesture_ratio(data[i][2], data[i][3]);                  /* get lr ratio */
+    }
     
-    return 0;                                           /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the configuration
+ * @brief      find the fifo datasets above the gesture decode threshold
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  **data pointer to data buffer
+ * @param[in]  len length of the data buffer
+ * @param[out] *mask pointer to a dataset mask buffer
+ * @param[out] *first pointer to a first dataset index buffer
+ * @param[out] *last pointer to a last dataset index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 len is over the fifo depth
+ * @note       none
+ */
+uint8_t apds9960_gesture_scan(apds9960_handle_t *handle, uint8_t (*data)[4], uint8_t len,
+                              uint32_t *mask, uint8_t *first, uint8_t *last)
+{
+    uint32_t m;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (len > APDS9960_GESTURE_FIFO_DEPTH)                                               /* check len */
+    {
+        handle->debug_print("apds9960: len is over the fifo depth.\n");                  /* len is over the fifo depth */
+        
+        return 4;                                                                        /* return error */
+    }
+    
+    m = a_apds9960_gesture_scan(&data[0][0], len, handle->gesture_threshold);            /* scan the datasets */
+    *mask = m;                                                                           /* set the mask */
+    if (m == 0)                                                                          /* no dataset */
+    {
+        *first = len;                                                                    /* no first dataset */
+        *last = len;                                                                     /* no last dataset */
+        
+        return 0;                                                                        /* success return 0 */
+    }
+#if defined(__GNUC__)
+    *first = (uint8_t)__builtin_ctzl(m);                                                 /* lowest set bit */
+    *last = (uint8_t)(sizeof(unsigned long) * 8 - 1 - __builtin_clzl(m));                /* highest set bit */
+#else
+    *first = 0;                                                                          /* from the first dataset */
+    while (((m >> *first) & 1) == 0)                                                     /* find the lowest set bit */
+    {
+        (*first)++;                                                                      /* next dataset */
+    }
+    *last = 31;                                                                          /* from the last bit */
+    while (((m >> *last) & 1) == 0)                                                      /* find the highest set bit */
+    {
+        (*last)--;                                                                       /* previous dataset */
+    }
+#endif
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     set the gesture decoder
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] conf chip configuration
- * @param[in] enable bool value
+ * @param[in] *decoder pointer to a gesture decoder, NULL selects g_apds9960_gesture_decoder_ratio
+ * @param[in] *state pointer to the decoder state
  * @return    status code
  *            - 0 success
- *            - 1 set conf failed
+ *            - 1 set gesture decoder failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 4 decoder feed is NULL
  * @note      none
  */
-uint8_t apds9960_set_conf(apds9960_handle_t *handle, apds9960_conf_t conf, apds9960_bool_t enable)
+uint8_t apds9960_set_gesture_decoder(apds9960_handle_t *handle, const apds9960_gesture_decoder_t *decoder, void *state)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_ENABLE, (uint8_t *)&prev, 1);        /* get enable */
-    if (res != 0)                                                                       /* check result */
+    if (decoder == NULL)                                                                 /* use the default one */
     {
-        handle->debug_print("apds9960: get enable failed.\n");                          /* get enable failed */
-       
-        return 1;                                                                       /* return error */
+        decoder = &g_apds9960_gesture_decoder_ratio;                                     /* set the ratio decoder */
     }
-    prev &= ~(1 << conf);                                                               /* clear conf */
-    prev |= enable << conf;                                                             /* set conf */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_ENABLE, (uint8_t *)&prev, 1);       /* set enable */
-    if (res != 0)                                                                       /* check result */
+    if (decoder->feed == NULL)                                                           /* check the feed */
     {
-        handle->debug_print("apds9960: set enable failed.\n");                          /* set enable failed */
-       
-        return 1;                                                                       /* return error */
+        handle->debug_print("apds9960: decoder feed is null.\n");                        /* decoder feed is null */
+        
+        return 4;                                                                        /* return error */
     }
+    if (decoder->init != NULL)                                                           /* check the init */
+    {
+        if (decoder->init(handle, state) != 0)                                           /* init the decoder */
+        {
+            handle->debug_print("apds9960: init gesture decoder failed.\n");             /* init gesture decoder failed */
+            
+            return 1;                                                                    /* return error */
+        }
+    }
+    handle->gesture_decoder = decoder;                                                   /* set the decoder */
+    handle->gesture_decoder_state = state;                                               /* set the state */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      get the configuration
+ * @brief      get the gesture decoder
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[in]  conf chip configuration
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] **decoder pointer to a gesture decoder buffer
+ * @param[out] **state pointer to a decoder state buffer
  * @return     status code
  *             - 0 success
- *             - 1 get conf failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_conf(apds9960_handle_t *handle, apds9960_conf_t conf, apds9960_bool_t *enable)
+uint8_t apds9960_get_gesture_decoder(apds9960_handle_t *handle, const apds9960_gesture_decoder_t **decoder, void **state)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                                /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                      /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                           /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                      /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_ENABLE, (uint8_t *)&prev, 1);       /* get enable */
-    if (res != 0)                                                                      /* check result */
-    {
-        handle->debug_print("apds9960: get enable failed.\n");                         /* get enable failed */
-       
-        return 1;                                                                      /* return error */
-    }
-    *enable = (apds9960_bool_t)((prev >> conf) & 0x01);                                /* get bool */
+    *decoder = handle->gesture_decoder;                                                  /* get the decoder */
+    *state = handle->gesture_decoder_state;                                              /* get the state */
     
-    return 0;                                                                          /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the adc integration time
+ * @brief     set the gesture decode threshold
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] integration_time adc integration time
+ * @param[in] threshold gesture decode threshold
  * @return    status code
  *            - 0 success
- *            - 1 set adc integration time failed
+ *            - 1 set gesture decode threshold failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_adc_integration_time(apds9960_handle_t *handle, uint8_t integration_time)
+uint8_t apds9960_set_gesture_decode_threshold(apds9960_handle_t *handle, uint8_t threshold)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                                /* check handle */
+    if (handle == NULL)                           /* check handle */
     {
-        return 2;                                                                      /* return error */
+        return 2;                                 /* return error */
     }
-    if (handle->inited != 1)                                                           /* check handle initialization */
+    if (handle->inited != 1)                      /* check handle initialization */
     {
-        return 3;                                                                      /* return error */
+        return 3;                                 /* return error */
     }
     
-    prev = integration_time;                                                           /* set integration time */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_ATIME, (uint8_t *)&prev, 1);       /* set atime */
-    if (res != 0)                                                                      /* check result */
-    {
-        handle->debug_print("apds9960: set atime failed.\n");                          /* set atime failed */
-       
-        return 1;                                                                      /* return error */
-    }
+    handle->gesture_threshold = threshold;        /* set threshold */
     
-    return 0;                                                                          /* success return 0 */
+    return 0;                                     /* success return 0 */
 }
 
 /**
- * @brief      get the adc integration time
+ * @brief      get the gesture decode threshold
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *integration_time pointer to an adc integration time buffer
+ * @param[out] *threshold pointer to a gesture decode threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 get adc integration time failed
+ *             - 1 get gesture decode threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_adc_integration_time(apds9960_handle_t *handle, uint8_t *integration_time)
+uint8_t apds9960_get_gesture_decode_threshold(apds9960_handle_t *handle, uint8_t *threshold)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                               /* check handle */
+    if (handle == NULL)                           /* check handle */
     {
-        return 2;                                                                     /* return error */
+        return 2;                                 /* return error */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle->inited != 1)                      /* check handle initialization */
     {
-        return 3;                                                                     /* return error */
+        return 3;                                 /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_ATIME, (uint8_t *)&prev, 1);       /* get atime */
-    if (res != 0)                                                                     /* check result */
-    {
-        handle->debug_print("apds9960: get atime failed.\n");                         /* get atime failed */
-       
-        return 1;                                                                     /* return error */
-    }
-    *integration_time = prev;                                                         /* get integration time */
+    *threshold = handle->gesture_threshold;       /* get threshold */
     
-    return 0;                                                                         /* success return 0 */
+    return 0;                                     /* success return 0 */
 }
 
 /**
- * @brief      convert the adc integration time to the register raw data
- * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[in]  ms integration time
- * @param[out] *reg pointer to a register raw buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     set the gesture decode sensitivity 1
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] sensitivity gesture decode sensitivity
+ * @return    status code
+ *            - 0 success
+ *            - 1 set gesture decode sensitivity 1 failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t apds9960_adc_integration_time_convert_to_register(apds9960_handle_t *handle, float ms, uint8_t *reg)
+uint8_t apds9960_set_gesture_decode_sensitivity_1(apds9960_handle_t *handle, int32_t sensitivity)
 {
-    if (handle == NULL)                        /* check handle */
+    if (handle == NULL)                                 /* check handle */
     {
-        return 2;                              /* return error */
+        return 2;                                       /* return error */
     }
-    if (handle->inited != 1)                   /* check handle initialization */
+    if (handle->inited != 1)                            /* check handle initialization */
     {
-        return 3;                              /* return error */
+        return 3;                                       /* return error */
     }
     
-    *reg = (uint8_t)(256.0f - ms / 2.78f);     /* convert real data to register data */
+    handle->gesture_sensitivity_1 = sensitivity;        /* set sensitivity */
     
-    return 0;                                  /* success return 0 */
+    return 0;                                           /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the integration time
+ * @brief      get the gesture decode sensitivity 1
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[in]  reg register raw data
- * @param[out] *ms pointer to an adc integration time buffer
+ * @param[out] *sensitivity pointer to a gesture decode sensitivity buffer
  * @return     status code
  *             - 0 success
+ *             - 1 get gesture decode sensitivity 1 failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_adc_integration_time_convert_to_data(apds9960_handle_t *handle, uint8_t reg, float *ms)
+uint8_t apds9960_get_gesture_decode_sensitivity_1(apds9960_handle_t *handle, int32_t *sensitivity)
 {
-    if (handle == NULL)                      /* check handle */
+    if (handle == NULL)                                 /* check handle */
     {
-        return 2;                            /* return error */
+        return 2;                                       /* return error */
     }
-    if (handle->inited != 1)                 /* check handle initialization */
+    if (handle->inited != 1)                            /* check handle initialization */
     {
-        return 3;                            /* return error */
+        return 3;                                       /* return error */
     }
     
-    *ms = (float)(256 - reg) * 2.78f;        /* convert raw data to real data */
+    *sensitivity = handle->gesture_sensitivity_1;       /* get sensitivity */
     
-    return 0;                                /* success return 0 */
+    return 0;                                           /* success return 0 */
 }
 
 /**
- * @brief     set the wait time
+ * @brief     set the gesture decode sensitivity 2
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] wait_time wait time
+ * @param[in] sensitivity gesture decode sensitivity
  * @return    status code
  *            - 0 success
- *            - 1 set wait time failed
+ *            - 1 set gesture decode sensitivity 2 failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_wait_time(apds9960_handle_t *handle, uint8_t wait_time)
+uint8_t apds9960_set_gesture_decode_sensitivity_2(apds9960_handle_t *handle, int32_t sensitivity)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                                /* check handle */
+    if (handle == NULL)                                 /* check handle */
     {
-        return 2;                                                                      /* return error */
+        return 2;                                       /* return error */
     }
-    if (handle->inited != 1)                                                           /* check handle initialization */
+    if (handle->inited != 1)                            /* check handle initialization */
     {
-        return 3;                                                                      /* return error */
+        return 3;                                       /* return error */
     }
     
-    prev = wait_time;                                                                  /* set wait time */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_WTIME, (uint8_t *)&prev, 1);       /* set wtime */
-    if (res != 0)                                                                      /* check result */
-    {
-        handle->debug_print("apds9960: set wtime failed.\n");                          /* set wtime failed */
-       
-        return 1;                                                                      /* return error */
-    }
+    handle->gesture_sensitivity_2 = sensitivity;        /* set sensitivity */
     
-    return 0;                                                                          /* success return 0 */
+    return 0;                                           /* success return 0 */
 }
 
 /**
- * @brief      get the wait time
+ * @brief      get the gesture decode sensitivity 2
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *wait_time pointer to a wait time buffer
+ * @param[out] *sensitivity pointer to a gesture decode sensitivity buffer
  * @return     status code
  *             - 0 success
- *             - 1 get wait time failed
+ *             - 1 get gesture decode sensitivity 2 failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_wait_time(apds9960_handle_t *handle, uint8_t *wait_time)
+uint8_t apds9960_get_gesture_decode_sensitivity_2(apds9960_handle_t *handle, int32_t *sensitivity)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                               /* check handle */
+    if (handle == NULL)                                 /* check handle */
     {
-        return 2;                                                                     /* return error */
+        return 2;                                       /* return error */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle->inited != 1)                            /* check handle initialization */
     {
-        return 3;                                                                     /* return error */
+        return 3;                                       /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_WTIME, (uint8_t *)&prev, 1);       /* get wtime */
-    if (res != 0)                                                                     /* check result */
-    {
-        handle->debug_print("apds9960: get wtime failed.\n");                         /* get wtime failed */
-       
-        return 1;                                                                     /* return error */
-    }
-    *wait_time = prev;                                                                /* get wait time */
+    *sensitivity = handle->gesture_sensitivity_2;       /* get sensitivity */
     
-    return 0;                                                                         /* success return 0 */
+    return 0;                                           /* success return 0 */
 }
 
 /**
- * @brief      convert the wait time to the register raw data
- * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[in]  ms wait time
- * @param[out] *reg pointer to a register raw buffer
- * @return     status code
- *             - 0 success
- *             - 1 get configuration register 1 failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     set the gesture decode confidence
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] confidence gesture decode confidence
+ * @return    status code
+ *            - 0 success
+ *            - 1 set gesture decode confidence failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t apds9960_wait_time_convert_to_register(apds9960_handle_t *handle, float ms, uint8_t *reg)
+uint8_t apds9960_set_gesture_decode_confidence(apds9960_handle_t *handle, int32_t confidence)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                                  /* check handle */
-    {
-        return 2;                                                                        /* return error */
-    }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle == NULL)                                /* check handle */
     {
-        return 3;                                                                        /* return error */
+        return 2;                                      /* return error */
     }
-    
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG1, (uint8_t *)&prev, 1);        /* get configuration register 1 */
-    if (res != 0)                                                                        /* check result */
+    if (handle->inited != 1)                           /* check handle initialization */
     {
-        handle->debug_print("apds9960: get configuration register 1 failed.\n");         /* get configuration register 1 failed */
-       
-        return 1;                                                                        /* return error */
+        return 3;                                      /* return error */
     }
     
-    if ((prev & (1 << 1)) != 0)                                                          /* check wait long */
-    {
-        *reg = (uint8_t)(256.0f - ms / (2.78f * 12.0f));                                 /* convert real data to register data */
-    }
-    else
-    {
-        *reg = (uint8_t)(256.0f - ms / 2.78f);                                           /* convert real data to register data */
-    }
+    handle->gesture_confidence = confidence;           /* set confidence */
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                          /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the wait time
+ * @brief      get the gesture decode confidence
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[in]  reg register raw data
- * @param[out] *ms pointer to a wait time buffer
+ * @param[out] *confidence pointer to a gesture decode confidence buffer
  * @return     status code
  *             - 0 success
- *             - 1 get configuration register 1 failed
+ *             - 1 get gesture decode confidence failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_wait_time_convert_to_data(apds9960_handle_t *handle, uint8_t reg, float *ms)
+uint8_t apds9960_get_gesture_decode_confidence(apds9960_handle_t *handle, int32_t *confidence)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                                  /* check handle */
-    {
-        return 2;                                                                        /* return error */
-    }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle == NULL)                                /* check handle */
     {
-        return 3;                                                                        /* return error */
+        return 2;                                      /* return error */
     }
-    
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG1, (uint8_t *)&prev, 1);        /* get configuration register 1 */
-    if (res != 0)                                                                        /* check result */
+    if (handle->inited != 1)                           /* check handle initialization */
     {
-        handle->debug_print("apds9960: get configuration register 1 failed.\n");         /* get configuration register 1 failed */
-       
-        return 1;                                                                        /* return error */
+        return 3;                                      /* return error */
     }
     
-    if ((prev & (1 << 1)) != 0)                                                          /* check wait long */
-    {
-        *ms = (float)(256 - reg) * 2.78f * 12.0f;                                        /* convert raw data to real data */
-    }
-    else
-    {
-        *ms = (float)(256 - reg) * 2.78f;                                                /* convert raw data to real data */
-    }
+    *confidence = handle->gesture_confidence;          /* get confidence */
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                          /* success return 0 */
 }
 
 /**
- * @brief     set the als interrupt low threshold
+ * @brief     set the configuration
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] threshold low threshold
+ * @param[in] conf chip configuration
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set als interrupt low threshold failed
+ *            - 1 set conf failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_als_interrupt_low_threshold(apds9960_handle_t *handle, uint16_t threshold)
+uint8_t apds9960_set_conf(apds9960_handle_t *handle, apds9960_conf_t conf, apds9960_bool_t enable)
 {
     uint8_t res;
-    uint8_t buf[2];
+    uint8_t prev;
     
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    buf[0] = (threshold >> 0) & 0xFF;                                                /* set lsb */
-    buf[1] = (threshold >> 8) & 0xFF;                                                /* set msb */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_AILTL, (uint8_t *)buf, 2);       /* set ailtl */
-    if (res != 0)                                                                    /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_ENABLE, (uint8_t *)&prev, 1);        /* get enable */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("apds9960: set ailtl failed.\n");                        /* set ailtl failed */
+        handle->debug_print("apds9960: get enable failed.\n");                          /* get enable failed */
        
-        return 1;                                                                    /* return error */
+        return 1;                                                                       /* return error */
+    }
+    prev &= ~(1 << conf);                                                               /* clear conf */
+    prev |= enable << conf;                                                             /* set conf */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_ENABLE, (uint8_t *)&prev, 1);       /* set enable */
+    if (res != 0)                                                                       /* check result */
+    {
+        handle->debug_print("apds9960: set enable failed.\n");                          /* set enable failed */
+       
+        return 1;                                                                       /* return error */
     }
     
-    return 0;                                                                        /* success return 0 */
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief      get the als interrupt low threshold
+ * @brief      get the configuration
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *threshold pointer to a low threshold buffer
+ * @param[in]  conf chip configuration
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get als interrupt low threshold failed
+ *             - 1 get conf failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_als_interrupt_low_threshold(apds9960_handle_t *handle, uint16_t *threshold)
+uint8_t apds9960_get_conf(apds9960_handle_t *handle, apds9960_conf_t conf, apds9960_bool_t *enable)
 {
     uint8_t res;
-    uint8_t buf[2];
+    uint8_t prev;
     
-    if (handle == NULL)                                                             /* check handle */
+    if (handle == NULL)                                                                /* check handle */
     {
-        return 2;                                                                   /* return error */
+        return 2;                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                        /* check handle initialization */
+    if (handle->inited != 1)                                                           /* check handle initialization */
     {
-        return 3;                                                                   /* return error */
+        return 3;                                                                      /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_AILTL, (uint8_t *)buf, 2);       /* get ailtl */
-    if (res != 0)                                                                   /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_ENABLE, (uint8_t *)&prev, 1);       /* get enable */
+    if (res != 0)                                                                      /* check result */
     {
-        handle->debug_print("apds9960: get ailtl failed.\n");                       /* get ailtl failed */
+        handle->debug_print("apds9960: get enable failed.\n");                         /* get enable failed */
        
-        return 1;                                                                   /* return error */
+        return 1;                                                                      /* return error */
     }
-    *threshold = (uint16_t)(((uint16_t)buf[1] << 8) | buf[0]);                      /* set threshold */
+    *enable = (apds9960_bool_t)((prev >> conf) & 0x01);                                /* get bool */
     
-    return 0;                                                                       /* success return 0 */
+    return 0;                                                                          /* success return 0 */
 }
 
 /**
- * @brief     set the als interrupt high threshold
+ * @brief     set the adc integration time
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] threshold high threshold
+ * @param[in] integration_time adc integration time
  * @return    status code
  *            - 0 success
- *            - 1 set als interrupt high threshold failed
+ *            - 1 set adc integration time failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_als_interrupt_high_threshold(apds9960_handle_t *handle, uint16_t threshold)
+uint8_t apds9960_set_adc_integration_time(apds9960_handle_t *handle, uint8_t integration_time)
 {
     uint8_t res;
-    uint8_t buf[2];
+    uint8_t prev;
     
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                                                                /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                           /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                                                      /* return error */
     }
     
-    buf[0] = (threshold >> 0) & 0xFF;                                                /* set lsb */
-    buf[1] = (threshold >> 8) & 0xFF;                                                /* set msb */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_AIHTL, (uint8_t *)buf, 2);       /* set aihtl */
-    if (res != 0)                                                                    /* check result */
+    prev = integration_time;                                                           /* set integration time */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_ATIME, (uint8_t *)&prev, 1);       /* set atime */
+    if (res != 0)                                                                      /* check result */
     {
-        handle->debug_print("apds9960: set aihtl failed.\n");                        /* set aihtl failed */
+        handle->debug_print("apds9960: set atime failed.\n");                          /* set atime failed */
        
-        return 1;                                                                    /* return error */
+        return 1;                                                                      /* return error */
     }
     
-    return 0;                                                                        /* success return 0 */
+    return 0;                                                                          /* success return 0 */
 }
 
 /**
- * @brief      get the als interrupt high threshold
+ * @brief      get the adc integration time
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *threshold pointer to a high threshold buffer
+ * @param[out] *integration_time pointer to an adc integration time buffer
  * @return     status code
  *             - 0 success
- *             - 1 get als interrupt high threshold failed
+ *             - 1 get adc integration time failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_als_interrupt_high_threshold(apds9960_handle_t *handle, uint16_t *threshold)
-{
-    uint8_t res;
-    uint8_t buf[2];
-    
-    if (handle == NULL)                                                             /* check handle */
-    {
-        return 2;                                                                   /* return error */
-    }
-    if (handle->inited != 1)                                                        /* check handle initialization */
-    {
-        return 3;                                                                   /* return error */
-    }
-    
-    res = a_apds9960_iic_read(handle, APDS9960_REG_AIHTL, (uint8_t *)buf, 2);       /* get aihtl */
-    if (res != 0)                                                                   /* check result */
-    {
-        handle->debug_print("apds9960: get aihtl failed.\n");                       /* get aihtl failed */
-       
-        return 1;                                                                   /* return error */
-    }
-    *threshold = (uint16_t)(((uint16_t)buf[1] << 8) | buf[0]);                      /* set threshold */
-    
-    return 0;                                                                       /* success return 0 */
-}
-
-/**
- * @brief     set the proximity interrupt low threshold
- * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] threshold low threshold
- * @return    status code
- *            - 0 success
- *            - 1 set proximity interrupt low threshold failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t apds9960_set_proximity_interrupt_low_threshold(apds9960_handle_t *handle, uint8_t threshold)
+uint8_t apds9960_get_adc_integration_time(apds9960_handle_t *handle, uint8_t *integration_time)
 {
     uint8_t res;
     uint8_t prev;
@@ -1473,722 +2410,712 @@ uint8_t apds9960_set_proximity_interrupt_low_threshold(apds9960_handle_t *handle
         return 3;                                                                     /* return error */
     }
     
-    prev = threshold;                                                                 /* set low threshold */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_PILT, (uint8_t *)&prev, 1);       /* set pilt */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_ATIME, (uint8_t *)&prev, 1);       /* get atime */
     if (res != 0)                                                                     /* check result */
     {
-        handle->debug_print("apds9960: set pilt failed.\n");                          /* set pilt failed */
+        handle->debug_print("apds9960: get atime failed.\n");                         /* get atime failed */
        
         return 1;                                                                     /* return error */
     }
+    *integration_time = prev;                                                         /* get integration time */
     
     return 0;                                                                         /* success return 0 */
 }
 
 /**
- * @brief      get the proximity interrupt low threshold
+ * @brief      convert the adc integration time to the register raw data
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *threshold pointer to a low threshold buffer
+ * @param[in]  ms integration time
+ * @param[out] *reg pointer to a register raw buffer
  * @return     status code
  *             - 0 success
- *             - 1 get proximity interrupt low threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_proximity_interrupt_low_threshold(apds9960_handle_t *handle, uint8_t *threshold)
+uint8_t apds9960_adc_integration_time_convert_to_register(apds9960_handle_t *handle, float ms, uint8_t *reg)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                        /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                              /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                   /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                              /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_PILT, (uint8_t *)&prev, 1);       /* get pilt */
-    if (res != 0)                                                                    /* check result */
+    *reg = (uint8_t)(256.0f - ms / 2.78f);     /* convert real data to register data */
+    
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief      convert the register raw data to the integration time
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  reg register raw data
+ * @param[out] *ms pointer to an adc integration time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t apds9960_adc_integration_time_convert_to_data(apds9960_handle_t *handle, uint8_t reg, float *ms)
+{
+    if (handle == NULL)                      /* check handle */
     {
-        handle->debug_print("apds9960: get pilt failed.\n");                         /* get pilt failed */
-       
-        return 1;                                                                    /* return error */
+        return 2;                            /* return error */
+    }
+    if (handle->inited != 1)                 /* check handle initialization */
+    {
+        return 3;                            /* return error */
     }
-    *threshold = prev;                                                               /* get low threshold */
     
-    return 0;                                                                        /* success return 0 */
+    *ms = (float)(256 - reg) * 2.78f;        /* convert raw data to real data */
+    
+    return 0;                                /* success return 0 */
 }
 
 /**
- * @brief     set the proximity interrupt high threshold
+ * @brief     set the wait time
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] threshold high threshold
+ * @param[in] wait_time wait time
  * @return    status code
  *            - 0 success
- *            - 1 set proximity interrupt high threshold failed
+ *            - 1 set wait time failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_proximity_interrupt_high_threshold(apds9960_handle_t *handle, uint8_t threshold)
+uint8_t apds9960_set_wait_time(apds9960_handle_t *handle, uint8_t wait_time)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                               /* check handle */
+    if (handle == NULL)                                                                /* check handle */
     {
-        return 2;                                                                     /* return error */
+        return 2;                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle->inited != 1)                                                           /* check handle initialization */
     {
-        return 3;                                                                     /* return error */
+        return 3;                                                                      /* return error */
     }
     
-    prev = threshold;                                                                 /* set high threshold */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_PIHT, (uint8_t *)&prev, 1);       /* set piht */
-    if (res != 0)                                                                     /* check result */
+    prev = wait_time;                                                                  /* set wait time */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_WTIME, (uint8_t *)&prev, 1);       /* set wtime */
+    if (res != 0)                                                                      /* check result */
     {
-        handle->debug_print("apds9960: set piht failed.\n");                          /* set piht failed */
+        handle->debug_print("apds9960: set wtime failed.\n");                          /* set wtime failed */
        
-        return 1;                                                                     /* return error */
+        return 1;                                                                      /* return error */
     }
     
-    return 0;                                                                         /* success return 0 */
+    return 0;                                                                          /* success return 0 */
 }
 
 /**
- * @brief      get the proximity interrupt high threshold
+ * @brief      get the wait time
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *threshold pointer to a high threshold buffer
+ * @param[out] *wait_time pointer to a wait time buffer
  * @return     status code
  *             - 0 success
- *             - 1 get proximity interrupt high threshold failed
+ *             - 1 get wait time failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_proximity_interrupt_high_threshold(apds9960_handle_t *handle, uint8_t *threshold)
+uint8_t apds9960_get_wait_time(apds9960_handle_t *handle, uint8_t *wait_time)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                                                               /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                          /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                                                     /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_PIHT, (uint8_t *)&prev, 1);       /* get piht */
-    if (res != 0)                                                                    /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_WTIME, (uint8_t *)&prev, 1);       /* get wtime */
+    if (res != 0)                                                                     /* check result */
     {
-        handle->debug_print("apds9960: get piht failed.\n");                         /* get piht failed */
+        handle->debug_print("apds9960: get wtime failed.\n");                         /* get wtime failed */
        
-        return 1;                                                                    /* return error */
+        return 1;                                                                     /* return error */
     }
-    *threshold = prev;                                                               /* get high threshold */
+    *wait_time = prev;                                                                /* get wait time */
     
-    return 0;                                                                        /* success return 0 */
+    return 0;                                                                         /* success return 0 */
 }
 
 /**
- * @brief     set the proximity interrupt cycle
- * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] cycle proximity interrupt cycle
- * @return    status code
- *            - 0 success
- *            - 1 set proximity interrupt cycle failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      convert the wait time to the register raw data
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  ms wait time
+ * @param[out] *reg pointer to a register raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get configuration register 1 failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t apds9960_set_proximity_interrupt_cycle(apds9960_handle_t *handle, apds9960_proximity_interrupt_cycle_t cycle)
+uint8_t apds9960_wait_time_convert_to_register(apds9960_handle_t *handle, float ms, uint8_t *reg)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                               /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                     /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                     /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_PERS, (uint8_t *)&prev, 1);        /* get persistence register */
-    if (res != 0)                                                                     /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG1, (uint8_t *)&prev, 1);        /* get configuration register 1 */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("apds9960: get persistence register failed.\n");          /* get persistence register failed */
+        handle->debug_print("apds9960: get configuration register 1 failed.\n");         /* get configuration register 1 failed */
        
-        return 1;                                                                     /* return error */
+        return 1;                                                                        /* return error */
     }
-    prev &= ~(0xF << 4);                                                              /* clear config */
-    prev |= cycle << 4;                                                               /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_PERS, (uint8_t *)&prev, 1);       /* set persistence register */
-    if (res != 0)                                                                     /* check result */
+    
+    if ((prev & (1 << 1)) != 0)                                                          /* check wait long */
     {
-        handle->debug_print("apds9960: set persistence register failed.\n");          /* set persistence register failed */
-       
-        return 1;                                                                     /* return error */
+        *reg = (uint8_t)(256.0f - ms / (2.78f * 12.0f));                                 /* convert real data to register data */
+    }
+    else
+    {
+        *reg = (uint8_t)(256.0f - ms / 2.78f);                                           /* convert real data to register data */
     }
     
-    return 0;                                                                         /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      get the proximity interrupt cycle
+ * @brief      convert the register raw data to the wait time
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *cycle pointer to a proximity interrupt cycle buffer
+ * @param[in]  reg register raw data
+ * @param[out] *ms pointer to a wait time buffer
  * @return     status code
  *             - 0 success
- *             - 1 get proximity interrupt cycle failed
+ *             - 1 get configuration register 1 failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_proximity_interrupt_cycle(apds9960_handle_t *handle, apds9960_proximity_interrupt_cycle_t *cycle)
+uint8_t apds9960_wait_time_convert_to_data(apds9960_handle_t *handle, uint8_t reg, float *ms)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                               /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                     /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                     /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_PERS, (uint8_t *)&prev, 1);        /* get persistence register */
-    if (res != 0)                                                                     /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG1, (uint8_t *)&prev, 1);        /* get configuration register 1 */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("apds9960: get persistence register failed.\n");          /* get persistence register failed */
+        handle->debug_print("apds9960: get configuration register 1 failed.\n");         /* get configuration register 1 failed */
        
-        return 1;                                                                     /* return error */
+        return 1;                                                                        /* return error */
     }
-    *cycle = (apds9960_proximity_interrupt_cycle_t)((prev >> 4) & 0xF);               /* set cycle */
     
-    return 0;                                                                         /* success return 0 */
+    if ((prev & (1 << 1)) != 0)                                                          /* check wait long */
+    {
+        *ms = (float)(256 - reg) * 2.78f * 12.0f;                                        /* convert raw data to real data */
+    }
+    else
+    {
+        *ms = (float)(256 - reg) * 2.78f;                                                /* convert raw data to real data */
+    }
+    
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the als interrupt cycle
+ * @brief     set the als interrupt low threshold
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] cycle als interrupt cycle
+ * @param[in] threshold low threshold
  * @return    status code
  *            - 0 success
- *            - 1 set als interrupt cycle failed
+ *            - 1 set als interrupt low threshold failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_als_interrupt_cycle(apds9960_handle_t *handle, apds9960_als_interrupt_cycle_t cycle)
+uint8_t apds9960_set_als_interrupt_low_threshold(apds9960_handle_t *handle, uint16_t threshold)
 {
     uint8_t res;
-    uint8_t prev;
+    uint8_t buf[2];
     
-    if (handle == NULL)                                                               /* check handle */
+    if (handle == NULL)                                                              /* check handle */
     {
-        return 2;                                                                     /* return error */
+        return 2;                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        return 3;                                                                     /* return error */
+        return 3;                                                                    /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_PERS, (uint8_t *)&prev, 1);        /* get persistence register */
-    if (res != 0)                                                                     /* check result */
-    {
-        handle->debug_print("apds9960: get persistence register failed.\n");          /* get persistence register failed */
-       
-        return 1;                                                                     /* return error */
-    }
-    prev &= ~(0xF << 0);                                                              /* clear config */
-    prev |= cycle << 0;                                                               /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_PERS, (uint8_t *)&prev, 1);       /* set persistence register */
-    if (res != 0)                                                                     /* check result */
+    buf[0] = (threshold >> 0) & 0xFF;                                                /* set lsb */
+    buf[1] = (threshold >> 8) & 0xFF;                                                /* set msb */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_AILTL, (uint8_t *)buf, 2);       /* set ailtl */
+    if (res != 0)                                                                    /* check result */
     {
-        handle->debug_print("apds9960: set persistence register failed.\n");          /* set persistence register failed */
+        handle->debug_print("apds9960: set ailtl failed.\n");                        /* set ailtl failed */
        
-        return 1;                                                                     /* return error */
+        return 1;                                                                    /* return error */
     }
     
-    return 0;                                                                         /* success return 0 */
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief      get the als interrupt cycle
+ * @brief      get the als interrupt low threshold
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *cycle pointer to an als interrupt cycle buffer
+ * @param[out] *threshold pointer to a low threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 get als interrupt cycle failed
+ *             - 1 get als interrupt low threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_als_interrupt_cycle(apds9960_handle_t *handle, apds9960_als_interrupt_cycle_t *cycle)
+uint8_t apds9960_get_als_interrupt_low_threshold(apds9960_handle_t *handle, uint16_t *threshold)
 {
     uint8_t res;
-    uint8_t prev;
+    uint8_t buf[2];
     
-    if (handle == NULL)                                                               /* check handle */
+    if (handle == NULL)                                                             /* check handle */
     {
-        return 2;                                                                     /* return error */
+        return 2;                                                                   /* return error */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle->inited != 1)                                                        /* check handle initialization */
     {
-        return 3;                                                                     /* return error */
+        return 3;                                                                   /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_PERS, (uint8_t *)&prev, 1);        /* get persistence register */
-    if (res != 0)                                                                     /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_AILTL, (uint8_t *)buf, 2);       /* get ailtl */
+    if (res != 0)                                                                   /* check result */
     {
-        handle->debug_print("apds9960: get persistence register failed.\n");          /* get persistence register failed */
+        handle->debug_print("apds9960: get ailtl failed.\n");                       /* get ailtl failed */
        
-        return 1;                                                                     /* return error */
+        return 1;                                                                   /* return error */
     }
-    *cycle = (apds9960_als_interrupt_cycle_t)((prev >> 0) & 0xF);                     /* get als interrupt cycle */
+    *threshold = (uint16_t)(((uint16_t)buf[1] << 8) | buf[0]);                      /* set threshold */
     
-    return 0;                                                                         /* success return 0 */
+    return 0;                                                                       /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the wait long
+ * @brief     set the als interrupt high threshold
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] enable bool value
+ * @param[in] threshold high threshold
  * @return    status code
  *            - 0 success
- *            - 1 set wait long failed
+ *            - 1 set als interrupt high threshold failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_wait_long(apds9960_handle_t *handle, apds9960_bool_t enable)
+uint8_t apds9960_set_als_interrupt_high_threshold(apds9960_handle_t *handle, uint16_t threshold)
 {
     uint8_t res;
-    uint8_t prev;
+    uint8_t buf[2];
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                              /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                    /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG1, (uint8_t *)&prev, 1);        /* get configuration register 1 */
-    if (res != 0)                                                                        /* check result */
-    {
-        handle->debug_print("apds9960: get configuration register 1 failed.\n");         /* get configuration register 1 failed */
-       
-        return 1;                                                                        /* return error */
-    }
-    prev &= ~(1 << 1);                                                                   /* clear config */
-    prev |= enable << 1;                                                                 /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_CONFIG1, (uint8_t *)&prev, 1);       /* set configuration register 1 */
-    if (res != 0)                                                                        /* check result */
+    buf[0] = (threshold >> 0) & 0xFF;                                                /* set lsb */
+    buf[1] = (threshold >> 8) & 0xFF;                                                /* set msb */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_AIHTL, (uint8_t *)buf, 2);       /* set aihtl */
+    if (res != 0)                                                                    /* check result */
     {
-        handle->debug_print("apds9960: set configuration register 1 failed.\n");         /* set configuration register 1 failed */
+        handle->debug_print("apds9960: set aihtl failed.\n");                        /* set aihtl failed */
        
-        return 1;                                                                        /* return error */
+        return 1;                                                                    /* return error */
     }
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief      get the wait long status
+ * @brief      get the als interrupt high threshold
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *threshold pointer to a high threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 get wait long failed
+ *             - 1 get als interrupt high threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_wait_long(apds9960_handle_t *handle, apds9960_bool_t *enable)
+uint8_t apds9960_get_als_interrupt_high_threshold(apds9960_handle_t *handle, uint16_t *threshold)
 {
     uint8_t res;
-    uint8_t prev;
+    uint8_t buf[2];
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                             /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                   /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                        /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                   /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG1, (uint8_t *)&prev, 1);        /* get configuration register 1 */
-    if (res != 0)                                                                        /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_AIHTL, (uint8_t *)buf, 2);       /* get aihtl */
+    if (res != 0)                                                                   /* check result */
     {
-        handle->debug_print("apds9960: get configuration register 1 failed.\n");         /* get configuration register 1 failed */
+        handle->debug_print("apds9960: get aihtl failed.\n");                       /* get aihtl failed */
        
-        return 1;                                                                        /* return error */
+        return 1;                                                                   /* return error */
     }
-    *enable = (apds9960_bool_t)((prev >> 1) & 0x1);                                      /* get bool */
+    *threshold = (uint16_t)(((uint16_t)buf[1] << 8) | buf[0]);                      /* set threshold */
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                       /* success return 0 */
 }
 
 /**
- * @brief     set the proximity pulse length
+ * @brief     set the proximity interrupt low threshold
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] len proximity pulse length
+ * @param[in] threshold low threshold
  * @return    status code
  *            - 0 success
- *            - 1 set proximity pulse length failed
+ *            - 1 set proximity interrupt low threshold failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_proximity_pulse_length(apds9960_handle_t *handle, apds9960_proximity_pulse_length_t len)
+uint8_t apds9960_set_proximity_interrupt_low_threshold(apds9960_handle_t *handle, uint8_t threshold)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                               /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                          /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                     /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_PPULSE, (uint8_t *)&prev, 1);              /* get proximity pulse count register */
-    if (res != 0)                                                                             /* check result */
-    {
-        handle->debug_print("apds9960: get proximity pulse count register failed.\n");        /* get proximity pulse count register failed */
-       
-        return 1;                                                                             /* return error */
-    }
-    prev &= ~(3 << 6);                                                                        /* clear config */
-    prev |= len << 6;                                                                         /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_PPULSE, (uint8_t *)&prev, 1);             /* set proximity pulse count register */
-    if (res != 0)                                                                             /* check result */
+    prev = threshold;                                                                 /* set low threshold */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_PILT, (uint8_t *)&prev, 1);       /* set pilt */
+    if (res != 0)                                                                     /* check result */
     {
-        handle->debug_print("apds9960: set proximity pulse count register failed.\n");        /* set proximity pulse count register failed */
+        handle->debug_print("apds9960: set pilt failed.\n");                          /* set pilt failed */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                     /* return error */
     }
     
-    return 0;                                                                                 /* success return 0 */
+    return 0;                                                                         /* success return 0 */
 }
 
 /**
- * @brief      get the proximity pulse length
+ * @brief      get the proximity interrupt low threshold
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *len pointer to a proximity pulse length buffer
+ * @param[out] *threshold pointer to a low threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 get proximity pulse length failed
+ *             - 1 get proximity interrupt low threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_proximity_pulse_length(apds9960_handle_t *handle, apds9960_proximity_pulse_length_t *len)
+uint8_t apds9960_get_proximity_interrupt_low_threshold(apds9960_handle_t *handle, uint8_t *threshold)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                              /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                    /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_PPULSE, (uint8_t *)&prev, 1);              /* get proximity pulse count register */
-    if (res != 0)                                                                             /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_PILT, (uint8_t *)&prev, 1);       /* get pilt */
+    if (res != 0)                                                                    /* check result */
     {
-        handle->debug_print("apds9960: get proximity pulse count register failed.\n");        /* get proximity pulse count register failed */
+        handle->debug_print("apds9960: get pilt failed.\n");                         /* get pilt failed */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                    /* return error */
     }
-    *len = (apds9960_proximity_pulse_length_t)((prev >> 6) & 0x3);                            /* get length */
+    *threshold = prev;                                                               /* get low threshold */
     
-    return 0;                                                                                 /* success return 0 */
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief     set the proximity pulse count
+ * @brief     set the proximity interrupt high threshold
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] count proximity pulse count
+ * @param[in] threshold high threshold
  * @return    status code
  *            - 0 success
- *            - 1 set proximity pulse count failed
+ *            - 1 set proximity interrupt high threshold failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 count is over 63
  * @note      none
  */
-uint8_t apds9960_set_proximity_pulse_count(apds9960_handle_t *handle, uint16_t count)
+uint8_t apds9960_set_proximity_interrupt_high_threshold(apds9960_handle_t *handle, uint8_t threshold)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                       /* check handle */
-    {
-        return 2;                                                                             /* return error */
-    }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle == NULL)                                                               /* check handle */
     {
-        return 3;                                                                             /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (count > 0x3F)                                                                         /* check count */
+    if (handle->inited != 1)                                                          /* check handle initialization */
     {
-        handle->debug_print("apds9960: count is over 63.\n");                                 /* count is over 63 */
-       
-        return 4;                                                                             /* return error */
+        return 3;                                                                     /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_PPULSE, (uint8_t *)&prev, 1);              /* get proximity pulse count register */
-    if (res != 0)                                                                             /* check result */
-    {
-        handle->debug_print("apds9960: get proximity pulse count register failed.\n");        /* get proximity pulse count register failed */
-       
-        return 1;                                                                             /* return error */
-    }
-    prev &= ~(0x3F << 0);                                                                     /* clear config */
-    prev |= (count & 0x3F) << 0;                                                              /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_PPULSE, (uint8_t *)&prev, 1);             /* set proximity pulse count register */
-    if (res != 0)                                                                             /* check result */
+    prev = threshold;                                                                 /* set high threshold */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_PIHT, (uint8_t *)&prev, 1);       /* set piht */
+    if (res != 0)                                                                     /* check result */
     {
-        handle->debug_print("apds9960: set proximity pulse count register failed.\n");        /* set proximity pulse count register failed */
+        handle->debug_print("apds9960: set piht failed.\n");                          /* set piht failed */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                     /* return error */
     }
     
-    return 0;                                                                                 /* success return 0 */
+    return 0;                                                                         /* success return 0 */
 }
 
 /**
- * @brief      get the proximity pulse count
+ * @brief      get the proximity interrupt high threshold
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *count pointer to a proximity pulse count buffer
+ * @param[out] *threshold pointer to a high threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 get proximity pulse count failed
+ *             - 1 get proximity interrupt high threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note      none
+ * @note       none
  */
-uint8_t apds9960_get_proximity_pulse_count(apds9960_handle_t *handle, uint16_t *count)
+uint8_t apds9960_get_proximity_interrupt_high_threshold(apds9960_handle_t *handle, uint8_t *threshold)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                              /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                    /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_PPULSE, (uint8_t *)&prev, 1);              /* get proximity pulse count register */
-    if (res != 0)                                                                             /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_PIHT, (uint8_t *)&prev, 1);       /* get piht */
+    if (res != 0)                                                                    /* check result */
     {
-        handle->debug_print("apds9960: get proximity pulse count register failed.\n");        /* get proximity pulse count register failed */
+        handle->debug_print("apds9960: get piht failed.\n");                         /* get piht failed */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                    /* return error */
     }
-    *count = prev & 0x3F;                                                                     /* get count */
+    *threshold = prev;                                                               /* get high threshold */
     
-    return 0;                                                                                 /* success return 0 */
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief     set the led current
+ * @brief     set the proximity interrupt cycle
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] current led current
+ * @param[in] cycle proximity interrupt cycle
  * @return    status code
  *            - 0 success
- *            - 1 set led current failed
+ *            - 1 set proximity interrupt cycle failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_led_current(apds9960_handle_t *handle, apds9960_led_current_t current)
+uint8_t apds9960_set_proximity_interrupt_cycle(apds9960_handle_t *handle, apds9960_proximity_interrupt_cycle_t cycle)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                               /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                          /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                     /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);        /* get control register */
-    if (res != 0)                                                                        /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_PERS, (uint8_t *)&prev, 1);        /* get persistence register */
+    if (res != 0)                                                                     /* check result */
     {
-        handle->debug_print("apds9960: get control register failed.\n");                 /* get control register failed */
+        handle->debug_print("apds9960: get persistence register failed.\n");          /* get persistence register failed */
        
-        return 1;                                                                        /* return error */
+        return 1;                                                                     /* return error */
     }
-    prev &= ~(0x3 << 6);                                                                 /* clear config */
-    prev |= current << 6;                                                                /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);       /* set control register register */
-    if (res != 0)                                                                        /* check result */
+    prev &= ~(0xF << 4);                                                              /* clear config */
+    prev |= cycle << 4;                                                               /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_PERS, (uint8_t *)&prev, 1);       /* set persistence register */
+    if (res != 0)                                                                     /* check result */
     {
-        handle->debug_print("apds9960: set control register register failed.\n");        /* set control register failed */
+        handle->debug_print("apds9960: set persistence register failed.\n");          /* set persistence register failed */
        
-        return 1;                                                                        /* return error */
+        return 1;                                                                     /* return error */
     }
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                         /* success return 0 */
 }
 
 /**
- * @brief      get the led current
+ * @brief      get the proximity interrupt cycle
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *current pointer to a led current buffer
+ * @param[out] *cycle pointer to a proximity interrupt cycle buffer
  * @return     status code
  *             - 0 success
- *             - 1 get led current failed
+ *             - 1 get proximity interrupt cycle failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_led_current(apds9960_handle_t *handle, apds9960_led_current_t *current)
+uint8_t apds9960_get_proximity_interrupt_cycle(apds9960_handle_t *handle, apds9960_proximity_interrupt_cycle_t *cycle)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                               /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                          /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                     /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);        /* get control register */
-    if (res != 0)                                                                        /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_PERS, (uint8_t *)&prev, 1);        /* get persistence register */
+    if (res != 0)                                                                     /* check result */
     {
-        handle->debug_print("apds9960: get control register failed.\n");                 /* get control register failed */
+        handle->debug_print("apds9960: get persistence register failed.\n");          /* get persistence register failed */
        
-        return 1;                                                                        /* return error */
+        return 1;                                                                     /* return error */
     }
-    *current = (apds9960_led_current_t)((prev >> 6) & 0x3);                              /* get the current */
+    *cycle = (apds9960_proximity_interrupt_cycle_t)((prev >> 4) & 0xF);               /* set cycle */
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                         /* success return 0 */
 }
 
 /**
- * @brief     set the proximity gain
+ * @brief     set the als interrupt cycle
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] gain proximity gain
+ * @param[in] cycle als interrupt cycle
  * @return    status code
  *            - 0 success
- *            - 1 set proximity gain failed
+ *            - 1 set als interrupt cycle failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_proximity_gain(apds9960_handle_t *handle, apds9960_proximity_gain_t gain)
+uint8_t apds9960_set_als_interrupt_cycle(apds9960_handle_t *handle, apds9960_als_interrupt_cycle_t cycle)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                               /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                          /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                     /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);        /* get control register */
-    if (res != 0)                                                                        /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_PERS, (uint8_t *)&prev, 1);        /* get persistence register */
+    if (res != 0)                                                                     /* check result */
     {
-        handle->debug_print("apds9960: get control register failed.\n");                 /* get control register failed */
+        handle->debug_print("apds9960: get persistence register failed.\n");          /* get persistence register failed */
        
-        return 1;                                                                        /* return error */
+        return 1;                                                                     /* return error */
     }
-    prev &= ~(0x3 << 2);                                                                 /* clear config */
-    prev |= gain << 2;                                                                   /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);       /* set control register register */
-    if (res != 0)                                                                        /* check result */
+    prev &= ~(0xF << 0);                                                              /* clear config */
+    prev |= cycle << 0;                                                               /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_PERS, (uint8_t *)&prev, 1);       /* set persistence register */
+    if (res != 0)                                                                     /* check result */
     {
-        handle->debug_print("apds9960: set control register register failed.\n");        /* set control register failed */
+        handle->debug_print("apds9960: set persistence register failed.\n");          /* set persistence register failed */
        
-        return 1;                                                                        /* return error */
+        return 1;                                                                     /* return error */
     }
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                         /* success return 0 */
 }
 
 /**
- * @brief      get the proximity gain
+ * @brief      get the als interrupt cycle
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *gain pointer to a proximity gain buffer
+ * @param[out] *cycle pointer to an als interrupt cycle buffer
  * @return     status code
  *             - 0 success
- *             - 1 get proximity gain failed
+ *             - 1 get als interrupt cycle failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_proximity_gain(apds9960_handle_t *handle, apds9960_proximity_gain_t *gain)
+uint8_t apds9960_get_als_interrupt_cycle(apds9960_handle_t *handle, apds9960_als_interrupt_cycle_t *cycle)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                               /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                          /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                     /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);        /* get control register */
-    if (res != 0)                                                                        /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_PERS, (uint8_t *)&prev, 1);        /* get persistence register */
+    if (res != 0)                                                                     /* check result */
     {
-        handle->debug_print("apds9960: get control register failed.\n");                 /* get control register failed */
+        handle->debug_print("apds9960: get persistence register failed.\n");          /* get persistence register failed */
        
-        return 1;                                                                        /* return error */
+        return 1;                                                                     /* return error */
     }
-    *gain = (apds9960_proximity_gain_t)((prev >> 2) & 0x3);                              /* get the gain */
+    *cycle = (apds9960_als_interrupt_cycle_t)((prev >> 0) & 0xF);                     /* get als interrupt cycle */
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                         /* success return 0 */
 }
 
 /**
- * @brief     set the als color gain
+ * @brief     enable or disable the wait long
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] gain als color gain
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set als color gain failed
+ *            - 1 set wait long failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_als_color_gain(apds9960_handle_t *handle, apds9960_als_color_gain_t gain)
+uint8_t apds9960_set_wait_long(apds9960_handle_t *handle, apds9960_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
@@ -2202,19 +3129,19 @@ uint8_t apds9960_set_als_color_gain(apds9960_handle_t *handle, apds9960_als_colo
         return 3;                                                                        /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);        /* get control register */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG1, (uint8_t *)&prev, 1);        /* get configuration register 1 */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("apds9960: get control register failed.\n");                 /* get control register failed */
+        handle->debug_print("apds9960: get configuration register 1 failed.\n");         /* get configuration register 1 failed */
        
         return 1;                                                                        /* return error */
     }
-    prev &= ~(0x3 << 0);                                                                 /* clear config */
-    prev |= gain << 0;                                                                   /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);       /* set control register register */
+    prev &= ~(1 << 1);                                                                   /* clear config */
+    prev |= enable << 1;                                                                 /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_CONFIG1, (uint8_t *)&prev, 1);       /* set configuration register 1 */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("apds9960: set control register register failed.\n");        /* set control register failed */
+        handle->debug_print("apds9960: set configuration register 1 failed.\n");         /* set configuration register 1 failed */
        
         return 1;                                                                        /* return error */
     }
@@ -2223,17 +3150,17 @@ uint8_t apds9960_set_als_color_gain(apds9960_handle_t *handle, apds9960_als_colo
 }
 
 /**
- * @brief      get the als color gain
+ * @brief      get the wait long status
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *gain pointer to an als color gain buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get als color gain failed
+ *             - 1 get wait long failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_als_color_gain(apds9960_handle_t *handle, apds9960_als_color_gain_t *gain)
+uint8_t apds9960_get_wait_long(apds9960_handle_t *handle, apds9960_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
@@ -2247,239 +3174,249 @@ uint8_t apds9960_get_als_color_gain(apds9960_handle_t *handle, apds9960_als_colo
         return 3;                                                                        /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);        /* get control register */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG1, (uint8_t *)&prev, 1);        /* get configuration register 1 */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("apds9960: get control register failed.\n");                 /* get control register failed */
+        handle->debug_print("apds9960: get configuration register 1 failed.\n");         /* get configuration register 1 failed */
        
         return 1;                                                                        /* return error */
     }
-    *gain = (apds9960_als_color_gain_t)((prev >> 0) & 0x3);                              /* get the gain */
+    *enable = (apds9960_bool_t)((prev >> 1) & 0x1);                                      /* get bool */
     
     return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the saturation interrupt
+ * @brief     set the proximity pulse length
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] saturation saturation interrupt type
- * @param[in] enable bool value
+ * @param[in] len proximity pulse length
  * @return    status code
  *            - 0 success
- *            - 1 set saturation interrupt failed
+ *            - 1 set proximity pulse length failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_saturation_interrupt(apds9960_handle_t *handle, apds9960_saturation_interrupt_t saturation, apds9960_bool_t enable)
+uint8_t apds9960_set_proximity_pulse_length(apds9960_handle_t *handle, apds9960_proximity_pulse_length_t len)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                             /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG2, (uint8_t *)&prev, 1);          /* get control 2 register */
-    if (res != 0)                                                                          /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_PPULSE, (uint8_t *)&prev, 1);              /* get proximity pulse count register */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("apds9960: get control 2 register failed.\n");                 /* get control 2 register failed */
+        handle->debug_print("apds9960: get proximity pulse count register failed.\n");        /* get proximity pulse count register failed */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                             /* return error */
     }
-    prev &= ~(1 << saturation);                                                            /* clear config */
-    prev |= enable << saturation;                                                          /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_CONFIG2, (uint8_t *)&prev, 1);         /* set control register 2 register */
-    if (res != 0)                                                                          /* check result */
+    prev &= ~(3 << 6);                                                                        /* clear config */
+    prev |= len << 6;                                                                         /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_PPULSE, (uint8_t *)&prev, 1);             /* set proximity pulse count register */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("apds9960: set control 2 register register failed.\n");        /* set control 2 register failed */
+        handle->debug_print("apds9960: set proximity pulse count register failed.\n");        /* set proximity pulse count register failed */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                             /* return error */
     }
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief      get the saturation interrupt
+ * @brief      get the proximity pulse length
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[in]  saturation saturation interrupt type
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *len pointer to a proximity pulse length buffer
  * @return     status code
  *             - 0 success
- *             - 1 get saturation interrupt failed
+ *             - 1 get proximity pulse length failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_saturation_interrupt(apds9960_handle_t *handle, apds9960_saturation_interrupt_t saturation, apds9960_bool_t *enable)
+uint8_t apds9960_get_proximity_pulse_length(apds9960_handle_t *handle, apds9960_proximity_pulse_length_t *len)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                             /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG2, (uint8_t *)&prev, 1);          /* get control 2 register */
-    if (res != 0)                                                                          /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_PPULSE, (uint8_t *)&prev, 1);              /* get proximity pulse count register */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("apds9960: get control 2 register failed.\n");                 /* get control 2 register failed */
+        handle->debug_print("apds9960: get proximity pulse count register failed.\n");        /* get proximity pulse count register failed */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                             /* return error */
     }
-    *enable = (apds9960_bool_t)((prev >> saturation) & 0x01);                              /* get the saturation */
+    *len = (apds9960_proximity_pulse_length_t)((prev >> 6) & 0x3);                            /* get length */
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set the led boost
+ * @brief     set the proximity pulse count
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] boost led boost
+ * @param[in] count proximity pulse count
  * @return    status code
  *            - 0 success
- *            - 1 set led boost failed
+ *            - 1 set proximity pulse count failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 4 count is over 63
  * @note      none
  */
-uint8_t apds9960_set_led_boost(apds9960_handle_t *handle, apds9960_led_boost_t boost)
+uint8_t apds9960_set_proximity_pulse_count(apds9960_handle_t *handle, uint16_t count)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                             /* return error */
+    }
+    if (count > 0x3F)                                                                         /* check count */
+    {
+        handle->debug_print("apds9960: count is over 63.\n");                                 /* count is over 63 */
+       
+        return 4;                                                                             /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG2, (uint8_t *)&prev, 1);          /* get control 2 register */
-    if (res != 0)                                                                          /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_PPULSE, (uint8_t *)&prev, 1);              /* get proximity pulse count register */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("apds9960: get control 2 register failed.\n");                 /* get control 2 register failed */
+        handle->debug_print("apds9960: get proximity pulse count register failed.\n");        /* get proximity pulse count register failed */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                             /* return error */
     }
-    prev &= ~(0x3 << 4);                                                                   /* clear config */
-    prev |= boost << 4;                                                                    /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_CONFIG2, (uint8_t *)&prev, 1);         /* set control register 2 register */
-    if (res != 0)                                                                          /* check result */
+    prev &= ~(0x3F << 0);                                                                     /* clear config */
+    prev |= (count & 0x3F) << 0;                                                              /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_PPULSE, (uint8_t *)&prev, 1);             /* set proximity pulse count register */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("apds9960: set control 2 register register failed.\n");        /* set control 2 register failed */
+        handle->debug_print("apds9960: set proximity pulse count register failed.\n");        /* set proximity pulse count register failed */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                             /* return error */
     }
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief      get the led boost
+ * @brief      get the proximity pulse count
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *boost pointer to a led boost buffer
+ * @param[out] *count pointer to a proximity pulse count buffer
  * @return     status code
  *             - 0 success
- *             - 1 get led boost failed
+ *             - 1 get proximity pulse count failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note      none
  */
-uint8_t apds9960_get_led_boost(apds9960_handle_t *handle, apds9960_led_boost_t *boost)
+uint8_t apds9960_get_proximity_pulse_count(apds9960_handle_t *handle, uint16_t *count)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                             /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG2, (uint8_t *)&prev, 1);          /* get control 2 register */
-    if (res != 0)                                                                          /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_PPULSE, (uint8_t *)&prev, 1);              /* get proximity pulse count register */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("apds9960: get control 2 register failed.\n");                 /* get control 2 register failed */
+        handle->debug_print("apds9960: get proximity pulse count register failed.\n");        /* get proximity pulse count register failed */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                             /* return error */
     }
-    *boost = (apds9960_led_boost_t)((prev >> 4) & 0x3);                                    /* set the LED boost */
+    *count = prev & 0x3F;                                                                     /* get count */
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief      get the status
- * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *status pointer to a status buffer
- * @return     status code
- *             - 0 success
- *             - 1 get status failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     set the led current
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] current led current
+ * @return    status code
+ *            - 0 success
+ *            - 1 set led current failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t apds9960_get_status(apds9960_handle_t *handle, uint8_t *status)
+uint8_t apds9960_set_led_current(apds9960_handle_t *handle, apds9960_led_current_t current)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                      /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                           /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                      /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_STATUS, (uint8_t *)&prev, 1);       /* get status register */
-    if (res != 0)                                                                      /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);        /* get control register */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("apds9960: get status register failed.\n");                /* get status register failed */
+        handle->debug_print("apds9960: get control register failed.\n");                 /* get control register failed */
        
-        return 1;                                                                      /* return error */
+        return 1;                                                                        /* return error */
+    }
+    prev &= ~(0x3 << 6);                                                                 /* clear config */
+    prev |= current << 6;                                                                /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);       /* set control register register */
+    if (res != 0)                                                                        /* check result */
+    {
+        handle->debug_print("apds9960: set control register register failed.\n");        /* set control register failed */
+       
+        return 1;                                                                        /* return error */
     }
-    *status = prev;                                                                    /* set the status */
     
-    return 0;                                                                          /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      read the rgbc data
+ * @brief      get the led current
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *red pointer to a red buffer
- * @param[out] *green pointer to a green buffer
- * @param[out] *blue pointer to a blue buffer
- * @param[out] *clear pointer to a clear buffer
+ * @param[out] *current pointer to a led current buffer
  * @return     status code
  *             - 0 success
- *             - 1 read rgbc failed
+ *             - 1 get led current failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_read_rgbc(apds9960_handle_t *handle, uint16_t *red, uint16_t *green, uint16_t *blue, uint16_t *clear)
+uint8_t apds9960_get_led_current(apds9960_handle_t *handle, apds9960_led_current_t *current)
 {
     uint8_t res;
-    uint8_t buf[8];
+    uint8_t prev;
     
     if (handle == NULL)                                                                  /* check handle */
     {
@@ -2490,271 +3427,278 @@ uint8_t apds9960_read_rgbc(apds9960_handle_t *handle, uint16_t *red, uint16_t *g
         return 3;                                                                        /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CDATAL, (uint8_t *)&buf[0], 2);       /* get cdatal register */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);        /* get control register */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("apds9960: get cdatal register failed.\n");                  /* get cdatal register failed */
+        handle->debug_print("apds9960: get control register failed.\n");                 /* get control register failed */
        
         return 1;                                                                        /* return error */
     }
-    res = a_apds9960_iic_read(handle, APDS9960_REG_RDATAL, (uint8_t *)&buf[2], 2);       /* get rdatal register */
-    if (res != 0)                                                                        /* check result */
+    *current = (apds9960_led_current_t)((prev >> 6) & 0x3);                              /* get the current */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     set the proximity gain
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] gain proximity gain
+ * @return    status code
+ *            - 0 success
+ *            - 1 set proximity gain failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t apds9960_set_proximity_gain(apds9960_handle_t *handle, apds9960_proximity_gain_t gain)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                  /* check handle */
     {
-        handle->debug_print("apds9960: get rdatal register failed.\n");                  /* get rdatal register failed */
-       
-        return 1;                                                                        /* return error */
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
     }
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GDATAL, (uint8_t *)&buf[4], 2);       /* get gdatal register */
+    
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);        /* get control register */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("apds9960: get gdatal register failed.\n");                  /* get gdatal register failed */
+        handle->debug_print("apds9960: get control register failed.\n");                 /* get control register failed */
        
         return 1;                                                                        /* return error */
     }
-    res = a_apds9960_iic_read(handle, APDS9960_REG_BDATAL, (uint8_t *)&buf[6], 2);       /* get bdatal register */
+    prev &= ~(0x3 << 2);                                                                 /* clear config */
+    prev |= gain << 2;                                                                   /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);       /* set control register register */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("apds9960: get bdatal register failed.\n");                  /* get bdatal register failed */
+        handle->debug_print("apds9960: set control register register failed.\n");        /* set control register failed */
        
         return 1;                                                                        /* return error */
     }
-    *red = (uint16_t)(((uint16_t)buf[3] << 0) | buf[2]);                                 /* set the red */
-    *green = (uint16_t)(((uint16_t)buf[5] << 0) | buf[4]);                               /* set the green */
-    *blue = (uint16_t)(((uint16_t)buf[7] << 0) | buf[6]);                                /* set the blue */
-    *clear = (uint16_t)(((uint16_t)buf[1] << 0) | buf[0]);                               /* set the clear */
     
     return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      read the proximity data
+ * @brief      get the proximity gain
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *proximity pointer to a proximity buffer
+ * @param[out] *gain pointer to a proximity gain buffer
  * @return     status code
  *             - 0 success
- *             - 1 read proximity failed
+ *             - 1 get proximity gain failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_read_proximity(apds9960_handle_t *handle, uint8_t *proximity)
+uint8_t apds9960_get_proximity_gain(apds9960_handle_t *handle, apds9960_proximity_gain_t *gain)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                      /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                           /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                      /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_PDATA, (uint8_t *)&prev, 1);        /* get proximity data register */
-    if (res != 0)                                                                      /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);        /* get control register */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("apds9960: get proximity data register failed.\n");        /* get proximity data register failed */
+        handle->debug_print("apds9960: get control register failed.\n");                 /* get control register failed */
        
-        return 1;                                                                      /* return error */
+        return 1;                                                                        /* return error */
     }
-    *proximity = prev;                                                                 /* set the proximity */
+    *gain = (apds9960_proximity_gain_t)((prev >> 2) & 0x3);                              /* get the gain */
     
-    return 0;                                                                          /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the proximity up right offset
+ * @brief     set the als color gain
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] offset proximity offset
+ * @param[in] gain als color gain
  * @return    status code
  *            - 0 success
- *            - 1 set proximity up right offset failed
+ *            - 1 set als color gain failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_proximity_up_right_offset(apds9960_handle_t *handle, int8_t offset)
+uint8_t apds9960_set_als_color_gain(apds9960_handle_t *handle, apds9960_als_color_gain_t gain)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                           /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                                 /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                                      /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                                 /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    if (offset >= 0)                                                                              /* if >= 0 */
-    {
-        prev = offset;                                                                            /* set the positive */
-    }
-    else                                                                                          /* < 0 */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);        /* get control register */
+    if (res != 0)                                                                        /* check result */
     {
-        prev = 0x80;                                                                              /* set the 0x80 */
-        prev |= (-offset);                                                                        /* set the negative */
+        handle->debug_print("apds9960: get control register failed.\n");                 /* get control register failed */
+       
+        return 1;                                                                        /* return error */
     }
-    res = a_apds9960_iic_write(handle, APDS9960_REG_POFFSET_UR, (uint8_t *)&prev, 1);             /* set proximity offset up right register */
-    if (res != 0)                                                                                 /* check result */
+    prev &= ~(0x3 << 0);                                                                 /* clear config */
+    prev |= gain << 0;                                                                   /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);       /* set control register register */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("apds9960: set proximity offset up right register failed.\n");        /* set proximity offset up right register failed */
+        handle->debug_print("apds9960: set control register register failed.\n");        /* set control register failed */
        
-        return 1;                                                                                 /* return error */
+        return 1;                                                                        /* return error */
     }
     
-    return 0;                                                                                     /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      get the proximity up right offset
+ * @brief      get the als color gain
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *offset pointer to a proximity offset buffer
+ * @param[out] *gain pointer to an als color gain buffer
  * @return     status code
  *             - 0 success
- *             - 1 get proximity up right offset failed
+ *             - 1 get als color gain failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_proximity_up_right_offset(apds9960_handle_t *handle, int8_t *offset)
+uint8_t apds9960_get_als_color_gain(apds9960_handle_t *handle, apds9960_als_color_gain_t *gain)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_POFFSET_UR, (uint8_t *)&prev, 1);             /* get proximity offset up right register */
-    if (res != 0)                                                                                /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONTROL, (uint8_t *)&prev, 1);        /* get control register */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("apds9960: get proximity offset up right register failed.\n");       /* get proximity offset up right register failed */
+        handle->debug_print("apds9960: get control register failed.\n");                 /* get control register failed */
        
-        return 1;                                                                                /* return error */
-    }
-    if ((prev & 0x80) != 0)                                                                      /* if < 0 */
-    {
-        prev &= ~0x80;                                                                           /* clear 0x80 */
-        *offset = -(int8_t)(prev);                                                               /* set the offset */
-    }
-    else                                                                                         /* >= 0 */
-    {
-        *offset = (int8_t)(prev);                                                                /* set the offset */
+        return 1;                                                                        /* return error */
     }
+    *gain = (apds9960_als_color_gain_t)((prev >> 0) & 0x3);                              /* get the gain */
     
-    return 0;                                                                                    /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the proximity down left offset
+ * @brief     set the saturation interrupt
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] offset proximity offset
+ * @param[in] saturation saturation interrupt type
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set proximity down left offset failed
+ *            - 1 set saturation interrupt failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_proximity_down_left_offset(apds9960_handle_t *handle, int8_t offset)
+uint8_t apds9960_set_saturation_interrupt(apds9960_handle_t *handle, apds9960_saturation_interrupt_t saturation, apds9960_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                           /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                                 /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                                      /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                                 /* return error */
+        return 3;                                                                          /* return error */
     }
     
-    if (offset >= 0)                                                                               /* if >= 0 */
-    {
-        prev = offset;                                                                             /* set the positive */
-    }
-    else                                                                                           /* <0 */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG2, (uint8_t *)&prev, 1);          /* get control 2 register */
+    if (res != 0)                                                                          /* check result */
     {
-        prev = 0x80;                                                                               /* set the 0x80 */
-        prev |= (-offset);                                                                         /* set the negative */
+        handle->debug_print("apds9960: get control 2 register failed.\n");                 /* get control 2 register failed */
+       
+        return 1;                                                                          /* return error */
     }
-    res = a_apds9960_iic_write(handle, APDS9960_REG_POFFSET_DL, (uint8_t *)&prev, 1);              /* set proximity offset down left register */
-    if (res != 0)                                                                                  /* check result */
+    prev &= ~(1 << saturation);                                                            /* clear config */
+    prev |= enable << saturation;                                                          /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_CONFIG2, (uint8_t *)&prev, 1);         /* set control register 2 register */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("apds9960: set proximity offset down left register failed.\n");        /* set proximity offset down left register failed */
+        handle->debug_print("apds9960: set control 2 register register failed.\n");        /* set control 2 register failed */
        
-        return 1;                                                                                  /* return error */
+        return 1;                                                                          /* return error */
     }
     
-    return 0;                                                                                      /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief      get the proximity down left offset
+ * @brief      get the saturation interrupt
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *offset pointer to a proximity offset buffer
+ * @param[in]  saturation saturation interrupt type
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get proximity down left offset failed
+ *             - 1 get saturation interrupt failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_proximity_down_left_offset(apds9960_handle_t *handle, int8_t *offset)
+uint8_t apds9960_get_saturation_interrupt(apds9960_handle_t *handle, apds9960_saturation_interrupt_t saturation, apds9960_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                           /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                                 /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                                      /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                                 /* return error */
+        return 3;                                                                          /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_POFFSET_DL, (uint8_t *)&prev, 1);              /* get proximity offset down left register */
-    if (res != 0)                                                                                 /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG2, (uint8_t *)&prev, 1);          /* get control 2 register */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("apds9960: get proximity offset down left register failed.\n");       /* get proximity offset down left register failed */
+        handle->debug_print("apds9960: get control 2 register failed.\n");                 /* get control 2 register failed */
        
-        return 1;                                                                                 /* return error */
-    }
-    if ((prev & 0x80) != 0)                                                                       /* if < 0 */
-    {
-        prev &= ~0x80;                                                                            /* clear 0x80 */
-        *offset = -(int8_t)(prev);                                                                /* set the offset */
-    }
-    else                                                                                          /* >= 0 */
-    {
-        *offset = (int8_t)(prev);                                                                 /* set the offset */
+        return 1;                                                                          /* return error */
     }
+    *enable = (apds9960_bool_t)((prev >> saturation) & 0x01);                              /* get the saturation */
     
-    return 0;                                                                                     /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the proximity gain compensation
+ * @brief     set the led boost
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] enable bool value
+ * @param[in] boost led boost
  * @return    status code
  *            - 0 success
- *            - 1 set proximity gain compensation failed
+ *            - 1 set led boost failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_proximity_gain_compensation(apds9960_handle_t *handle, apds9960_bool_t enable)
+uint8_t apds9960_set_led_boost(apds9960_handle_t *handle, apds9960_led_boost_t boost)
 {
     uint8_t res;
     uint8_t prev;
@@ -2768,19 +3712,19 @@ uint8_t apds9960_set_proximity_gain_compensation(apds9960_handle_t *handle, apds
         return 3;                                                                          /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);          /* get control 3 register */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG2, (uint8_t *)&prev, 1);          /* get control 2 register */
     if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("apds9960: get control 3 register failed.\n");                 /* get control 3 register failed */
+        handle->debug_print("apds9960: get control 2 register failed.\n");                 /* get control 2 register failed */
        
         return 1;                                                                          /* return error */
     }
-    prev &= ~(1 << 5);                                                                     /* clear config */
-    prev |= enable << 5;                                                                   /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);         /* set control register 3 register */
+    prev &= ~(0x3 << 4);                                                                   /* clear config */
+    prev |= boost << 4;                                                                    /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_CONFIG2, (uint8_t *)&prev, 1);         /* set control register 2 register */
     if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("apds9960: set control 3 register register failed.\n");        /* set control 3 register failed */
+        handle->debug_print("apds9960: set control 2 register register failed.\n");        /* set control 2 register failed */
        
         return 1;                                                                          /* return error */
     }
@@ -2789,17 +3733,17 @@ uint8_t apds9960_set_proximity_gain_compensation(apds9960_handle_t *handle, apds
 }
 
 /**
- * @brief      get the proximity gain compensation status
+ * @brief      get the led boost
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *boost pointer to a led boost buffer
  * @return     status code
  *             - 0 success
- *             - 1 get proximity gain compensation failed
+ *             - 1 get led boost failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_proximity_gain_compensation(apds9960_handle_t *handle, apds9960_bool_t *enable)
+uint8_t apds9960_get_led_boost(apds9960_handle_t *handle, apds9960_led_boost_t *boost)
 {
     uint8_t res;
     uint8_t prev;
@@ -2813,761 +3757,780 @@ uint8_t apds9960_get_proximity_gain_compensation(apds9960_handle_t *handle, apds
         return 3;                                                                          /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);          /* get control 3 register */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG2, (uint8_t *)&prev, 1);          /* get control 2 register */
     if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("apds9960: get control 3 register failed.\n");                 /* get control 3 register failed */
+        handle->debug_print("apds9960: get control 2 register failed.\n");                 /* get control 2 register failed */
        
         return 1;                                                                          /* return error */
     }
-    *enable = (apds9960_bool_t)((prev >> 5) & 0x01);                                       /* get bool */
+    *boost = (apds9960_led_boost_t)((prev >> 4) & 0x3);                                    /* set the LED boost */
     
     return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief     enable or disable sleeping after interrupt
- * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set sleep after interrupt failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      get the status
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t apds9960_set_sleep_after_interrupt(apds9960_handle_t *handle, apds9960_bool_t enable)
+uint8_t apds9960_get_status(apds9960_handle_t *handle, uint8_t *status)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                           /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                      /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);          /* get control 3 register */
-    if (res != 0)                                                                          /* check result */
-    {
-        handle->debug_print("apds9960: get control 3 register failed.\n");                 /* get control 3 register failed */
-       
-        return 1;                                                                          /* return error */
-    }
-    prev &= ~(1 << 4);                                                                     /* clear config */
-    prev |= enable << 4;                                                                   /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);         /* set control register 3 register */
-    if (res != 0)                                                                          /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_STATUS, (uint8_t *)&prev, 1);       /* get status register */
+    if (res != 0)                                                                      /* check result */
     {
-        handle->debug_print("apds9960: set control 3 register register failed.\n");        /* set control 3 register failed */
+        handle->debug_print("apds9960: get status register failed.\n");                /* get status register failed */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                      /* return error */
     }
+    *status = prev;                                                                    /* set the status */
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                          /* success return 0 */
 }
 
 /**
- * @brief      get the sleeping after interrupt status
+ * @brief      read the rgbc data
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *red pointer to a red buffer
+ * @param[out] *green pointer to a green buffer
+ * @param[out] *blue pointer to a blue buffer
+ * @param[out] *clear pointer to a clear buffer
  * @return     status code
  *             - 0 success
- *             - 1 get sleep after interrupt failed
+ *             - 1 read rgbc failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_sleep_after_interrupt(apds9960_handle_t *handle, apds9960_bool_t *enable)
+uint8_t apds9960_read_rgbc(apds9960_handle_t *handle, uint16_t *red, uint16_t *green, uint16_t *blue, uint16_t *clear)
 {
     uint8_t res;
-    uint8_t prev;
+    uint8_t buf[8];
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);          /* get control 3 register */
-    if (res != 0)                                                                          /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CDATAL, (uint8_t *)buf, 8);           /* get cdatal - bdatah register */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("apds9960: get control 3 register failed.\n");                 /* get control 3 register failed */
+        handle->debug_print("apds9960: get rgbc data register failed.\n");               /* get rgbc data register failed */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                        /* return error */
     }
-    *enable = (apds9960_bool_t)((prev >> 4) & 0x01);                                       /* get bool */
+    *red = (uint16_t)(((uint16_t)buf[3] << 8) | buf[2]);                                 /* set the red */
+    *green = (uint16_t)(((uint16_t)buf[5] << 8) | buf[4]);                               /* set the green */
+    *blue = (uint16_t)(((uint16_t)buf[7] << 8) | buf[6]);                                /* set the blue */
+    *clear = (uint16_t)(((uint16_t)buf[1] << 8) | buf[0]);                               /* set the clear */
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the proximity mask
- * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] mask proximity mask
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set proximity mask failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      read the proximity data
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *proximity pointer to a proximity buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read proximity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t apds9960_set_proximity_mask(apds9960_handle_t *handle, apds9960_proximity_mask_t mask, apds9960_bool_t enable)
+uint8_t apds9960_read_proximity(apds9960_handle_t *handle, uint8_t *proximity)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                           /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                      /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);          /* get control 3 register */
-    if (res != 0)                                                                          /* check result */
-    {
-        handle->debug_print("apds9960: get control 3 register failed.\n");                 /* get control 3 register failed */
-       
-        return 1;                                                                          /* return error */
-    }
-    prev &= ~(1 << mask);                                                                  /* clear config */
-    prev |= enable << mask;                                                                /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);         /* set control register 3 register */
-    if (res != 0)                                                                          /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_PDATA, (uint8_t *)&prev, 1);        /* get proximity data register */
+    if (res != 0)                                                                      /* check result */
     {
-        handle->debug_print("apds9960: set control 3 register register failed.\n");        /* set control 3 register failed */
+        handle->debug_print("apds9960: get proximity data register failed.\n");        /* get proximity data register failed */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                      /* return error */
     }
+    *proximity = prev;                                                                 /* set the proximity */
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                          /* success return 0 */
 }
 
 /**
- * @brief      get the proximity mask status
+ * @brief      read the status, rgbc and proximity data in one transaction
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[in]  mask proximity mask
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *status pointer to a status buffer
+ * @param[out] *red pointer to a red buffer
+ * @param[out] *green pointer to a green buffer
+ * @param[out] *blue pointer to a blue buffer
+ * @param[out] *clear pointer to a clear buffer
+ * @param[out] *proximity pointer to a proximity buffer
  * @return     status code
  *             - 0 success
- *             - 1 get proximity mask failed
+ *             - 1 read all failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       status can be NULL, then the status register is not read
  */
-uint8_t apds9960_get_proximity_mask(apds9960_handle_t *handle, apds9960_proximity_mask_t mask, apds9960_bool_t *enable)
+uint8_t apds9960_read_all(apds9960_handle_t *handle, uint8_t *status, uint16_t *red, uint16_t *green, uint16_t *blue, uint16_t *clear, uint8_t *proximity)
 {
     uint8_t res;
-    uint8_t prev;
+    uint8_t buf[10];
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                      /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                                 /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                            /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);       /* get control 3 register */
-    if (res != 0)                                                                       /* check result */
+    if (status != NULL)                                                                      /* check status */
     {
-        handle->debug_print("apds9960: get control 3 register failed.\n");              /* get control 3 register failed */
+        res = a_apds9960_iic_read(handle, APDS9960_REG_STATUS, (uint8_t *)&buf[0], 10);      /* get status - pdata register */
+    }
+    else
+    {
+        res = a_apds9960_iic_read(handle, APDS9960_REG_CDATAL, (uint8_t *)&buf[1], 9);       /* get cdatal - pdata register */
+    }
+    if (res != 0)                                                                            /* check result */
+    {
+        handle->debug_print("apds9960: get all data register failed.\n");                   /* get all data register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                                            /* return error */
     }
-    *enable = (apds9960_bool_t)((prev >> mask) & 0x01);                                 /* get bool */
+    if (status != NULL)                                                                      /* check status */
+    {
+        *status = buf[0];                                                                    /* set the status */
+    }
+    *clear = (uint16_t)(((uint16_t)buf[2] << 8) | buf[1]);                                   /* set the clear */
+    *red = (uint16_t)(((uint16_t)buf[4] << 8) | buf[3]);                                     /* set the red */
+    *green = (uint16_t)(((uint16_t)buf[6] << 8) | buf[5]);                                   /* set the green */
+    *blue = (uint16_t)(((uint16_t)buf[8] << 8) | buf[7]);                                    /* set the blue */
+    *proximity = buf[9];                                                                     /* set the proximity */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief     set the gesture proximity enter threshold
+ * @brief     set the proximity up right offset
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] threshold gesture proximity enter threshold
+ * @param[in] offset proximity offset
  * @return    status code
  *            - 0 success
- *            - 1 set gesture proximity enter threshold failed
+ *            - 1 set proximity up right offset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_gesture_proximity_enter_threshold(apds9960_handle_t *handle, uint8_t threshold)
+uint8_t apds9960_set_proximity_up_right_offset(apds9960_handle_t *handle, int8_t offset)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                                   /* check handle */
+    if (handle == NULL)                                                                           /* check handle */
     {
-        return 2;                                                                                         /* return error */
+        return 2;                                                                                 /* return error */
     }
-    if (handle->inited != 1)                                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                      /* check handle initialization */
     {
-        return 3;                                                                                         /* return error */
+        return 3;                                                                                 /* return error */
     }
     
-    prev = threshold;                                                                                     /* set threshold */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GPENTH, (uint8_t *)&prev, 1);                         /* set gesture proximity enter threshold register */
-    if (res != 0)                                                                                         /* check result */
+    if (offset >= 0)                                                                              /* if >= 0 */
     {
-        handle->debug_print("apds9960: set gesture proximity enter threshold register failed.\n");        /* set gesture proximity enter threshold register failed */
+        prev = offset;                                                                            /* set the positive */
+    }
+    else                                                                                          /* < 0 */
+    {
+        prev = 0x80;                                                                              /* set the 0x80 */
+        prev |= (-offset);                                                                        /* set the negative */
+    }
+    res = a_apds9960_iic_write(handle, APDS9960_REG_POFFSET_UR, (uint8_t *)&prev, 1);             /* set proximity offset up right register */
+    if (res != 0)                                                                                 /* check result */
+    {
+        handle->debug_print("apds9960: set proximity offset up right register failed.\n");        /* set proximity offset up right register failed */
        
-        return 1;                                                                                         /* return error */
+        return 1;                                                                                 /* return error */
     }
     
-    return 0;                                                                                             /* success return 0 */
+    return 0;                                                                                     /* success return 0 */
 }
 
 /**
- * @brief      get the gesture proximity enter threshold
+ * @brief      get the proximity up right offset
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *threshold pointer to a gesture proximity enter threshold buffer
+ * @param[out] *offset pointer to a proximity offset buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture proximity enter threshold failed
+ *             - 1 get proximity up right offset failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_proximity_enter_threshold(apds9960_handle_t *handle, uint8_t *threshold)
+uint8_t apds9960_get_proximity_up_right_offset(apds9960_handle_t *handle, int8_t *offset)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                                   /* check handle */
+    if (handle == NULL)                                                                          /* check handle */
     {
-        return 2;                                                                                         /* return error */
+        return 2;                                                                                /* return error */
     }
-    if (handle->inited != 1)                                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                     /* check handle initialization */
     {
-        return 3;                                                                                         /* return error */
+        return 3;                                                                                /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GPENTH, (uint8_t *)&prev, 1);                          /* get gesture proximity enter threshold register */
-    if (res != 0)                                                                                         /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_POFFSET_UR, (uint8_t *)&prev, 1);             /* get proximity offset up right register */
+    if (res != 0)                                                                                /* check result */
     {
-        handle->debug_print("apds9960: get gesture proximity enter threshold register failed.\n");        /* get gesture proximity enter threshold register failed */
+        handle->debug_print("apds9960: get proximity offset up right register failed.\n");       /* get proximity offset up right register failed */
        
-        return 1;                                                                                         /* return error */
+        return 1;                                                                                /* return error */
+    }
+    if ((prev & 0x80) != 0)                                                                      /* if < 0 */
+    {
+        prev &= ~0x80;                                                                           /* clear 0x80 */
+        *offset = -(int8_t)(prev);                                                               /* set the offset */
+    }
+    else                                                                                         /* >= 0 */
+    {
+        *offset = (int8_t)(prev);                                                                /* set the offset */
     }
-    *threshold = prev;                                                                                    /* set threshold */
     
-    return 0;                                                                                             /* success return 0 */
+    return 0;                                                                                    /* success return 0 */
 }
 
 /**
- * @brief     set the gesture proximity exit threshold
+ * @brief     set the proximity down left offset
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] threshold gesture proximity exit threshold
+ * @param[in] offset proximity offset
  * @return    status code
  *            - 0 success
- *            - 1 set gesture proximity exit threshold failed
+ *            - 1 set proximity down left offset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_gesture_proximity_exit_threshold(apds9960_handle_t *handle, uint8_t threshold)
+uint8_t apds9960_set_proximity_down_left_offset(apds9960_handle_t *handle, int8_t offset)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                                  /* check handle */
+    if (handle == NULL)                                                                           /* check handle */
     {
-        return 2;                                                                                        /* return error */
+        return 2;                                                                                 /* return error */
     }
-    if (handle->inited != 1)                                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                                      /* check handle initialization */
     {
-        return 3;                                                                                        /* return error */
+        return 3;                                                                                 /* return error */
     }
     
-    prev = threshold;                                                                                    /* set threshold */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GEXTH, (uint8_t *)&prev, 1);                         /* set gesture proximity exit threshold register */
-    if (res != 0)                                                                                        /* check result */
+    if (offset >= 0)                                                                               /* if >= 0 */
     {
-        handle->debug_print("apds9960: set gesture proximity exit threshold register failed.\n");        /* set gesture proximity exit threshold register failed */
+        prev = offset;                                                                             /* set the positive */
+    }
+    else                                                                                           /* <0 */
+    {
+        prev = 0x80;                                                                               /* set the 0x80 */
+        prev |= (-offset);                                                                         /* set the negative */
+    }
+    res = a_apds9960_iic_write(handle, APDS9960_REG_POFFSET_DL, (uint8_t *)&prev, 1);              /* set proximity offset down left register */
+    if (res != 0)                                                                                  /* check result */
+    {
+        handle->debug_print("apds9960: set proximity offset down left register failed.\n");        /* set proximity offset down left register failed */
        
-        return 1;                                                                                        /* return error */
+        return 1;                                                                                  /* return error */
     }
     
-    return 0;                                                                                            /* success return 0 */
+    return 0;                                                                                      /* success return 0 */
 }
 
 /**
- * @brief      get the gesture proximity exit threshold
+ * @brief      get the proximity down left offset
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *threshold pointer to a gesture proximity exit threshold buffer
+ * @param[out] *offset pointer to a proximity offset buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture proximity exit threshold failed
+ *             - 1 get proximity down left offset failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_proximity_exit_threshold(apds9960_handle_t *handle, uint8_t *threshold)
+uint8_t apds9960_get_proximity_down_left_offset(apds9960_handle_t *handle, int8_t *offset)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                                  /* check handle */
+    if (handle == NULL)                                                                           /* check handle */
     {
-        return 2;                                                                                        /* return error */
+        return 2;                                                                                 /* return error */
     }
-    if (handle->inited != 1)                                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                                      /* check handle initialization */
     {
-        return 3;                                                                                        /* return error */
+        return 3;                                                                                 /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GEXTH, (uint8_t *)&prev, 1);                          /* get gesture proximity exit threshold register */
-    if (res != 0)                                                                                        /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_POFFSET_DL, (uint8_t *)&prev, 1);              /* get proximity offset down left register */
+    if (res != 0)                                                                                 /* check result */
     {
-        handle->debug_print("apds9960: get gesture proximity exit threshold register failed.\n");        /* get gesture proximity exit threshold register failed */
+        handle->debug_print("apds9960: get proximity offset down left register failed.\n");       /* get proximity offset down left register failed */
        
-        return 1;                                                                                        /* return error */
+        return 1;                                                                                 /* return error */
+    }
+    if ((prev & 0x80) != 0)                                                                       /* if < 0 */
+    {
+        prev &= ~0x80;                                                                            /* clear 0x80 */
+        *offset = -(int8_t)(prev);                                                                /* set the offset */
+    }
+    else                                                                                          /* >= 0 */
+    {
+        *offset = (int8_t)(prev);                                                                 /* set the offset */
     }
-    *threshold = prev;                                                                                   /* set the threshold */
     
-    return 0;                                                                                            /* success return 0 */
+    return 0;                                                                                     /* success return 0 */
 }
 
 /**
- * @brief     set the gesture fifo threshold
+ * @brief     enable or disable the proximity gain compensation
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] threshold gesture fifo threshold
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set gesture fifo threshold failed
+ *            - 1 set proximity gain compensation failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_gesture_fifo_threshold(apds9960_handle_t *handle, apds9960_gesture_fifo_threshold_t threshold)
+uint8_t apds9960_set_proximity_gain_compensation(apds9960_handle_t *handle, apds9960_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                          /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);          /* get gesture control 1 register */
-    if (res != 0)                                                                         /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);          /* get control 3 register */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("apds9960: get gesture control 1 register failed.\n");        /* get gesture control 1 register failed */
+        handle->debug_print("apds9960: get control 3 register failed.\n");                 /* get control 3 register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                          /* return error */
     }
-    prev &= ~(3 << 6);                                                                    /* clear config */
-    prev |= threshold << 6;                                                               /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);         /* set gesture control 1 register */
-    if (res != 0)                                                                         /* check result */
+    prev &= ~(1 << 5);                                                                     /* clear config */
+    prev |= enable << 5;                                                                   /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);         /* set control register 3 register */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("apds9960: set gesture control 1 register failed.\n");        /* set gesture control 1 register failed */
+        handle->debug_print("apds9960: set control 3 register register failed.\n");        /* set control 3 register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                          /* return error */
     }
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief      get the gesture fifo threshold
+ * @brief      get the proximity gain compensation status
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *threshold pointer to a gesture fifo threshold buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture fifo threshold failed
+ *             - 1 get proximity gain compensation failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_fifo_threshold(apds9960_handle_t *handle, apds9960_gesture_fifo_threshold_t *threshold)
+uint8_t apds9960_get_proximity_gain_compensation(apds9960_handle_t *handle, apds9960_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                          /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);          /* get gesture control 1 register */
-    if (res != 0)                                                                         /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);          /* get control 3 register */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("apds9960: get gesture control 1 register failed.\n");        /* get gesture control 1 register failed */
+        handle->debug_print("apds9960: get control 3 register failed.\n");                 /* get control 3 register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                          /* return error */
     }
-    *threshold = (apds9960_gesture_fifo_threshold_t)((prev >> 6) & 0x3);                  /* set the threshold */
+    *enable = (apds9960_bool_t)((prev >> 5) & 0x01);                                       /* get bool */
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief     set the gesture exit persistence
+ * @brief     enable or disable sleeping after interrupt
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] persistence gesture exit persistence
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set gesture exit persistence failed
+ *            - 1 set sleep after interrupt failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_gesture_exit_persistence(apds9960_handle_t *handle, apds9960_gesture_exit_persistence_t persistence)
+uint8_t apds9960_set_sleep_after_interrupt(apds9960_handle_t *handle, apds9960_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                          /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);          /* get gesture control 1 register */
-    if (res != 0)                                                                         /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);          /* get control 3 register */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("apds9960: get gesture control 1 register failed.\n");        /* get gesture control 1 register failed */
+        handle->debug_print("apds9960: get control 3 register failed.\n");                 /* get control 3 register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                          /* return error */
     }
-    prev &= ~(3 << 0);                                                                    /* clear config */
-    prev |= persistence << 0;                                                             /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);         /* set gesture control 1 register */
-    if (res != 0)                                                                         /* check result */
+    prev &= ~(1 << 4);                                                                     /* clear config */
+    prev |= enable << 4;                                                                   /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);         /* set control register 3 register */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("apds9960: set gesture control 1 register failed.\n");        /* set gesture control 1 register failed */
+        handle->debug_print("apds9960: set control 3 register register failed.\n");        /* set control 3 register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                          /* return error */
     }
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief      get the gesture exit persistence
+ * @brief      get the sleeping after interrupt status
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *persistence pointer to a gesture exit persistence buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture exit persistence failed
+ *             - 1 get sleep after interrupt failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_exit_persistence(apds9960_handle_t *handle, apds9960_gesture_exit_persistence_t *persistence)
+uint8_t apds9960_get_sleep_after_interrupt(apds9960_handle_t *handle, apds9960_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                          /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);          /* get gesture control 1 register */
-    if (res != 0)                                                                         /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);          /* get control 3 register */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("apds9960: get gesture control 1 register failed.\n");        /* get gesture control 1 register failed */
+        handle->debug_print("apds9960: get control 3 register failed.\n");                 /* get control 3 register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                          /* return error */
     }
-    *persistence = (apds9960_gesture_exit_persistence_t)((prev >> 0) & 0x3);              /* set the persistence */
+    *enable = (apds9960_bool_t)((prev >> 4) & 0x01);                                       /* get bool */
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief     set the gesture exit mask
+ * @brief     enable or disable the proximity mask
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] mask exit mask
+ * @param[in] mask proximity mask
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set gesture exit mask failed
+ *            - 1 set proximity mask failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 mask is over 0xF
  * @note      none
  */
-uint8_t apds9960_set_gesture_exit_mask(apds9960_handle_t *handle, uint8_t mask)
+uint8_t apds9960_set_proximity_mask(apds9960_handle_t *handle, apds9960_proximity_mask_t mask, apds9960_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
-    }
-    if (mask > 0xF)                                                                       /* check result */
-    {
-        handle->debug_print("apds9960: mask is over 0xF.\n");                             /* mask is over 0xF */
-       
-        return 4;                                                                         /* return error */
+        return 3;                                                                          /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);          /* get gesture control 1 register */
-    if (res != 0)                                                                         /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);          /* get control 3 register */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("apds9960: get gesture control 1 register failed.\n");        /* get gesture control 1 register failed */
+        handle->debug_print("apds9960: get control 3 register failed.\n");                 /* get control 3 register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                          /* return error */
     }
-    prev &= ~(0xF << 2);                                                                  /* clear config */
-    prev |= (mask & 0xF) << 2;                                                            /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);         /* set gesture control 1 register */
-    if (res != 0)                                                                         /* check result */
+    prev &= ~(1 << mask);                                                                  /* clear config */
+    prev |= enable << mask;                                                                /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);         /* set control register 3 register */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("apds9960: set gesture control 1 register failed.\n");        /* set gesture control 1 register failed */
+        handle->debug_print("apds9960: set control 3 register register failed.\n");        /* set control 3 register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                          /* return error */
     }
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief      get the gesture exit mask
+ * @brief      get the proximity mask status
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *mask pointer to an exit mask buffer
+ * @param[in]  mask proximity mask
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture exit mask failed
+ *             - 1 get proximity mask failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_exit_mask(apds9960_handle_t *handle, uint8_t *mask)
+uint8_t apds9960_get_proximity_mask(apds9960_handle_t *handle, apds9960_proximity_mask_t mask, apds9960_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);          /* get gesture control 1 register */
-    if (res != 0)                                                                         /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_CONFIG3, (uint8_t *)&prev, 1);       /* get control 3 register */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("apds9960: get gesture control 1 register failed.\n");        /* get gesture control 1 register failed */
+        handle->debug_print("apds9960: get control 3 register failed.\n");              /* get control 3 register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                       /* return error */
     }
-    *mask = (prev >> 2) & 0xF;                                                            /* set the mask */
+    *enable = (apds9960_bool_t)((prev >> mask) & 0x01);                                 /* get bool */
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief     set the gesture gain
+ * @brief     set the gesture proximity enter threshold
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] gain gesture gain
+ * @param[in] threshold gesture proximity enter threshold
  * @return    status code
  *            - 0 success
- *            - 1 set gesture gain failed
+ *            - 1 set gesture proximity enter threshold failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_gesture_gain(apds9960_handle_t *handle, apds9960_gesture_gain_control_t gain)
+uint8_t apds9960_set_gesture_proximity_enter_threshold(apds9960_handle_t *handle, uint8_t threshold)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                                   /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                              /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                                         /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);          /* get gesture control 2 register */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("apds9960: get gesture control 2 register failed.\n");        /* get gesture control 2 register failed */
-       
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(0x3 << 5);                                                                  /* clear config */
-    prev |= gain << 5;                                                                    /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);         /* set gesture control 2 register */
-    if (res != 0)                                                                         /* check result */
+    prev = threshold;                                                                                     /* set threshold */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GPENTH, (uint8_t *)&prev, 1);                         /* set gesture proximity enter threshold register */
+    if (res != 0)                                                                                         /* check result */
     {
-        handle->debug_print("apds9960: set gesture control 2 register failed.\n");        /* set gesture control 2 register failed */
+        handle->debug_print("apds9960: set gesture proximity enter threshold register failed.\n");        /* set gesture proximity enter threshold register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                                         /* return error */
     }
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the gesture gain
+ * @brief      get the gesture proximity enter threshold
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *gain pointer to a gesture gain buffer
+ * @param[out] *threshold pointer to a gesture proximity enter threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture gain failed
+ *             - 1 get gesture proximity enter threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_gain(apds9960_handle_t *handle, apds9960_gesture_gain_control_t *gain)
+uint8_t apds9960_get_gesture_proximity_enter_threshold(apds9960_handle_t *handle, uint8_t *threshold)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                                   /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                              /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                                         /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);          /* get gesture control 2 register */
-    if (res != 0)                                                                         /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GPENTH, (uint8_t *)&prev, 1);                          /* get gesture proximity enter threshold register */
+    if (res != 0)                                                                                         /* check result */
     {
-        handle->debug_print("apds9960: get gesture control 2 register failed.\n");        /* get gesture control 2 register failed */
+        handle->debug_print("apds9960: get gesture proximity enter threshold register failed.\n");        /* get gesture proximity enter threshold register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                                         /* return error */
     }
-    *gain = (apds9960_gesture_gain_control_t)((prev >> 5) & 0x3);                         /* set the gain */
+    *threshold = prev;                                                                                    /* set threshold */
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                                             /* success return 0 */
 }
 
 /**
- * @brief     set the gesture led current
+ * @brief     set the gesture proximity exit threshold
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] current gesture led current
+ * @param[in] threshold gesture proximity exit threshold
  * @return    status code
  *            - 0 success
- *            - 1 set gesture led current failed
+ *            - 1 set gesture proximity exit threshold failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_gesture_led_current(apds9960_handle_t *handle, apds9960_gesture_led_current_t current)
+uint8_t apds9960_set_gesture_proximity_exit_threshold(apds9960_handle_t *handle, uint8_t threshold)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                                  /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                             /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                                        /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);          /* get gesture control 2 register */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("apds9960: get gesture control 2 register failed.\n");        /* get gesture control 2 register failed */
-       
-        return 1;                                                                         /* return error */
-    }
-    prev &= ~(0x3 << 3);                                                                  /* clear config */
-    prev |= current << 3;                                                                 /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);         /* set gesture control 2 register */
-    if (res != 0)                                                                         /* check result */
+    prev = threshold;                                                                                    /* set threshold */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GEXTH, (uint8_t *)&prev, 1);                         /* set gesture proximity exit threshold register */
+    if (res != 0)                                                                                        /* check result */
     {
-        handle->debug_print("apds9960: set gesture control 2 register failed.\n");        /* set gesture control 2 register failed */
+        handle->debug_print("apds9960: set gesture proximity exit threshold register failed.\n");        /* set gesture proximity exit threshold register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                                        /* return error */
     }
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                                            /* success return 0 */
 }
 
 /**
- * @brief      get the gesture led current
+ * @brief      get the gesture proximity exit threshold
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *current pointer to a gesture led current buffer
+ * @param[out] *threshold pointer to a gesture proximity exit threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture led current failed
+ *             - 1 get gesture proximity exit threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_led_current(apds9960_handle_t *handle, apds9960_gesture_led_current_t *current)
+uint8_t apds9960_get_gesture_proximity_exit_threshold(apds9960_handle_t *handle, uint8_t *threshold)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                                  /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                             /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                                        /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);          /* get gesture control 2 register */
-    if (res != 0)                                                                         /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GEXTH, (uint8_t *)&prev, 1);                          /* get gesture proximity exit threshold register */
+    if (res != 0)                                                                                        /* check result */
     {
-        handle->debug_print("apds9960: get gesture control 2 register failed.\n");        /* get gesture control 2 register failed */
+        handle->debug_print("apds9960: get gesture proximity exit threshold register failed.\n");        /* get gesture proximity exit threshold register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                                        /* return error */
     }
-    *current = (apds9960_gesture_led_current_t)((prev >> 3) & 0x3);                       /* set the current */
+    *threshold = prev;                                                                                   /* set the threshold */
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the gesture wait time
+ * @brief     set the gesture fifo threshold
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] t gesture wait time
+ * @param[in] threshold gesture fifo threshold
  * @return    status code
  *            - 0 success
- *            - 1 set gesture wait time failed
+ *            - 1 set gesture fifo threshold failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_gesture_wait_time(apds9960_handle_t *handle, apds9960_gesture_wait_time_t t)
+uint8_t apds9960_set_gesture_fifo_threshold(apds9960_handle_t *handle, apds9960_gesture_fifo_threshold_t threshold)
 {
     uint8_t res;
     uint8_t prev;
@@ -3581,19 +4544,19 @@ uint8_t apds9960_set_gesture_wait_time(apds9960_handle_t *handle, apds9960_gestu
         return 3;                                                                         /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);          /* get gesture control 2 register */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);          /* get gesture control 1 register */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: get gesture control 2 register failed.\n");        /* get gesture control 2 register failed */
+        handle->debug_print("apds9960: get gesture control 1 register failed.\n");        /* get gesture control 1 register failed */
        
         return 1;                                                                         /* return error */
     }
-    prev &= ~(0x7 << 0);                                                                  /* clear config */
-    prev |= t << 0;                                                                       /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);         /* set gesture control 2 register */
+    prev &= ~(3 << 6);                                                                    /* clear config */
+    prev |= threshold << 6;                                                               /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);         /* set gesture control 1 register */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: set gesture control 2 register failed.\n");        /* set gesture control 2 register failed */
+        handle->debug_print("apds9960: set gesture control 1 register failed.\n");        /* set gesture control 1 register failed */
        
         return 1;                                                                         /* return error */
     }
@@ -3602,17 +4565,17 @@ uint8_t apds9960_set_gesture_wait_time(apds9960_handle_t *handle, apds9960_gestu
 }
 
 /**
- * @brief      get the gesture wait time
+ * @brief      get the gesture fifo threshold
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *t pointer to a gesture wait time buffer
+ * @param[out] *threshold pointer to a gesture fifo threshold buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture wait time failed
+ *             - 1 get gesture fifo threshold failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_wait_time(apds9960_handle_t *handle, apds9960_gesture_wait_time_t *t)
+uint8_t apds9960_get_gesture_fifo_threshold(apds9960_handle_t *handle, apds9960_gesture_fifo_threshold_t *threshold)
 {
     uint8_t res;
     uint8_t prev;
@@ -3626,75 +4589,75 @@ uint8_t apds9960_get_gesture_wait_time(apds9960_handle_t *handle, apds9960_gestu
         return 3;                                                                         /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);          /* get gesture control 2 register */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);          /* get gesture control 1 register */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: get gesture control 2 register failed.\n");        /* get gesture control 2 register failed */
+        handle->debug_print("apds9960: get gesture control 1 register failed.\n");        /* get gesture control 1 register failed */
        
         return 1;                                                                         /* return error */
     }
-    *t = (apds9960_gesture_wait_time_t)((prev >> 0) & 0x7);                               /* set the wait time */
+    *threshold = (apds9960_gesture_fifo_threshold_t)((prev >> 6) & 0x3);                  /* set the threshold */
     
     return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief     set the gesture up offset
+ * @brief     set the gesture exit persistence
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] offset gesture up offset
+ * @param[in] persistence gesture exit persistence
  * @return    status code
  *            - 0 success
- *            - 1 set gesture up offset failed
+ *            - 1 set gesture exit persistence failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_gesture_up_offset(apds9960_handle_t *handle, int8_t offset)
+uint8_t apds9960_set_gesture_exit_persistence(apds9960_handle_t *handle, apds9960_gesture_exit_persistence_t persistence)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    if (offset >= 0)                                                                       /* if >= 0 */
-    {
-        prev = offset;                                                                     /* set the positive */
-    }
-    else                                                                                   /* <0 */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);          /* get gesture control 1 register */
+    if (res != 0)                                                                         /* check result */
     {
-        prev = 0x80;                                                                       /* set the 0x80 */
-        prev |= (-offset);                                                                 /* set the negative */
+        handle->debug_print("apds9960: get gesture control 1 register failed.\n");        /* get gesture control 1 register failed */
+       
+        return 1;                                                                         /* return error */
     }
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GOFFSET_U, (uint8_t *)&prev, 1);       /* set gesture up offset register */
-    if (res != 0)                                                                          /* check result */
+    prev &= ~(3 << 0);                                                                    /* clear config */
+    prev |= persistence << 0;                                                             /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);         /* set gesture control 1 register */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: set gesture up offset register failed.\n");         /* set gesture up offset register failed */
+        handle->debug_print("apds9960: set gesture control 1 register failed.\n");        /* set gesture control 1 register failed */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                         /* return error */
     }
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the gesture up offset
+ * @brief      get the gesture exit persistence
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *offset pointer to a gesture up offset buffer
+ * @param[out] *persistence pointer to a gesture exit persistence buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture up offset failed
+ *             - 1 get gesture exit persistence failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_up_offset(apds9960_handle_t *handle, int8_t *offset)
+uint8_t apds9960_get_gesture_exit_persistence(apds9960_handle_t *handle, apds9960_gesture_exit_persistence_t *persistence)
 {
     uint8_t res;
     uint8_t prev;
@@ -3708,83 +4671,82 @@ uint8_t apds9960_get_gesture_up_offset(apds9960_handle_t *handle, int8_t *offset
         return 3;                                                                         /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GOFFSET_U, (uint8_t *)&prev, 1);       /* get gesture up offset register */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);          /* get gesture control 1 register */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: get gesture up offset register failed.\n");        /* get gesture up offset register failed */
+        handle->debug_print("apds9960: get gesture control 1 register failed.\n");        /* get gesture control 1 register failed */
        
         return 1;                                                                         /* return error */
     }
-    if ((prev & 0x80) != 0)                                                               /* if < 0 */
-    {
-        prev &= ~0x80;                                                                    /* clear 0x80 */
-        *offset = -(int8_t)(prev);                                                        /* set the offset */
-    }
-    else                                                                                  /* >= 0 */
-    {
-        *offset = (int8_t)(prev);                                                         /* set the offset */
-    }
+    *persistence = (apds9960_gesture_exit_persistence_t)((prev >> 0) & 0x3);              /* set the persistence */
     
     return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief     set the gesture down offset
+ * @brief     set the gesture exit mask
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] offset gesture down offset
+ * @param[in] mask exit mask
  * @return    status code
  *            - 0 success
- *            - 1 set gesture down offset failed
+ *            - 1 set gesture exit mask failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 4 mask is over 0xF
  * @note      none
  */
-uint8_t apds9960_set_gesture_down_offset(apds9960_handle_t *handle, int8_t offset)
+uint8_t apds9960_set_gesture_exit_mask(apds9960_handle_t *handle, uint8_t mask)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                         /* return error */
     }
-    
-    if (offset >= 0)                                                                       /* if >= 0 */
+    if (mask > 0xF)                                                                       /* check result */
     {
-        prev = offset;                                                                     /* set the positive */
+        handle->debug_print("apds9960: mask is over 0xF.\n");                             /* mask is over 0xF */
+       
+        return 4;                                                                         /* return error */
     }
-    else                                                                                   /* <0 */
+    
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);          /* get gesture control 1 register */
+    if (res != 0)                                                                         /* check result */
     {
-        prev = 0x80;                                                                       /* set the 0x80 */
-        prev |= (-offset);                                                                 /* set the negative */
+        handle->debug_print("apds9960: get gesture control 1 register failed.\n");        /* get gesture control 1 register failed */
+       
+        return 1;                                                                         /* return error */
     }
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GOFFSET_D, (uint8_t *)&prev, 1);       /* set gesture down offset register */
-    if (res != 0)                                                                          /* check result */
+    prev &= ~(0xF << 2);                                                                  /* clear config */
+    prev |= (mask & 0xF) << 2;                                                            /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);         /* set gesture control 1 register */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: set gesture down offset register failed.\n");       /* set gesture down offset register failed */
+        handle->debug_print("apds9960: set gesture control 1 register failed.\n");        /* set gesture control 1 register failed */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                         /* return error */
     }
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the gesture down offset
+ * @brief      get the gesture exit mask
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *offset pointer to a gesture down offset buffer
+ * @param[out] *mask pointer to an exit mask buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture down offset failed
+ *             - 1 get gesture exit mask failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_down_offset(apds9960_handle_t *handle, int8_t *offset)
+uint8_t apds9960_get_gesture_exit_mask(apds9960_handle_t *handle, uint8_t *mask)
 {
     uint8_t res;
     uint8_t prev;
@@ -3798,83 +4760,75 @@ uint8_t apds9960_get_gesture_down_offset(apds9960_handle_t *handle, int8_t *offs
         return 3;                                                                         /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GOFFSET_D, (uint8_t *)&prev, 1);       /* get gesture down offset register */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF1, (uint8_t *)&prev, 1);          /* get gesture control 1 register */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: get gesture down offset register failed.\n");      /* get gesture down offset register failed */
+        handle->debug_print("apds9960: get gesture control 1 register failed.\n");        /* get gesture control 1 register failed */
        
         return 1;                                                                         /* return error */
     }
-    if ((prev & 0x80) != 0)                                                               /* if < 0 */
-    {
-        prev &= ~0x80;                                                                    /* clear 0x80 */
-        *offset = -(int8_t)(prev);                                                        /* set the offset */
-    }
-    else                                                                                  /* >= 0 */
-    {
-        *offset = (int8_t)(prev);                                                         /* set the offset */
-    }
+    *mask = (prev >> 2) & 0xF;                                                            /* set the mask */
     
     return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief     set the gesture left offset
+ * @brief     set the gesture gain
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] offset gesture left offset
+ * @param[in] gain gesture gain
  * @return    status code
  *            - 0 success
- *            - 1 set gesture left offset failed
+ *            - 1 set gesture gain failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_gesture_left_offset(apds9960_handle_t *handle, int8_t offset)
+uint8_t apds9960_set_gesture_gain(apds9960_handle_t *handle, apds9960_gesture_gain_control_t gain)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    if (offset >= 0)                                                                       /* if >= 0 */
-    {
-        prev = offset;                                                                     /* set the positive */
-    }
-    else                                                                                   /* <0 */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);          /* get gesture control 2 register */
+    if (res != 0)                                                                         /* check result */
     {
-        prev = 0x80;                                                                       /* set the 0x80 */
-        prev |= (-offset);                                                                 /* set the negative */
+        handle->debug_print("apds9960: get gesture control 2 register failed.\n");        /* get gesture control 2 register failed */
+       
+        return 1;                                                                         /* return error */
     }
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GOFFSET_L, (uint8_t *)&prev, 1);       /* set gesture left offset register */
-    if (res != 0)                                                                          /* check result */
+    prev &= ~(0x3 << 5);                                                                  /* clear config */
+    prev |= gain << 5;                                                                    /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);         /* set gesture control 2 register */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: set gesture left offset register failed.\n");       /* set gesture left offset register failed */
+        handle->debug_print("apds9960: set gesture control 2 register failed.\n");        /* set gesture control 2 register failed */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                         /* return error */
     }
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the gesture left offset
+ * @brief      get the gesture gain
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *offset pointer to a gesture left offset buffer
+ * @param[out] *gain pointer to a gesture gain buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture left offset failed
+ *             - 1 get gesture gain failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_left_offset(apds9960_handle_t *handle, int8_t *offset)
+uint8_t apds9960_get_gesture_gain(apds9960_handle_t *handle, apds9960_gesture_gain_control_t *gain)
 {
     uint8_t res;
     uint8_t prev;
@@ -3888,83 +4842,75 @@ uint8_t apds9960_get_gesture_left_offset(apds9960_handle_t *handle, int8_t *offs
         return 3;                                                                         /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GOFFSET_L, (uint8_t *)&prev, 1);       /* get gesture left offset register */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);          /* get gesture control 2 register */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: get gesture left offset register failed.\n");      /* get gesture left offset register failed */
+        handle->debug_print("apds9960: get gesture control 2 register failed.\n");        /* get gesture control 2 register failed */
        
         return 1;                                                                         /* return error */
     }
-    if ((prev & 0x80) != 0)                                                               /* if < 0 */
-    {
-        prev &= ~0x80;                                                                    /* clear 0x80 */
-        *offset = -(int8_t)(prev);                                                        /* set the offset */
-    }
-    else                                                                                  /* >= 0 */
-    {
-        *offset = (int8_t)(prev);                                                         /* set the offset */
-    }
+    *gain = (apds9960_gesture_gain_control_t)((prev >> 5) & 0x3);                         /* set the gain */
     
     return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief     set the gesture right offset
+ * @brief     set the gesture led current
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] offset gesture right offset
+ * @param[in] current gesture led current
  * @return    status code
  *            - 0 success
- *            - 1 set gesture right offset failed
+ *            - 1 set gesture led current failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_gesture_right_offset(apds9960_handle_t *handle, int8_t offset)
+uint8_t apds9960_set_gesture_led_current(apds9960_handle_t *handle, apds9960_gesture_led_current_t current)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    if (offset >= 0)                                                                       /* if >= 0 */
-    {
-        prev = offset;                                                                     /* set the positive */
-    }
-    else                                                                                   /* <0 */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);          /* get gesture control 2 register */
+    if (res != 0)                                                                         /* check result */
     {
-        prev = 0x80;                                                                       /* set the 0x80 */
-        prev |= (-offset);                                                                 /* set the negative */
+        handle->debug_print("apds9960: get gesture control 2 register failed.\n");        /* get gesture control 2 register failed */
+       
+        return 1;                                                                         /* return error */
     }
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GOFFSET_R, (uint8_t *)&prev, 1);       /* set gesture right offset register */
-    if (res != 0)                                                                          /* check result */
+    prev &= ~(0x3 << 3);                                                                  /* clear config */
+    prev |= current << 3;                                                                 /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);         /* set gesture control 2 register */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: set gesture right offset register failed.\n");      /* set gesture right offset register failed */
+        handle->debug_print("apds9960: set gesture control 2 register failed.\n");        /* set gesture control 2 register failed */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                         /* return error */
     }
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the gesture right offset
+ * @brief      get the gesture led current
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *offset pointer to a gesture right offset buffer
+ * @param[out] *current pointer to a gesture led current buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture right offset failed
+ *             - 1 get gesture led current failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_right_offset(apds9960_handle_t *handle, int8_t *offset)
+uint8_t apds9960_get_gesture_led_current(apds9960_handle_t *handle, apds9960_gesture_led_current_t *current)
 {
     uint8_t res;
     uint8_t prev;
@@ -3978,572 +4924,643 @@ uint8_t apds9960_get_gesture_right_offset(apds9960_handle_t *handle, int8_t *off
         return 3;                                                                         /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GOFFSET_R, (uint8_t *)&prev, 1);       /* get gesture right offset register */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);          /* get gesture control 2 register */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: get gesture right offset register failed.\n");     /* get gesture right offset register failed */
+        handle->debug_print("apds9960: get gesture control 2 register failed.\n");        /* get gesture control 2 register failed */
        
         return 1;                                                                         /* return error */
     }
-    if ((prev & 0x80) != 0)                                                               /* if < 0 */
-    {
-        prev &= ~0x80;                                                                    /* clear 0x80 */
-        *offset = -(int8_t)(prev);                                                        /* set the offset */
-    }
-    else                                                                                  /* >= 0 */
-    {
-        *offset = (int8_t)(prev);                                                         /* set the offset */
-    }
+    *current = (apds9960_gesture_led_current_t)((prev >> 3) & 0x3);                       /* set the current */
     
     return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief     set the gesture pulse length
+ * @brief     set the gesture wait time
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] len gesture pulse length
+ * @param[in] t gesture wait time
  * @return    status code
  *            - 0 success
- *            - 1 set gesture pulse length failed
+ *            - 1 set gesture wait time failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_gesture_pulse_length(apds9960_handle_t *handle, apds9960_gesture_pulse_length_t len)
+uint8_t apds9960_set_gesture_wait_time(apds9960_handle_t *handle, apds9960_gesture_wait_time_t t)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GPULSE, (uint8_t *)&prev, 1);              /* get gesture pulse count register */
-    if (res != 0)                                                                             /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);          /* get gesture control 2 register */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: get gesture pulse count register failed.\n");          /* get gesture pulse count register failed */
+        handle->debug_print("apds9960: get gesture control 2 register failed.\n");        /* get gesture control 2 register failed */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                         /* return error */
     }
-    prev &= ~(3 << 6);                                                                        /* clear config */
-    prev |= len << 6;                                                                         /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GPULSE, (uint8_t *)&prev, 1);             /* set gesture pulse count register */
-    if (res != 0)                                                                             /* check result */
+    prev &= ~(0x7 << 0);                                                                  /* clear config */
+    prev |= t << 0;                                                                       /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);         /* set gesture control 2 register */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: set gesture pulse count register failed.\n");          /* set gesture pulse count register failed */
+        handle->debug_print("apds9960: set gesture control 2 register failed.\n");        /* set gesture control 2 register failed */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                         /* return error */
     }
     
-    return 0;                                                                                 /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the gesture pulse length
+ * @brief      get the gesture wait time
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *len pointer to a gesture pulse length buffer
+ * @param[out] *t pointer to a gesture wait time buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture pulse length failed
+ *             - 1 get gesture wait time failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_pulse_length(apds9960_handle_t *handle, apds9960_gesture_pulse_length_t *len)
+uint8_t apds9960_get_gesture_wait_time(apds9960_handle_t *handle, apds9960_gesture_wait_time_t *t)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GPULSE, (uint8_t *)&prev, 1);            /* get gesture pulse count register */
-    if (res != 0)                                                                           /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF2, (uint8_t *)&prev, 1);          /* get gesture control 2 register */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: get gesture pulse count register failed.\n");        /* get gesture pulse count register failed */
+        handle->debug_print("apds9960: get gesture control 2 register failed.\n");        /* get gesture control 2 register failed */
        
-        return 1;                                                                           /* return error */
+        return 1;                                                                         /* return error */
     }
-    *len = (apds9960_gesture_pulse_length_t)((prev >> 6) & 0x3);                            /* get length */
+    *t = (apds9960_gesture_wait_time_t)((prev >> 0) & 0x7);                               /* set the wait time */
     
-    return 0;                                                                               /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief     set the gesture pulse count
+ * @brief     set the gesture up offset
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] count gesture pulse count
+ * @param[in] offset gesture up offset
  * @return    status code
  *            - 0 success
- *            - 1 set gesture pulse count failed
+ *            - 1 set gesture up offset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 count is over 63
  * @note      none
  */
-uint8_t apds9960_set_gesture_pulse_count(apds9960_handle_t *handle, uint16_t count)
+uint8_t apds9960_set_gesture_up_offset(apds9960_handle_t *handle, int8_t offset)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                                                                          /* return error */
     }
-    if (count > 0x3F)                                                                       /* check count */
+    
+    if (offset >= 0)                                                                       /* if >= 0 */
     {
-        handle->debug_print("apds9960: count is over 63.\n");                               /* count is over 63 */
-       
-        return 4;                                                                           /* return error */
+        prev = offset;                                                                     /* set the positive */
     }
-    
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GPULSE, (uint8_t *)&prev, 1);            /* get gesture pulse count register */
-    if (res != 0)                                                                           /* check result */
+    else                                                                                   /* <0 */
     {
-        handle->debug_print("apds9960: get gesture pulse count register failed.\n");        /* get gesture pulse count register failed */
-       
-        return 1;                                                                           /* return error */
+        prev = 0x80;                                                                       /* set the 0x80 */
+        prev |= (-offset);                                                                 /* set the negative */
     }
-    prev &= ~(0x3F << 0);                                                                   /* clear config */
-    prev |= (count & 0x3F) << 0;                                                            /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GPULSE, (uint8_t *)&prev, 1);           /* set gesture pulse count register */
-    if (res != 0)                                                                           /* check result */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GOFFSET_U, (uint8_t *)&prev, 1);       /* set gesture up offset register */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("apds9960: set gesture pulse count register failed.\n");        /* set gesture pulse count register failed */
+        handle->debug_print("apds9960: set gesture up offset register failed.\n");         /* set gesture up offset register failed */
        
-        return 1;                                                                           /* return error */
+        return 1;                                                                          /* return error */
     }
     
-    return 0;                                                                               /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief      get the gesture pulse count
+ * @brief      get the gesture up offset
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *count pointer to a gesture pulse count buffer
+ * @param[out] *offset pointer to a gesture up offset buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture pulse count failed
+ *             - 1 get gesture up offset failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_pulse_count(apds9960_handle_t *handle, uint16_t *count)
+uint8_t apds9960_get_gesture_up_offset(apds9960_handle_t *handle, int8_t *offset)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GPULSE, (uint8_t *)&prev, 1);            /* get gesture pulse count register */
-    if (res != 0)                                                                           /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GOFFSET_U, (uint8_t *)&prev, 1);       /* get gesture up offset register */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: get gesture pulse count register failed.\n");        /* get gesture pulse count register failed */
+        handle->debug_print("apds9960: get gesture up offset register failed.\n");        /* get gesture up offset register failed */
        
-        return 1;                                                                           /* return error */
+        return 1;                                                                         /* return error */
+    }
+    if ((prev & 0x80) != 0)                                                               /* if < 0 */
+    {
+        prev &= ~0x80;                                                                    /* clear 0x80 */
+        *offset = -(int8_t)(prev);                                                        /* set the offset */
+    }
+    else                                                                                  /* >= 0 */
+    {
+        *offset = (int8_t)(prev);                                                         /* set the offset */
     }
-    *count = prev & 0x3F;                                                                   /* get count */
     
-    return 0;                                                                               /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief     set the gesture dimension
+ * @brief     set the gesture down offset
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] s gesture dimension
+ * @param[in] offset gesture down offset
  * @return    status code
  *            - 0 success
- *            - 1 set gesture dimension failed
+ *            - 1 set gesture down offset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_gesture_dimension(apds9960_handle_t *handle, apds9960_gesture_dimension_select_t s)
+uint8_t apds9960_set_gesture_down_offset(apds9960_handle_t *handle, int8_t offset)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                          /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF3, (uint8_t *)&prev, 1);        /* get gesture conf 3 register */
-    if (res != 0)                                                                       /* check result */
+    if (offset >= 0)                                                                       /* if >= 0 */
     {
-        handle->debug_print("apds9960: get gesture conf 3 register failed.\n");         /* get gesture conf 3 register failed */
-       
-        return 1;                                                                       /* return error */
+        prev = offset;                                                                     /* set the positive */
     }
-    prev &= ~(3 << 0);                                                                  /* clear config */
-    prev |= s << 0;                                                                     /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF3, (uint8_t *)&prev, 1);       /* set gesture conf 3 register */
-    if (res != 0)                                                                       /* check result */
+    else                                                                                   /* <0 */
     {
-        handle->debug_print("apds9960: set gesture conf 3 register failed.\n");         /* set gesture conf 3 register failed */
+        prev = 0x80;                                                                       /* set the 0x80 */
+        prev |= (-offset);                                                                 /* set the negative */
+    }
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GOFFSET_D, (uint8_t *)&prev, 1);       /* set gesture down offset register */
+    if (res != 0)                                                                          /* check result */
+    {
+        handle->debug_print("apds9960: set gesture down offset register failed.\n");       /* set gesture down offset register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                                          /* return error */
     }
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief      get the gesture dimension
+ * @brief      get the gesture down offset
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *s pointer to a gesture dimension buffer
+ * @param[out] *offset pointer to a gesture down offset buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture dimension failed
+ *             - 1 get gesture down offset failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_dimension_select(apds9960_handle_t *handle, apds9960_gesture_dimension_select_t *s)
+uint8_t apds9960_get_gesture_down_offset(apds9960_handle_t *handle, int8_t *offset)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF3, (uint8_t *)&prev, 1);        /* get gesture conf 3 register */
-    if (res != 0)                                                                       /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GOFFSET_D, (uint8_t *)&prev, 1);       /* get gesture down offset register */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: get gesture conf 3 register failed.\n");         /* get gesture conf 3 register failed */
+        handle->debug_print("apds9960: get gesture down offset register failed.\n");      /* get gesture down offset register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                                         /* return error */
+    }
+    if ((prev & 0x80) != 0)                                                               /* if < 0 */
+    {
+        prev &= ~0x80;                                                                    /* clear 0x80 */
+        *offset = -(int8_t)(prev);                                                        /* set the offset */
+    }
+    else                                                                                  /* >= 0 */
+    {
+        *offset = (int8_t)(prev);                                                         /* set the offset */
     }
-    *s = (apds9960_gesture_dimension_select_t)(prev & 0x3);                             /* get the select */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief     clear the gesture fifo status
+ * @brief     set the gesture left offset
  * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] offset gesture left offset
  * @return    status code
  *            - 0 success
- *            - 1 gesture fifo clear failed
+ *            - 1 set gesture left offset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_gesture_fifo_clear(apds9960_handle_t *handle)
+uint8_t apds9960_set_gesture_left_offset(apds9960_handle_t *handle, int8_t offset)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                          /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);        /* get gesture conf 4 register */
-    if (res != 0)                                                                       /* check result */
+    if (offset >= 0)                                                                       /* if >= 0 */
     {
-        handle->debug_print("apds9960: get gesture conf 4 register failed.\n");         /* get gesture conf 4 register failed */
-       
-        return 1;                                                                       /* return error */
+        prev = offset;                                                                     /* set the positive */
     }
-    prev &= ~(1 << 2);                                                                  /* clear config */
-    prev |= 1 << 2;                                                                     /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);       /* set gesture conf 4 register */
-    if (res != 0)                                                                       /* check result */
+    else                                                                                   /* <0 */
     {
-        handle->debug_print("apds9960: set gesture conf 4 register failed.\n");         /* set gesture conf 4 register failed */
+        prev = 0x80;                                                                       /* set the 0x80 */
+        prev |= (-offset);                                                                 /* set the negative */
+    }
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GOFFSET_L, (uint8_t *)&prev, 1);       /* set gesture left offset register */
+    if (res != 0)                                                                          /* check result */
+    {
+        handle->debug_print("apds9960: set gesture left offset register failed.\n");       /* set gesture left offset register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                                          /* return error */
     }
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the gesture interrupt
- * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set gesture interrupt failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      get the gesture left offset
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *offset pointer to a gesture left offset buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get gesture left offset failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t apds9960_set_gesture_interrupt(apds9960_handle_t *handle, apds9960_bool_t enable)
+uint8_t apds9960_get_gesture_left_offset(apds9960_handle_t *handle, int8_t *offset)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);        /* get gesture conf 4 register */
-    if (res != 0)                                                                       /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GOFFSET_L, (uint8_t *)&prev, 1);       /* get gesture left offset register */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: get gesture conf 4 register failed.\n");         /* get gesture conf 4 register failed */
+        handle->debug_print("apds9960: get gesture left offset register failed.\n");      /* get gesture left offset register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                                         /* return error */
     }
-    prev &= ~(1 << 1);                                                                  /* clear config */
-    prev |= enable << 1;                                                                /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);       /* set gesture conf 4 register */
-    if (res != 0)                                                                       /* check result */
+    if ((prev & 0x80) != 0)                                                               /* if < 0 */
     {
-        handle->debug_print("apds9960: set gesture conf 4 register failed.\n");         /* set gesture conf 4 register failed */
+        prev &= ~0x80;                                                                    /* clear 0x80 */
+        *offset = -(int8_t)(prev);                                                        /* set the offset */
+    }
+    else                                                                                  /* >= 0 */
+    {
+        *offset = (int8_t)(prev);                                                         /* set the offset */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     set the gesture right offset
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] offset gesture right offset
+ * @return    status code
+ *            - 0 success
+ *            - 1 set gesture right offset failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t apds9960_set_gesture_right_offset(apds9960_handle_t *handle, int8_t offset)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (handle->inited != 1)                                                               /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    if (offset >= 0)                                                                       /* if >= 0 */
+    {
+        prev = offset;                                                                     /* set the positive */
+    }
+    else                                                                                   /* <0 */
+    {
+        prev = 0x80;                                                                       /* set the 0x80 */
+        prev |= (-offset);                                                                 /* set the negative */
+    }
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GOFFSET_R, (uint8_t *)&prev, 1);       /* set gesture right offset register */
+    if (res != 0)                                                                          /* check result */
+    {
+        handle->debug_print("apds9960: set gesture right offset register failed.\n");      /* set gesture right offset register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                                          /* return error */
     }
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief      get the gesture interrupt status
+ * @brief      get the gesture right offset
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *offset pointer to a gesture right offset buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture interrupt failed
+ *             - 1 get gesture right offset failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_interrupt(apds9960_handle_t *handle, apds9960_bool_t *enable)
+uint8_t apds9960_get_gesture_right_offset(apds9960_handle_t *handle, int8_t *offset)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);        /* get gesture conf 4 register */
-    if (res != 0)                                                                       /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GOFFSET_R, (uint8_t *)&prev, 1);       /* get gesture right offset register */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("apds9960: get gesture conf 4 register failed.\n");         /* get gesture conf 4 register failed */
+        handle->debug_print("apds9960: get gesture right offset register failed.\n");     /* get gesture right offset register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                                         /* return error */
+    }
+    if ((prev & 0x80) != 0)                                                               /* if < 0 */
+    {
+        prev &= ~0x80;                                                                    /* clear 0x80 */
+        *offset = -(int8_t)(prev);                                                        /* set the offset */
+    }
+    else                                                                                  /* >= 0 */
+    {
+        *offset = (int8_t)(prev);                                                         /* set the offset */
     }
-    *enable = (apds9960_bool_t)((prev >> 1) & 0x1);                                     /* set bool */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the gesture mode
+ * @brief     set the gesture pulse length
  * @param[in] *handle pointer to an apds9960 handle structure
- * @param[in] enable bool value
+ * @param[in] len gesture pulse length
  * @return    status code
  *            - 0 success
- *            - 1 set gesture mode failed
+ *            - 1 set gesture pulse length failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_set_gesture_mode(apds9960_handle_t *handle, apds9960_bool_t enable)
+uint8_t apds9960_set_gesture_pulse_length(apds9960_handle_t *handle, apds9960_gesture_pulse_length_t len)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                             /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);        /* get gesture conf 4 register */
-    if (res != 0)                                                                       /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GPULSE, (uint8_t *)&prev, 1);              /* get gesture pulse count register */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("apds9960: get gesture conf 4 register failed.\n");         /* get gesture conf 4 register failed */
+        handle->debug_print("apds9960: get gesture pulse count register failed.\n");          /* get gesture pulse count register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                                             /* return error */
     }
-    prev &= ~(1 << 0);                                                                  /* clear config */
-    prev |= enable << 0;                                                                /* set config */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);       /* set gesture conf 4 register */
-    if (res != 0)                                                                       /* check result */
+    prev &= ~(3 << 6);                                                                        /* clear config */
+    prev |= len << 6;                                                                         /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GPULSE, (uint8_t *)&prev, 1);             /* set gesture pulse count register */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("apds9960: set gesture conf 4 register failed.\n");         /* set gesture conf 4 register failed */
+        handle->debug_print("apds9960: set gesture pulse count register failed.\n");          /* set gesture pulse count register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                                             /* return error */
     }
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief      get the gesture mode status
+ * @brief      get the gesture pulse length
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *len pointer to a gesture pulse length buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture mode failed
+ *             - 1 get gesture pulse length failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_mode(apds9960_handle_t *handle, apds9960_bool_t *enable)
+uint8_t apds9960_get_gesture_pulse_length(apds9960_handle_t *handle, apds9960_gesture_pulse_length_t *len)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                     /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                           /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                                /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                           /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);        /* get gesture conf 4 register */
-    if (res != 0)                                                                       /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GPULSE, (uint8_t *)&prev, 1);            /* get gesture pulse count register */
+    if (res != 0)                                                                           /* check result */
     {
-        handle->debug_print("apds9960: get gesture conf 4 register failed.\n");         /* get gesture conf 4 register failed */
+        handle->debug_print("apds9960: get gesture pulse count register failed.\n");        /* get gesture pulse count register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                                           /* return error */
     }
-    *enable = (apds9960_bool_t)((prev >> 0) & 0x1);                                     /* set bool */
+    *len = (apds9960_gesture_pulse_length_t)((prev >> 6) & 0x3);                            /* get length */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                               /* success return 0 */
 }
 
 /**
- * @brief      get the gesture fifo level
- * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *level pointer to a gesture fifo level buffer
- * @return     status code
- *             - 0 success
- *             - 1 get gesture fifo level failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     set the gesture pulse count
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] count gesture pulse count
+ * @return    status code
+ *            - 0 success
+ *            - 1 set gesture pulse count failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 count is over 63
+ * @note      none
  */
-uint8_t apds9960_get_gesture_fifo_level(apds9960_handle_t *handle, uint8_t *level)
+uint8_t apds9960_set_gesture_pulse_count(apds9960_handle_t *handle, uint16_t count)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                     /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                           /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                                /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                           /* return error */
+    }
+    if (count > 0x3F)                                                                       /* check count */
+    {
+        handle->debug_print("apds9960: count is over 63.\n");                               /* count is over 63 */
+       
+        return 4;                                                                           /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GFLVL, (uint8_t *)&prev, 1);            /* get gesture fifo level register */
-    if (res != 0)                                                                          /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GPULSE, (uint8_t *)&prev, 1);            /* get gesture pulse count register */
+    if (res != 0)                                                                           /* check result */
     {
-        handle->debug_print("apds9960: get gesture fifo level register failed.\n");        /* get gesture fifo level register failed */
+        handle->debug_print("apds9960: get gesture pulse count register failed.\n");        /* get gesture pulse count register failed */
        
-        return 1;                                                                          /* return error */
+        return 1;                                                                           /* return error */
+    }
+    prev &= ~(0x3F << 0);                                                                   /* clear config */
+    prev |= (count & 0x3F) << 0;                                                            /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GPULSE, (uint8_t *)&prev, 1);           /* set gesture pulse count register */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("apds9960: set gesture pulse count register failed.\n");        /* set gesture pulse count register failed */
+       
+        return 1;                                                                           /* return error */
     }
-    *level = prev;                                                                         /* set fifo level */
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                               /* success return 0 */
 }
 
 /**
- * @brief      get the gesture status
+ * @brief      get the gesture pulse count
  * @param[in]  *handle pointer to an apds9960 handle structure
- * @param[out] *status pointer to a status buffer
+ * @param[out] *count pointer to a gesture pulse count buffer
  * @return     status code
  *             - 0 success
- *             - 1 get gesture status failed
+ *             - 1 get gesture pulse count failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t apds9960_get_gesture_status(apds9960_handle_t *handle, uint8_t *status)
+uint8_t apds9960_get_gesture_pulse_count(apds9960_handle_t *handle, uint16_t *count)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                                     /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                           /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                                /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                           /* return error */
     }
     
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GSTATUS, (uint8_t *)&prev, 1);        /* get gesture status register */
-    if (res != 0)                                                                        /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GPULSE, (uint8_t *)&prev, 1);            /* get gesture pulse count register */
+    if (res != 0)                                                                           /* check result */
     {
-        handle->debug_print("apds9960: get gesture status register failed.\n");          /* get gesture status register failed */
+        handle->debug_print("apds9960: get gesture pulse count register failed.\n");        /* get gesture pulse count register failed */
        
-        return 1;                                                                        /* return error */
+        return 1;                                                                           /* return error */
     }
-    *status = prev;                                                                      /* set status */
+    *count = prev & 0x3F;                                                                   /* get count */
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                               /* success return 0 */
 }
 
 /**
- * @brief     force an interrupt
+ * @brief     set the gesture dimension
  * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] s gesture dimension
  * @return    status code
  *            - 0 success
- *            - 1 force interrupt failed
+ *            - 1 set gesture dimension failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_force_interrupt(apds9960_handle_t *handle)
+uint8_t apds9960_set_gesture_dimension(apds9960_handle_t *handle, apds9960_gesture_dimension_select_t s)
 {
     uint8_t res;
     uint8_t prev;
@@ -4557,11 +5574,19 @@ uint8_t apds9960_force_interrupt(apds9960_handle_t *handle)
         return 3;                                                                       /* return error */
     }
     
-    prev = 0xFF;                                                                        /* set 0xFF */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_IFORCE, (uint8_t *)&prev, 1);       /* forces an interrupt */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF3, (uint8_t *)&prev, 1);        /* get gesture conf 3 register */
     if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("apds9960: forces an interrupt failed.\n");                 /* forces an interrupt failed */
+        handle->debug_print("apds9960: get gesture conf 3 register failed.\n");         /* get gesture conf 3 register failed */
+       
+        return 1;                                                                       /* return error */
+    }
+    prev &= ~(3 << 0);                                                                  /* clear config */
+    prev |= s << 0;                                                                     /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF3, (uint8_t *)&prev, 1);       /* set gesture conf 3 register */
+    if (res != 0)                                                                       /* check result */
+    {
+        handle->debug_print("apds9960: set gesture conf 3 register failed.\n");         /* set gesture conf 3 register failed */
        
         return 1;                                                                       /* return error */
     }
@@ -4570,159 +5595,2618 @@ uint8_t apds9960_force_interrupt(apds9960_handle_t *handle)
 }
 
 /**
- * @brief     clear the proximity interrupt
+ * @brief      get the gesture dimension
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *s pointer to a gesture dimension buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get gesture dimension failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t apds9960_get_gesture_dimension_select(apds9960_handle_t *handle, apds9960_gesture_dimension_select_t *s)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF3, (uint8_t *)&prev, 1);        /* get gesture conf 3 register */
+    if (res != 0)                                                                       /* check result */
+    {
+        handle->debug_print("apds9960: get gesture conf 3 register failed.\n");         /* get gesture conf 3 register failed */
+       
+        return 1;                                                                       /* return error */
+    }
+    *s = (apds9960_gesture_dimension_select_t)(prev & 0x3);                             /* get the select */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     clear the gesture fifo status
  * @param[in] *handle pointer to an apds9960 handle structure
  * @return    status code
  *            - 0 success
- *            - 1 proximity interrupt clear failed
+ *            - 1 gesture fifo clear failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_proximity_interrupt_clear(apds9960_handle_t *handle)
+uint8_t apds9960_gesture_fifo_clear(apds9960_handle_t *handle)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    prev = 0xFF;                                                                         /* set 0xFF */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_PICLEAR, (uint8_t *)&prev, 1);       /* proximity interrupt clear */
-    if (res != 0)                                                                        /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);        /* get gesture conf 4 register */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("apds9960: proximity interrupt clear failed.\n");            /* proximity interrupt clear failed */
+        handle->debug_print("apds9960: get gesture conf 4 register failed.\n");         /* get gesture conf 4 register failed */
        
-        return 1;                                                                        /* return error */
+        return 1;                                                                       /* return error */
+    }
+    prev &= ~(1 << 2);                                                                  /* clear config */
+    prev |= 1 << 2;                                                                     /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);       /* set gesture conf 4 register */
+    if (res != 0)                                                                       /* check result */
+    {
+        handle->debug_print("apds9960: set gesture conf 4 register failed.\n");         /* set gesture conf 4 register failed */
+       
+        return 1;                                                                       /* return error */
+    }
+    if (handle->gesture_decoder->reset != NULL)                                         /* check the reset */
+    {
+        handle->gesture_decoder->reset(handle, handle->gesture_decoder_state);          /* drop the gesture being decoded */
     }
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief     clear the als interrupt
+ * @brief     enable or disable the gesture interrupt
  * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 als interrupt clear failed
+ *            - 1 set gesture interrupt failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_als_interrupt_clear(apds9960_handle_t *handle)
+uint8_t apds9960_set_gesture_interrupt(apds9960_handle_t *handle, apds9960_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    prev = 0xFF;                                                                         /* set 0xFF */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_CICLEAR, (uint8_t *)&prev, 1);       /* als interrupt clear */
-    if (res != 0)                                                                        /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);        /* get gesture conf 4 register */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("apds9960: als interrupt clear failed.\n");                  /* als interrupt clear failed */
+        handle->debug_print("apds9960: get gesture conf 4 register failed.\n");         /* get gesture conf 4 register failed */
        
-        return 1;                                                                        /* return error */
+        return 1;                                                                       /* return error */
+    }
+    prev &= ~(1 << 1);                                                                  /* clear config */
+    prev |= enable << 1;                                                                /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);       /* set gesture conf 4 register */
+    if (res != 0)                                                                       /* check result */
+    {
+        handle->debug_print("apds9960: set gesture conf 4 register failed.\n");         /* set gesture conf 4 register failed */
+       
+        return 1;                                                                       /* return error */
     }
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief     clear the all not gesture interrupt
+ * @brief      get the gesture interrupt status
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get gesture interrupt failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t apds9960_get_gesture_interrupt(apds9960_handle_t *handle, apds9960_bool_t *enable)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);        /* get gesture conf 4 register */
+    if (res != 0)                                                                       /* check result */
+    {
+        handle->debug_print("apds9960: get gesture conf 4 register failed.\n");         /* get gesture conf 4 register failed */
+       
+        return 1;                                                                       /* return error */
+    }
+    *enable = (apds9960_bool_t)((prev >> 1) & 0x1);                                     /* set bool */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the gesture mode
  * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 all non gesture interrupt clear failed
+ *            - 1 set gesture mode failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t apds9960_all_non_gesture_interrupt_clear(apds9960_handle_t *handle)
+uint8_t apds9960_set_gesture_mode(apds9960_handle_t *handle, apds9960_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
+    uint8_t gesture;
+    uint8_t second;
     
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    prev = 0xFF;                                                                             /* set 0xFF */
-    res = a_apds9960_iic_write(handle, APDS9960_REG_AICLEAR, (uint8_t *)&prev, 1);           /* clear all non-gesture interrupts */
-    if (res != 0)                                                                            /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);        /* get gesture conf 4 register */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("apds9960: clear all non-gesture interrupts failed.\n");         /* clear all non-gesture interrupts failed */
+        handle->debug_print("apds9960: get gesture conf 4 register failed.\n");         /* get gesture conf 4 register failed */
        
-        return 1;                                                                            /* return error */
+        return 1;                                                                       /* return error */
+    }
+    prev &= ~(1 << 0);                                                                  /* clear config */
+    prev |= enable << 0;                                                                /* set config */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);       /* set gesture conf 4 register */
+    if (res != 0)                                                                       /* check result */
+    {
+        handle->debug_print("apds9960: set gesture conf 4 register failed.\n");         /* set gesture conf 4 register failed */
+       
+        return 1;                                                                       /* return error */
+    }
+    if ((enable == APDS9960_BOOL_FALSE) && (handle->gesture_decoder->flush != NULL))    /* gesture mode is left */
+    {
+        if (handle->gesture_decoder->flush(handle, handle->gesture_decoder_state,
+                                           &gesture, &second) != 0)                     /* flush the decoder */
+        {
+            handle->debug_print("apds9960: flush gesture decoder failed.\n");           /* flush gesture decoder failed */
+           
+            return 1;                                                                   /* return error */
+        }
+        handle->gesture_status |= gesture;                                              /* save the gesture */
+        handle->gesture_second |= second;                                               /* save the second stroke */
     }
     
-    return 0;                                                                                /* success return 0 */
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief         read data from the gesture fifo
- * @param[in]     *handle pointer to an apds9960 handle structure
- * @param[out]    **data pointer to a data buffer
- * @param[in,out] *len pointer to a data length buffer
- * @return        status code
- *                - 0 success
- *                - 1 read gesture fifo failed
- *                - 2 handle is NULL
- *                - 3 handle is not initialized
- * @note          none
+ * @brief      get the gesture mode status
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get gesture mode failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t apds9960_read_gesture_fifo(apds9960_handle_t *handle, uint8_t (*data)[4], uint8_t *len)
+uint8_t apds9960_get_gesture_mode(apds9960_handle_t *handle, apds9960_bool_t *enable)
 {
     uint8_t res;
-    uint8_t level;
+    uint8_t prev;
     
-    if (handle == NULL)                                                                         /* check handle */
-    {
-        return 2;                                                                               /* return error */
-    }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 3;                                                                               /* return error */
+        return 2;                                                                       /* return error */
     }
-    
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GFLVL, (uint8_t *)&level, 1);                /* get gesture fifo level register */
-    if (res != 0)                                                                               /* check result */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        handle->debug_print("apds9960: get gesture fifo level register failed.\n");             /* get gesture fifo level register failed */
-       
-        return 1;                                                                               /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    *len = level < (*len) ? level : (*len);
-    res = a_apds9960_iic_read(handle, APDS9960_REG_GFIFO_U, (uint8_t *)data, (*len) * 4);       /* read gesture fifo */
-    if (res != 0)                                                                               /* check result */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GCONF4, (uint8_t *)&prev, 1);        /* get gesture conf 4 register */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("apds9960: read gesture fifo failed.\n");                           /* read gesture fifo failed */
+        handle->debug_print("apds9960: get gesture conf 4 register failed.\n");         /* get gesture conf 4 register failed */
        
-        return 1;                                                                               /* return error */
+        return 1;                                                                       /* return error */
     }
+    *enable = (apds9960_bool_t)((prev >> 0) & 0x1);                                     /* set bool */
     
-    return 0;                                                                                   /* success return 0 */
+    return 0;                                                                           /* success return 0 */
 }
 
+/**
+ * @brief      get the gesture fifo level
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *level pointer to a gesture fifo level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get gesture fifo level failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t apds9960_get_gesture_fifo_level(apds9960_handle_t *handle, uint8_t *level)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (handle->inited != 1)                                                               /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GFLVL, (uint8_t *)&prev, 1);            /* get gesture fifo level register */
+    if (res != 0)                                                                          /* check result */
+    {
+        handle->debug_print("apds9960: get gesture fifo level register failed.\n");        /* get gesture fifo level register failed */
+       
+        return 1;                                                                          /* return error */
+    }
+    *level = prev;                                                                         /* set fifo level */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief      get the gesture status
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get gesture status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t apds9960_get_gesture_status(apds9960_handle_t *handle, uint8_t *status)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GSTATUS, (uint8_t *)&prev, 1);        /* get gesture status register */
+    if (res != 0)                                                                        /* check result */
+    {
+        handle->debug_print("apds9960: get gesture status register failed.\n");          /* get gesture status register failed */
+       
+        return 1;                                                                        /* return error */
+    }
+    *status = prev;                                                                      /* set status */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     force an interrupt
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 force interrupt failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t apds9960_force_interrupt(apds9960_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    
+    prev = 0xFF;                                                                        /* set 0xFF */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_IFORCE, (uint8_t *)&prev, 1);       /* forces an interrupt */
+    if (res != 0)                                                                       /* check result */
+    {
+        handle->debug_print("apds9960: forces an interrupt failed.\n");                 /* forces an interrupt failed */
+       
+        return 1;                                                                       /* return error */
+    }
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     clear the proximity interrupt
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 proximity interrupt clear failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t apds9960_proximity_interrupt_clear(apds9960_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    
+    prev = 0xFF;                                                                         /* set 0xFF */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_PICLEAR, (uint8_t *)&prev, 1);       /* proximity interrupt clear */
+    if (res != 0)                                                                        /* check result */
+    {
+        handle->debug_print("apds9960: proximity interrupt clear failed.\n");            /* proximity interrupt clear failed */
+       
+        return 1;                                                                        /* return error */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     clear the als interrupt
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 als interrupt clear failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t apds9960_als_interrupt_clear(apds9960_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    
+    prev = 0xFF;                                                                         /* set 0xFF */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_CICLEAR, (uint8_t *)&prev, 1);       /* als interrupt clear */
+    if (res != 0)                                                                        /* check result */
+    {
+        handle->debug_print("apds9960: als interrupt clear failed.\n");                  /* als interrupt clear failed */
+       
+        return 1;                                                                        /* return error */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     clear the all not gesture interrupt
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 all non gesture interrupt clear failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t apds9960_all_non_gesture_interrupt_clear(apds9960_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    
+    prev = 0xFF;                                                                             /* set 0xFF */
+    res = a_apds9960_iic_write(handle, APDS9960_REG_AICLEAR, (uint8_t *)&prev, 1);           /* clear all non-gesture interrupts */
+    if (res != 0)                                                                            /* check result */
+    {
+        handle->debug_print("apds9960: clear all non-gesture interrupts failed.\n");         /* clear all non-gesture interrupts failed */
+       
+        return 1;                                                                            /* return error */
+    }
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief         read data from the gesture fifo
+ * @param[in]     *handle pointer to an apds9960 handle structure
+ * @param[out]    **data pointer to a data buffer
+ * @param[in,out] *len pointer to a data length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read gesture fifo failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          none
+ */
+uint8_t apds9960_read_gesture_fifo(apds9960_handle_t *handle, uint8_t (*data)[4], uint8_t *len)
+{
+    uint8_t res;
+    uint8_t level;
+    
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GFLVL, (uint8_t *)&level, 1);                /* get gesture fifo level register */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("apds9960: get gesture fifo level register failed.\n");             /* get gesture fifo level register failed */
+       
+        return 1;                                                                               /* return error */
+    }
+    a_apds9960_gesture_fifo_stamp(handle, level);                                               /* estimate the capture time */
+    
+    *len = level < (*len) ? level : (*len);
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GFIFO_U, (uint8_t *)data, (*len) * 4);       /* read gesture fifo */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("apds9960: read gesture fifo failed.\n");                           /* read gesture fifo failed */
+       
+        return 1;                                                                               /* return error */
+    }
+    handle->gesture_fifo_level = (uint8_t)(level - (*len));                                    /* save the unread level */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the capture time of the last read gesture fifo data
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *timestamp pointer to a timestamp buffer
+ * @param[out] *period pointer to a period buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       data[i] of the last apds9960_read_gesture_fifo or apds9960_drain_gesture_fifo was
+ *             captured at about timestamp + i * period ns, timestamp is 0 when it is unknown,
+ *             the period comes from the gesture pulse count, pulse length and wait time
+ */
+uint8_t apds9960_get_gesture_fifo_timestamp(apds9960_handle_t *handle, uint64_t *timestamp, uint32_t *period)
+{
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    
+    *timestamp = handle->gesture_fifo_ns;                                                       /* get the timestamp */
+    *period = handle->gesture_period_ns;                                                        /* get the period */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief         drain the gesture fifo
+ * @param[in]     *handle pointer to an apds9960 handle structure
+ * @param[out]    **data pointer to a data buffer
+ * @param[in,out] *len pointer to a data length buffer
+ * @param[out]    *overflow pointer to an overflow buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 drain gesture fifo failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          the fifo is read in bursts until it is empty or the data buffer is full,
+ *                when the gesture engine exits the fifo stops filling and the loop ends,
+ *                each burst is batched with the read of the next fifo level
+ */
+uint8_t apds9960_drain_gesture_fifo(apds9960_handle_t *handle, uint8_t (*data)[4], uint8_t *len, apds9960_bool_t *overflow)
+{
+    uint8_t res;
+    uint8_t n;
+    uint8_t total;
+    uint8_t buf[2];
+    apds9960_iic_msg_t msg[2];
+    
+    if (handle == NULL)                                                                             /* check handle */
+    {
+        return 2;                                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                                        /* check handle initialization */
+    {
+        return 3;                                                                                   /* return error */
+    }
+    
+    total = 0;                                                                                      /* init 0 */
+    *overflow = APDS9960_BOOL_FALSE;                                                                /* no overflow */
+    res = a_apds9960_iic_read(handle, APDS9960_REG_GFLVL, (uint8_t *)buf, 2);                       /* get gesture fifo level and status register */
+    if (res != 0)                                                                                   /* check result */
+    {
+        handle->debug_print("apds9960: get gesture fifo level and status register failed.\n");     /* get gesture fifo level and status register failed */
+        *len = total;                                                                               /* set the drained length */
+        
+        return 1;                                                                                   /* return error */
+    }
+    a_apds9960_gesture_fifo_stamp(handle, buf[0]);                                                  /* estimate the capture time */
+    while (1)                                                                                       /* loop */
+    {
+        if ((buf[1] & (1 << APDS9960_GESTURE_STATUS_FIFO_OVERFLOW)) != 0)                           /* check overflow */
+        {
+            *overflow = APDS9960_BOOL_TRUE;                                                         /* set overflow */
+        }
+        n = (uint8_t)((*len) - total);                                                              /* free buffer */
+        n = buf[0] < n ? buf[0] : n;                                                                /* read the min length */
+        if (n == 0)                                                                                 /* fifo is empty or buffer is full */
+        {
+            handle->gesture_fifo_level = buf[0];                                                    /* save the unread level */
+            
+            break;                                                                                  /* break */
+        }
+        msg[0].write = 0;                                                                           /* read */
+        msg[0].reg = APDS9960_REG_GFIFO_U;                                                          /* read gesture fifo */
+        msg[0].buf = (uint8_t *)data[total];                                                        /* set the buffer */
+        msg[0].len = (uint16_t)(n * 4);                                                             /* set the length */
+        msg[1].write = 0;                                                                           /* read */
+        msg[1].reg = APDS9960_REG_GFLVL;                                                            /* get gesture fifo level and status register */
+        msg[1].buf = (uint8_t *)buf;                                                                /* set the buffer */
+        msg[1].len = 2;                                                                             /* set the length */
+        res = a_apds9960_iic_transfer(handle, msg, 2);                                              /* read the fifo and the next level in one batch */
+        if (res != 0)                                                                               /* check result */
+        {
+            handle->debug_print("apds9960: read gesture fifo failed.\n");                           /* read gesture fifo failed */
+            *len = total;                                                                           /* set the drained length */
+            
+            return 1;                                                                               /* return error */
+        }
+        total = (uint8_t)(total + n);                                                               /* add the drained length */
+    }
+    *len = total;                                                                                   /* set the drained length */
+    
+    return 0;                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      read one event from the event ring
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *event pointer to an event structure
+ * @param[out] **fifo pointer to a gesture fifo buffer of APDS9960_GESTURE_FIFO_DEPTH datasets or NULL
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 event ring is NULL
+ *             - 5 event ring is empty
+ * @note       it never blocks and never touches the bus, so it can run on another thread than the irq handler,
+ *             only one thread may read the ring and the gesture fifo is skipped when fifo is NULL
+ */
+uint8_t apds9960_read_event(apds9960_handle_t *handle, apds9960_event_t *event, uint8_t (*fifo)[4])
+{
+    uint32_t tail;
+    uint32_t index;
+    apds9960_event_ring_t *ring;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->event_ring == NULL)                                                       /* check the event ring */
+    {
+        return 4;                                                                         /* return error */
+    }
+    
+    ring = handle->event_ring;                                                            /* get the ring */
+    tail = ring->tail;                                                                    /* only the consumer changes tail */
+    if (APDS9960_RING_LOAD_ACQUIRE(&ring->head) == tail)                                  /* check the ring */
+    {
+        return 5;                                                                         /* ring is empty */
+    }
+    index = tail & (APDS9960_EVENT_RING_SIZE - 1);                                        /* get the slot */
+    *event = ring->event[index];                                                          /* copy the event */
+    if (fifo != NULL)                                                                     /* check the fifo buffer */
+    {
+        if (event->fifo_len != 0)                                                         /* check the fifo */
+        {
+            memcpy(fifo, ring->fifo[index], (size_t)event->fifo_len * 4);                 /* copy the fifo */
+        }
+        event->fifo = fifo;                                                               /* set the fifo */
+    }
+    else
+    {
+        event->fifo_len = 0;                                                              /* fifo is skipped */
+    }
+    APDS9960_RING_STORE_RELEASE(&ring->tail, tail + 1);                                   /* release the slot */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      get the number of events dropped by the event ring
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *dropped pointer to a dropped number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 event ring is NULL
+ * @note       an event is dropped when the ring is full, the oldest events are kept
+ */
+uint8_t apds9960_get_event_dropped(apds9960_handle_t *handle, uint32_t *dropped)
+{
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->event_ring == NULL)                                                       /* check the event ring */
+    {
+        return 4;                                                                         /* return error */
+    }
+    
+    *dropped = handle->event_ring->dropped;                                               /* get the dropped number */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the register cache
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the cache is write through and only holds the configuration registers,
+ *            so the setters only write the register once the cache is filled
+ */
+uint8_t apds9960_set_cache(apds9960_handle_t *handle, apds9960_bool_t enable)
+{
+    if (handle == NULL)                                   /* check handle */
+    {
+        return 2;                                         /* return error */
+    }
+    if (handle->inited != 1)                              /* check handle initialization */
+    {
+        return 3;                                         /* return error */
+    }
+    
+    handle->cache_enable = (uint8_t)enable;               /* set the cache */
+    handle->cache_valid = 0;                              /* clear the cache */
+    
+    return 0;                                             /* success return 0 */
+}
+
+/**
+ * @brief      get the register cache status
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t apds9960_get_cache(apds9960_handle_t *handle, apds9960_bool_t *enable)
+{
+    if (handle == NULL)                                   /* check handle */
+    {
+        return 2;                                         /* return error */
+    }
+    if (handle->inited != 1)                              /* check handle initialization */
+    {
+        return 3;                                         /* return error */
+    }
+    
+    *enable = (apds9960_bool_t)(handle->cache_enable);    /* get the cache */
+    
+    return 0;                                             /* success return 0 */
+}
+
+/**
+ * @brief     sync the register cache with the chip
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 cache sync failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 cache is disabled
+ * @note      none
+ */
+uint8_t apds9960_cache_sync(apds9960_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t buf[31];
+    apds9960_iic_msg_t msg[2];
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (handle->cache_enable == 0)                                                       /* check the cache */
+    {
+        handle->debug_print("apds9960: cache is disabled.\n");                           /* cache is disabled */
+        
+        return 4;                                                                        /* return error */
+    }
+    
+    handle->cache_valid = 0;                                                             /* clear the cache */
+    msg[0].write = 0;                                                                    /* read */
+    msg[0].reg = APDS9960_REG_ENABLE;                                                    /* read enable - config2 register */
+    msg[0].buf = (uint8_t *)buf;                                                         /* set the buffer */
+    msg[0].len = 17;                                                                     /* set the length */
+    msg[1].write = 0;                                                                    /* read */
+    msg[1].reg = APDS9960_REG_POFFSET_UR;                                                /* read poffset_ur - gconf3 register */
+    msg[1].buf = (uint8_t *)buf + 17;                                                    /* set the buffer */
+    msg[1].len = 14;                                                                     /* set the length */
+    res = a_apds9960_iic_transfer(handle, msg, 2);                                       /* read all registers in one batch */
+    if (res != 0)                                                                        /* check result */
+    {
+        handle->debug_print("apds9960: read enable - gconf3 register failed.\n");        /* read enable - gconf3 register failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     invalidate the register cache
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it after the chip is reset or powered down externally
+ */
+uint8_t apds9960_cache_invalidate(apds9960_handle_t *handle)
+{
+    if (handle == NULL)                         /* check handle */
+    {
+        return 2;                               /* return error */
+    }
+    if (handle->inited != 1)                    /* check handle initialization */
+    {
+        return 3;                               /* return error */
+    }
+    
+    handle->cache_valid = 0;                    /* clear the cache */
+    
+    return 0;                                   /* success return 0 */
+}
+
+/**
+ * @brief     apply the whole configuration
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *config pointer to a configuration structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 apply config failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 config is invalid
+ * @note      enable register is written after all the other registers
+ */
+uint8_t apds9960_apply_config(apds9960_handle_t *handle, const apds9960_config_t *config)
+{
+    uint8_t res;
+    uint8_t image[APDS9960_CACHE_SIZE];
+    apds9960_iic_msg_t msg[3];
+    
+    if (handle == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    if (a_apds9960_config_check(handle, config) != 0)                                             /* check the config */
+    {
+        return 4;                                                                                 /* return error */
+    }
+    
+    msg[0].write = 0;                                                                             /* read */
+    msg[0].reg = APDS9960_REG_ENABLE;                                                             /* read enable - config2 register */
+    msg[0].buf = &image[APDS9960_REG_ENABLE - APDS9960_CACHE_BASE];                               /* set the buffer */
+    msg[0].len = 17;                                                                              /* set the length */
+    msg[1].write = 0;                                                                             /* read */
+    msg[1].reg = APDS9960_REG_POFFSET_UR;                                                         /* read poffset_ur - gconf4 register */
+    msg[1].buf = &image[APDS9960_REG_POFFSET_UR - APDS9960_CACHE_BASE];                           /* set the buffer */
+    msg[1].len = 15;                                                                              /* set the length */
+    res = a_apds9960_iic_transfer(handle, msg, 2);                                                /* read all registers in one batch */
+    if (res != 0)                                                                                 /* check result */
+    {
+        handle->debug_print("apds9960: read enable - gconf4 register failed.\n");                 /* read enable - gconf4 register failed */
+        
+        return 1;                                                                                 /* return error */
+    }
+    a_apds9960_config_pack(config, image);                                                        /* pack the config */
+    msg[0].write = 1;                                                                             /* write */
+    msg[0].reg = APDS9960_REG_ATIME;                                                              /* write atime - config2 register */
+    msg[0].buf = &image[APDS9960_REG_ATIME - APDS9960_CACHE_BASE];                                /* set the buffer */
+    msg[0].len = 16;                                                                              /* set the length */
+    msg[1].write = 1;                                                                             /* write */
+    msg[1].reg = APDS9960_REG_POFFSET_UR;                                                         /* write poffset_ur - gconf4 register */
+    msg[1].buf = &image[APDS9960_REG_POFFSET_UR - APDS9960_CACHE_BASE];                           /* set the buffer */
+    msg[1].len = 15;                                                                              /* set the length */
+    msg[2].write = 1;                                                                             /* write */
+    msg[2].reg = APDS9960_REG_ENABLE;                                                             /* write enable register */
+    msg[2].buf = &image[APDS9960_REG_ENABLE - APDS9960_CACHE_BASE];                               /* set the buffer */
+    msg[2].len = 1;                                                                               /* set the length */
+    res = a_apds9960_iic_transfer(handle, msg, 3);                                                /* write all registers in one batch */
+    if (res != 0)                                                                                 /* check result */
+    {
+        handle->debug_print("apds9960: write atime - gconf4 register failed.\n");                 /* write atime - gconf4 register failed */
+        
+        return 1;                                                                                 /* return error */
+    }
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      read the register image from the chip
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *image pointer to a register image structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get image failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       id, status and data registers are not read and set to 0
+ */
+uint8_t apds9960_get_image(apds9960_handle_t *handle, apds9960_image_t *image)
+{
+    uint8_t res;
+    apds9960_iic_msg_t msg[2];
+    
+    if (handle == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    
+    msg[0].write = 0;                                                                             /* read */
+    msg[0].reg = APDS9960_REG_ENABLE;                                                             /* read enable - config2 register */
+    msg[0].buf = &image->reg[APDS9960_REG_ENABLE - APDS9960_CACHE_BASE];                          /* set the buffer */
+    msg[0].len = 17;                                                                              /* set the length */
+    msg[1].write = 0;                                                                             /* read */
+    msg[1].reg = APDS9960_REG_POFFSET_UR;                                                         /* read poffset_ur - gconf4 register */
+    msg[1].buf = &image->reg[APDS9960_REG_POFFSET_UR - APDS9960_CACHE_BASE];                      /* set the buffer */
+    msg[1].len = 15;                                                                              /* set the length */
+    res = a_apds9960_iic_transfer(handle, msg, 2);                                                /* read all registers in one batch */
+    if (res != 0)                                                                                 /* check result */
+    {
+        handle->debug_print("apds9960: read enable - gconf4 register failed.\n");                 /* read enable - gconf4 register failed */
+        
+        return 1;                                                                                 /* return error */
+    }
+    memset(&image->reg[APDS9960_REG_CONFIG2 + 1 - APDS9960_CACHE_BASE], 0, APDS9960_REG_POFFSET_UR - APDS9960_REG_CONFIG2 - 1);    /* clear the unused registers */
+    image->reg[APDS9960_REG_GCONF4 - APDS9960_CACHE_BASE] &= ~(1 << 2);                           /* fifo clear is not a state */
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief         pack the configuration into a register image
+ * @param[in]     *handle pointer to an apds9960 handle structure
+ * @param[in]     *config pointer to a configuration structure
+ * @param[in,out] *image pointer to a register image structure
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 config is invalid
+ * @note          image should be read by apds9960_get_image first, reserved bits are kept
+ */
+uint8_t apds9960_config_to_image(apds9960_handle_t *handle, const apds9960_config_t *config, apds9960_image_t *image)
+{
+    if (handle == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    if (a_apds9960_config_check(handle, config) != 0)                                             /* check the config */
+    {
+        return 4;                                                                                 /* return error */
+    }
+    
+    a_apds9960_config_pack(config, image->reg);                                                   /* pack the config */
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     write the changed registers between two images
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *current pointer to the current register image structure
+ * @param[in] *target pointer to the target register image structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 apply image failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      changed registers are grouped into bursts, engines are disabled before
+ *            and enabled after the other registers are written, a burst never includes
+ *            the reserved registers
+ */
+uint8_t apds9960_apply_image(apds9960_handle_t *handle, const apds9960_image_t *current, const apds9960_image_t *target)
+{
+    uint8_t res;
+    uint8_t prev;
+    uint8_t i;
+    uint8_t j;
+    uint8_t end;
+    uint8_t seg;
+    uint8_t num;
+    apds9960_iic_msg_t msg[APDS9960_IIC_BATCH_MAX];
+    const uint8_t range[2][2] = {{APDS9960_REG_ATIME, APDS9960_REG_CONFIG2},
+                                 {APDS9960_REG_POFFSET_UR, APDS9960_REG_GCONF4}};
+    
+    if (handle == NULL)                                                                             /* check handle */
+    {
+        return 2;                                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                                        /* check handle initialization */
+    {
+        return 3;                                                                                   /* return error */
+    }
+    
+    num = 0;                                                                                        /* init 0 */
+    prev = current->reg[0];                                                                         /* get the current enable */
+    if ((prev & ~target->reg[0]) != 0)                                                              /* some engines will stop */
+    {
+        prev &= target->reg[0];                                                                     /* stop them first */
+        msg[num].write = 1;                                                                         /* write */
+        msg[num].reg = APDS9960_REG_ENABLE;                                                         /* write enable register */
+        msg[num].buf = (uint8_t *)&prev;                                                            /* set the buffer */
+        msg[num].len = 1;                                                                           /* set the length */
+        num++;                                                                                      /* num++ */
+    }
+    for (seg = 0; seg < 2; seg++)                                                                   /* run all ranges */
+    {
+        i = (uint8_t)(range[seg][0] - APDS9960_CACHE_BASE);                                         /* first register */
+        end = (uint8_t)(range[seg][1] - APDS9960_CACHE_BASE);                                       /* last register */
+        while (i <= end)                                                                            /* find all changed registers */
+        {
+            if ((current->reg[i] == target->reg[i]) ||
+                (a_apds9960_image_writable(i + APDS9960_CACHE_BASE) == 0))                          /* check the register */
+            {
+                i++;                                                                                /* skip it */
+                
+                continue;                                                                           /* next */
+            }
+            j = i;                                                                                  /* burst start */
+            while (1)                                                                               /* extend the burst */
+            {
+                uint8_t k;
+                
+                k = (uint8_t)(j + 1);                                                               /* next register */
+                while ((k <= end) && (k <= j + APDS9960_IMAGE_BURST_GAP + 1) &&
+                       (a_apds9960_image_writable(k + APDS9960_CACHE_BASE) != 0) &&
+                       (current->reg[k] == target->reg[k]))                                         /* skip the short gap */
+                {
+                    k++;                                                                            /* next register */
+                }
+                if ((k > end) || (k > j + APDS9960_IMAGE_BURST_GAP + 1) ||
+                    (a_apds9960_image_writable(k + APDS9960_CACHE_BASE) == 0))                      /* no change nearby or reserved */
+                {
+                    break;                                                                          /* break */
+                }
+                j = k;                                                                              /* merge into the burst */
+            }
+            msg[num].write = 1;                                                                     /* write */
+            msg[num].reg = (uint8_t)(i + APDS9960_CACHE_BASE);                                      /* write the burst */
+            msg[num].buf = (uint8_t *)&target->reg[i];                                              /* set the buffer */
+            msg[num].len = (uint16_t)(j - i + 1);                                                   /* set the length */
+            num++;                                                                                  /* num++ */
+            i = (uint8_t)(j + 1);                                                                   /* continue after the burst */
+        }
+    }
+    if (prev != target->reg[0])                                                                     /* check the enable */
+    {
+        msg[num].write = 1;                                                                         /* write */
+        msg[num].reg = APDS9960_REG_ENABLE;                                                         /* write enable register */
+        msg[num].buf = (uint8_t *)&target->reg[0];                                                  /* set the buffer */
+        msg[num].len = 1;                                                                           /* set the length */
+        num++;                                                                                      /* num++ */
+    }
+    if (num == 0)                                                                                   /* nothing changed */
+    {
+        return 0;                                                                                   /* success return 0 */
+    }
+    res = a_apds9960_iic_transfer(handle, msg, num);                                                /* write all bursts in one batch */
+    if (res != 0)                                                                                   /* check result */
+    {
+        handle->debug_print("apds9960: write register burst failed.\n");                            /* write register burst failed */
+        
+        return 1;                                                                                   /* return error */
+    }
+    
+    return 0;                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     submit an async register read
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] reg iic register address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @param[in] step next step
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      none
+ */
+static uint8_t a_apds9960_async_read(apds9960_handle_t *handle, uint8_t reg, uint8_t *data, uint16_t len, uint8_t step)
+{
+    if (handle->iic_read_submit(handle->user, APDS9960_ADDRESS, reg, data, len) != 0)    /* submit the read */
+    {
+        handle->debug_print("apds9960: submit read failed.\n");                          /* submit read failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    handle->async_write = 0;                                                             /* read */
+    handle->async_reg = reg;                                                             /* set the register */
+    handle->async_data = data;                                                           /* set the buffer */
+    handle->async_len = len;                                                             /* set the length */
+    handle->async_pending = 1;                                                           /* transfer in flight */
+    handle->async_step = step;                                                           /* set the next step */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     submit an async register write
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] reg iic register address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @param[in] step next step
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      none
+ */
+static uint8_t a_apds9960_async_write(apds9960_handle_t *handle, uint8_t reg, uint8_t *data, uint16_t len, uint8_t step)
+{
+    if (handle->iic_write_submit(handle->user, APDS9960_ADDRESS, reg, data, len) != 0)   /* submit the write */
+    {
+        handle->debug_print("apds9960: submit write failed.\n");                         /* submit write failed */
+        a_apds9960_cache_update(handle, reg, data, len, 0);                              /* registers are unknown */
+        
+        return 1;                                                                        /* return error */
+    }
+    handle->async_write = 1;                                                             /* write */
+    handle->async_reg = reg;                                                             /* set the register */
+    handle->async_data = data;                                                           /* set the buffer */
+    handle->async_len = len;                                                             /* set the length */
+    handle->async_pending = 1;                                                           /* transfer in flight */
+    handle->async_step = step;                                                           /* set the next step */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     finish the async operation
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] res operation result
+ * @note      none
+ */
+static void a_apds9960_async_finish(apds9960_handle_t *handle, uint8_t res)
+{
+    handle->async_pending = 0;                                                           /* no transfer */
+    handle->async_state = (res == 0) ? APDS9960_ASYNC_STATE_DONE : APDS9960_ASYNC_STATE_ERROR;    /* set the state */
+    if (handle->async_callback != NULL)                                                  /* if valid */
+    {
+        handle->async_callback(handle->user, handle->async_operation, res);              /* run the callback */
+    }
+}
+
+/**
+ * @brief     run one step of the async operation
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 step failed
+ * @note      a step either submits a transfer or moves to the next step
+ */
+static uint8_t a_apds9960_async_step(apds9960_handle_t *handle)
+{
+    uint8_t n;
+    apds9960_event_t *event;
+    
+    event = handle->async_event;                                                                 /* get the event */
+    switch (handle->async_step)
+    {
+        case APDS9960_ASYNC_STEP_START :
+        {
+            if (handle->async_operation == APDS9960_ASYNC_OPERATION_READ_FIFO)                   /* read fifo */
+            {
+                handle->async_step = APDS9960_ASYNC_STEP_FIFO_LEVEL;                             /* read the fifo level */
+                
+                return 0;                                                                        /* success return 0 */
+            }
+            if (handle->async_operation == APDS9960_ASYNC_OPERATION_APPLY_CONFIG)                /* apply config */
+            {
+                return a_apds9960_async_read(handle, APDS9960_REG_ENABLE, &handle->async_buf[APDS9960_REG_ENABLE - APDS9960_CACHE_BASE], 17, APDS9960_ASYNC_STEP_CONFIG_READ);        /* read enable - config2 register */
+            }
+            
+            return a_apds9960_async_read(handle, APDS9960_REG_STATUS, handle->async_buf, 10, APDS9960_ASYNC_STEP_DATA);        /* read status and data */
+        }
+        case APDS9960_ASYNC_STEP_DATA :
+        {
+            a_apds9960_event_parse(event, handle->async_buf);                                    /* parse the status and data */
+            if (handle->async_operation == APDS9960_ASYNC_OPERATION_READ_DATA)                   /* read data */
+            {
+                handle->async_step = APDS9960_ASYNC_STEP_FINISH;                                 /* finish */
+            }
+            else if ((event->status & (1 << APDS9960_STATUS_GINT)) != 0)                         /* only gesture interrupt needs the gesture fifo */
+            {
+                handle->async_step = APDS9960_ASYNC_STEP_FIFO_LEVEL;                             /* drain the fifo */
+            }
+            else
+            {
+                handle->async_step = APDS9960_ASYNC_STEP_CLEAR;                                  /* clear the interrupts */
+            }
+            
+            return 0;                                                                            /* success return 0 */
+        }
+        case APDS9960_ASYNC_STEP_FIFO_LEVEL :
+        {
+            return a_apds9960_async_read(handle, APDS9960_REG_GFLVL, handle->async_buf, 2, APDS9960_ASYNC_STEP_FIFO_READ);        /* read gesture fifo level and status */
+        }
+        case APDS9960_ASYNC_STEP_FIFO_READ :
+        {
+            if (event->fifo_len == 0)                                                            /* first fifo level */
+            {
+                handle->gesture_edge_ns = (handle->async_operation == APDS9960_ASYNC_OPERATION_IRQ) ? event->timestamp : 0;        /* anchor the irq to its timestamp */
+                a_apds9960_gesture_fifo_time(handle, handle->async_buf[0], 
+                                             (handle->timestamp_ns != NULL) ? handle->timestamp_ns() : 0);    /* estimate the capture time */
+                handle->gesture_edge_ns = 0;                                                     /* edge is used */
+                event->fifo_timestamp = handle->gesture_fifo_ns;                                 /* set the fifo timestamp */
+                event->fifo_period = handle->gesture_period_ns;                                  /* set the fifo period */
+            }
+            if ((handle->async_buf[1] & (1 << APDS9960_GESTURE_STATUS_FIFO_OVERFLOW)) != 0)      /* check overflow */
+            {
+                event->gesture_status |= 1 << APDS9960_GESTURE_STATUS_FIFO_OVERFLOW;             /* set fifo overflow */
+            }
+            n = (uint8_t)(handle->async_size - event->fifo_len);                                 /* free buffer */
+            n = handle->async_buf[0] < n ? handle->async_buf[0] : n;                             /* read the min length */
+            if (n == 0)                                                                          /* fifo is empty or buffer is full */
+            {
+                handle->gesture_fifo_level = handle->async_buf[0];                               /* save the unread level */
+                if (event->fifo_len != 0)                                                        /* check the length */
+                {
+                    event->gesture_status |= 1 << APDS9960_GESTURE_STATUS_FIFO_VALID;            /* set fifo valid */
+                }
+                if (handle->async_operation == APDS9960_ASYNC_OPERATION_READ_FIFO)               /* read fifo */
+                {
+                    handle->async_step = APDS9960_ASYNC_STEP_FINISH;                             /* finish */
+                }
+                else
+                {
+                    (void)apds9960_gesture_decode(handle, event->fifo, event->fifo_len);         /* decode the gesture */
+                    handle->async_step = APDS9960_ASYNC_STEP_CLEAR;                              /* clear the interrupts */
+                }
+                
+                return 0;                                                                        /* success return 0 */
+            }
+            handle->async_count = n;                                                             /* save the datasets */
+            
+            return a_apds9960_async_read(handle, APDS9960_REG_GFIFO_U, (uint8_t *)event->fifo[event->fifo_len], (uint16_t)(n * 4), APDS9960_ASYNC_STEP_FIFO_DATA);        /* read gesture fifo */
+        }
+        case APDS9960_ASYNC_STEP_FIFO_DATA :
+        {
+            event->fifo_len = (uint8_t)(event->fifo_len + handle->async_count);                  /* add the drained length */
+            handle->async_step = APDS9960_ASYNC_STEP_FIFO_LEVEL;                                 /* read the fifo level again */
+            
+            return 0;                                                                            /* success return 0 */
+        }
+        case APDS9960_ASYNC_STEP_CLEAR :
+        {
+            if (((event->status & ((1 << APDS9960_STATUS_CPSAT) | (1 << APDS9960_STATUS_PGSAT) | 
+                 (1 << APDS9960_STATUS_PINT) | (1 << APDS9960_STATUS_AINT))) != 0) ||
+                ((event->status & (1 << APDS9960_STATUS_GINT)) == 0))                            /* not only the gesture interrupt */
+            {
+                handle->async_buf[0] = 0xFF;                                                     /* set 0xFF */
+                
+                return a_apds9960_async_write(handle, APDS9960_REG_AICLEAR, handle->async_buf, 1, APDS9960_ASYNC_STEP_FIFO_CLEAR);        /* clear all non-gesture interrupts */
+            }
+            handle->async_step = APDS9960_ASYNC_STEP_FIFO_CLEAR;                                 /* clear the gesture fifo */
+            
+            return 0;                                                                            /* success return 0 */
+        }
+        case APDS9960_ASYNC_STEP_FIFO_CLEAR :
+        {
+            if (((event->status & (1 << APDS9960_STATUS_GINT)) != 0) && 
+                ((handle->gesture_fifo_level != 0) || 
+                 ((event->gesture_status & (1 << APDS9960_GESTURE_STATUS_FIFO_OVERFLOW)) != 0))) /* the fifo is not drained or overflowed */
+            {
+                return a_apds9960_async_read(handle, APDS9960_REG_GCONF4, handle->async_buf, 1, APDS9960_ASYNC_STEP_GCONF4_READ);        /* get gesture conf 4 register */
+            }
+            handle->async_step = APDS9960_ASYNC_STEP_GESTURE;                                    /* report the gesture */
+            
+            return 0;                                                                            /* success return 0 */
+        }
+        case APDS9960_ASYNC_STEP_GCONF4_READ :
+        {
+            handle->async_buf[0] |= 1 << 2;                                                      /* set config */
+            
+            return a_apds9960_async_write(handle, APDS9960_REG_GCONF4, handle->async_buf, 1, APDS9960_ASYNC_STEP_GCONF4_WRITE);        /* set gesture conf 4 register */
+        }
+        case APDS9960_ASYNC_STEP_GCONF4_WRITE :
+        {
+            handle->gesture_fifo_level = 0;                                                      /* fifo is cleared */
+            handle->async_step = APDS9960_ASYNC_STEP_GESTURE;                                    /* report the gesture */
+            
+            return 0;                                                                            /* success return 0 */
+        }
+        case APDS9960_ASYNC_STEP_GESTURE :
+        {
+            event->gesture = handle->gesture_status;                                             /* set the decoded gesture */
+            event->gesture_second = handle->gesture_second;                                      /* set the second stroke */
+            if ((event->gesture | event->gesture_second) != 0)                                   /* if we find gesture */
+            {
+                a_apds9960_gesture_reset(handle);                                                /* reset the gesture state */
+            }
+            handle->async_step = APDS9960_ASYNC_STEP_FINISH;                                     /* finish */
+            
+            return 0;                                                                            /* success return 0 */
+        }
+        case APDS9960_ASYNC_STEP_CONFIG_READ :
+        {
+            return a_apds9960_async_read(handle, APDS9960_REG_POFFSET_UR, &handle->async_buf[APDS9960_REG_POFFSET_UR - APDS9960_CACHE_BASE], 15, APDS9960_ASYNC_STEP_CONFIG_WRITE);        /* read poffset_ur - gconf4 register */
+        }
+        case APDS9960_ASYNC_STEP_CONFIG_WRITE :
+        {
+            a_apds9960_config_pack(handle->async_config, handle->async_buf);                     /* pack the config */
+            
+            return a_apds9960_async_write(handle, APDS9960_REG_ATIME, &handle->async_buf[APDS9960_REG_ATIME - APDS9960_CACHE_BASE], 16, APDS9960_ASYNC_STEP_CONFIG_GESTURE);        /* write atime - config2 register */
+        }
+        case APDS9960_ASYNC_STEP_CONFIG_GESTURE :
+        {
+            return a_apds9960_async_write(handle, APDS9960_REG_POFFSET_UR, &handle->async_buf[APDS9960_REG_POFFSET_UR - APDS9960_CACHE_BASE], 15, APDS9960_ASYNC_STEP_CONFIG_ENABLE);        /* write poffset_ur - gconf4 register */
+        }
+        case APDS9960_ASYNC_STEP_CONFIG_ENABLE :
+        {
+            return a_apds9960_async_write(handle, APDS9960_REG_ENABLE, &handle->async_buf[APDS9960_REG_ENABLE - APDS9960_CACHE_BASE], 1, APDS9960_ASYNC_STEP_FINISH);        /* write enable register */
+        }
+        default :
+        {
+            a_apds9960_async_finish(handle, 0);                                                  /* operation is done */
+            
+            return 0;                                                                            /* success return 0 */
+        }
+    }
+}
+
+/**
+ * @brief     start an async operation
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] operation async operation
+ * @param[in] *event pointer to an event structure
+ * @param[in] **fifo pointer to a gesture fifo buffer
+ * @param[in] size gesture fifo buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async iic functions are NULL
+ *            - 5 async operation is busy
+ *            - 6 event is NULL
+ * @note      the first transfer is submitted before it returns, only apply config runs without an event
+ */
+static uint8_t a_apds9960_async_start(apds9960_handle_t *handle, uint8_t operation, apds9960_event_t *event, uint8_t (*fifo)[4], uint8_t size)
+{
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if ((handle->iic_read_submit == NULL) || (handle->iic_write_submit == NULL) ||
+        (handle->iic_poll == NULL))                                                      /* check the async iic functions */
+    {
+        handle->debug_print("apds9960: async iic functions are null.\n");                /* async iic functions are null */
+        
+        return 4;                                                                        /* return error */
+    }
+    if (handle->async_state == APDS9960_ASYNC_STATE_BUSY)                                /* check the state */
+    {
+        handle->debug_print("apds9960: async operation is busy.\n");                     /* async operation is busy */
+        
+        return 5;                                                                        /* return error */
+    }
+    if ((operation != APDS9960_ASYNC_OPERATION_APPLY_CONFIG) && (event == NULL))         /* check the event */
+    {
+        handle->debug_print("apds9960: event is null.\n");                               /* event is null */
+        
+        return 6;                                                                        /* return error */
+    }
+    
+    if (event != NULL)                                                                   /* check the event */
+    {
+        memset(event, 0, sizeof(apds9960_event_t));                                      /* clear the event */
+        event->fifo = fifo;                                                              /* set the fifo */
+        if ((operation == APDS9960_ASYNC_OPERATION_IRQ) && (handle->timestamp_ns != NULL))    /* check the timestamp */
+        {
+            event->timestamp = handle->timestamp_ns();                                   /* get the timestamp */
+        }
+    }
+    handle->async_operation = operation;                                                 /* set the operation */
+    handle->async_event = event;                                                         /* set the event */
+    handle->async_size = size;                                                           /* set the fifo size */
+    handle->async_pending = 0;                                                           /* no transfer */
+    handle->async_step = APDS9960_ASYNC_STEP_START;                                      /* set the first step */
+    handle->async_state = APDS9960_ASYNC_STATE_BUSY;                                     /* set busy */
+    if (a_apds9960_async_step(handle) != 0)                                              /* submit the first transfer */
+    {
+        handle->async_state = APDS9960_ASYNC_STATE_IDLE;                                 /* nothing is running */
+        
+        return 1;                                                                        /* return error */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      submit an async read of the status, rgbc and proximity data
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *event pointer to an event structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 submit failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 async iic functions are NULL
+ *             - 5 async operation is busy
+ *             - 6 event is NULL
+ * @note       event is filled when apds9960_async_poll reports done
+ */
+uint8_t apds9960_async_read_data(apds9960_handle_t *handle, apds9960_event_t *event)
+{
+    return a_apds9960_async_start(handle, APDS9960_ASYNC_OPERATION_READ_DATA, event, NULL, 0);        /* start the operation */
+}
+
+/**
+ * @brief      submit an async drain of the gesture fifo
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] **data pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @param[out] *event pointer to an event structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 submit failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 async iic functions are NULL
+ *             - 5 async operation is busy
+ *             - 6 event is NULL
+ * @note       event fifo, fifo_len and gesture_status are filled when apds9960_async_poll reports done,
+ *             fifo_timestamp is 0 until a blocking gesture fifo read has read the gesture period
+ */
+uint8_t apds9960_async_read_gesture_fifo(apds9960_handle_t *handle, uint8_t (*data)[4], uint8_t len, apds9960_event_t *event)
+{
+    return a_apds9960_async_start(handle, APDS9960_ASYNC_OPERATION_READ_FIFO, event, data, len);      /* start the operation */
+}
+
+/**
+ * @brief      submit an async irq service
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *event pointer to an event structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 submit failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 async iic functions are NULL
+ *             - 5 async operation is busy
+ *             - 6 event is NULL
+ * @note       it runs the same transfers as the event mode of apds9960_irq_handler without retry,
+ *             event is filled when apds9960_async_poll reports done
+ */
+uint8_t apds9960_async_irq_handler(apds9960_handle_t *handle, apds9960_event_t *event)
+{
+    if (handle == NULL)                                                                                /* check handle */
+    {
+        return 2;                                                                                      /* return error */
+    }
+    
+    return a_apds9960_async_start(handle, APDS9960_ASYNC_OPERATION_IRQ, event, handle->event_fifo, APDS9960_GESTURE_FIFO_DEPTH);        /* start the operation */
+}
+
+/**
+ * @brief     submit an async apply of the whole configuration
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *config pointer to a configuration structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async iic functions are NULL
+ *            - 5 async operation is busy
+ *            - 6 config is invalid
+ * @note      config must be kept until apds9960_async_poll reports done
+ */
+uint8_t apds9960_async_apply_config(apds9960_handle_t *handle, const apds9960_config_t *config)
+{
+    if (handle == NULL)                                                                                /* check handle */
+    {
+        return 2;                                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                                           /* check handle initialization */
+    {
+        return 3;                                                                                      /* return error */
+    }
+    if (a_apds9960_config_check(handle, config) != 0)                                                  /* check the config */
+    {
+        return 6;                                                                                      /* return error */
+    }
+    if (handle->async_state != APDS9960_ASYNC_STATE_BUSY)                                              /* check the state */
+    {
+        handle->async_config = config;                                                                 /* set the config */
+    }
+    
+    return a_apds9960_async_start(handle, APDS9960_ASYNC_OPERATION_APPLY_CONFIG, NULL, NULL, 0);      /* start the operation */
+}
+
+/**
+ * @brief      run the async state machine
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *state pointer to a state buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       it never blocks, a finished transfer starts the next one of the operation,
+ *             blocking functions must not be called while the state is busy
+ */
+uint8_t apds9960_async_poll(apds9960_handle_t *handle, apds9960_async_state_t *state)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                                /* check handle */
+    {
+        return 2;                                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                                           /* check handle initialization */
+    {
+        return 3;                                                                                      /* return error */
+    }
+    
+    while (handle->async_state == APDS9960_ASYNC_STATE_BUSY)                                           /* run until blocked or finished */
+    {
+        if (handle->async_pending != 0)                                                                /* check the transfer */
+        {
+            res = handle->iic_poll(handle->user);                                                      /* poll the transfer */
+            if (res == 2)                                                                              /* transfer is running */
+            {
+                break;                                                                                 /* break */
+            }
+            handle->async_pending = 0;                                                                 /* transfer is finished */
+            if ((handle->async_write != 0) || (res == 0))                                              /* failed reads change nothing */
+            {
+                a_apds9960_cache_update(handle, handle->async_reg, handle->async_data, handle->async_len, (uint8_t)(res == 0));        /* update the cache */
+            }
+            if (handle->async_write != 0)                                                              /* check the write */
+            {
+                a_apds9960_timing_update(handle, handle->async_reg, handle->async_len);                /* update the timing */
+            }
+            if (res != 0)                                                                              /* check the result */
+            {
+                handle->debug_print("apds9960: async transfer failed.\n");                             /* async transfer failed */
+                a_apds9960_async_finish(handle, 1);                                                    /* operation failed */
+                
+                break;                                                                                 /* break */
+            }
+        }
+        if (a_apds9960_async_step(handle) != 0)                                                        /* run one step */
+        {
+            a_apds9960_async_finish(handle, 1);                                                        /* operation failed */
+            
+            break;                                                                                     /* break */
+        }
+    }
+    *state = (apds9960_async_state_t)(handle->async_state);                                           /* set the state */
+    
+    return 0;                                                                                          /* success return 0 */
+}
+
+/**
+ * @brief      get the state machine cycle time
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *us pointer to a cycle time buffer
+ * @param[out] *mask pointer to a status valid bits buffer, it can be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 1 get cycle time failed
+ * @note       the states run in the order proximity, gesture, wait and als,
+ *             mask has PVALID when proximity is enabled and AVALID when als is enabled
+ */
+static uint8_t a_apds9960_cycle_time(apds9960_handle_t *handle, uint32_t *us, uint8_t *mask)
+{
+    uint8_t res;
+    uint8_t buf[17];
+    uint8_t valid;
+    uint32_t cycle;
+    
+    res = a_apds9960_iic_read(handle, APDS9960_REG_ENABLE, (uint8_t *)buf, 17);          /* read enable - config2 register */
+    if (res != 0)                                                                         /* check result */
+    {
+        handle->debug_print("apds9960: read config failed.\n");                          /* read config failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    cycle = 0;                                                                            /* init 0 */
+    valid = 0;                                                                            /* init 0 */
+    if (((buf[0] >> APDS9960_CONF_PROXIMITY_DETECT_ENABLE) & 0x01) != 0)                  /* check proximity enable */
+    {
+        uint8_t ppulse;
+        
+        ppulse = buf[APDS9960_REG_PPULSE - APDS9960_REG_ENABLE];                          /* get the pulse register */
+        cycle += APDS9960_PULSE_SETUP_US + 
+                 (uint32_t)((ppulse & 0x3F) + 1) * (8U << ((ppulse >> 6) & 0x3));         /* pulse period is twice the pulse length */
+        valid |= 1 << APDS9960_STATUS_PVALID;                                             /* proximity is valid once per cycle */
+    }
+    if (((buf[0] >> APDS9960_CONF_GESTURE_ENABLE) & 0x01) != 0)                           /* check gesture enable */
+    {
+        res = a_apds9960_gesture_period(handle);                                          /* read the gesture period */
+        if (res != 0)                                                                     /* check result */
+        {
+            return 1;                                                                     /* return error */
+        }
+        cycle += handle->gesture_period_ns / 1000;                                        /* one gesture pass and its wait */
+    }
+    if (((buf[0] >> APDS9960_CONF_WAIT_ENABLE) & 0x01) != 0)                              /* check wait enable */
+    {
+        uint32_t wait;
+        
+        wait = (256 - (uint32_t)buf[APDS9960_REG_WTIME - APDS9960_REG_ENABLE]) * APDS9960_STEP_US;     /* wait steps */
+        if (((buf[APDS9960_REG_CONFIG1 - APDS9960_REG_ENABLE] >> 1) & 0x01) != 0)         /* check wait long */
+        {
+            wait *= 12;                                                                   /* wait long is 12x */
+        }
+        cycle += wait;                                                                    /* add the wait time */
+    }
+    if (((buf[0] >> APDS9960_CONF_ALS_ENABLE) & 0x01) != 0)                               /* check als enable */
+    {
+        cycle += (256 - (uint32_t)buf[APDS9960_REG_ATIME - APDS9960_REG_ENABLE]) * APDS9960_STEP_US;   /* integration steps */
+        valid |= 1 << APDS9960_STATUS_AVALID;                                             /* als is valid once per cycle */
+    }
+    *us = cycle;                                                                          /* set the cycle time */
+    if (mask != NULL)                                                                     /* check mask */
+    {
+        *mask = valid;                                                                    /* set the mask */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     sleep until an absolute time
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] ns absolute timestamp_ns time
+ * @note      timestamp_ns must be linked, it falls back to delay_ms when delay_until_ns is not linked
+ */
+static void a_apds9960_sleep_until(apds9960_handle_t *handle, uint64_t ns)
+{
+    uint64_t now;
+    
+    if (handle->delay_until_ns != NULL)                                                   /* check delay_until_ns */
+    {
+        handle->delay_until_ns(ns);                                                       /* sleep until the time */
+        
+        return;                                                                           /* return */
+    }
+    now = handle->timestamp_ns();                                                         /* get the time */
+    if (ns > now)                                                                         /* check the time */
+    {
+        handle->delay_ms((uint32_t)((ns - now + 999999ULL) / 1000000ULL));                /* sleep for the rest */
+    }
+}
+
+/**
+ * @brief         wait for a status valid bit
+ * @param[in]     *handle pointer to an apds9960 handle structure
+ * @param[in]     bit status valid bit
+ * @param[in]     timeout_ms timeout in ms
+ * @param[in,out] *last pointer to the time the bit was found last, 0 when unknown
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 5 timeout
+ *                - 6 the engine of the bit is disabled
+ * @note          it sleeps until APDS9960_WAIT_SPIN_US before the expected data and polls the status
+ *                without sleeping from there, when the phase is unknown it polls every 1/16 cycle
+ */
+static uint8_t a_apds9960_wait_valid(apds9960_handle_t *handle, uint8_t bit, uint32_t timeout_ms, uint64_t *last)
+{
+    uint8_t res;
+    uint8_t mask;
+    uint8_t status;
+    uint32_t cycle;
+    uint64_t now;
+    uint64_t step;
+    uint64_t ready;
+    uint64_t period;
+    uint64_t deadline;
+    
+    res = a_apds9960_cycle_time(handle, (uint32_t *)&cycle, (uint8_t *)&mask);           /* get the cycle time */
+    if (res != 0)                                                                         /* check result */
+    {
+        return 1;                                                                         /* return error */
+    }
+    if ((mask & (1 << bit)) == 0)                                                         /* check the engine */
+    {
+        return 6;                                                                         /* return error */
+    }
+    period = (uint64_t)cycle * 1000;                                                      /* cycle in ns */
+    step = period / 16;                                                                   /* poll step */
+    if (step < APDS9960_SAMPLE_POLL_US * 1000)                                            /* check the min step */
+    {
+        step = APDS9960_SAMPLE_POLL_US * 1000;                                            /* set the min step */
+    }
+    deadline = handle->timestamp_ns() + (uint64_t)timeout_ms * 1000000ULL;               /* set the deadline */
+    while (1)                                                                             /* loop */
+    {
+        res = a_apds9960_iic_read(handle, APDS9960_REG_STATUS, (uint8_t *)&status, 1);   /* get status register */
+        if (res != 0)                                                                     /* check result */
+        {
+            handle->debug_print("apds9960: get status register failed.\n");             /* get status register failed */
+            
+            return 1;                                                                     /* return error */
+        }
+        now = handle->timestamp_ns();                                                     /* get the time */
+        if ((status & (1 << bit)) != 0)                                                   /* check the valid bit */
+        {
+            *last = now;                                                                  /* save the phase */
+            
+            return 0;                                                                     /* success return 0 */
+        }
+        if (now >= deadline)                                                              /* check timeout */
+        {
+            return 5;                                                                     /* return error */
+        }
+        ready = *last + period;                                                           /* expected data */
+        if ((*last != 0) && (now + APDS9960_WAIT_SPIN_US * 1000 < ready))                 /* check the remaining time */
+        {
+            ready -= APDS9960_WAIT_SPIN_US * 1000;                                        /* wake up before the data */
+            a_apds9960_sleep_until(handle, (ready < deadline) ? ready : deadline);        /* sleep */
+        }
+        else if ((*last == 0) || (now > ready + step))                                    /* check the phase */
+        {
+            a_apds9960_sleep_until(handle, (now + step < deadline) ? (now + step) : deadline);    /* phase is unknown, poll slowly */
+        }
+        else
+        {
+            continue;                                                                     /* data is due, poll without sleep */
+        }
+    }
+}
+
+/**
+ * @brief      get the state machine cycle time
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *us pointer to a cycle time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get cycle time failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       it is the sum of the enabled proximity, gesture, wait and als states,
+ *             proximity and gesture times are estimated from the pulse count and length,
+ *             the wait time is 12 times longer when wait long is enabled,
+ *             one new sample is ready per cycle
+ */
+uint8_t apds9960_get_cycle_time(apds9960_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    
+    return a_apds9960_cycle_time(handle, us, NULL);                                       /* get the cycle time */
+}
+
+/**
+ * @brief     start a periodic sampling schedule
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *periodic pointer to a periodic sampling structure
+ * @param[in] hz sampling rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 periodic init failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timestamp_ns is null
+ *            - 5 hz is invalid
+ * @note      1 <= hz <= 1000000 / cycle time, the first deadline is one period from now
+ */
+uint8_t apds9960_periodic_init(apds9960_handle_t *handle, apds9960_periodic_t *periodic, uint16_t hz)
+{
+    uint8_t res;
+    uint32_t cycle;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->timestamp_ns == NULL)                                                     /* check timestamp_ns */
+    {
+        handle->debug_print("apds9960: timestamp_ns is null.\n");                         /* timestamp_ns is null */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    res = apds9960_get_cycle_time(handle, (uint32_t *)&cycle);                            /* get the cycle time */
+    if (res != 0)                                                                         /* check result */
+    {
+        return 1;                                                                         /* return error */
+    }
+    if ((hz == 0) || ((uint64_t)hz * cycle > 1000000ULL))                                 /* check the rate */
+    {
+        handle->debug_print("apds9960: hz is invalid.\n");                                /* hz is invalid */
+        
+        return 5;                                                                         /* return error */
+    }
+    periodic->period_ns = 1000000000ULL / hz;                                             /* set the period */
+    periodic->deadline_ns = handle->timestamp_ns();                                       /* start from now */
+    periodic->count = 0;                                                                  /* clear the count */
+    periodic->missed = 0;                                                                 /* clear the missed */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     wait for the next deadline of a periodic sampling schedule
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *periodic pointer to a periodic sampling structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timestamp_ns is null
+ * @note      deadlines are absolute so the read time does not add up, when the caller
+ *            is late the passed deadlines are counted as missed and skipped
+ */
+uint8_t apds9960_periodic_wait(apds9960_handle_t *handle, apds9960_periodic_t *periodic)
+{
+    uint64_t now;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->timestamp_ns == NULL)                                                     /* check timestamp_ns */
+    {
+        handle->debug_print("apds9960: timestamp_ns is null.\n");                         /* timestamp_ns is null */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    periodic->deadline_ns += periodic->period_ns;                                         /* next deadline */
+    now = handle->timestamp_ns();                                                         /* get the time */
+    if (now > periodic->deadline_ns)                                                      /* check late */
+    {
+        uint64_t skip;
+        
+        skip = (now - periodic->deadline_ns) / periodic->period_ns + 1;                   /* get the passed deadlines */
+        periodic->deadline_ns += skip * periodic->period_ns;                              /* keep the period grid */
+        periodic->missed += (uint32_t)skip;                                               /* add the missed */
+    }
+    a_apds9960_sleep_until(handle, periodic->deadline_ns);                                /* sleep until the deadline */
+    periodic->count++;                                                                    /* add the count */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      wait for the next sample and read it
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *event pointer to an event structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read next sample failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timestamp_ns is null
+ *             - 5 sample timeout
+ *             - 6 als and proximity are disabled
+ * @note       it sleeps until the predicted data ready time and reads status and data in one burst,
+ *             the status is only polled again when the prediction was early or once every
+ *             32 samples to follow the chip oscillator, the first call and apds9960_apply_config
+ *             synchronize to the chip cycle again,
+ *             AVALID is waited for when als is enabled, otherwise PVALID
+ */
+uint8_t apds9960_read_next_sample(apds9960_handle_t *handle, apds9960_event_t *event)
+{
+    uint8_t res;
+    uint8_t early;
+    uint8_t buf[10];
+    uint64_t now;
+    uint64_t wait;
+    uint64_t step;
+    uint64_t timeout;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->timestamp_ns == NULL)                                                     /* check timestamp_ns */
+    {
+        handle->debug_print("apds9960: timestamp_ns is null.\n");                         /* timestamp_ns is null */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    if (handle->sample_ns == 0)                                                           /* check the synchronization */
+    {
+        res = a_apds9960_cycle_time(handle, (uint32_t *)&handle->sample_cycle_us, 
+                                    (uint8_t *)&handle->sample_mask);                     /* get the cycle time */
+        if (res != 0)                                                                     /* check result */
+        {
+            return 1;                                                                     /* return error */
+        }
+        if (handle->sample_mask == 0)                                                     /* check the mask */
+        {
+            handle->debug_print("apds9960: als and proximity are disabled.\n");          /* als and proximity are disabled */
+            
+            return 6;                                                                     /* return error */
+        }
+        if ((handle->sample_mask & (1 << APDS9960_STATUS_AVALID)) != 0)                   /* check als */
+        {
+            handle->sample_mask = 1 << APDS9960_STATUS_AVALID;                            /* als is the last state */
+        }
+        res = a_apds9960_iic_read(handle, APDS9960_REG_STATUS, (uint8_t *)buf, 10);      /* read to clear the old sample */
+        if (res != 0)                                                                     /* check result */
+        {
+            handle->debug_print("apds9960: get all data register failed.\n");           /* get all data register failed */
+            
+            return 1;                                                                     /* return error */
+        }
+        handle->sample_period_ns = (uint64_t)handle->sample_cycle_us * 1000;              /* start from the register timing */
+        handle->sample_sync_ns = 0;                                                       /* no phase */
+        handle->sample_count = 0;                                                         /* no samples */
+        wait = handle->timestamp_ns();                                                    /* the phase is unknown */
+        early = 1;                                                                        /* poll until the sample is ready */
+    }
+    else
+    {
+        wait = handle->sample_ns + handle->sample_period_ns;                              /* predicted data ready */
+        early = 0;                                                                        /* not polled yet */
+    }
+    step = handle->sample_period_ns / 16;                                                 /* poll step */
+    if (step < APDS9960_SAMPLE_POLL_US * 1000)                                            /* check the min step */
+    {
+        step = APDS9960_SAMPLE_POLL_US * 1000;                                            /* set the min step */
+    }
+    if (early != 0)                                                                       /* check the synchronization */
+    {
+        wait += step;                                                                     /* first poll */
+    }
+    else if (handle->sample_count >= APDS9960_SAMPLE_PROBE)                               /* check the probe */
+    {
+        wait -= step;                                                                     /* read one step early to measure the phase again */
+    }
+    timeout = wait + handle->sample_period_ns * 2 + step;                                 /* two cycles late */
+    while (1)                                                                             /* loop */
+    {
+        a_apds9960_sleep_until(handle, wait);                                             /* sleep until the time */
+        res = a_apds9960_iic_read(handle, APDS9960_REG_STATUS, (uint8_t *)buf, 10);      /* get status - pdata register */
+        if (res != 0)                                                                     /* check result */
+        {
+            handle->debug_print("apds9960: get all data register failed.\n");           /* get all data register failed */
+            handle->sample_ns = 0;                                                        /* synchronize again */
+            
+            return 1;                                                                     /* return error */
+        }
+        now = handle->timestamp_ns();                                                     /* get the time */
+        if ((buf[0] & handle->sample_mask) != 0)                                          /* check the valid bit */
+        {
+            break;                                                                        /* break */
+        }
+        if (handle->sample_ns != 0)                                                       /* skip the synchronization read */
+        {
+            handle->sample_polls++;                                                       /* the prediction was early */
+        }
+        if (now > timeout)                                                                /* check timeout */
+        {
+            handle->debug_print("apds9960: sample timeout.\n");                          /* sample timeout */
+            handle->sample_ns = 0;                                                        /* synchronize again */
+            
+            return 5;                                                                     /* return error */
+        }
+        early = 1;                                                                        /* flag early */
+        wait = now + step;                                                                /* poll again */
+    }
+    handle->sample_count++;                                                               /* one more cycle */
+    if (early == 0)                                                                       /* check early */
+    {
+        handle->sample_ns = wait - handle->sample_period_ns / 1024;                       /* keep the grid, slowly move earlier */
+    }
+    else
+    {
+        if ((handle->sample_ns != 0) && (handle->sample_sync_ns != 0) && 
+            (handle->sample_count >= 2))                                                  /* check the synchronization */
+        {
+            uint64_t period;
+            uint64_t nominal;
+            
+            period = (now - handle->sample_sync_ns) / handle->sample_count;               /* measured chip period */
+            nominal = (uint64_t)handle->sample_cycle_us * 1000;                           /* register period */
+            if ((period > nominal - nominal / 16) && (period < nominal + nominal / 16))   /* reject skipped cycles */
+            {
+                handle->sample_period_ns = (handle->sample_period_ns * 3 + period) / 4;   /* follow the chip oscillator */
+            }
+        }
+        handle->sample_sync_ns = now;                                                     /* ready within the last step */
+        handle->sample_count = 0;                                                         /* restart the count */
+        handle->sample_ns = now;                                                          /* new phase */
+    }
+    
+    event->timestamp = handle->sample_ns;                                                 /* set the timestamp */
+    event->status = buf[0];                                                               /* set the status */
+    event->gesture_status = 0;                                                            /* no gesture status */
+    event->gesture = 0;                                                                   /* no gesture */
+    event->gesture_second = 0;                                                            /* no second stroke */
+    event->clear = (uint16_t)(((uint16_t)buf[2] << 8) | buf[1]);                          /* set the clear */
+    event->red = (uint16_t)(((uint16_t)buf[4] << 8) | buf[3]);                            /* set the red */
+    event->green = (uint16_t)(((uint16_t)buf[6] << 8) | buf[5]);                          /* set the green */
+    event->blue = (uint16_t)(((uint16_t)buf[8] << 8) | buf[7]);                           /* set the blue */
+    event->proximity = buf[9];                                                            /* set the proximity */
+    event->fifo = NULL;                                                                   /* no fifo */
+    event->fifo_len = 0;                                                                  /* no fifo */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      get the status reads that found no new data
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *polls pointer to a polls buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t apds9960_get_sample_polls(apds9960_handle_t *handle, uint32_t *polls)
+{
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    
+    *polls = handle->sample_polls;                                                        /* get the polls */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      wait for the als data and read it
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  timeout_ms timeout in ms
+ * @param[out] *red pointer to a red buffer
+ * @param[out] *green pointer to a green buffer
+ * @param[out] *blue pointer to a blue buffer
+ * @param[out] *clear pointer to a clear buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait and read rgbc failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timestamp_ns is null
+ *             - 5 wait timeout
+ *             - 6 als is disabled
+ * @note       it waits for AVALID, sleeping while the expected integration time left is long
+ *             and polling the status without sleep when the data is due
+ */
+uint8_t apds9960_wait_and_read_rgbc(apds9960_handle_t *handle, uint32_t timeout_ms, uint16_t *red, uint16_t *green, uint16_t *blue, uint16_t *clear)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->timestamp_ns == NULL)                                                     /* check timestamp_ns */
+    {
+        handle->debug_print("apds9960: timestamp_ns is null.\n");                         /* timestamp_ns is null */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    res = a_apds9960_wait_valid(handle, APDS9960_STATUS_AVALID, timeout_ms, 
+                                (uint64_t *)&handle->wait_als_ns);                        /* wait for als valid */
+    if (res == 5)                                                                         /* check timeout */
+    {
+        handle->debug_print("apds9960: wait timeout.\n");                                /* wait timeout */
+        
+        return 5;                                                                         /* return error */
+    }
+    if (res == 6)                                                                         /* check the engine */
+    {
+        handle->debug_print("apds9960: als is disabled.\n");                             /* als is disabled */
+        
+        return 6;                                                                         /* return error */
+    }
+    if (res != 0)                                                                         /* check result */
+    {
+        return 1;                                                                         /* return error */
+    }
+    if (apds9960_read_rgbc(handle, red, green, blue, clear) != 0)                         /* read rgbc */
+    {
+        return 1;                                                                         /* return error */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      wait for the proximity data and read it
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  timeout_ms timeout in ms
+ * @param[out] *proximity pointer to a proximity buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait and read proximity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timestamp_ns is null
+ *             - 5 wait timeout
+ *             - 6 proximity is disabled
+ * @note       it waits for PVALID, sleeping while the expected cycle time left is long
+ *             and polling the status without sleep when the data is due
+ */
+uint8_t apds9960_wait_and_read_proximity(apds9960_handle_t *handle, uint32_t timeout_ms, uint8_t *proximity)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->timestamp_ns == NULL)                                                     /* check timestamp_ns */
+    {
+        handle->debug_print("apds9960: timestamp_ns is null.\n");                         /* timestamp_ns is null */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    res = a_apds9960_wait_valid(handle, APDS9960_STATUS_PVALID, timeout_ms, 
+                                (uint64_t *)&handle->wait_proximity_ns);                  /* wait for proximity valid */
+    if (res == 5)                                                                         /* check timeout */
+    {
+        handle->debug_print("apds9960: wait timeout.\n");                                /* wait timeout */
+        
+        return 5;                                                                         /* return error */
+    }
+    if (res == 6)                                                                         /* check the engine */
+    {
+        handle->debug_print("apds9960: proximity is disabled.\n");                       /* proximity is disabled */
+        
+        return 6;                                                                         /* return error */
+    }
+    if (res != 0)                                                                         /* check result */
+    {
+        return 1;                                                                         /* return error */
+    }
+    if (apds9960_read_proximity(handle, proximity) != 0)                                  /* read proximity */
+    {
+        return 1;                                                                         /* return error */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     add a stroke to a trajectory axis
+ * @param[in] *axis pointer to a trajectory axis structure
+ * @param[in] swing stroke ratio swing
+ * @param[in] end dataset index of the stroke end
+ * @note      strokes over APDS9960_TRAJECTORY_STROKES are dropped
+ */
+static void a_apds9960_trajectory_stroke(apds9960_trajectory_axis_t *axis, int32_t swing, uint8_t end)
+{
+    if (axis->count < APDS9960_TRAJECTORY_STROKES)                                        /* check the count */
+    {
+        axis->swing[axis->count] = swing;                                                 /* set the swing */
+        axis->end[axis->count] = end;                                                     /* set the end */
+        axis->count++;                                                                    /* count++ */
+    }
+}
+
+/**
+ * @brief     feed one centroid ratio to a trajectory axis
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *axis pointer to a trajectory axis structure
+ * @param[in] ratio centroid ratio
+ * @param[in] index dataset index
+ * @note      a stroke ends when the ratio turns back by sensitivity 2
+ */
+static void a_apds9960_trajectory_axis(apds9960_handle_t *handle, apds9960_trajectory_axis_t *axis,
+                                       int32_t ratio, uint8_t index)
+{
+    int32_t swing;
+    
+    if (axis->dir == 0)                                                                   /* no stroke yet */
+    {
+        if (ratio > axis->high)                                                           /* check the high */
+        {
+            axis->high = ratio;                                                           /* set the high */
+        }
+        if (ratio < axis->low)                                                            /* check the low */
+        {
+            axis->low = ratio;                                                            /* set the low */
+        }
+        if ((axis->high - axis->low) >= handle->gesture_sensitivity_2)                    /* the first stroke starts */
+        {
+            axis->dir = (ratio == axis->high) ? 1 : -1;                                   /* the new extreme gives the direction */
+            axis->pivot = (axis->dir > 0) ? axis->low : axis->high;                       /* set the pivot */
+            axis->extreme = ratio;                                                        /* set the extreme */
+            axis->turn = index;                                                           /* set the turn */
+        }
+        
+        return;                                                                           /* return */
+    }
+    
+    if (((axis->dir > 0) && (ratio > axis->extreme)) ||                                   /* the stroke goes on */
+        ((axis->dir < 0) && (ratio < axis->extreme)))
+    {
+        axis->extreme = ratio;                                                            /* set the extreme */
+        axis->turn = index;                                                               /* set the turn */
+        
+        return;                                                                           /* return */
+    }
+    if (abs(ratio - axis->extreme) >= handle->gesture_sensitivity_2)                      /* the stroke turns */
+    {
+        swing = axis->extreme - axis->pivot;                                              /* get the swing */
+        if (abs(swing) >= handle->gesture_sensitivity_1)                                  /* check sensitivity 1 */
+        {
+            a_apds9960_trajectory_stroke(axis, swing, axis->turn);                        /* add the stroke */
+        }
+        axis->pivot = axis->extreme;                                                      /* the extreme is the new pivot */
+        axis->extreme = ratio;                                                            /* set the extreme */
+        axis->dir = (int8_t)(-axis->dir);                                                 /* reverse the direction */
+        axis->turn = index;                                                               /* set the turn */
+    }
+}
+
+/**
+ * @brief     close a trajectory axis at the gesture exit
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *trajectory pointer to a trajectory structure
+ * @param[in] a axis index, 0 for ud and 1 for lr
+ * @note      an axis without a stroke falls back to the peak order of its two channels
+ */
+static void a_apds9960_trajectory_close(apds9960_handle_t *handle, apds9960_trajectory_t *trajectory, uint8_t a)
+{
+    apds9960_trajectory_axis_t *axis;
+    int32_t swing;
+    uint8_t first;
+    uint8_t last;
+    
+    axis = &trajectory->axis[a];                                                          /* get the axis */
+    if (axis->dir != 0)                                                                   /* close the current stroke */
+    {
+        swing = axis->extreme - axis->pivot;                                              /* get the swing */
+        if (abs(swing) >= handle->gesture_sensitivity_1)                                  /* check sensitivity 1 */
+        {
+            a_apds9960_trajectory_stroke(axis, swing, axis->turn);                        /* add the stroke */
+        }
+    }
+    if (axis->count != 0)                                                                 /* strokes are found */
+    {
+        return;                                                                           /* return */
+    }
+    
+    first = trajectory->peak_index[a * 2];                                                /* up or left peak */
+    last = trajectory->peak_index[a * 2 + 1];                                             /* down or right peak */
+    swing = (axis->dir == 0) ? (axis->high - axis->low) : abs(axis->extreme - axis->pivot);        /* get the weak swing */
+    if ((first == last) || (swing < handle->gesture_sensitivity_2))                       /* no crossing order */
+    {
+        return;                                                                           /* return */
+    }
+    if (first < last)                                                                     /* up or left is crossed first */
+    {
+        a_apds9960_trajectory_stroke(axis, -swing, last);                                 /* the ratio falls */
+    }
+    else
+    {
+        a_apds9960_trajectory_stroke(axis, swing, first);                                 /* the ratio rises */
+    }
+}
+
+/**
+ * @brief     merge the strokes of both axes into gestures
+ * @param[in] *trajectory pointer to a trajectory structure
+ * @param[out] *gesture pointer to a first stroke gesture mask buffer
+ * @param[out] *second pointer to a second stroke gesture mask buffer
+ * @note      none
+ */
+static void a_apds9960_trajectory_merge(apds9960_trajectory_t *trajectory, uint8_t *gesture, uint8_t *second)
+{
+    uint8_t mask[APDS9960_TRAJECTORY_STROKES * 2];
+    int32_t swing[APDS9960_TRAJECTORY_STROKES * 2];
+    uint8_t end[APDS9960_TRAJECTORY_STROKES * 2];
+    uint8_t axis[APDS9960_TRAJECTORY_STROKES * 2];
+    uint8_t *out[2];
+    uint8_t i, j, n, k;
+    
+    n = 0;                                                                                /* no stroke */
+    for (i = 0; i < 2; i++)                                                               /* both axes */
+    {
+        for (j = 0; j < trajectory->axis[i].count; j++)                                   /* all strokes */
+        {
+            k = n;                                                                        /* insert by the end index */
+            while ((k > 0) && (end[k - 1] > trajectory->axis[i].end[j]))                  /* find the position */
+            {
+                mask[k] = mask[k - 1];                                                    /* move the mask */
+                swing[k] = swing[k - 1];                                                  /* move the swing */
+                end[k] = end[k - 1];                                                      /* move the end */
+                axis[k] = axis[k - 1];                                                    /* move the axis */
+                k--;                                                                      /* k-- */
+            }
+            swing[k] = trajectory->axis[i].swing[j];                                      /* set the swing */
+            end[k] = trajectory->axis[i].end[j];                                          /* set the end */
+            axis[k] = i;                                                                  /* set the axis */
+            mask[k] = (i == 0) ? a_apds9960_gesture_direction(swing[k], 0) :
+                                 a_apds9960_gesture_direction(0, swing[k]);               /* set the mask */
+            n++;                                                                          /* n++ */
+        }
+    }
+    
+    out[0] = gesture;                                                                     /* first stroke */
+    out[1] = second;                                                                      /* second stroke */
+    *gesture = 0;                                                                         /* no gesture */
+    *second = 0;                                                                          /* no second gesture */
+    k = 0;                                                                                /* first stroke */
+    for (i = 0; (i < 2) && (k < n); i++)                                                  /* two gestures */
+    {
+        *out[i] = mask[k];                                                                /* set the gesture */
+        if ((k + 1 < n) && (axis[k + 1] != axis[k]) &&                                    /* the other axis */
+            ((end[k + 1] - end[k]) <= APDS9960_TRAJECTORY_GAP) &&                         /* ends together */
+            (abs(swing[k + 1]) * 2 >= abs(swing[k])) &&                                   /* similar swing */
+            (abs(swing[k]) * 2 >= abs(swing[k + 1])))
+        {
+            *out[i] |= mask[k + 1];                                                       /* diagonal */
+            k++;                                                                          /* k++ */
+        }
+        k++;                                                                              /* next stroke */
+    }
+}
+
+/**
+ * @brief      end the gesture of a trajectory classifier
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  *trajectory pointer to a trajectory structure
+ * @param[out] *gesture pointer to a first stroke gesture mask buffer
+ * @param[out] *second pointer to a second stroke gesture mask buffer
+ * @note       none
+ */
+static void a_apds9960_trajectory_end(apds9960_handle_t *handle, apds9960_trajectory_t *trajectory,
+                                      uint8_t *gesture, uint8_t *second)
+{
+    a_apds9960_trajectory_close(handle, trajectory, 0);                                   /* close ud axis */
+    a_apds9960_trajectory_close(handle, trajectory, 1);                                   /* close lr axis */
+    a_apds9960_trajectory_merge(trajectory, gesture, second);                             /* merge the strokes */
+    trajectory->second = *second;                                                         /* save the second stroke */
+    trajectory->active = 0;                                                               /* gesture ends */
+}
+
+/**
+ * @brief     init a trajectory classifier
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *trajectory pointer to a trajectory structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t apds9960_trajectory_init(apds9960_handle_t *handle, apds9960_trajectory_t *trajectory)
+{
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    
+    memset(trajectory, 0, sizeof(apds9960_trajectory_t));                                 /* clear the trajectory */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      classify gestures from the whole trajectory one fifo dataset at a time
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  *trajectory pointer to a trajectory structure
+ * @param[in]  *data pointer to one dataset of up, down, left and right
+ * @param[out] *gesture pointer to a first stroke gesture mask buffer
+ * @param[out] *second pointer to a second stroke gesture mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t apds9960_trajectory_decode_dataset(apds9960_handle_t *handle, apds9960_trajectory_t *trajectory,
+                                           uint8_t *data, uint8_t *gesture, uint8_t *second)
+{
+    int32_t ratio[2];
+    uint8_t i;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    
+    *gesture = 0;                                                                         /* no gesture */
+    *second = 0;                                                                          /* no second gesture */
+    if ((data[0] > handle->gesture_threshold) &&                                          /* check gesture threshold */
+        (data[1] > handle->gesture_threshold) &&                                          /* check gesture threshold */
+        (data[2] > handle->gesture_threshold) &&                                          /* check gesture threshold */
+        (data[3] > handle->gesture_threshold)                                             /* check gesture threshold */
+       )
+    {
+        ratio[0] = a_apds9960_gesture_ratio(data[0], data[1]);                            /* get ud ratio */
+        ratio[1] = a_apds9960_gesture_ratio(data[2], data[3]);                            /* get lr ratio */
+        trajectory->exit = 0;                                                             /* the hand is in */
+        if (trajectory->active == 0)                                                      /* a new gesture */
+        {
+            memset(trajectory, 0, sizeof(apds9960_trajectory_t));                         /* clear the trajectory */
+            for (i = 0; i < 2; i++)                                                       /* both axes */
+            {
+                trajectory->axis[i].high = ratio[i];                                      /* set the high */
+                trajectory->axis[i].low = ratio[i];                                       /* set the low */
+            }
+            trajectory->active = 1;                                                       /* track the gesture */
+        }
+        for (i = 0; i < 4; i++)                                                           /* all channels */
+        {
+            if (data[i] > trajectory->peak[i])                                            /* check the peak */
+            {
+                trajectory->peak[i] = data[i];                                            /* set the peak */
+                trajectory->peak_index[i] = trajectory->index;                            /* set the peak time */
+            }
+        }
+        a_apds9960_trajectory_axis(handle, &trajectory->axis[0], ratio[0], trajectory->index);        /* ud axis */
+        a_apds9960_trajectory_axis(handle, &trajectory->axis[1], ratio[1], trajectory->index);        /* lr axis */
+        if (trajectory->index < 0xFF)                                                     /* check the index */
+        {
+            trajectory->index++;                                                          /* index++ */
+        }
+        
+        return 0;                                                                         /* success return 0 */
+    }
+    
+    if (trajectory->active == 0)                                                          /* no gesture */
+    {
+        return 0;                                                                         /* success return 0 */
+    }
+    trajectory->exit++;                                                                   /* exit++ */
+    if (trajectory->exit < APDS9960_GESTURE_EXIT_FRAMES)                                  /* the hand may be back */
+    {
+        return 0;                                                                         /* success return 0 */
+    }
+    a_apds9960_trajectory_end(handle, trajectory, gesture, second);                       /* end the gesture */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     init the trajectory decoder
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *state pointer to a trajectory structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 state is NULL
+ * @note      none
+ */
+static uint8_t a_apds9960_trajectory_decoder_init(apds9960_handle_t *handle, void *state)
+{
+    if (state == NULL)                                                                    /* check the state */
+    {
+        handle->debug_print("apds9960: trajectory is null.\n");                          /* trajectory is null */
+        
+        return 1;                                                                         /* return error */
+    }
+    memset(state, 0, sizeof(apds9960_trajectory_t));                                      /* clear the trajectory */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      feed one dataset to the trajectory decoder
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  *state pointer to a trajectory structure
+ * @param[in]  *data pointer to one dataset of up, down, left and right
+ * @param[out] *gesture pointer to a first stroke gesture mask buffer
+ * @param[out] *second pointer to a second stroke gesture mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 feed failed
+ * @note       none
+ */
+static uint8_t a_apds9960_trajectory_decoder_feed(apds9960_handle_t *handle, void *state, uint8_t *data, uint8_t *gesture, uint8_t *second)
+{
+    return apds9960_trajectory_decode_dataset(handle, (apds9960_trajectory_t *)state, data, gesture, second);  /* decode one dataset */
+}
+
+/**
+ * @brief      end the gesture of the trajectory decoder now
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  *state pointer to a trajectory structure
+ * @param[out] *gesture pointer to a first stroke gesture mask buffer
+ * @param[out] *second pointer to a second stroke gesture mask buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+static uint8_t a_apds9960_trajectory_decoder_flush(apds9960_handle_t *handle, void *state, uint8_t *gesture, uint8_t *second)
+{
+    apds9960_trajectory_t *trajectory = (apds9960_trajectory_t *)state;
+    
+    *gesture = 0;                                                                         /* no gesture */
+    *second = 0;                                                                          /* no second gesture */
+    if (trajectory->active != 0)                                                          /* a gesture is tracked */
+    {
+        a_apds9960_trajectory_end(handle, trajectory, gesture, second);                   /* end the gesture */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     reset the trajectory decoder
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *state pointer to a trajectory structure
+ * @note      none
+ */
+static void a_apds9960_trajectory_decoder_reset(apds9960_handle_t *handle, void *state)
+{
+    (void)handle;
+    
+    memset(state, 0, sizeof(apds9960_trajectory_t));                                      /* clear the trajectory */
+}
+
+/**
+ * @brief built-in trajectory decoder
+ */
+const apds9960_gesture_decoder_t g_apds9960_gesture_decoder_trajectory =
+{
+    "trajectory",                                 /* name */
+    a_apds9960_trajectory_decoder_init,           /* init */
+    a_apds9960_trajectory_decoder_feed,           /* feed */
+    a_apds9960_trajectory_decoder_flush,          /* flush */
+    a_apds9960_trajectory_decoder_reset,          /* reset */
+};
+
 /**
  * @brief     set the chip register
  * @param[in] *handle pointer to an apds9960 handle structure
@@ -71,6 +71,54 @@ extern "C"{
     #define APDS9960_GESTURE_SENSITIVITY_2 20        /**< 20 */
 #endif
 
+#ifndef APDS9960_GESTURE_CONFIDENCE
+    #define APDS9960_GESTURE_CONFIDENCE    20        /**< 20 */
+#endif
+
+#ifndef APDS9960_GESTURE_EXIT_FRAMES
+    #define APDS9960_GESTURE_EXIT_FRAMES   2         /**< 2 */
+#endif
+
+/**
+ * @brief apds9960 trajectory classifier definition
+ */
+#ifndef APDS9960_TRAJECTORY_STROKES
+    #define APDS9960_TRAJECTORY_STROKES    2         /**< strokes kept per axis */
+#endif
+
+#ifndef APDS9960_TRAJECTORY_GAP
+    #define APDS9960_TRAJECTORY_GAP        2         /**< max datasets between the ends of a diagonal's strokes */
+#endif
+
+/**
+ * @brief apds9960 gesture scan definition
+ */
+#ifndef APDS9960_GESTURE_SIMD
+    #define APDS9960_GESTURE_SIMD          1         /**< use sse2 or neon when the compiler targets it, 0 for scalar only */
+#endif
+
+/**
+ * @brief apds9960 register cache definition
+ */
+#define APDS9960_CACHE_SIZE 44        /**< cache the register map from 0x80 to 0xAB */
+
+/**
+ * @brief apds9960 gesture fifo definition
+ */
+#define APDS9960_GESTURE_FIFO_DEPTH 32        /**< 32 datasets of the gesture fifo */
+
+/**
+ * @brief apds9960 iic batch definition
+ */
+#define APDS9960_IIC_BATCH_MAX 21             /**< 21 transfers, 21 reads use 42 iic messages */
+
+/**
+ * @brief apds9960 event ring definition
+ */
+#ifndef APDS9960_EVENT_RING_SIZE
+    #define APDS9960_EVENT_RING_SIZE 16        /**< 16 events, must be a power of 2 */
+#endif
+
 /**
  * @brief apds9960 bool enumeration definition
  */
@@ -340,31 +388,311 @@ typedef enum
     APDS9960_INTERRUPT_STATUS_AVALID        = 0,        /**< als valid */
 } apds9960_interrupt_status_t;
 
+/**
+ * @brief apds9960 gesture enumeration definition
+ */
+typedef enum
+{
+    APDS9960_GESTURE_FAR   = (1 << 0),        /**< gesture far */
+    APDS9960_GESTURE_NEAR  = (1 << 1),        /**< gesture near */
+    APDS9960_GESTURE_DOWN  = (1 << 2),        /**< gesture down */
+    APDS9960_GESTURE_UP    = (1 << 3),        /**< gesture up */
+    APDS9960_GESTURE_RIGHT = (1 << 4),        /**< gesture right */
+    APDS9960_GESTURE_LEFT  = (1 << 5),        /**< gesture left */
+} apds9960_gesture_t;
+
+/**
+ * @brief apds9960 gesture report state enumeration definition
+ */
+typedef enum
+{
+    APDS9960_GESTURE_REPORT_EARLY   = 0x00,        /**< direction leads with margin while the hand is still in */
+    APDS9960_GESTURE_REPORT_CONFIRM = 0x01,        /**< gesture ended in the reported direction */
+    APDS9960_GESTURE_REPORT_RETRACT = 0x02,        /**< gesture ended in another or no direction */
+} apds9960_gesture_report_state_t;
+
+/**
+ * @brief apds9960 iic message structure definition
+ */
+typedef struct apds9960_iic_msg_s
+{
+    uint8_t write;                   /**< 1 for write and 0 for read */
+    uint8_t reg;                     /**< iic register address */
+    uint8_t *buf;                    /**< data buffer */
+    uint16_t len;                    /**< data length */
+} apds9960_iic_msg_t;
+
+/**
+ * @brief apds9960 gesture report structure definition
+ */
+typedef struct apds9960_gesture_report_s
+{
+    uint64_t timestamp;              /**< timestamp in ns when the report is made, 0 when timestamp_ns is not linked */
+    uint8_t gesture;                 /**< gesture mask */
+    uint8_t state;                   /**< report state */
+    int32_t confidence;              /**< lead of the dominant ratio delta over the other one */
+} apds9960_gesture_report_t;
+
+/**
+ * @brief apds9960 interrupt event structure definition
+ */
+typedef struct apds9960_event_s
+{
+    uint64_t timestamp;              /**< timestamp in ns taken when the irq handler is entered */
+    uint8_t status;                  /**< status register */
+    uint8_t gesture_status;          /**< gesture status register bits */
+    uint8_t gesture;                 /**< decoded gesture mask */
+    uint8_t gesture_second;          /**< decoded second stroke gesture mask */
+    uint16_t red;                    /**< red channel data */
+    uint16_t green;                  /**< green channel data */
+    uint16_t blue;                   /**< blue channel data */
+    uint16_t clear;                  /**< clear channel data */
+    uint8_t proximity;               /**< proximity data */
+    uint8_t (*fifo)[4];              /**< drained gesture fifo data */
+    uint8_t fifo_len;                /**< drained gesture fifo length */
+    uint64_t fifo_timestamp;         /**< estimated capture time of fifo[0] in ns, 0 when unknown */
+    uint32_t fifo_period;            /**< estimated time between two fifo datasets in ns */
+} apds9960_event_t;
+
+/**
+ * @brief apds9960 event ring structure definition
+ */
+typedef struct apds9960_event_ring_s
+{
+    volatile uint32_t head;                                                          /**< write index, only changed by the irq handler */
+    volatile uint32_t tail;                                                          /**< read index, only changed by apds9960_read_event */
+    volatile uint32_t dropped;                                                       /**< events dropped because the ring is full */
+    apds9960_event_t event[APDS9960_EVENT_RING_SIZE];                                /**< event buffer */
+    uint8_t fifo[APDS9960_EVENT_RING_SIZE][APDS9960_GESTURE_FIFO_DEPTH][4];          /**< gesture fifo buffer of each event */
+} apds9960_event_ring_t;
+
+/**
+ * @brief apds9960 periodic sampling structure definition
+ */
+typedef struct apds9960_periodic_s
+{
+    uint64_t period_ns;          /**< sampling period in ns */
+    uint64_t deadline_ns;        /**< absolute time of the last deadline in ns */
+    uint32_t count;              /**< deadlines reached */
+    uint32_t missed;             /**< deadlines missed because the caller was late */
+} apds9960_periodic_t;
+
+/**
+ * @brief apds9960 trajectory axis structure definition
+ */
+typedef struct apds9960_trajectory_axis_s
+{
+    int32_t pivot;                                          /**< ratio at the last turning point */
+    int32_t extreme;                                        /**< ratio extreme of the current stroke */
+    int32_t high;                                           /**< max ratio before the first stroke */
+    int32_t low;                                            /**< min ratio before the first stroke */
+    int8_t dir;                                             /**< stroke direction, 0 before the first stroke */
+    uint8_t count;                                          /**< stroke count */
+    int32_t swing[APDS9960_TRAJECTORY_STROKES];             /**< stroke ratio swing */
+    uint8_t end[APDS9960_TRAJECTORY_STROKES];               /**< dataset index of the stroke end */
+    uint8_t turn;                                           /**< dataset index of the extreme */
+} apds9960_trajectory_axis_t;
+
+/**
+ * @brief apds9960 trajectory structure definition
+ */
+typedef struct apds9960_trajectory_s
+{
+    apds9960_trajectory_axis_t axis[2];                     /**< ud and lr centroid axis */
+    uint8_t peak[4];                                        /**< peak of up, down, left and right */
+    uint8_t peak_index[4];                                  /**< dataset index of the peaks */
+    uint8_t index;                                          /**< datasets in the gesture */
+    uint8_t exit;                                           /**< datasets below the threshold */
+    uint8_t active;                                         /**< gesture is tracked */
+    uint8_t second;                                         /**< second stroke gesture mask of the last gesture */
+} apds9960_trajectory_t;
+
+/**
+ * @brief apds9960 ratio decoder structure definition
+ */
+typedef struct apds9960_gesture_ratio_s
+{
+    int32_t ud_delta;                                       /**< ud ratio delta */
+    int32_t lr_delta;                                       /**< lr ratio delta */
+    int32_t ud_first;                                       /**< ud ratio of the first dataset */
+    int32_t lr_first;                                       /**< lr ratio of the first dataset */
+    int32_t ud_last;                                        /**< ud ratio of the last dataset */
+    int32_t lr_last;                                        /**< lr ratio of the last dataset */
+    int32_t near_count;                                     /**< near count */
+    int32_t far_count;                                      /**< far count */
+    uint8_t stream;                                         /**< stream state */
+    uint8_t exit;                                           /**< stream exit datasets */
+    uint8_t early;                                          /**< gesture reported early */
+} apds9960_gesture_ratio_t;
+
+struct apds9960_handle_s;
+
+/**
+ * @brief apds9960 gesture decoder structure definition
+ */
+typedef struct apds9960_gesture_decoder_s
+{
+    const char *name;                                                                                      /**< decoder name */
+    uint8_t (*init)(struct apds9960_handle_s *handle, void *state);                                        /**< point to an init function address */
+    uint8_t (*feed)(struct apds9960_handle_s *handle, void *state, uint8_t *data,
+                    uint8_t *gesture, uint8_t *second);                                                    /**< point to a feed function address */
+    uint8_t (*flush)(struct apds9960_handle_s *handle, void *state, uint8_t *gesture, uint8_t *second);    /**< point to a flush function address */
+    void (*reset)(struct apds9960_handle_s *handle, void *state);                                          /**< point to a reset function address */
+} apds9960_gesture_decoder_t;
+
+/**
+ * @brief apds9960 async operation enumeration definition
+ */
+typedef enum
+{
+    APDS9960_ASYNC_OPERATION_NONE         = 0x00,        /**< no operation */
+    APDS9960_ASYNC_OPERATION_READ_DATA    = 0x01,        /**< read status, rgbc and proximity data */
+    APDS9960_ASYNC_OPERATION_READ_FIFO    = 0x02,        /**< drain the gesture fifo */
+    APDS9960_ASYNC_OPERATION_IRQ          = 0x03,        /**< service the interrupt */
+    APDS9960_ASYNC_OPERATION_APPLY_CONFIG = 0x04,        /**< apply the configuration */
+} apds9960_async_operation_t;
+
+/**
+ * @brief apds9960 async state enumeration definition
+ */
+typedef enum
+{
+    APDS9960_ASYNC_STATE_IDLE  = 0x00,        /**< no operation is submitted */
+    APDS9960_ASYNC_STATE_BUSY  = 0x01,        /**< operation is running */
+    APDS9960_ASYNC_STATE_DONE  = 0x02,        /**< operation is done */
+    APDS9960_ASYNC_STATE_ERROR = 0x03,        /**< operation failed */
+} apds9960_async_state_t;
+
 /**
  * @brief apds9960 handle structure definition
  */
 typedef struct apds9960_handle_s
 {
-    uint8_t (*iic_init)(void);                                                          /**< point to an iic_init function address */
-    uint8_t (*iic_deinit)(void);                                                        /**< point to an iic_deinit function address */
-    uint8_t (*iic_read)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);         /**< point to an iic_read function address */
-    uint8_t (*iic_write)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);        /**< point to an iic_write function address */
-    void (*delay_ms)(uint32_t ms);                                                      /**< point to a delay_ms function address */
-    void (*debug_print)(const char *const fmt, ...);                                    /**< point to a debug_print function address */
-    void (*receive_callback)(uint8_t type);                                             /**< point to a receive_callback function address */
-    uint8_t inited;                                                                     /**< inited flag */
-    uint8_t gesture_status;                                                             /**< gesture status */
-    uint8_t gesture_threshold;                                                          /**< gesture threshold */
-    int32_t gesture_sensitivity_1;                                                      /**< gesture sensitivity 1 */
-    int32_t gesture_sensitivity_2;                                                      /**< gesture sensitivity 2 */
-    int32_t gesture_ud_delta;                                                           /**< gesture ud delta */
-    int32_t gesture_lr_delta;                                                           /**< gesture lr delta */
-    int32_t gesture_ud_count;                                                           /**< gesture ud count */
-    int32_t gesture_lr_count;                                                           /**< gesture lr count */
-    int32_t gesture_near_count;                                                         /**< gesture near count */
-    int32_t gesture_far_count;                                                          /**< gesture far count */
+    uint8_t (*iic_init)(void *user);                                                                       /**< point to an iic_init function address */
+    uint8_t (*iic_deinit)(void *user);                                                                     /**< point to an iic_deinit function address */
+    uint8_t (*iic_read)(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);                /**< point to an iic_read function address */
+    uint8_t (*iic_write)(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);               /**< point to an iic_write function address */
+    void (*delay_ms)(uint32_t ms);                                                                         /**< point to a delay_ms function address */
+    void (*debug_print)(const char *const fmt, ...);                                                       /**< point to a debug_print function address */
+    void (*receive_callback)(void *user, uint8_t type);                                                    /**< point to a receive_callback function address */
+    void (*event_callback)(void *user, apds9960_event_t *event);                                           /**< point to an event_callback function address */
+    uint64_t (*timestamp_ns)(void);                                                                        /**< point to a timestamp_ns function address */
+    void *user;                                                                                            /**< user context passed to the iic functions and callbacks */
+    uint8_t (*iic_read_submit)(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);         /**< point to an iic_read_submit function address */
+    uint8_t (*iic_write_submit)(void *user, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);        /**< point to an iic_write_submit function address */
+    uint8_t (*iic_poll)(void *user);                                                                       /**< point to an iic_poll function address */
+    void (*async_callback)(void *user, uint8_t operation, uint8_t res);                                    /**< point to an async_callback function address */
+    uint8_t (*iic_transfer)(void *user, uint8_t addr, apds9960_iic_msg_t *msg, uint8_t num);               /**< point to an iic_transfer function address */
+    apds9960_event_ring_t *event_ring;                                                                     /**< event ring filled by the irq handler */
+    void (*delay_until_ns)(uint64_t ns);                                                                   /**< point to a delay_until_ns function address */
+    void (*gesture_callback)(void *user, apds9960_gesture_report_t *report);                               /**< point to a gesture_callback function address */
+    uint8_t inited;                                                                                        /**< inited flag */
+    uint8_t gesture_status;                                                                                /**< gesture status */
+    uint8_t gesture_second;                                                                                /**< second stroke gesture status */
+    uint8_t gesture_threshold;                                                                             /**< gesture threshold */
+    int32_t gesture_sensitivity_1;                                                                         /**< gesture sensitivity 1 */
+    int32_t gesture_sensitivity_2;                                                                         /**< gesture sensitivity 2 */
+    int32_t gesture_confidence;                                                                            /**< gesture confidence */
+    apds9960_gesture_ratio_t gesture_ratio;                                                                /**< state of the built-in ratio decoder */
+    const apds9960_gesture_decoder_t *gesture_decoder;                                                     /**< gesture decoder */
+    void *gesture_decoder_state;                                                                           /**< gesture decoder state */
+    uint8_t gesture_fifo_level;                                                                            /**< gesture fifo level left unread */
+    uint8_t cache_enable;                                                                                  /**< register cache enable flag */
+    uint64_t cache_valid;                                                                                  /**< register cache valid bit map */
+    uint8_t cache[APDS9960_CACHE_SIZE];                                                                    /**< register cache buffer */
+    uint8_t event_fifo[APDS9960_GESTURE_FIFO_DEPTH][4];                                                    /**< event gesture fifo buffer */
+    uint8_t async_operation;                                                                               /**< async operation */
+    uint8_t async_state;                                                                                   /**< async state */
+    uint8_t async_step;                                                                                    /**< async operation step */
+    uint8_t async_pending;                                                                                 /**< async transfer in flight flag */
+    uint8_t async_write;                                                                                   /**< async transfer direction */
+    uint8_t async_reg;                                                                                     /**< async transfer register */
+    uint16_t async_len;                                                                                    /**< async transfer length */
+    uint8_t *async_data;                                                                                   /**< async transfer buffer */
+    uint8_t async_count;                                                                                   /**< async gesture fifo datasets in flight */
+    uint8_t async_size;                                                                                    /**< async gesture fifo buffer size */
+    apds9960_event_t *async_event;                                                                         /**< async output event */
+    const struct apds9960_config_s *async_config;                                                          /**< async configuration */
+    uint8_t async_buf[APDS9960_CACHE_SIZE];                                                                /**< async register buffer */
+    uint64_t sample_ns;                                                                                    /**< estimated time of the last data ready, 0 when not synchronized */
+    uint64_t sample_period_ns;                                                                             /**< measured cycle time used to predict the next data ready */
+    uint64_t sample_sync_ns;                                                                               /**< time of the last status poll that found new data */
+    uint32_t sample_count;                                                                                 /**< samples since the last synchronization */
+    uint32_t sample_cycle_us;                                                                              /**< cycle time of the register timing */
+    uint32_t sample_polls;                                                                                 /**< status reads that found no new data */
+    uint8_t sample_mask;                                                                                   /**< status valid bit of the next sample */
+    uint64_t wait_als_ns;                                                                                  /**< time AVALID was found last */
+    uint64_t wait_proximity_ns;                                                                            /**< time PVALID was found last */
+    uint32_t gesture_period_ns;                                                                            /**< time between two gesture datasets, 0 when not read yet */
+    uint8_t gesture_fifo_threshold;                                                                        /**< datasets in the fifo when the gesture interrupt is asserted */
+    uint64_t gesture_edge_ns;                                                                              /**< edge time of the irq being handled, 0 otherwise */
+    uint64_t gesture_fifo_ns;                                                                              /**< estimated capture time of the first dataset of the last fifo read */
 } apds9960_handle_t;
 
+/**
+ * @brief apds9960 configuration structure definition
+ */
+typedef struct apds9960_config_s
+{
+    apds9960_bool_t power_on;                                                   /**< power on */
+    apds9960_bool_t als_enable;                                                 /**< als enable */
+    apds9960_bool_t proximity_detect_enable;                                    /**< proximity detect enable */
+    apds9960_bool_t wait_enable;                                                /**< wait enable */
+    apds9960_bool_t als_interrupt_enable;                                       /**< als interrupt enable */
+    apds9960_bool_t proximity_interrupt_enable;                                 /**< proximity interrupt enable */
+    apds9960_bool_t gesture_enable;                                             /**< gesture enable */
+    uint8_t adc_integration_time;                                               /**< adc integration time register raw data */
+    uint8_t wait_time;                                                          /**< wait time register raw data */
+    apds9960_bool_t wait_long;                                                  /**< wait long */
+    uint16_t als_interrupt_low_threshold;                                       /**< als interrupt low threshold */
+    uint16_t als_interrupt_high_threshold;                                      /**< als interrupt high threshold */
+    uint8_t proximity_interrupt_low_threshold;                                  /**< proximity interrupt low threshold */
+    uint8_t proximity_interrupt_high_threshold;                                 /**< proximity interrupt high threshold */
+    apds9960_proximity_interrupt_cycle_t proximity_interrupt_cycle;             /**< proximity interrupt cycle */
+    apds9960_als_interrupt_cycle_t als_interrupt_cycle;                         /**< als interrupt cycle */
+    apds9960_proximity_pulse_length_t proximity_pulse_length;                   /**< proximity pulse length */
+    uint8_t proximity_pulse_count;                                              /**< proximity pulse count */
+    apds9960_led_current_t led_current;                                         /**< led current */
+    apds9960_proximity_gain_t proximity_gain;                                   /**< proximity gain */
+    apds9960_als_color_gain_t als_color_gain;                                   /**< als color gain */
+    apds9960_bool_t saturation_interrupt_proximity;                             /**< proximity saturation interrupt */
+    apds9960_bool_t saturation_interrupt_clear_photodiode;                      /**< clear photo diode saturation interrupt */
+    apds9960_led_boost_t led_boost;                                             /**< led boost */
+    int8_t proximity_up_right_offset;                                           /**< proximity up right offset */
+    int8_t proximity_down_left_offset;                                          /**< proximity down left offset */
+    apds9960_bool_t proximity_gain_compensation;                                /**< proximity gain compensation */
+    apds9960_bool_t sleep_after_interrupt;                                      /**< sleep after interrupt */
+    apds9960_bool_t proximity_mask_up;                                          /**< proximity mask up */
+    apds9960_bool_t proximity_mask_down;                                        /**< proximity mask down */
+    apds9960_bool_t proximity_mask_left;                                        /**< proximity mask left */
+    apds9960_bool_t proximity_mask_right;                                       /**< proximity mask right */
+    uint8_t gesture_proximity_enter_threshold;                                  /**< gesture proximity enter threshold */
+    uint8_t gesture_proximity_exit_threshold;                                   /**< gesture proximity exit threshold */
+    apds9960_gesture_fifo_threshold_t gesture_fifo_threshold;                   /**< gesture fifo threshold */
+    apds9960_gesture_exit_persistence_t gesture_exit_persistence;               /**< gesture exit persistence */
+    uint8_t gesture_exit_mask;                                                  /**< gesture exit mask */
+    apds9960_gesture_gain_control_t gesture_gain;                               /**< gesture gain */
+    apds9960_gesture_led_current_t gesture_led_current;                         /**< gesture led current */
+    apds9960_gesture_wait_time_t gesture_wait_time;                             /**< gesture wait time */
+    int8_t gesture_up_offset;                                                   /**< gesture up offset */
+    int8_t gesture_down_offset;                                                 /**< gesture down offset */
+    int8_t gesture_left_offset;                                                 /**< gesture left offset */
+    int8_t gesture_right_offset;                                                /**< gesture right offset */
+    apds9960_gesture_pulse_length_t gesture_pulse_length;                       /**< gesture pulse length */
+    uint8_t gesture_pulse_count;                                                /**< gesture pulse count */
+    apds9960_gesture_dimension_select_t gesture_dimension;                      /**< gesture dimension */
+    apds9960_bool_t gesture_interrupt;                                          /**< gesture interrupt */
+    apds9960_bool_t gesture_mode;                                               /**< gesture mode */
+} apds9960_config_t;
+
+/**
+ * @brief apds9960 register image structure definition
+ */
+typedef struct apds9960_image_s
+{
+    uint8_t reg[APDS9960_CACHE_SIZE];        /**< register map from 0x80 to 0xAB */
+} apds9960_image_t;
+
 /**
  * @brief apds9960 information structure definition
  */
@@ -456,6 +784,99 @@ typedef struct apds9960_info_s
  */
 #define DRIVER_APDS9960_LINK_RECEIVE_CALLBACK(HANDLE, FUC)  (HANDLE)->receive_callback = FUC
 
+/**
+ * @brief     link event_callback function
+ * @param[in] HANDLE pointer to an apds9960 handle structure
+ * @param[in] FUC pointer to an event_callback function address
+ * @note      once linked the irq handler runs it once per interrupt instead of the receive_callback
+ */
+#define DRIVER_APDS9960_LINK_EVENT_CALLBACK(HANDLE, FUC)    (HANDLE)->event_callback = FUC
+
+/**
+ * @brief     link gesture_callback function
+ * @param[in] HANDLE pointer to an apds9960 handle structure
+ * @param[in] FUC pointer to a gesture_callback function address
+ * @note      optional, once linked the gesture decoder commits early, it runs it with an early report
+ *            as soon as a direction is emitted and with a confirm or retract report when the gesture ends,
+ *            the gesture status only gets the direction resolved when the gesture ends
+ */
+#define DRIVER_APDS9960_LINK_GESTURE_CALLBACK(HANDLE, FUC)  (HANDLE)->gesture_callback = FUC
+
+/**
+ * @brief     link timestamp_ns function
+ * @param[in] HANDLE pointer to an apds9960 handle structure
+ * @param[in] FUC pointer to a timestamp_ns function address
+ * @note      optional, the event timestamp is 0 when it is not linked
+ */
+#define DRIVER_APDS9960_LINK_TIMESTAMP_NS(HANDLE, FUC)      (HANDLE)->timestamp_ns = FUC
+
+/**
+ * @brief     link user context
+ * @param[in] HANDLE pointer to an apds9960 handle structure
+ * @param[in] USER pointer to a user context
+ * @note      the context is passed to the iic functions and callbacks, so one handle per sensor
+ *            can share the same linked functions
+ */
+#define DRIVER_APDS9960_LINK_USER(HANDLE, USER)             (HANDLE)->user = USER
+
+/**
+ * @brief     link iic_read_submit function
+ * @param[in] HANDLE pointer to an apds9960 handle structure
+ * @param[in] FUC pointer to an iic_read_submit function address
+ * @note      optional, only the async functions need it
+ */
+#define DRIVER_APDS9960_LINK_IIC_READ_SUBMIT(HANDLE, FUC)   (HANDLE)->iic_read_submit = FUC
+
+/**
+ * @brief     link iic_write_submit function
+ * @param[in] HANDLE pointer to an apds9960 handle structure
+ * @param[in] FUC pointer to an iic_write_submit function address
+ * @note      optional, only the async functions need it
+ */
+#define DRIVER_APDS9960_LINK_IIC_WRITE_SUBMIT(HANDLE, FUC)  (HANDLE)->iic_write_submit = FUC
+
+/**
+ * @brief     link iic_poll function
+ * @param[in] HANDLE pointer to an apds9960 handle structure
+ * @param[in] FUC pointer to an iic_poll function address
+ * @note      optional, only the async functions need it
+ */
+#define DRIVER_APDS9960_LINK_IIC_POLL(HANDLE, FUC)          (HANDLE)->iic_poll = FUC
+
+/**
+ * @brief     link async_callback function
+ * @param[in] HANDLE pointer to an apds9960 handle structure
+ * @param[in] FUC pointer to an async_callback function address
+ * @note      optional, it is run by apds9960_async_poll when an operation is finished
+ */
+#define DRIVER_APDS9960_LINK_ASYNC_CALLBACK(HANDLE, FUC)    (HANDLE)->async_callback = FUC
+
+/**
+ * @brief     link iic_transfer function
+ * @param[in] HANDLE pointer to an apds9960 handle structure
+ * @param[in] FUC pointer to an iic_transfer function address
+ * @note      optional, when it is not linked the batched transfers fall back to iic_read and iic_write
+ */
+#define DRIVER_APDS9960_LINK_IIC_TRANSFER(HANDLE, FUC)      (HANDLE)->iic_transfer = FUC
+
+/**
+ * @brief     link event ring
+ * @param[in] HANDLE pointer to an apds9960 handle structure
+ * @param[in] RING pointer to an event ring structure
+ * @note      once linked the irq handler pushes one event per interrupt into the ring,
+ *            the ring is reset by apds9960_init and a ring linked later must be zeroed
+ */
+#define DRIVER_APDS9960_LINK_EVENT_RING(HANDLE, RING)       (HANDLE)->event_ring = RING
+
+/**
+ * @brief     link delay_until_ns function
+ * @param[in] HANDLE pointer to an apds9960 handle structure
+ * @param[in] FUC pointer to a delay_until_ns function address
+ * @note      optional, it sleeps until an absolute timestamp_ns time,
+ *            apds9960_periodic_wait falls back to delay_ms when it is not linked
+ */
+#define DRIVER_APDS9960_LINK_DELAY_UNTIL_NS(HANDLE, FUC)    (HANDLE)->delay_until_ns = FUC
+
 /**
  * @}
  */
@@ -485,10 +906,28 @@ uint8_t apds9960_info(apds9960_info_t *info);
  *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      gesture registers are only accessed when the gesture interrupt is asserted and
+ *            the gesture fifo is only cleared when the callback has not drained it,
+ *            when the event_callback is linked the status, data and gesture fifo are read
+ *            in bursts and reported by one event instead of the receive_callback
  */
 uint8_t apds9960_irq_handler(apds9960_handle_t *handle);
 
+/**
+ * @brief     irq handler with the interrupt timestamp
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] timestamp interrupt timestamp in ns
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      timestamp is the edge time taken by the interrupt source, e.g. the kernel gpio event time,
+ *            it is used as the event timestamp instead of timestamp_ns, without the event callback and
+ *            ring it anchors the gesture fifo drained by the receive_callback
+ */
+uint8_t apds9960_irq_handler_timestamp(apds9960_handle_t *handle, uint64_t timestamp);
+
 /**
  * @brief     initialize the chip
  * @param[in] *handle pointer to an apds9960 handle structure
@@ -545,6 +984,24 @@ uint8_t apds9960_read_rgbc(apds9960_handle_t *handle, uint16_t *red, uint16_t *g
  */
 uint8_t apds9960_read_proximity(apds9960_handle_t *handle, uint8_t *proximity);
 
+/**
+ * @brief      read the status, rgbc and proximity data in one transaction
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *status pointer to a status buffer
+ * @param[out] *red pointer to a red buffer
+ * @param[out] *green pointer to a green buffer
+ * @param[out] *blue pointer to a blue buffer
+ * @param[out] *clear pointer to a clear buffer
+ * @param[out] *proximity pointer to a proximity buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read all failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       status can be NULL, then the status register is not read
+ */
+uint8_t apds9960_read_all(apds9960_handle_t *handle, uint8_t *status, uint16_t *red, uint16_t *green, uint16_t *blue, uint16_t *clear, uint8_t *proximity);
+
 /**
  * @brief         read data from the gesture fifo
  * @param[in]     *handle pointer to an apds9960 handle structure
@@ -559,6 +1016,66 @@ uint8_t apds9960_read_proximity(apds9960_handle_t *handle, uint8_t *proximity);
  */
 uint8_t apds9960_read_gesture_fifo(apds9960_handle_t *handle, uint8_t (*data)[4], uint8_t *len);
 
+/**
+ * @brief      get the capture time of the last read gesture fifo data
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *timestamp pointer to a timestamp buffer
+ * @param[out] *period pointer to a period buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       data[i] of the last apds9960_read_gesture_fifo or apds9960_drain_gesture_fifo was
+ *             captured at about timestamp + i * period ns, timestamp is 0 when it is unknown,
+ *             the period comes from the gesture pulse count, pulse length and wait time
+ */
+uint8_t apds9960_get_gesture_fifo_timestamp(apds9960_handle_t *handle, uint64_t *timestamp, uint32_t *period);
+
+/**
+ * @brief         drain the gesture fifo
+ * @param[in]     *handle pointer to an apds9960 handle structure
+ * @param[out]    **data pointer to a data buffer
+ * @param[in,out] *len pointer to a data length buffer
+ * @param[out]    *overflow pointer to an overflow buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 drain gesture fifo failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          the fifo is read in bursts until it is empty or the data buffer is full,
+ *                when the gesture engine exits the fifo stops filling and the loop ends
+ */
+uint8_t apds9960_drain_gesture_fifo(apds9960_handle_t *handle, uint8_t (*data)[4], uint8_t *len, apds9960_bool_t *overflow);
+
+/**
+ * @brief      read one event from the event ring
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *event pointer to an event structure
+ * @param[out] **fifo pointer to a gesture fifo buffer of APDS9960_GESTURE_FIFO_DEPTH datasets or NULL
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 event ring is NULL
+ *             - 5 event ring is empty
+ * @note       it never blocks and never touches the bus, so it can run on another thread than the irq handler,
+ *             only one thread may read the ring and the gesture fifo is skipped when fifo is NULL
+ */
+uint8_t apds9960_read_event(apds9960_handle_t *handle, apds9960_event_t *event, uint8_t (*fifo)[4]);
+
+/**
+ * @brief      get the number of events dropped by the event ring
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *dropped pointer to a dropped number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 event ring is NULL
+ * @note       an event is dropped when the ring is full, the oldest events are kept
+ */
+uint8_t apds9960_get_event_dropped(apds9960_handle_t *handle, uint32_t *dropped);
+
 /**
  * @brief     decode gestures from the fifo data
  * @param[in] *handle pointer to an apds9960 handle structure
@@ -569,11 +1086,33 @@ uint8_t apds9960_read_gesture_fifo(apds9960_handle_t *handle, uint8_t (*data)[4]
  *            - 1 decode gesture from fifo failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 decode failed
- * @note      none
+ * @note      every dataset is fed to apds9960_gesture_decode_dataset, so the result does not depend on
+ *            how the fifo was split into chunks
  */
 uint8_t apds9960_gesture_decode(apds9960_handle_t *handle, uint8_t (*data)[4], uint8_t len);
 
+/**
+ * @brief      decode gestures from one fifo dataset
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  *data pointer to one dataset of up, down, left and right
+ * @param[out] *gesture pointer to a gesture bits buffer
+ * @param[out] *second pointer to a second stroke gesture bits buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 decode gesture from dataset failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the dataset is fed to the decoder set by apds9960_set_gesture_decoder,
+ *             with the default ratio decoder a gesture starts at the first dataset above the decode threshold and ends after
+ *             APDS9960_GESTURE_EXIT_FRAMES datasets below it, the direction is resolved when the gesture ends
+ *             and gesture is 0 until then, only with the gesture_callback linked an early report is run as
+ *             soon as the dominant ratio delta reaches sensitivity 1 and leads the other one by the confidence,
+ *             it is confirmed or retracted at the end and a retracted one is followed by the direction
+ *             resolved at the end, if any,
+ *             second is the second stroke of a compound gesture and is always 0 with the ratio decoder
+ */
+uint8_t apds9960_gesture_decode_dataset(apds9960_handle_t *handle, uint8_t *data, uint8_t *gesture, uint8_t *second);
+
 /**
  * @brief     set the gesture decode threshold
  * @param[in] *handle pointer to an apds9960 handle structure
@@ -652,6 +1191,126 @@ uint8_t apds9960_set_gesture_decode_sensitivity_2(apds9960_handle_t *handle, int
  */
 uint8_t apds9960_get_gesture_decode_sensitivity_2(apds9960_handle_t *handle, int32_t *sensitivity);
 
+/**
+ * @brief     set the gesture decode confidence
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] confidence gesture decode confidence
+ * @return    status code
+ *            - 0 success
+ *            - 1 set gesture decode confidence failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      a large confidence holds every direction until the gesture ends
+ */
+uint8_t apds9960_set_gesture_decode_confidence(apds9960_handle_t *handle, int32_t confidence);
+
+/**
+ * @brief      get the gesture decode confidence
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *confidence pointer to a gesture decode confidence buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get gesture decode confidence failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t apds9960_get_gesture_decode_confidence(apds9960_handle_t *handle, int32_t *confidence);
+
+/**
+ * @brief      get the ud and lr ratios of fifo datasets
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  **data pointer to data buffer
+ * @param[in]  len length of the data buffer
+ * @param[out] **ratio pointer to a ud and lr ratio buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       ratio[i][0] is ((up - down) * 100) / (up + down) and ratio[i][1] is
+ *             ((left - right) * 100) / (left + right), both are bit-identical to the integer division
+ *             but built on a reciprocal table of the channel sum, so no divider is needed, a ratio is 0
+ *             when both channels are 0, the built-in decoders use the same kernel
+ */
+uint8_t apds9960_gesture_ratio(apds9960_handle_t *handle, uint8_t (*data)[4], uint8_t len, int32_t (*ratio)[2]);
+
+/**
+ * @brief      find the fifo datasets above the gesture decode threshold
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  **data pointer to data buffer
+ * @param[in]  len length of the data buffer
+ * @param[out] *mask pointer to a dataset mask buffer
+ * @param[out] *first pointer to a first dataset index buffer
+ * @param[out] *last pointer to a last dataset index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 len is over the fifo depth
+ * @note       bit i of mask is set when all four channels of data[i] are above the decode threshold,
+ *             first and last are len when no dataset is, four datasets are tested per sse2 or neon
+ *             compare when the compiler targets it and APDS9960_GESTURE_SIMD is not 0
+ */
+uint8_t apds9960_gesture_scan(apds9960_handle_t *handle, uint8_t (*data)[4], uint8_t len,
+                              uint32_t *mask, uint8_t *first, uint8_t *last);
+
+/**
+ * @brief     set the gesture decoder
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *decoder pointer to a gesture decoder, NULL selects g_apds9960_gesture_decoder_ratio
+ * @param[in] *state pointer to the decoder state
+ * @return    status code
+ *            - 0 success
+ *            - 1 set gesture decoder failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 decoder feed is NULL
+ * @note      the decoder init is run with the state before the decoder is used, the state is owned by
+ *            the caller and must live as long as the decoder is set, the built-in ratio decoder
+ *            ignores the state and uses the handle's own one, the second stroke of a compound
+ *            gesture is kept apart from gesture_status and passed to the receive_callback after
+ *            the first stroke
+ */
+uint8_t apds9960_set_gesture_decoder(apds9960_handle_t *handle, const apds9960_gesture_decoder_t *decoder, void *state);
+
+/**
+ * @brief      get the gesture decoder
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] **decoder pointer to a gesture decoder buffer
+ * @param[out] **state pointer to a decoder state buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t apds9960_get_gesture_decoder(apds9960_handle_t *handle, const apds9960_gesture_decoder_t **decoder, void **state);
+
+/**
+ * @brief      end the gesture being decoded
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *gesture pointer to a gesture bits buffer
+ * @param[out] *second pointer to a second stroke gesture bits buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 flush gesture decoder failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the gesture is resolved as if the hand had left, it is also run when the gesture mode
+ *             is disabled
+ */
+uint8_t apds9960_gesture_decode_flush(apds9960_handle_t *handle, uint8_t *gesture, uint8_t *second);
+
+/**
+ * @brief built-in streaming ratio decoder, the default one
+ */
+extern const apds9960_gesture_decoder_t g_apds9960_gesture_decoder_ratio;
+
+/**
+ * @brief built-in trajectory decoder, the state is an apds9960_trajectory_t
+ */
+extern const apds9960_gesture_decoder_t g_apds9960_gesture_decoder_trajectory;
+
 /**
  * @brief     set the configuration
  * @param[in] *handle pointer to an apds9960 handle structure
@@ -1698,7 +2357,7 @@ uint8_t apds9960_get_gesture_dimension_select(apds9960_handle_t *handle, apds996
  *            - 1 gesture fifo clear failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the gesture being decoded is dropped by the decoder reset
  */
 uint8_t apds9960_gesture_fifo_clear(apds9960_handle_t *handle);
 
@@ -1737,7 +2396,7 @@ uint8_t apds9960_get_gesture_interrupt(apds9960_handle_t *handle, apds9960_bool_
  *            - 1 set gesture mode failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      disabling the gesture mode flushes the gesture decoder into the gesture status
  */
 uint8_t apds9960_set_gesture_mode(apds9960_handle_t *handle, apds9960_bool_t enable);
 
@@ -1828,6 +2487,399 @@ uint8_t apds9960_als_interrupt_clear(apds9960_handle_t *handle);
  */
 uint8_t apds9960_all_non_gesture_interrupt_clear(apds9960_handle_t *handle);
 
+/**
+ * @}
+ */
+
+/**
+ * @defgroup apds9960_cache_driver apds9960 cache driver function
+ * @brief    apds9960 cache driver modules
+ * @ingroup  apds9960_driver
+ * @{
+ */
+
+/**
+ * @brief     enable or disable the register cache
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the cache is write through and only holds the configuration registers,
+ *            so the setters only write the register once the cache is filled
+ */
+uint8_t apds9960_set_cache(apds9960_handle_t *handle, apds9960_bool_t enable);
+
+/**
+ * @brief      get the register cache status
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t apds9960_get_cache(apds9960_handle_t *handle, apds9960_bool_t *enable);
+
+/**
+ * @brief     sync the register cache with the chip
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 cache sync failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 cache is disabled
+ * @note      none
+ */
+uint8_t apds9960_cache_sync(apds9960_handle_t *handle);
+
+/**
+ * @brief     invalidate the register cache
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it after the chip is reset or powered down externally
+ */
+uint8_t apds9960_cache_invalidate(apds9960_handle_t *handle);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup apds9960_config_driver apds9960 config driver function
+ * @brief    apds9960 config driver modules
+ * @ingroup  apds9960_driver
+ * @{
+ */
+
+/**
+ * @brief     apply the whole configuration
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *config pointer to a configuration structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 apply config failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 config is invalid
+ * @note      enable register is written after all the other registers
+ */
+uint8_t apds9960_apply_config(apds9960_handle_t *handle, const apds9960_config_t *config);
+
+/**
+ * @brief      read the register image from the chip
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *image pointer to a register image structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get image failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       id, status and data registers are not read and set to 0
+ */
+uint8_t apds9960_get_image(apds9960_handle_t *handle, apds9960_image_t *image);
+
+/**
+ * @brief         pack the configuration into a register image
+ * @param[in]     *handle pointer to an apds9960 handle structure
+ * @param[in]     *config pointer to a configuration structure
+ * @param[in,out] *image pointer to a register image structure
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 config is invalid
+ * @note          image should be read by apds9960_get_image first, reserved bits are kept
+ */
+uint8_t apds9960_config_to_image(apds9960_handle_t *handle, const apds9960_config_t *config, apds9960_image_t *image);
+
+/**
+ * @brief     write the changed registers between two images
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *current pointer to the current register image structure
+ * @param[in] *target pointer to the target register image structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 apply image failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      changed registers are grouped into bursts, engines are disabled before
+ *            and enabled after the other registers are written, a burst never includes
+ *            the reserved registers
+ */
+uint8_t apds9960_apply_image(apds9960_handle_t *handle, const apds9960_image_t *current, const apds9960_image_t *target);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup apds9960_async_driver apds9960 async driver function
+ * @brief    apds9960 async driver modules
+ * @ingroup  apds9960_driver
+ * @{
+ */
+
+/**
+ * @brief      submit an async read of the status, rgbc and proximity data
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *event pointer to an event structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 submit failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 async iic functions are NULL
+ *             - 5 async operation is busy
+ *             - 6 event is NULL
+ * @note       event is filled when apds9960_async_poll reports done
+ */
+uint8_t apds9960_async_read_data(apds9960_handle_t *handle, apds9960_event_t *event);
+
+/**
+ * @brief      submit an async drain of the gesture fifo
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] **data pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @param[out] *event pointer to an event structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 submit failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 async iic functions are NULL
+ *             - 5 async operation is busy
+ *             - 6 event is NULL
+ * @note       event fifo, fifo_len and gesture_status are filled when apds9960_async_poll reports done,
+ *             fifo_timestamp is 0 until a blocking gesture fifo read has read the gesture period
+ */
+uint8_t apds9960_async_read_gesture_fifo(apds9960_handle_t *handle, uint8_t (*data)[4], uint8_t len, apds9960_event_t *event);
+
+/**
+ * @brief      submit an async irq service
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *event pointer to an event structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 submit failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 async iic functions are NULL
+ *             - 5 async operation is busy
+ *             - 6 event is NULL
+ * @note       it runs the same transfers as the event mode of apds9960_irq_handler without retry,
+ *             event is filled when apds9960_async_poll reports done
+ */
+uint8_t apds9960_async_irq_handler(apds9960_handle_t *handle, apds9960_event_t *event);
+
+/**
+ * @brief     submit an async apply of the whole configuration
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *config pointer to a configuration structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async iic functions are NULL
+ *            - 5 async operation is busy
+ *            - 6 config is invalid
+ * @note      config must be kept until apds9960_async_poll reports done
+ */
+uint8_t apds9960_async_apply_config(apds9960_handle_t *handle, const apds9960_config_t *config);
+
+/**
+ * @brief      run the async state machine
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *state pointer to a state buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       it never blocks, a finished transfer starts the next one of the operation,
+ *             blocking functions must not be called while the state is busy
+ */
+uint8_t apds9960_async_poll(apds9960_handle_t *handle, apds9960_async_state_t *state);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup apds9960_timing_driver apds9960 timing driver function
+ * @brief    apds9960 timing driver modules
+ * @ingroup  apds9960_driver
+ * @{
+ */
+
+/**
+ * @brief      get the state machine cycle time
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *us pointer to a cycle time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get cycle time failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       it is the sum of the enabled proximity, gesture, wait and als states,
+ *             proximity and gesture times are estimated from the pulse count and length,
+ *             the wait time is 12 times longer when wait long is enabled,
+ *             one new sample is ready per cycle
+ */
+uint8_t apds9960_get_cycle_time(apds9960_handle_t *handle, uint32_t *us);
+
+/**
+ * @brief     start a periodic sampling schedule
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *periodic pointer to a periodic sampling structure
+ * @param[in] hz sampling rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 periodic init failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timestamp_ns is null
+ *            - 5 hz is invalid
+ * @note      1 <= hz <= 1000000 / cycle time, the first deadline is one period from now
+ */
+uint8_t apds9960_periodic_init(apds9960_handle_t *handle, apds9960_periodic_t *periodic, uint16_t hz);
+
+/**
+ * @brief     wait for the next deadline of a periodic sampling schedule
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *periodic pointer to a periodic sampling structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timestamp_ns is null
+ * @note      deadlines are absolute so the read time does not add up, when the caller
+ *            is late the passed deadlines are counted as missed and skipped
+ */
+uint8_t apds9960_periodic_wait(apds9960_handle_t *handle, apds9960_periodic_t *periodic);
+
+/**
+ * @brief      wait for the next sample and read it
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *event pointer to an event structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read next sample failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timestamp_ns is null
+ *             - 5 sample timeout
+ *             - 6 als and proximity are disabled
+ * @note       it sleeps until the predicted data ready time and reads status and data in one burst,
+ *             the status is only polled again when the prediction was early or once every
+ *             32 samples to follow the chip oscillator, the first call and apds9960_apply_config
+ *             synchronize to the chip cycle again,
+ *             AVALID is waited for when als is enabled, otherwise PVALID
+ */
+uint8_t apds9960_read_next_sample(apds9960_handle_t *handle, apds9960_event_t *event);
+
+/**
+ * @brief      get the status reads that found no new data
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[out] *polls pointer to a polls buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t apds9960_get_sample_polls(apds9960_handle_t *handle, uint32_t *polls);
+
+/**
+ * @brief      wait for the als data and read it
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  timeout_ms timeout in ms
+ * @param[out] *red pointer to a red buffer
+ * @param[out] *green pointer to a green buffer
+ * @param[out] *blue pointer to a blue buffer
+ * @param[out] *clear pointer to a clear buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait and read rgbc failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timestamp_ns is null
+ *             - 5 wait timeout
+ *             - 6 als is disabled
+ * @note       it waits for AVALID, sleeping while the expected integration time left is long
+ *             and polling the status without sleep when the data is due
+ */
+uint8_t apds9960_wait_and_read_rgbc(apds9960_handle_t *handle, uint32_t timeout_ms, uint16_t *red, uint16_t *green, uint16_t *blue, uint16_t *clear);
+
+/**
+ * @brief      wait for the proximity data and read it
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  timeout_ms timeout in ms
+ * @param[out] *proximity pointer to a proximity buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait and read proximity failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timestamp_ns is null
+ *             - 5 wait timeout
+ *             - 6 proximity is disabled
+ * @note       it waits for PVALID, sleeping while the expected cycle time left is long
+ *             and polling the status without sleep when the data is due
+ */
+uint8_t apds9960_wait_and_read_proximity(apds9960_handle_t *handle, uint32_t timeout_ms, uint8_t *proximity);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup apds9960_trajectory_driver apds9960 trajectory driver function
+ * @brief    apds9960 trajectory driver modules
+ * @ingroup  apds9960_driver
+ * @{
+ */
+
+/**
+ * @brief     init a trajectory classifier
+ * @param[in] *handle pointer to an apds9960 handle structure
+ * @param[in] *trajectory pointer to a trajectory structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t apds9960_trajectory_init(apds9960_handle_t *handle, apds9960_trajectory_t *trajectory);
+
+/**
+ * @brief      classify gestures from the whole trajectory one fifo dataset at a time
+ * @param[in]  *handle pointer to an apds9960 handle structure
+ * @param[in]  *trajectory pointer to a trajectory structure
+ * @param[in]  *data pointer to one dataset of up, down, left and right
+ * @param[out] *gesture pointer to a first stroke gesture mask buffer
+ * @param[out] *second pointer to a second stroke gesture mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the ud and lr ratios of every dataset are cut into strokes at each turn larger than
+ *             sensitivity 2, a stroke counts when it swings at least sensitivity 1, an axis without
+ *             a stroke falls back to the peak order of its two channels,
+ *             strokes of both axes ending within APDS9960_TRAJECTORY_GAP datasets make a diagonal,
+ *             e.g. APDS9960_GESTURE_UP | APDS9960_GESTURE_RIGHT, and a following stroke is
+ *             reported in second, e.g. up then down,
+ *             gesture and second are 0 until the gesture ends, the work per dataset is constant
+ */
+uint8_t apds9960_trajectory_decode_dataset(apds9960_handle_t *handle, apds9960_trajectory_t *trajectory,
+                                           uint8_t *data, uint8_t *gesture, uint8_t *second);
+
 /**
  * @}
  */
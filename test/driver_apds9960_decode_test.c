@@ -0,0 +1,607 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_apds9960_decode_test.c
+ * @brief     driver apds9960 decode test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-01-23
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/01/23  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_apds9960_decode_test.h"
+#include <stdlib.h>
+
+static apds9960_handle_t gs_handle;        /**< apds9960 handle */
+static uint8_t gs_data[64][4];             /**< inner data */
+static int32_t gs_ratio[64][2];            /**< kernel ratio buffer */
+static int32_t gs_ratio_check[64][2];      /**< division ratio buffer */
+static uint32_t gs_retract;                /**< retracted early gestures */
+static uint8_t gs_retract_mask;            /**< retracted gestures of one run */
+
+/**
+ * @brief decoders under test
+ */
+static const apds9960_gesture_decoder_t *const gs_decoder[] =
+{
+    &g_apds9960_gesture_decoder_ratio,
+    &g_apds9960_gesture_decoder_trajectory,
+};
+
+/**
+ * @brief decode test case structure definition
+ */
+typedef struct decode_test_case_s
+{
+    const char *name;        /**< case name */
+    float path[6];           /**< hand start, middle and end point */
+    uint8_t gesture;         /**< expected first gesture */
+    uint8_t second;          /**< expected second gesture */
+} decode_test_case_t;
+
+/**
+ * @brief decode test cases, the photodiodes sit at up (0, 1), down (0, -1), left (-1, 0) and right (1, 0)
+ */
+static const decode_test_case_t gs_case[] =
+{
+    {"right",           { 0.0f,  2.0f,  0.0f,  0.0f,  0.0f, -2.0f}, APDS9960_GESTURE_RIGHT,                       0},
+    {"left",            { 0.0f, -2.0f,  0.0f,  0.0f,  0.0f,  2.0f}, APDS9960_GESTURE_LEFT,                        0},
+    {"down",            { 2.0f,  0.0f,  0.0f,  0.0f, -2.0f,  0.0f}, APDS9960_GESTURE_DOWN,                        0},
+    {"up",              {-2.0f,  0.0f,  0.0f,  0.0f,  2.0f,  0.0f}, APDS9960_GESTURE_UP,                          0},
+    {"up right",        {-1.5f,  1.5f,  0.0f,  0.0f,  1.5f, -1.5f}, APDS9960_GESTURE_UP | APDS9960_GESTURE_RIGHT,   0},
+    {"down left",       { 1.5f, -1.5f,  0.0f,  0.0f, -1.5f,  1.5f}, APDS9960_GESTURE_DOWN | APDS9960_GESTURE_LEFT, 0},
+    {"up then down",    {-2.0f,  0.0f,  2.0f,  0.0f, -2.0f,  0.0f}, APDS9960_GESTURE_UP,                          APDS9960_GESTURE_DOWN},
+    {"right then left", { 0.0f,  2.0f,  0.0f, -2.0f,  0.0f,  2.0f}, APDS9960_GESTURE_RIGHT,                       APDS9960_GESTURE_LEFT},
+};
+
+/**
+ * @brief     generate the fifo datasets of a hand path
+ * @param[in] *c pointer to a test case
+ * @param[in] steps datasets while the hand is in
+ * @return    datasets
+ * @note      none
+ */
+static uint8_t a_decode_test_generate(const decode_test_case_t *c, uint8_t steps)
+{
+    const float x[4] = {0.0f, 0.0f, -1.0f, 1.0f};
+    const float y[4] = {1.0f, -1.0f, 0.0f, 0.0f};
+    float px, py, dx, dy, t, v;
+    uint8_t i, k, n;
+    
+    n = 0;
+    for (i = 0; i < 2; i++)
+    {
+        gs_data[n][0] = gs_data[n][1] = gs_data[n][2] = gs_data[n][3] = 1;
+        n++;
+    }
+    for (i = 0; i <= steps; i++)
+    {
+        t = (float)i / (float)steps;
+        if (t < 0.5f)
+        {
+            px = c->path[0] + (c->path[2] - c->path[0]) * t * 2.0f;
+            py = c->path[1] + (c->path[3] - c->path[1]) * t * 2.0f;
+        }
+        else
+        {
+            px = c->path[2] + (c->path[4] - c->path[2]) * (t - 0.5f) * 2.0f;
+            py = c->path[3] + (c->path[5] - c->path[3]) * (t - 0.5f) * 2.0f;
+        }
+        for (k = 0; k < 4; k++)
+        {
+            dx = px - x[k];
+            dy = py - y[k];
+            v = 30.0f + 220.0f / (1.0f + (dx * dx + dy * dy) * 1.5f) + (float)(rand() % 7 - 3);
+            gs_data[n][k] = (uint8_t)((v > 255.0f) ? 255.0f : v);
+        }
+        n++;
+    }
+    for (i = 0; i < 3; i++)
+    {
+        gs_data[n][0] = gs_data[n][1] = gs_data[n][2] = gs_data[n][3] = 1;
+        n++;
+    }
+    
+    return n;
+}
+
+/**
+ * @brief     get the ratios of the datasets with the integer division
+ * @param[in] len datasets
+ * @note      none
+ */
+static void a_decode_test_ratio_division(uint8_t len)
+{
+    uint8_t i;
+    
+    for (i = 0; i < len; i++)
+    {
+        if ((gs_data[i][0] + gs_data[i][1]) == 0)
+        {
+            gs_ratio_check[i][0] = 0;
+            gs_ratio_check[i][1] = 0;
+            
+            continue;
+        }
+        gs_ratio_check[i][0] = ((gs_data[i][0] - gs_data[i][1]) * 100) / (gs_data[i][0] + gs_data[i][1]);
+        gs_ratio_check[i][1] = ((gs_data[i][2] - gs_data[i][3]) * 100) / (gs_data[i][2] + gs_data[i][3]);
+    }
+}
+
+/**
+ * @brief     count the retracted early gestures
+ * @param[in] *user pointer to a user context
+ * @param[in] *report pointer to a gesture report
+ * @note      none
+ */
+static void a_decode_test_callback(void *user, apds9960_gesture_report_t *report)
+{
+    (void)user;
+    
+    if (report->state == APDS9960_GESTURE_REPORT_RETRACT)
+    {
+        gs_retract++;
+        gs_retract_mask |= report->gesture;
+    }
+}
+
+/**
+ * @brief      find the datasets above the threshold one dataset at a time
+ * @param[in]  len datasets
+ * @param[in]  threshold gesture decode threshold
+ * @param[out] *first pointer to a first dataset index buffer
+ * @param[out] *last pointer to a last dataset index buffer
+ * @return     dataset mask
+ * @note       none
+ */
+static uint32_t a_decode_test_scan_scalar(uint8_t len, uint8_t threshold, uint8_t *first, uint8_t *last)
+{
+    uint32_t mask;
+    uint8_t i;
+    
+    mask = 0;
+    *first = len;
+    *last = len;
+    for (i = 0; i < len; i++)
+    {
+        if ((gs_data[i][0] > threshold) && (gs_data[i][1] > threshold) && 
+            (gs_data[i][2] > threshold) && (gs_data[i][3] > threshold))
+        {
+            mask |= 1UL << i;
+            if (*first == len)
+            {
+                *first = i;
+            }
+            *last = i;
+        }
+    }
+    
+    return mask;
+}
+
+/**
+ * @brief     decode test
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+uint8_t apds9960_decode_test(uint32_t times)
+{
+    uint8_t res;
+    uint8_t c;
+    uint8_t i;
+    uint8_t len;
+    uint8_t d;
+    uint8_t g;
+    uint8_t s;
+    uint8_t first;
+    uint8_t second;
+    uint8_t threshold;
+    uint8_t first_check;
+    uint8_t last_check;
+    uint8_t k;
+    uint8_t n;
+    uint8_t status[2];
+    uint16_t a;
+    uint16_t b;
+    uint32_t j;
+    uint32_t ok;
+    uint32_t mismatch;
+    uint32_t mask;
+    uint32_t mask_check;
+    uint32_t ok_all;
+    uint32_t datasets;
+    uint64_t t;
+    uint64_t ns;
+    uint64_t ns_all;
+    uint64_t ns_max;
+    uint64_t ns_kernel;
+    uint64_t ns_division;
+    uint32_t cycle;
+    uint32_t cycle_max;
+    uint64_t cycle_all;
+    uint64_t cycle_kernel;
+    uint64_t cycle_division;
+    apds9960_trajectory_t trajectory;
+    apds9960_info_t info;
+    
+    /* link interface function */
+    DRIVER_APDS9960_LINK_INIT(&gs_handle, apds9960_handle_t);
+    DRIVER_APDS9960_LINK_IIC_INIT(&gs_handle, apds9960_interface_iic_init);
+    DRIVER_APDS9960_LINK_IIC_DEINIT(&gs_handle, apds9960_interface_iic_deinit);
+    DRIVER_APDS9960_LINK_IIC_READ(&gs_handle, apds9960_interface_iic_read);
+    DRIVER_APDS9960_LINK_IIC_WRITE(&gs_handle, apds9960_interface_iic_write);
+    DRIVER_APDS9960_LINK_IIC_TRANSFER(&gs_handle, apds9960_interface_iic_transfer);
+    DRIVER_APDS9960_LINK_DELAY_MS(&gs_handle, apds9960_interface_delay_ms);
+    DRIVER_APDS9960_LINK_TIMESTAMP_NS(&gs_handle, apds9960_interface_timestamp_ns);
+    DRIVER_APDS9960_LINK_DELAY_UNTIL_NS(&gs_handle, apds9960_interface_delay_until_ns);
+    DRIVER_APDS9960_LINK_DEBUG_PRINT(&gs_handle, apds9960_interface_debug_print);
+    DRIVER_APDS9960_LINK_RECEIVE_CALLBACK(&gs_handle, apds9960_interface_receive_callback);
+    
+    /* get information */
+    res = apds9960_info(&info);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get info failed.\n");
+       
+        return 1;
+    }
+    else
+    {
+        /* print chip info */
+        apds9960_interface_debug_print("apds9960: chip is %s.\n", info.chip_name);
+        apds9960_interface_debug_print("apds9960: manufacturer is %s.\n", info.manufacturer_name);
+        apds9960_interface_debug_print("apds9960: interface is %s.\n", info.interface);
+        apds9960_interface_debug_print("apds9960: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        apds9960_interface_debug_print("apds9960: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        apds9960_interface_debug_print("apds9960: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        apds9960_interface_debug_print("apds9960: max current is %0.2fmA.\n", info.max_current_ma);
+        apds9960_interface_debug_print("apds9960: max temperature is %0.1fC.\n", info.temperature_max);
+        apds9960_interface_debug_print("apds9960: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start decode test */
+    apds9960_interface_debug_print("apds9960: start decode test.\n");
+    
+    /* init the apds9960 */
+    res = apds9960_init(&gs_handle);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* ratio kernel against the integer division for every channel pair */
+    mismatch = 0;
+    datasets = 0;
+    ns_kernel = 0;
+    ns_division = 0;
+    cycle_kernel = 0;
+    cycle_division = 0;
+    for (j = 0; j < times; j++)
+    {
+        for (a = 0; a < 256; a++)
+        {
+            for (b = 0; b < 256; b += 64)
+            {
+                for (i = 0; i < 64; i++)
+                {
+                    gs_data[i][0] = (uint8_t)a;
+                    gs_data[i][1] = (uint8_t)(b + i);
+                    gs_data[i][2] = (uint8_t)(b + i);
+                    gs_data[i][3] = (uint8_t)a;
+                }
+                t = apds9960_interface_timestamp_ns();
+                cycle = apds9960_interface_cycle_count();
+                res = apds9960_gesture_ratio(&gs_handle, gs_data, 64, gs_ratio);
+                cycle_kernel += apds9960_interface_cycle_count() - cycle;
+                ns_kernel += apds9960_interface_timestamp_ns() - t;
+                if (res != 0)
+                {
+                    apds9960_interface_debug_print("apds9960: gesture ratio failed.\n");
+                    (void)apds9960_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+                t = apds9960_interface_timestamp_ns();
+                cycle = apds9960_interface_cycle_count();
+                a_decode_test_ratio_division(64);
+                cycle_division += apds9960_interface_cycle_count() - cycle;
+                ns_division += apds9960_interface_timestamp_ns() - t;
+                datasets += 64;
+                for (i = 0; i < 64; i++)
+                {
+                    if ((gs_ratio[i][0] != gs_ratio_check[i][0]) || (gs_ratio[i][1] != gs_ratio_check[i][1]))
+                    {
+                        mismatch++;
+                    }
+                }
+            }
+        }
+    }
+    apds9960_interface_debug_print("apds9960: ratio kernel %d mismatches in %d datasets.\n", mismatch, datasets);
+    if (datasets == 0)
+    {
+        datasets = 1;
+    }
+    apds9960_interface_debug_print("apds9960: ratio kernel %d ps per dataset, division %d ps per dataset.\n", 
+                                   (uint32_t)(ns_kernel * 1000 / datasets), (uint32_t)(ns_division * 1000 / datasets));
+    if (cycle_kernel != 0)
+    {
+        apds9960_interface_debug_print("apds9960: ratio kernel %d.%02d cycles per dataset, division %d.%02d cycles per dataset.\n", 
+                                       (uint32_t)(cycle_kernel / datasets), (uint32_t)(cycle_kernel * 100 / datasets % 100),
+                                       (uint32_t)(cycle_division / datasets), (uint32_t)(cycle_division * 100 / datasets % 100));
+    }
+    if (mismatch != 0)
+    {
+        apds9960_interface_debug_print("apds9960: ratio kernel check failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* threshold scan against the scalar loop for random blocks */
+    res = apds9960_get_gesture_decode_threshold(&gs_handle, &threshold);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get gesture decode threshold failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mismatch = 0;
+    datasets = 0;
+    ns_kernel = 0;
+    ns_division = 0;
+    cycle_kernel = 0;
+    cycle_division = 0;
+    for (j = 0; j < times * 1024; j++)
+    {
+        len = (uint8_t)(1 + rand() % 32);
+        for (i = 0; i < len; i++)
+        {
+            gs_data[i][0] = (uint8_t)(threshold + rand() % 24 - 4);
+            gs_data[i][1] = (uint8_t)(threshold + rand() % 24 - 4);
+            gs_data[i][2] = (uint8_t)(threshold + rand() % 24 - 4);
+            gs_data[i][3] = (uint8_t)(threshold + rand() % 24 - 4);
+        }
+        t = apds9960_interface_timestamp_ns();
+        cycle = apds9960_interface_cycle_count();
+        res = apds9960_gesture_scan(&gs_handle, gs_data, len, &mask, &first, &second);
+        cycle_kernel += apds9960_interface_cycle_count() - cycle;
+        ns_kernel += apds9960_interface_timestamp_ns() - t;
+        if (res != 0)
+        {
+            apds9960_interface_debug_print("apds9960: gesture scan failed.\n");
+            (void)apds9960_deinit(&gs_handle);
+            
+            return 1;
+        }
+        t = apds9960_interface_timestamp_ns();
+        cycle = apds9960_interface_cycle_count();
+        mask_check = a_decode_test_scan_scalar(len, threshold, &first_check, &last_check);
+        cycle_division += apds9960_interface_cycle_count() - cycle;
+        ns_division += apds9960_interface_timestamp_ns() - t;
+        if ((mask != mask_check) || (first != first_check) || (second != last_check))
+        {
+            mismatch++;
+        }
+        datasets += len;
+    }
+    apds9960_interface_debug_print("apds9960: threshold scan %d mismatches in %d datasets.\n", mismatch, datasets);
+    if (datasets == 0)
+    {
+        datasets = 1;
+    }
+    apds9960_interface_debug_print("apds9960: threshold scan %d ps per dataset, scalar loop %d ps per dataset.\n", 
+                                   (uint32_t)(ns_kernel * 1000 / datasets), (uint32_t)(ns_division * 1000 / datasets));
+    if (cycle_kernel != 0)
+    {
+        apds9960_interface_debug_print("apds9960: threshold scan %d.%02d cycles per dataset, scalar loop %d.%02d cycles per dataset.\n", 
+                                       (uint32_t)(cycle_kernel / datasets), (uint32_t)(cycle_kernel * 100 / datasets % 100),
+                                       (uint32_t)(cycle_division / datasets), (uint32_t)(cycle_division * 100 / datasets % 100));
+    }
+    if (mismatch != 0)
+    {
+        apds9960_interface_debug_print("apds9960: threshold scan check failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    for (d = 0; d < sizeof(gs_decoder) / sizeof(gs_decoder[0]); d++)
+    {
+        /* set the decoder */
+        res = apds9960_set_gesture_decoder(&gs_handle, gs_decoder[d], (d == 0) ? NULL : &trajectory);
+        if (res != 0)
+        {
+            apds9960_interface_debug_print("apds9960: set gesture decoder failed.\n");
+            (void)apds9960_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        ok_all = 0;
+        ns_all = 0;
+        ns_max = 0;
+        cycle_all = 0;
+        cycle_max = 0;
+        datasets = 0;
+        for (c = 0; c < sizeof(gs_case) / sizeof(gs_case[0]); c++)
+        {
+            ok = 0;
+            for (j = 0; j < times; j++)
+            {
+                /* 6, 12, 18 or 24 datasets */
+                len = a_decode_test_generate(&gs_case[c], (uint8_t)(6 + (j % 4) * 6));
+                first = 0;
+                second = 0;
+                gs_handle.gesture_status = 0;
+                gs_handle.gesture_second = 0;
+                for (i = 0; i < len; i++)
+                {
+                    t = apds9960_interface_timestamp_ns();
+                    cycle = apds9960_interface_cycle_count();
+                    res = apds9960_gesture_decode_dataset(&gs_handle, gs_data[i], &g, &s);
+                    cycle = apds9960_interface_cycle_count() - cycle;
+                    ns = apds9960_interface_timestamp_ns() - t;
+                    if (res != 0)
+                    {
+                        apds9960_interface_debug_print("apds9960: gesture decode dataset failed.\n");
+                        (void)apds9960_deinit(&gs_handle);
+                        
+                        return 1;
+                    }
+                    first |= g;
+                    second |= s;
+                    ns_all += ns;
+                    ns_max = (ns > ns_max) ? ns : ns_max;
+                    cycle_all += cycle;
+                    cycle_max = (cycle > cycle_max) ? cycle : cycle_max;
+                }
+                res = apds9960_gesture_decode_flush(&gs_handle, &g, &s);
+                if (res != 0)
+                {
+                    apds9960_interface_debug_print("apds9960: gesture decode flush failed.\n");
+                    (void)apds9960_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+                first |= g;
+                second |= s;
+                datasets += len;
+                
+                /* the handle keeps both strokes for the receive_callback */
+                if ((first == gs_case[c].gesture) && (second == gs_case[c].second) &&
+                    (gs_handle.gesture_status == first) && (gs_handle.gesture_second == second))
+                {
+                    ok++;
+                }
+            }
+            apds9960_interface_debug_print("apds9960: %s decoder %s %d/%d.\n", gs_decoder[d]->name,
+                                           gs_case[c].name, ok, times);
+            
+            /* the trajectory decoder resolves every case and the ratio decoder the single swipes, */
+            /* noise may split a slow diagonal swipe into two strokes, so 90% of the runs are enough */
+            if (((d != 0) || (((gs_case[c].gesture & (gs_case[c].gesture - 1)) == 0) && (gs_case[c].second == 0))) &&
+                (ok * 10 < times * 9))
+            {
+                apds9960_interface_debug_print("apds9960: check %s decoder %s error.\n", gs_decoder[d]->name, gs_case[c].name);
+                (void)apds9960_deinit(&gs_handle);
+                
+                return 1;
+            }
+            ok_all += ok;
+        }
+        if (datasets == 0)
+        {
+            datasets = 1;
+        }
+        apds9960_interface_debug_print("apds9960: %s decoder %d correct, %d ns per dataset, max %d ns.\n",
+                                       gs_decoder[d]->name, ok_all, (uint32_t)(ns_all / datasets), (uint32_t)ns_max);
+        if (cycle_all != 0)
+        {
+            apds9960_interface_debug_print("apds9960: %s decoder %d cycles per dataset, max %d cycles.\n",
+                                           gs_decoder[d]->name, (uint32_t)(cycle_all / datasets), cycle_max);
+        }
+    }
+    
+    /* set the default decoder */
+    res = apds9960_set_gesture_decoder(&gs_handle, NULL, NULL);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: set gesture decoder failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the fifo is decoded in chunks and the gesture status is cleared after each one as the irq handler does */
+    ok = 0;
+    gs_retract = 0;
+    for (c = 0; c < sizeof(gs_case) / sizeof(gs_case[0]); c++)
+    {
+        for (j = 0; j < times; j++)
+        {
+            len = a_decode_test_generate(&gs_case[c], (uint8_t)(6 + (j % 4) * 6));
+            for (k = 0; k < 2; k++)
+            {
+                DRIVER_APDS9960_LINK_GESTURE_CALLBACK(&gs_handle, (k == 0) ? NULL : a_decode_test_callback);
+                gs_handle.gesture_status = 0;
+                gs_retract_mask = 0;
+                status[k] = 0;
+                res = 0;
+                for (i = 0; (i < len) && (res == 0); i += n)
+                {
+                    n = ((len - i) < 4) ? (uint8_t)(len - i) : 4;
+                    res = apds9960_gesture_decode(&gs_handle, &gs_data[i], n);
+                    status[k] |= gs_handle.gesture_status & 0x3C;
+                    gs_handle.gesture_status = 0;
+                }
+                if (res == 0)
+                {
+                    res = apds9960_gesture_decode_flush(&gs_handle, &g, &s);
+                }
+                if (res != 0)
+                {
+                    apds9960_interface_debug_print("apds9960: gesture decode failed.\n");
+                    DRIVER_APDS9960_LINK_GESTURE_CALLBACK(&gs_handle, NULL);
+                    (void)apds9960_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+                status[k] |= gs_handle.gesture_status & 0x3C;
+            }
+            if ((status[0] == status[1]) && ((status[0] & (status[0] - 1)) == 0) &&
+                ((status[1] & gs_retract_mask) == 0))
+            {
+                ok++;
+            }
+        }
+    }
+    DRIVER_APDS9960_LINK_GESTURE_CALLBACK(&gs_handle, NULL);
+    gs_handle.gesture_status = 0;
+    gs_handle.gesture_second = 0;
+    apds9960_interface_debug_print("apds9960: early commit %d retracts, check chunked gesture status %s.\n", 
+                                   gs_retract, (ok == times * (sizeof(gs_case) / sizeof(gs_case[0]))) ? "ok" : "error");
+    if (ok != times * (sizeof(gs_case) / sizeof(gs_case[0])))
+    {
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish decode test */
+    apds9960_interface_debug_print("apds9960: finish decode test.\n");
+    (void)apds9960_deinit(&gs_handle);
+    
+    return 0;
+}
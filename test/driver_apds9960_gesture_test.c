@@ -59,13 +59,39 @@ uint8_t apds9960_gesture_test_irq_handler(void)
     }
 }
 
+/**
+ * @brief     gesture test irq with the interrupt timestamp
+ * @param[in] *user pointer to a user context
+ * @param[in] timestamp interrupt timestamp in ns
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      it has the type of the timestamped gpio handler, user is not used
+ */
+uint8_t apds9960_gesture_test_irq_handler_timestamp(void *user, uint64_t timestamp)
+{
+    (void)user;
+    
+    if (apds9960_irq_handler_timestamp(&gs_handle, timestamp) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
 /**
  * @brief     interface receive callback
+ * @param[in] *user pointer to a user context
  * @param[in] type interrupt type
  * @note      none
  */
-static void a_callback(uint8_t type)
+static void a_callback(void *user, uint8_t type)
 {
+    (void)user;
+    
     switch (type)
     {
         case APDS9960_INTERRUPT_STATUS_GESTURE_LEFT :
@@ -130,13 +156,10 @@ static void a_callback(uint8_t type)
             }
             
             /* gesture decode */
-            if (len >= 4)
+            res = apds9960_gesture_decode(&gs_handle, gs_data, len);
+            if (res != 0)
             {
-                res = apds9960_gesture_decode(&gs_handle, gs_data, len);
-                if (res != 0)
-                {
-                    apds9960_interface_debug_print("apds9960: gesture decode failed.\n");
-                }
+                apds9960_interface_debug_print("apds9960: gesture decode failed.\n");
             }
             
             break;
@@ -188,6 +211,33 @@ static void a_callback(uint8_t type)
     }
 }
 
+/**
+ * @brief     interface gesture callback
+ * @param[in] *user pointer to a user context
+ * @param[in] *report pointer to a gesture report
+ * @note      none
+ */
+static void a_gesture_callback(void *user, apds9960_gesture_report_t *report)
+{
+    const char *state;
+    
+    (void)user;
+    
+    if (report->state == APDS9960_GESTURE_REPORT_EARLY)
+    {
+        state = "early";
+    }
+    else if (report->state == APDS9960_GESTURE_REPORT_CONFIRM)
+    {
+        state = "confirm";
+    }
+    else
+    {
+        state = "retract";
+    }
+    apds9960_interface_debug_print("apds9960: %s gesture 0x%02X with confidence %d.\n", state, report->gesture, report->confidence);
+}
+
 /**
  * @brief     gesture test
  * @param[in] times test times
@@ -201,6 +251,8 @@ uint8_t apds9960_gesture_test(uint32_t times)
     uint8_t res;
     uint8_t reg;
     uint32_t i;
+    uint32_t period;
+    uint64_t timestamp;
     apds9960_info_t info;
     
     /* link interface function */
@@ -209,9 +261,13 @@ uint8_t apds9960_gesture_test(uint32_t times)
     DRIVER_APDS9960_LINK_IIC_DEINIT(&gs_handle, apds9960_interface_iic_deinit);
     DRIVER_APDS9960_LINK_IIC_READ(&gs_handle, apds9960_interface_iic_read);
     DRIVER_APDS9960_LINK_IIC_WRITE(&gs_handle, apds9960_interface_iic_write);
+    DRIVER_APDS9960_LINK_IIC_TRANSFER(&gs_handle, apds9960_interface_iic_transfer);
     DRIVER_APDS9960_LINK_DELAY_MS(&gs_handle, apds9960_interface_delay_ms);
+    DRIVER_APDS9960_LINK_TIMESTAMP_NS(&gs_handle, apds9960_interface_timestamp_ns);
+    DRIVER_APDS9960_LINK_DELAY_UNTIL_NS(&gs_handle, apds9960_interface_delay_until_ns);
     DRIVER_APDS9960_LINK_DEBUG_PRINT(&gs_handle, apds9960_interface_debug_print);
     DRIVER_APDS9960_LINK_RECEIVE_CALLBACK(&gs_handle, a_callback);
+    DRIVER_APDS9960_LINK_GESTURE_CALLBACK(&gs_handle, a_gesture_callback);
     
     /* get information */
     res = apds9960_info(&info);
@@ -767,6 +823,16 @@ uint8_t apds9960_gesture_test(uint32_t times)
         return 1;
     }
     
+    /* set gesture decode confidence */
+    res = apds9960_set_gesture_decode_confidence(&gs_handle, 20);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: set gesture decode confidence failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
     /* gesture fifo clear */
     res = apds9960_gesture_fifo_clear(&gs_handle);
     if (res != 0)
@@ -861,6 +927,18 @@ uint8_t apds9960_gesture_test(uint32_t times)
         }
     }
     
+    /* get gesture fifo timestamp */
+    res = apds9960_get_gesture_fifo_timestamp(&gs_handle, &timestamp, &period);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get gesture fifo timestamp failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: last gesture fifo timestamp is %llu ns with period %d ns.\n", 
+                                   (unsigned long long)timestamp, period);
+    
     /* finish gesture test */
     apds9960_interface_debug_print("apds9960: finish gesture test.\n");
     (void)apds9960_deinit(&gs_handle);
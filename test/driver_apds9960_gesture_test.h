@@ -57,6 +57,17 @@ extern "C"{
  */
 uint8_t apds9960_gesture_test_irq_handler(void);
 
+/**
+ * @brief     gesture test irq with the interrupt timestamp
+ * @param[in] *user pointer to a user context
+ * @param[in] timestamp interrupt timestamp in ns
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      it has the type of the timestamped gpio handler, user is not used
+ */
+uint8_t apds9960_gesture_test_irq_handler_timestamp(void *user, uint64_t timestamp);
+
 /**
  * @brief     gesture test
  * @param[in] times test times
@@ -38,6 +38,7 @@
 
 static apds9960_handle_t gs_handle;        /**< apds9960 handle */
 static volatile uint8_t gs_flag;           /**< flag */
+static apds9960_event_ring_t gs_ring;      /**< event ring */
 
 /**
  * @brief  interrupt test irq
@@ -58,13 +59,39 @@ uint8_t apds9960_interrupt_test_irq_handler(void)
     }
 }
 
+/**
+ * @brief     interrupt test irq with the interrupt timestamp
+ * @param[in] *user pointer to a user context
+ * @param[in] timestamp interrupt timestamp in ns
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      it has the type of the timestamped gpio handler, user is not used
+ */
+uint8_t apds9960_interrupt_test_irq_handler_timestamp(void *user, uint64_t timestamp)
+{
+    (void)user;
+    
+    if (apds9960_irq_handler_timestamp(&gs_handle, timestamp) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
 /**
  * @brief     interface receive callback
+ * @param[in] *user pointer to a user context
  * @param[in] type interrupt type
  * @note      none
  */
-static void a_callback(uint8_t type)
+static void a_callback(void *user, uint8_t type)
 {
+    (void)user;
+    
     switch (type)
     {
         case APDS9960_INTERRUPT_STATUS_GESTURE_LEFT :
@@ -191,6 +218,32 @@ static void a_callback(uint8_t type)
     }
 }
 
+/**
+ * @brief     interface event callback
+ * @param[in] *user pointer to a user context
+ * @param[in] *event pointer to an event structure
+ * @note      none
+ */
+static void a_event_callback(void *user, apds9960_event_t *event)
+{
+    (void)user;
+    
+    apds9960_interface_debug_print("apds9960: irq event status 0x%02X at %llu ns.\n", event->status, (unsigned long long)event->timestamp);
+    if ((event->status & (1 << APDS9960_STATUS_PINT)) != 0)
+    {
+        apds9960_interface_debug_print("apds9960: proximity is 0x%02X.\n", event->proximity);
+        gs_flag = 1;
+    }
+    if ((event->status & (1 << APDS9960_STATUS_AINT)) != 0)
+    {
+        apds9960_interface_debug_print("apds9960: red is 0x%04X.\n", event->red);
+        apds9960_interface_debug_print("apds9960: green is 0x%04X.\n", event->green);
+        apds9960_interface_debug_print("apds9960: blue is 0x%04X.\n", event->blue);
+        apds9960_interface_debug_print("apds9960: clear is 0x%04X.\n", event->clear);
+        gs_flag = 1;
+    }
+}
+
 /**
  * @brief     interrupt test
  * @param[in] times test times
@@ -209,6 +262,7 @@ uint8_t apds9960_interrupt_test(uint32_t times, uint16_t als_low_threshold, uint
     uint8_t res;
     uint8_t reg;
     uint32_t i;
+    uint32_t dropped;
     apds9960_info_t info;
     
     /* link interface function */
@@ -217,7 +271,10 @@ uint8_t apds9960_interrupt_test(uint32_t times, uint16_t als_low_threshold, uint
     DRIVER_APDS9960_LINK_IIC_DEINIT(&gs_handle, apds9960_interface_iic_deinit);
     DRIVER_APDS9960_LINK_IIC_READ(&gs_handle, apds9960_interface_iic_read);
     DRIVER_APDS9960_LINK_IIC_WRITE(&gs_handle, apds9960_interface_iic_write);
+    DRIVER_APDS9960_LINK_IIC_TRANSFER(&gs_handle, apds9960_interface_iic_transfer);
     DRIVER_APDS9960_LINK_DELAY_MS(&gs_handle, apds9960_interface_delay_ms);
+    DRIVER_APDS9960_LINK_TIMESTAMP_NS(&gs_handle, apds9960_interface_timestamp_ns);
+    DRIVER_APDS9960_LINK_DELAY_UNTIL_NS(&gs_handle, apds9960_interface_delay_until_ns);
     DRIVER_APDS9960_LINK_DEBUG_PRINT(&gs_handle, apds9960_interface_debug_print);
     DRIVER_APDS9960_LINK_RECEIVE_CALLBACK(&gs_handle, a_callback);
     
@@ -859,6 +916,66 @@ uint8_t apds9960_interrupt_test(uint32_t times, uint16_t als_low_threshold, uint
         }
     }
     
+    /* event callback test */
+    apds9960_interface_debug_print("apds9960: event callback test.\n");
+    
+    /* link the event callback */
+    DRIVER_APDS9960_LINK_EVENT_CALLBACK(&gs_handle, a_event_callback);
+    
+    gs_flag = 0;
+    for (i = 0; i < times; i++)
+    {
+        while (1)
+        {
+            if (gs_flag != 0)
+            {
+                gs_flag = 0;
+                
+                /* 100 ms */
+                apds9960_interface_delay_ms(100);
+                
+                break;
+            }
+            else
+            {
+                /* 100 ms */
+                apds9960_interface_delay_ms(100); 
+                
+                continue;
+            }
+        }
+    }
+    DRIVER_APDS9960_LINK_EVENT_CALLBACK(&gs_handle, NULL);
+    
+    /* event ring test */
+    apds9960_interface_debug_print("apds9960: event ring test.\n");
+    
+    /* link the event ring */
+    memset(&gs_ring, 0, sizeof(apds9960_event_ring_t));
+    DRIVER_APDS9960_LINK_EVENT_RING(&gs_handle, &gs_ring);
+    
+    for (i = 0; i < times; i++)
+    {
+        apds9960_event_t event;
+        
+        /* read events on this thread */
+        while (apds9960_read_event(&gs_handle, &event, NULL) != 0)
+        {
+            /* 100 ms */
+            apds9960_interface_delay_ms(100);
+        }
+        a_event_callback(NULL, &event);
+    }
+    if (apds9960_get_event_dropped(&gs_handle, &dropped) != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get event dropped failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: event ring dropped %d events.\n", dropped);
+    DRIVER_APDS9960_LINK_EVENT_RING(&gs_handle, NULL);
+    
     /* finish interrupt test */
     apds9960_interface_debug_print("apds9960: finish interrupt test.\n");
     (void)apds9960_deinit(&gs_handle);
@@ -51,7 +51,12 @@ uint8_t apds9960_read_test(uint32_t times)
     uint8_t res;
     uint8_t reg;
     uint32_t i;
+    uint32_t cycle;
+    uint32_t polls;
+    uint64_t last;
+    uint64_t gap_max;
     apds9960_info_t info;
+    apds9960_periodic_t periodic;
     
     /* link interface function */
     DRIVER_APDS9960_LINK_INIT(&gs_handle, apds9960_handle_t);
@@ -59,7 +64,13 @@ uint8_t apds9960_read_test(uint32_t times)
     DRIVER_APDS9960_LINK_IIC_DEINIT(&gs_handle, apds9960_interface_iic_deinit);
     DRIVER_APDS9960_LINK_IIC_READ(&gs_handle, apds9960_interface_iic_read);
     DRIVER_APDS9960_LINK_IIC_WRITE(&gs_handle, apds9960_interface_iic_write);
+    DRIVER_APDS9960_LINK_IIC_TRANSFER(&gs_handle, apds9960_interface_iic_transfer);
+    DRIVER_APDS9960_LINK_IIC_READ_SUBMIT(&gs_handle, apds9960_interface_iic_read_submit);
+    DRIVER_APDS9960_LINK_IIC_WRITE_SUBMIT(&gs_handle, apds9960_interface_iic_write_submit);
+    DRIVER_APDS9960_LINK_IIC_POLL(&gs_handle, apds9960_interface_iic_poll);
     DRIVER_APDS9960_LINK_DELAY_MS(&gs_handle, apds9960_interface_delay_ms);
+    DRIVER_APDS9960_LINK_TIMESTAMP_NS(&gs_handle, apds9960_interface_timestamp_ns);
+    DRIVER_APDS9960_LINK_DELAY_UNTIL_NS(&gs_handle, apds9960_interface_delay_until_ns);
     DRIVER_APDS9960_LINK_DEBUG_PRINT(&gs_handle, apds9960_interface_debug_print);
     DRIVER_APDS9960_LINK_RECEIVE_CALLBACK(&gs_handle, apds9960_interface_receive_callback);
     
@@ -696,6 +707,299 @@ uint8_t apds9960_read_test(uint32_t times)
         apds9960_interface_delay_ms(1000);
     }
     
+    /* read all test */
+    apds9960_interface_debug_print("apds9960: read all test.\n");
+    
+    for (i = 0; i < times; i++)
+    {
+        uint8_t status;
+        uint8_t proximity;
+        uint16_t red, green, blue, clear;
+        
+        /* read all */
+        res = apds9960_read_all(&gs_handle, (uint8_t *)&status, (uint16_t *)&red, (uint16_t *)&green, (uint16_t *)&blue, (uint16_t *)&clear, (uint8_t *)&proximity);
+        if (res != 0)
+        {
+            apds9960_interface_debug_print("apds9960: read all failed.\n");
+            (void)apds9960_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* output */
+        apds9960_interface_debug_print("apds9960: status is 0x%02X.\n", status);
+        apds9960_interface_debug_print("apds9960: red is 0x%04X.\n", red);
+        apds9960_interface_debug_print("apds9960: green is 0x%04X.\n", green);
+        apds9960_interface_debug_print("apds9960: blue is 0x%04X.\n", blue);
+        apds9960_interface_debug_print("apds9960: clear is 0x%04X.\n", clear);
+        apds9960_interface_debug_print("apds9960: proximity is 0x%02X.\n", proximity);
+        
+        /* 1000 ms */
+        apds9960_interface_delay_ms(1000);
+    }
+    
+    /* async read test */
+    apds9960_interface_debug_print("apds9960: async read test.\n");
+    
+    for (i = 0; i < times; i++)
+    {
+        uint32_t polls;
+        apds9960_event_t event;
+        apds9960_async_state_t state;
+        
+        /* submit read data */
+        res = apds9960_async_read_data(&gs_handle, &event);
+        if (res != 0)
+        {
+            apds9960_interface_debug_print("apds9960: async read data failed.\n");
+            (void)apds9960_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* poll until finished */
+        polls = 0;
+        state = APDS9960_ASYNC_STATE_BUSY;
+        while (state == APDS9960_ASYNC_STATE_BUSY)
+        {
+            (void)apds9960_async_poll(&gs_handle, &state);
+            polls++;
+        }
+        if (state != APDS9960_ASYNC_STATE_DONE)
+        {
+            apds9960_interface_debug_print("apds9960: async read data failed.\n");
+            (void)apds9960_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* output */
+        apds9960_interface_debug_print("apds9960: poll %d times.\n", polls);
+        apds9960_interface_debug_print("apds9960: status is 0x%02X.\n", event.status);
+        apds9960_interface_debug_print("apds9960: red is 0x%04X.\n", event.red);
+        apds9960_interface_debug_print("apds9960: green is 0x%04X.\n", event.green);
+        apds9960_interface_debug_print("apds9960: blue is 0x%04X.\n", event.blue);
+        apds9960_interface_debug_print("apds9960: clear is 0x%04X.\n", event.clear);
+        apds9960_interface_debug_print("apds9960: proximity is 0x%02X.\n", event.proximity);
+        
+        /* 1000 ms */
+        apds9960_interface_delay_ms(1000);
+    }
+    
+    /* periodic read test */
+    apds9960_interface_debug_print("apds9960: periodic read test.\n");
+    
+    /* get cycle time */
+    res = apds9960_get_cycle_time(&gs_handle, (uint32_t *)&cycle);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get cycle time failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: cycle time is %dus.\n", cycle);
+    
+    /* 1 hz */
+    res = apds9960_periodic_init(&gs_handle, &periodic, 1);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: periodic init failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < times; i++)
+    {
+        uint16_t red, green, blue, clear;
+        
+        /* wait the deadline */
+        res = apds9960_periodic_wait(&gs_handle, &periodic);
+        if (res != 0)
+        {
+            apds9960_interface_debug_print("apds9960: periodic wait failed.\n");
+            (void)apds9960_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* read rgbc */
+        res = apds9960_read_rgbc(&gs_handle, (uint16_t *)&red, (uint16_t *)&green, (uint16_t *)&blue, (uint16_t *)&clear);
+        if (res != 0)
+        {
+            apds9960_interface_debug_print("apds9960: read rgbc failed.\n");
+            (void)apds9960_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* output */
+        apds9960_interface_debug_print("apds9960: red is 0x%04X.\n", red);
+        apds9960_interface_debug_print("apds9960: green is 0x%04X.\n", green);
+        apds9960_interface_debug_print("apds9960: blue is 0x%04X.\n", blue);
+        apds9960_interface_debug_print("apds9960: clear is 0x%04X.\n", clear);
+    }
+    apds9960_interface_debug_print("apds9960: missed %d deadlines.\n", periodic.missed);
+    
+    /* read next sample test */
+    apds9960_interface_debug_print("apds9960: read next sample test.\n");
+    
+    for (i = 0; i < times; i++)
+    {
+        apds9960_event_t event;
+        
+        /* read next sample */
+        res = apds9960_read_next_sample(&gs_handle, &event);
+        if (res != 0)
+        {
+            apds9960_interface_debug_print("apds9960: read next sample failed.\n");
+            (void)apds9960_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* output */
+        apds9960_interface_debug_print("apds9960: status is 0x%02X.\n", event.status);
+        apds9960_interface_debug_print("apds9960: red is 0x%04X.\n", event.red);
+        apds9960_interface_debug_print("apds9960: green is 0x%04X.\n", event.green);
+        apds9960_interface_debug_print("apds9960: blue is 0x%04X.\n", event.blue);
+        apds9960_interface_debug_print("apds9960: clear is 0x%04X.\n", event.clear);
+        apds9960_interface_debug_print("apds9960: proximity is 0x%02X.\n", event.proximity);
+    }
+    
+    /* get sample polls */
+    res = apds9960_get_sample_polls(&gs_handle, (uint32_t *)&polls);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get sample polls failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: %d status polls found no new data.\n", polls);
+    
+    /* read next sample after a timing change test */
+    apds9960_interface_debug_print("apds9960: read next sample after a timing change test.\n");
+    
+    /* convert adc integration time */
+    res = apds9960_adc_integration_time_convert_to_register(&gs_handle, 10.0f, (uint8_t *)&reg);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: adc integration time convert to register failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set adc integration time */
+    res = apds9960_set_adc_integration_time(&gs_handle, reg);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: set adc integration time failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* get cycle time */
+    res = apds9960_get_cycle_time(&gs_handle, (uint32_t *)&cycle);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get cycle time failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: cycle time is %dus.\n", cycle);
+    
+    last = 0;
+    gap_max = 0;
+    for (i = 0; i < 8; i++)
+    {
+        apds9960_event_t event;
+        
+        /* read next sample */
+        res = apds9960_read_next_sample(&gs_handle, &event);
+        if (res != 0)
+        {
+            apds9960_interface_debug_print("apds9960: read next sample failed.\n");
+            (void)apds9960_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* the first samples synchronize again */
+        if ((i >= 2) && (event.timestamp - last > gap_max))
+        {
+            gap_max = event.timestamp - last;
+        }
+        last = event.timestamp;
+    }
+    apds9960_interface_debug_print("apds9960: max sample interval is %dus.\n", (uint32_t)(gap_max / 1000));
+    apds9960_interface_debug_print("apds9960: check sample interval %s.\n", (gap_max < (uint64_t)cycle * 1500) ? "ok" : "error");
+    if (gap_max >= (uint64_t)cycle * 1500)
+    {
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* convert adc integration time */
+    res = apds9960_adc_integration_time_convert_to_register(&gs_handle, 103.0f, (uint8_t *)&reg);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: adc integration time convert to register failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set adc integration time */
+    res = apds9960_set_adc_integration_time(&gs_handle, reg);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: set adc integration time failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* wait and read test */
+    apds9960_interface_debug_print("apds9960: wait and read test.\n");
+    
+    for (i = 0; i < times; i++)
+    {
+        uint8_t proximity;
+        uint16_t red, green, blue, clear;
+        
+        /* wait and read rgbc */
+        res = apds9960_wait_and_read_rgbc(&gs_handle, 1000, (uint16_t *)&red, (uint16_t *)&green, (uint16_t *)&blue, (uint16_t *)&clear);
+        if (res != 0)
+        {
+            apds9960_interface_debug_print("apds9960: wait and read rgbc failed.\n");
+            (void)apds9960_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* wait and read proximity */
+        res = apds9960_wait_and_read_proximity(&gs_handle, 1000, (uint8_t *)&proximity);
+        if (res != 0)
+        {
+            apds9960_interface_debug_print("apds9960: wait and read proximity failed.\n");
+            (void)apds9960_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* output */
+        apds9960_interface_debug_print("apds9960: red is 0x%04X.\n", red);
+        apds9960_interface_debug_print("apds9960: green is 0x%04X.\n", green);
+        apds9960_interface_debug_print("apds9960: blue is 0x%04X.\n", blue);
+        apds9960_interface_debug_print("apds9960: clear is 0x%04X.\n", clear);
+        apds9960_interface_debug_print("apds9960: proximity is 0x%02X.\n", proximity);
+    }
+    
     /* finish read test */
     apds9960_interface_debug_print("apds9960: finish read test.\n");
     (void)apds9960_deinit(&gs_handle);
@@ -38,6 +38,7 @@
 #include <stdlib.h>
 
 static apds9960_handle_t gs_handle;        /**< apds9960 handle */
+static uint8_t gs_fifo[32][4];             /**< gesture fifo buffer */
 
 /**
  * @brief  register test
@@ -76,6 +77,13 @@ uint8_t apds9960_register_test(void)
     apds9960_gesture_wait_time_t gesture_wait_time;
     apds9960_gesture_pulse_length_t gesture_len;
     apds9960_gesture_dimension_select_t s;
+    apds9960_config_t config;
+    apds9960_trajectory_t trajectory;
+    const apds9960_gesture_decoder_t *decoder;
+    void *decoder_state;
+    apds9960_image_t image, image_target;
+    apds9960_event_t event;
+    apds9960_async_state_t state;
     
     /* link interface function */
     DRIVER_APDS9960_LINK_INIT(&gs_handle, apds9960_handle_t);
@@ -83,7 +91,13 @@ uint8_t apds9960_register_test(void)
     DRIVER_APDS9960_LINK_IIC_DEINIT(&gs_handle, apds9960_interface_iic_deinit);
     DRIVER_APDS9960_LINK_IIC_READ(&gs_handle, apds9960_interface_iic_read);
     DRIVER_APDS9960_LINK_IIC_WRITE(&gs_handle, apds9960_interface_iic_write);
+    DRIVER_APDS9960_LINK_IIC_TRANSFER(&gs_handle, apds9960_interface_iic_transfer);
+    DRIVER_APDS9960_LINK_IIC_READ_SUBMIT(&gs_handle, apds9960_interface_iic_read_submit);
+    DRIVER_APDS9960_LINK_IIC_WRITE_SUBMIT(&gs_handle, apds9960_interface_iic_write_submit);
+    DRIVER_APDS9960_LINK_IIC_POLL(&gs_handle, apds9960_interface_iic_poll);
     DRIVER_APDS9960_LINK_DELAY_MS(&gs_handle, apds9960_interface_delay_ms);
+    DRIVER_APDS9960_LINK_TIMESTAMP_NS(&gs_handle, apds9960_interface_timestamp_ns);
+    DRIVER_APDS9960_LINK_DELAY_UNTIL_NS(&gs_handle, apds9960_interface_delay_until_ns);
     DRIVER_APDS9960_LINK_DEBUG_PRINT(&gs_handle, apds9960_interface_debug_print);
     DRIVER_APDS9960_LINK_RECEIVE_CALLBACK(&gs_handle, apds9960_interface_receive_callback);
     
@@ -3027,6 +3041,73 @@ uint8_t apds9960_register_test(void)
     }
     apds9960_interface_debug_print("apds9960: check gesture decode sensitivity %s.\n", sensitivity_check == sensitivity ? "ok" : "error");
     
+    /* apds9960_set_gesture_decode_confidence/apds9960_get_gesture_decode_confidence test */
+    apds9960_interface_debug_print("apds9960: apds9960_set_gesture_decode_confidence/apds9960_get_gesture_decode_confidence test.\n");
+    
+    sensitivity = rand() % 65536;
+    res = apds9960_set_gesture_decode_confidence(&gs_handle, sensitivity);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: set gesture decode confidence failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: set gesture decode confidence %d.\n", sensitivity);
+    res = apds9960_get_gesture_decode_confidence(&gs_handle, (int32_t *)&sensitivity_check);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get gesture decode confidence failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check gesture decode confidence %s.\n", sensitivity_check == sensitivity ? "ok" : "error");
+    
+    /* apds9960_set_gesture_decoder/apds9960_get_gesture_decoder test */
+    apds9960_interface_debug_print("apds9960: apds9960_set_gesture_decoder/apds9960_get_gesture_decoder test.\n");
+    
+    /* set the trajectory decoder */
+    res = apds9960_set_gesture_decoder(&gs_handle, &g_apds9960_gesture_decoder_trajectory, &trajectory);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: set gesture decoder failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: set gesture decoder %s.\n", g_apds9960_gesture_decoder_trajectory.name);
+    res = apds9960_get_gesture_decoder(&gs_handle, &decoder, &decoder_state);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get gesture decoder failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check gesture decoder %s.\n", 
+                                   ((decoder == &g_apds9960_gesture_decoder_trajectory) && (decoder_state == &trajectory)) ? "ok" : "error");
+    
+    /* set the default decoder */
+    res = apds9960_set_gesture_decoder(&gs_handle, NULL, NULL);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: set gesture decoder failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: set gesture decoder default.\n");
+    res = apds9960_get_gesture_decoder(&gs_handle, &decoder, &decoder_state);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get gesture decoder failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check gesture decoder %s.\n", (decoder == &g_apds9960_gesture_decoder_ratio) ? "ok" : "error");
+    
     /* apds9960_adc_integration_time_convert_to_register/apds9960_adc_integration_time_convert_to_data test */
     apds9960_interface_debug_print("apds9960: apds9960_adc_integration_time_convert_to_register/apds9960_adc_integration_time_convert_to_data test.\n");
     
@@ -3185,6 +3266,413 @@ uint8_t apds9960_register_test(void)
     }
     apds9960_interface_debug_print("apds9960: check all non gesture interrupt clear %s.\n", res == 0 ? "ok" : "error");
     
+    /* apds9960_drain_gesture_fifo test */
+    apds9960_interface_debug_print("apds9960: apds9960_drain_gesture_fifo test.\n");
+    
+    /* drain gesture fifo */
+    level = 32;
+    res = apds9960_drain_gesture_fifo(&gs_handle, gs_fifo, (uint8_t *)&level, &enable);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: drain gesture fifo failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: drain gesture fifo %d datasets.\n", level);
+    apds9960_interface_debug_print("apds9960: check drain gesture fifo %s.\n", res == 0 ? "ok" : "error");
+    
+    /* apds9960_set_cache/apds9960_get_cache test */
+    apds9960_interface_debug_print("apds9960: apds9960_set_cache/apds9960_get_cache test.\n");
+    
+    /* enable cache */
+    res = apds9960_set_cache(&gs_handle, APDS9960_BOOL_TRUE);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: set cache failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: enable cache.\n");
+    res = apds9960_get_cache(&gs_handle, &enable);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get cache failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check cache %s.\n", enable == APDS9960_BOOL_TRUE ? "ok" : "error");
+    
+    /* disable cache */
+    res = apds9960_set_cache(&gs_handle, APDS9960_BOOL_FALSE);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: set cache failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: disable cache.\n");
+    res = apds9960_get_cache(&gs_handle, &enable);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get cache failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check cache %s.\n", enable == APDS9960_BOOL_FALSE ? "ok" : "error");
+    
+    /* apds9960_cache_sync/apds9960_cache_invalidate test */
+    apds9960_interface_debug_print("apds9960: apds9960_cache_sync/apds9960_cache_invalidate test.\n");
+    
+    /* enable cache */
+    res = apds9960_set_cache(&gs_handle, APDS9960_BOOL_TRUE);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: set cache failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* cache sync */
+    res = apds9960_cache_sync(&gs_handle);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: cache sync failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check cache sync %s.\n", res == 0 ? "ok" : "error");
+    
+    /* set led current from the cache */
+    res = apds9960_set_led_current(&gs_handle, APDS9960_LED_CURRENT_50_MA);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: set led current failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: set led current 50 mA.\n");
+    
+    /* cache invalidate */
+    res = apds9960_cache_invalidate(&gs_handle);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: cache invalidate failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* get led current from the chip */
+    res = apds9960_get_led_current(&gs_handle, &current);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get led current failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check cache write through %s.\n", current == APDS9960_LED_CURRENT_50_MA ? "ok" : "error");
+    
+    /* disable cache */
+    res = apds9960_set_cache(&gs_handle, APDS9960_BOOL_FALSE);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: set cache failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* apds9960_apply_config test */
+    apds9960_interface_debug_print("apds9960: apds9960_apply_config test.\n");
+    
+    /* set the config */
+    memset(&config, 0, sizeof(apds9960_config_t));
+    config.power_on = APDS9960_BOOL_TRUE;
+    config.adc_integration_time = rand() % 256;
+    config.wait_time = rand() % 256;
+    config.als_interrupt_high_threshold = rand() % 65536;
+    config.proximity_pulse_count = rand() % 64;
+    config.led_current = APDS9960_LED_CURRENT_25_MA;
+    config.proximity_up_right_offset = -(rand() % 128);
+    config.gesture_exit_mask = rand() % 0x10;
+    config.gesture_pulse_count = rand() % 64;
+    config.gesture_interrupt = APDS9960_BOOL_TRUE;
+    res = apds9960_apply_config(&gs_handle, &config);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: apply config failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: apply config.\n");
+    res = apds9960_get_adc_integration_time(&gs_handle, (uint8_t *)&integration_time_check);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get adc integration time failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check adc integration time %s.\n", integration_time_check == config.adc_integration_time ? "ok" : "error");
+    res = apds9960_get_wait_time(&gs_handle, (uint8_t *)&wait_time_check);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get wait time failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check wait time %s.\n", wait_time_check == config.wait_time ? "ok" : "error");
+    res = apds9960_get_als_interrupt_high_threshold(&gs_handle, (uint16_t *)&threshold_check);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get als interrupt high threshold failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check als interrupt high threshold %s.\n", threshold_check == config.als_interrupt_high_threshold ? "ok" : "error");
+    res = apds9960_get_proximity_pulse_count(&gs_handle, (uint16_t *)&count_check);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get proximity pulse count failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check proximity pulse count %s.\n", count_check == config.proximity_pulse_count ? "ok" : "error");
+    res = apds9960_get_led_current(&gs_handle, &current);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get led current failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check led current %s.\n", current == config.led_current ? "ok" : "error");
+    res = apds9960_get_proximity_up_right_offset(&gs_handle, (int8_t *)&offset_check);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get proximity up right offset failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check proximity up right offset %s.\n", offset_check == config.proximity_up_right_offset ? "ok" : "error");
+    res = apds9960_get_gesture_exit_mask(&gs_handle, (uint8_t *)&mask_check);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get gesture exit mask failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check gesture exit mask %s.\n", mask_check == config.gesture_exit_mask ? "ok" : "error");
+    res = apds9960_get_gesture_pulse_count(&gs_handle, (uint16_t *)&count_check);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get gesture pulse count failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check gesture pulse count %s.\n", count_check == config.gesture_pulse_count ? "ok" : "error");
+    res = apds9960_get_gesture_interrupt(&gs_handle, &enable);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get gesture interrupt failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check gesture interrupt %s.\n", enable == config.gesture_interrupt ? "ok" : "error");
+    
+    /* apds9960_get_image/apds9960_config_to_image/apds9960_apply_image test */
+    apds9960_interface_debug_print("apds9960: apds9960_get_image/apds9960_config_to_image/apds9960_apply_image test.\n");
+    
+    /* get the current image */
+    res = apds9960_get_image(&gs_handle, &image);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get image failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* change the config */
+    memcpy(&image_target, &image, sizeof(apds9960_image_t));
+    config.led_current = APDS9960_LED_CURRENT_100_MA;
+    config.gesture_pulse_count = rand() % 64;
+    res = apds9960_config_to_image(&gs_handle, &config, &image_target);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: config to image failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* apply the changed registers */
+    res = apds9960_apply_image(&gs_handle, &image, &image_target);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: apply image failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: apply image.\n");
+    res = apds9960_get_led_current(&gs_handle, &current);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get led current failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check led current %s.\n", current == config.led_current ? "ok" : "error");
+    res = apds9960_get_gesture_pulse_count(&gs_handle, (uint16_t *)&count_check);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get gesture pulse count failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check gesture pulse count %s.\n", count_check == config.gesture_pulse_count ? "ok" : "error");
+    res = apds9960_get_image(&gs_handle, &image);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get image failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check image %s.\n", memcmp(&image, &image_target, sizeof(apds9960_image_t)) == 0 ? "ok" : "error");
+    
+    /* apds9960_async_apply_config test */
+    apds9960_interface_debug_print("apds9960: apds9960_async_apply_config test.\n");
+    
+    /* set the config */
+    config.adc_integration_time = rand() % 256;
+    config.wait_time = rand() % 256;
+    config.als_interrupt_high_threshold = rand() % 65536;
+    res = apds9960_async_apply_config(&gs_handle, &config);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: async apply config failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    state = APDS9960_ASYNC_STATE_BUSY;
+    while (state == APDS9960_ASYNC_STATE_BUSY)
+    {
+        res = apds9960_async_poll(&gs_handle, &state);
+        if (res != 0)
+        {
+            apds9960_interface_debug_print("apds9960: async poll failed.\n");
+            (void)apds9960_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    apds9960_interface_debug_print("apds9960: check async state %s.\n", state == APDS9960_ASYNC_STATE_DONE ? "ok" : "error");
+    res = apds9960_get_adc_integration_time(&gs_handle, (uint8_t *)&integration_time_check);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get adc integration time failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check adc integration time %s.\n", integration_time_check == config.adc_integration_time ? "ok" : "error");
+    res = apds9960_get_wait_time(&gs_handle, (uint8_t *)&wait_time_check);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get wait time failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check wait time %s.\n", wait_time_check == config.wait_time ? "ok" : "error");
+    res = apds9960_get_als_interrupt_high_threshold(&gs_handle, (uint16_t *)&threshold_check);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: get als interrupt high threshold failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    apds9960_interface_debug_print("apds9960: check als interrupt high threshold %s.\n", threshold_check == config.als_interrupt_high_threshold ? "ok" : "error");
+    
+    /* apds9960_async_read_gesture_fifo test */
+    apds9960_interface_debug_print("apds9960: apds9960_async_read_gesture_fifo test.\n");
+    
+    res = apds9960_async_read_gesture_fifo(&gs_handle, gs_fifo, 32, &event);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: async read gesture fifo failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    state = APDS9960_ASYNC_STATE_BUSY;
+    while (state == APDS9960_ASYNC_STATE_BUSY)
+    {
+        res = apds9960_async_poll(&gs_handle, &state);
+        if (res != 0)
+        {
+            apds9960_interface_debug_print("apds9960: async poll failed.\n");
+            (void)apds9960_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    apds9960_interface_debug_print("apds9960: check async state %s.\n", state == APDS9960_ASYNC_STATE_DONE ? "ok" : "error");
+    apds9960_interface_debug_print("apds9960: gesture fifo len is %d.\n", event.fifo_len);
+    
+    /* apds9960_async_irq_handler test */
+    apds9960_interface_debug_print("apds9960: apds9960_async_irq_handler test.\n");
+    
+    res = apds9960_async_irq_handler(&gs_handle, &event);
+    if (res != 0)
+    {
+        apds9960_interface_debug_print("apds9960: async irq handler failed.\n");
+        (void)apds9960_deinit(&gs_handle);
+        
+        return 1;
+    }
+    state = APDS9960_ASYNC_STATE_BUSY;
+    while (state == APDS9960_ASYNC_STATE_BUSY)
+    {
+        res = apds9960_async_poll(&gs_handle, &state);
+        if (res != 0)
+        {
+            apds9960_interface_debug_print("apds9960: async poll failed.\n");
+            (void)apds9960_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    apds9960_interface_debug_print("apds9960: check async state %s.\n", state == APDS9960_ASYNC_STATE_DONE ? "ok" : "error");
+    apds9960_interface_debug_print("apds9960: status is 0x%02X.\n", event.status);
+    
+    /* a NULL event is rejected */
+    res = apds9960_async_irq_handler(&gs_handle, NULL);
+    apds9960_interface_debug_print("apds9960: check async null event %s.\n", res == 6 ? "ok" : "error");
+    
     /* finish register test */
     apds9960_interface_debug_print("apds9960: finish register test.\n");
     (void)apds9960_deinit(&gs_handle);